@@ -237,7 +237,8 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def("markInputVariable", &InputQuery::markInputVariable)
         .def("markOutputVariable", &InputQuery::markOutputVariable)
         .def("outputVariableByIndex", &InputQuery::outputVariableByIndex)
-        .def("setSymbolicBoundTightener", &InputQuery::setSymbolicBoundTightener);
+        .def("setSymbolicBoundTightener", &InputQuery::setSymbolicBoundTightener)
+        .def("constructSymbolicBoundTightener", &InputQuery::constructSymbolicBoundTightener);
     py::class_<MarabouOptions>(m, "Options")
         .def(py::init())
         .def_readwrite("_numWorkers", &MarabouOptions::_numWorkers)
@@ -248,17 +249,28 @@ PYBIND11_MODULE(MarabouCore, m) {
         .def_readwrite("_timeoutFactor", &MarabouOptions::_timeoutFactor)
         .def_readwrite("_verbosity", &MarabouOptions::_verbosity)
         .def_readwrite("_dnc", &MarabouOptions::_dnc);
-    py::class_<SymbolicBoundTightener, std::unique_ptr<SymbolicBoundTightener,py::nodelete>>(m, "SymbolicBoundTightener")
-        .def(py::init())
-        .def("setNumberOfLayers", &SymbolicBoundTightener::setNumberOfLayers)
-        .def("setLayerSize", &SymbolicBoundTightener::setLayerSize)
-        .def("allocateWeightAndBiasSpace", &SymbolicBoundTightener::allocateWeightAndBiasSpace)
-        .def("setBias", &SymbolicBoundTightener::setBias)
-        .def("setWeight", &SymbolicBoundTightener::setWeight)
-        .def("setInputLowerBound", &SymbolicBoundTightener::setInputLowerBound)
-        .def("setInputUpperBound", &SymbolicBoundTightener::setInputUpperBound)
-        .def("setReluBVariable", &SymbolicBoundTightener::setReluBVariable)
-        .def("setReluFVariable", &SymbolicBoundTightener::setReluFVariable);
+    py::class_<SymbolicBoundTightener, std::unique_ptr<SymbolicBoundTightener,py::nodelete>> sbt(m, "SymbolicBoundTightener");
+    sbt.def(py::init());
+    sbt.def("setNumberOfLayers", &SymbolicBoundTightener::setNumberOfLayers);
+    sbt.def("setLayerSize", &SymbolicBoundTightener::setLayerSize);
+    sbt.def("setLayerType", &SymbolicBoundTightener::setLayerType);
+    sbt.def("addLayerDependency", &SymbolicBoundTightener::addLayerDependency);
+    sbt.def("allocateWeightAndBiasSpace", &SymbolicBoundTightener::allocateWeightAndBiasSpace);
+    sbt.def("setBias", &SymbolicBoundTightener::setBias);
+    sbt.def("setWeight", (void (SymbolicBoundTightener::*)(unsigned, unsigned, unsigned, double)) &SymbolicBoundTightener::setWeight);
+    sbt.def("setWeight", (void (SymbolicBoundTightener::*)(unsigned, unsigned, unsigned, unsigned, double)) &SymbolicBoundTightener::setWeight);
+    sbt.def("addMaxSource", &SymbolicBoundTightener::addMaxSource);
+    sbt.def("setInputLowerBound", &SymbolicBoundTightener::setInputLowerBound);
+    sbt.def("setInputUpperBound", &SymbolicBoundTightener::setInputUpperBound);
+    sbt.def("setReluBVariable", &SymbolicBoundTightener::setReluBVariable);
+    sbt.def("setReluFVariable", &SymbolicBoundTightener::setReluFVariable);
+    py::enum_<SymbolicBoundTightener::LayerType>(sbt, "LayerType")
+        .value("INPUT", SymbolicBoundTightener::LayerType::INPUT)
+        .value("WEIGHTED_SUM", SymbolicBoundTightener::LayerType::WEIGHTED_SUM)
+        .value("RELU", SymbolicBoundTightener::LayerType::RELU)
+        .value("ABSOLUTE_VALUE", SymbolicBoundTightener::LayerType::ABSOLUTE_VALUE)
+        .value("MAX", SymbolicBoundTightener::LayerType::MAX)
+        .export_values();
     py::class_<Equation> eq(m, "Equation");
     eq.def(py::init());
     eq.def(py::init<Equation::EquationType>());
@@ -173,7 +173,13 @@ class MarabouNetwork:
         for u in self.upperBounds:
             assert u < self.numVars
             ipq.setUpperBound(u, self.upperBounds[u])
-            
+
+        # Recover the network topology (e.g., convolutions, max pooling and
+        # residual connections) for symbolic bound tightening, unless the
+        # network provides its own tightener
+        if not hasattr(self, "sbt"):
+            ipq.constructSymbolicBoundTightener()
+
         return ipq
 
     def solve(self, filename="", verbose=True, options=None):
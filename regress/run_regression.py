@@ -130,6 +130,7 @@ def main():
     parser.add_argument('property_file', nargs='?', default='')
     parser.add_argument('expected_result', choices=EXPECTED_RESULT_OPTIONS)
     parser.add_argument('--dnc', action='store_true')
+    parser.add_argument('--portfolio', action='store_true')
     parser.add_argument('--timeout', nargs='?', const=DEFAULT_TIMEOUT, type=int)
 
     args = parser.parse_args()
@@ -144,6 +145,8 @@ def main():
     marabou_args = []
     if args.dnc:
         marabou_args += ['--dnc']
+    if args.portfolio:
+        marabou_args += ['--portfolio']
     if args.network_file.endswith('nnet'):
         return run_marabou(binary, network_file, property_file, expected_result, args.timeout, marabou_args)
     elif args.network_file.endswith('mps'):
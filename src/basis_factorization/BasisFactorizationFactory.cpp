@@ -21,31 +21,55 @@
 #include "SparseFTFactorization.h"
 #include "SparseLUFactorization.h"
 
+GlobalConfiguration::BasisFactorizationType BasisFactorizationFactory::_basisFactorizationType =
+    GlobalConfiguration::BASIS_FACTORIZATION_TYPE;
+
 IBasisFactorization *BasisFactorizationFactory::createBasisFactorization( unsigned basisSize, const IBasisFactorization::BasisColumnOracle &basisColumnOracle )
 {
     // LU
-    if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE ==
-         GlobalConfiguration::LU_FACTORIZATION )
+    if ( _basisFactorizationType == GlobalConfiguration::LU_FACTORIZATION )
         return new LUFactorization( basisSize, basisColumnOracle );
 
     // Sparse LU
-    if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE ==
-         GlobalConfiguration::SPARSE_LU_FACTORIZATION )
+    if ( _basisFactorizationType == GlobalConfiguration::SPARSE_LU_FACTORIZATION )
         return new SparseLUFactorization( basisSize, basisColumnOracle );
 
     // FT
-    else if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE ==
-              GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION )
+    else if ( _basisFactorizationType == GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION )
         return new ForrestTomlinFactorization( basisSize, basisColumnOracle );
 
     // Sparse FT
-    else if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE ==
-              GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION )
+    else if ( _basisFactorizationType == GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION )
         return new SparseFTFactorization( basisSize, basisColumnOracle );
 
     throw BasisFactorizationError( BasisFactorizationError::UNKNOWN_BASIS_FACTORIZATION_TYPE );
 }
 
+GlobalConfiguration::BasisFactorizationType BasisFactorizationFactory::getBasisFactorizationType()
+{
+    return _basisFactorizationType;
+}
+
+void BasisFactorizationFactory::setBasisFactorizationType( GlobalConfiguration::BasisFactorizationType type )
+{
+    _basisFactorizationType = type;
+}
+
+void BasisFactorizationFactory::setBasisFactorizationType( const String &name )
+{
+    if ( name == "lu" )
+        _basisFactorizationType = GlobalConfiguration::LU_FACTORIZATION;
+    else if ( name == "sparse-lu" )
+        _basisFactorizationType = GlobalConfiguration::SPARSE_LU_FACTORIZATION;
+    else if ( name == "ft" )
+        _basisFactorizationType = GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION;
+    else if ( name == "sparse-ft" )
+        _basisFactorizationType = GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
+    else
+        throw BasisFactorizationError( BasisFactorizationError::UNKNOWN_BASIS_FACTORIZATION_TYPE,
+                                       name.ascii() );
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
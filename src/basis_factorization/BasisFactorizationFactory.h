@@ -16,12 +16,30 @@
 #ifndef __BasisFactorizationFactory_h__
 #define __BasisFactorizationFactory_h__
 
+#include "GlobalConfiguration.h"
 #include "IBasisFactorization.h"
+#include "MString.h"
 
 class BasisFactorizationFactory
 {
 public:
     static IBasisFactorization *createBasisFactorization( unsigned basisSize, const IBasisFactorization::BasisColumnOracle &basisColumnOracle );
+
+    /*
+      The type of the factorizations being created. It defaults to
+      GlobalConfiguration::BASIS_FACTORIZATION_TYPE, and may be
+      overridden at startup, e.g. for benchmarking. It should not be
+      changed once factorizations have been created, as factorizations
+      of different types cannot be mixed.
+
+      The names of the types are "lu", "sparse-lu", "ft" and "sparse-ft".
+    */
+    static GlobalConfiguration::BasisFactorizationType getBasisFactorizationType();
+    static void setBasisFactorizationType( GlobalConfiguration::BasisFactorizationType type );
+    static void setBasisFactorizationType( const String &name );
+
+private:
+    static GlobalConfiguration::BasisFactorizationType _basisFactorizationType;
 };
 
 #endif // __BasisFactorizationFactory_h__
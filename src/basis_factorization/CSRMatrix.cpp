@@ -28,6 +28,7 @@ CSRMatrix::CSRMatrix()
     , _JA( NULL )
     , _nnz( 0 )
     , _estimatedNnz( 0 )
+    , _rowCapacity( 0 )
 {
 }
 
@@ -39,6 +40,7 @@ CSRMatrix::CSRMatrix( const double *M, unsigned m, unsigned n )
     , _JA( NULL )
     , _nnz( 0 )
     , _estimatedNnz( 0 )
+    , _rowCapacity( 0 )
 {
     initialize( M, m, n );
 }
@@ -90,7 +92,8 @@ void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
     if ( !_A )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::A" );
 
-    _IA = new unsigned[_m + 1];
+    _rowCapacity = _m;
+    _IA = new unsigned[_rowCapacity + 1];
     if ( !_IA )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::IA" );
 
@@ -106,8 +109,10 @@ void CSRMatrix::increaseCapacity()
 {
     ASSERT( _m > 0 && _n > 0 );
 
+    // Grow geometrically, so that adding entries takes amortized constant time
     unsigned estimatedNumRowEntries = std::max( 2U, _n / ROW_DENSITY_ESTIMATE );
-    unsigned newEstimatedNnz = _estimatedNnz + ( estimatedNumRowEntries * _m );
+    unsigned newEstimatedNnz = std::max( 2 * _estimatedNnz,
+                                         _estimatedNnz + ( estimatedNumRowEntries * _m ) );
 
     double *newA = new double[newEstimatedNnz];
     if ( !newA )
@@ -117,8 +122,8 @@ void CSRMatrix::increaseCapacity()
     if ( !newJA )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::newJA" );
 
-    memcpy( newA, _A, _estimatedNnz * sizeof(double) );
-    memcpy( newJA, _JA, _estimatedNnz * sizeof(unsigned) );
+    memcpy( newA, _A, _nnz * sizeof(double) );
+    memcpy( newJA, _JA, _nnz * sizeof(unsigned) );
 
     delete[] _A;
     delete[] _JA;
@@ -138,11 +143,19 @@ double CSRMatrix::get( unsigned row, unsigned column ) const
 
 void CSRMatrix::addLastRow( const double *row )
 {
-    // Array _IA needs to increase by one
-    unsigned *newIA = new unsigned[_m + 2];
-    memcpy( newIA, _IA, sizeof(unsigned) * ( _m + 1 ) );
-    delete[] _IA;
-    _IA = newIA;
+    // Array _IA needs to increase by one. Grow it geometrically, so
+    // that adding rows takes amortized constant time.
+    if ( _m + 1 > _rowCapacity )
+    {
+        _rowCapacity = std::max( 2 * _rowCapacity, _m + 1 );
+        unsigned *newIA = new unsigned[_rowCapacity + 1];
+        if ( !newIA )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::newIA" );
+
+        memcpy( newIA, _IA, sizeof(unsigned) * ( _m + 1 ) );
+        delete[] _IA;
+        _IA = newIA;
+    }
 
     // Add the new row
     _IA[_m + 1] = _IA[_m];
@@ -247,13 +260,15 @@ void CSRMatrix::storeIntoOther( SparseMatrix *other ) const
     otherCsr->_n = _n;
     otherCsr->_nnz = _nnz;
     otherCsr->_estimatedNnz = _estimatedNnz;
+    otherCsr->_rowCapacity = _rowCapacity;
 
+    // Only the occupied entries need to be copied
     otherCsr->_A = new double[_estimatedNnz];
     if ( !otherCsr->_A )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrA" );
-    memcpy( otherCsr->_A, _A, sizeof(double) * _estimatedNnz );
+    memcpy( otherCsr->_A, _A, sizeof(double) * _nnz );
 
-    otherCsr->_IA = new unsigned[_m + 1];
+    otherCsr->_IA = new unsigned[_rowCapacity + 1];
     if ( !otherCsr->_IA )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrIA" );
     memcpy( otherCsr->_IA, _IA, sizeof(unsigned) * ( _m + 1 ) );
@@ -261,7 +276,7 @@ void CSRMatrix::storeIntoOther( SparseMatrix *other ) const
     otherCsr->_JA = new unsigned[_estimatedNnz];
     if ( !otherCsr->_JA )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrJA" );
-    memcpy( otherCsr->_JA, _JA, sizeof(unsigned) * _estimatedNnz );
+    memcpy( otherCsr->_JA, _JA, sizeof(unsigned) * _nnz );
 }
 
 void CSRMatrix::getRow( unsigned row, SparseUnsortedList *result ) const
@@ -517,6 +532,26 @@ void CSRMatrix::addEmptyColumn()
     ++_n;
 }
 
+void CSRMatrix::removeLastRow()
+{
+    ASSERT( _m > 0 );
+
+    // The entries of the last row are stored at the end of _A and _JA
+    _nnz = _IA[_m - 1];
+    --_m;
+}
+
+void CSRMatrix::removeLastColumn()
+{
+    ASSERT( _n > 0 );
+    DEBUG({
+            for ( unsigned i = 0; i < _nnz; ++i )
+                ASSERT( _JA[i] != _n - 1 );
+        });
+
+    --_n;
+}
+
 unsigned CSRMatrix::getNnz() const
 {
     return _nnz;
@@ -76,6 +76,14 @@ public:
      */
     void addEmptyColumn();
 
+    /*
+      Remove the last row/column of the matrix. The last column
+      is assumed to be all zeroes. These operations undo addLastRow()
+      and addEmptyColumn(), respectively.
+    */
+    void removeLastRow();
+    void removeLastColumn();
+
     /*
       A mechanism for storing a set of changes to the matrix,
       and then executing them all at once to reduce overhead
@@ -167,6 +175,12 @@ private:
     */
     unsigned _estimatedNnz;
 
+    /*
+      The number of rows that _IA can accommodate. Since rows are
+      added one at a time, _IA is grown geometrically.
+    */
+    unsigned _rowCapacity;
+
     /*
       If too many elements are stored for the current
       arrays' capacity, increase their size.
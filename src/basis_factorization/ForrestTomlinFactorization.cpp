@@ -497,6 +497,28 @@ void ForrestTomlinFactorization::backwardTransformation( const double *y, double
     }
 }
 
+void ForrestTomlinFactorization::sparseForwardTransformation( const double *y,
+                                                              const unsigned */* yIndices */,
+                                                              unsigned /* yNnz */,
+                                                              double *x,
+                                                              unsigned *xIndices,
+                                                              unsigned &xNnz ) const
+{
+    forwardTransformation( y, x );
+    listNonZeros( x, _m, xIndices, xNnz );
+}
+
+void ForrestTomlinFactorization::sparseBackwardTransformation( const double *y,
+                                                               const unsigned */* yIndices */,
+                                                               unsigned /* yNnz */,
+                                                               double *x,
+                                                               unsigned *xIndices,
+                                                               unsigned &xNnz ) const
+{
+    backwardTransformation( y, x );
+    listNonZeros( x, _m, xIndices, xNnz );
+}
+
 void ForrestTomlinFactorization::storeFactorization( IBasisFactorization *other )
 {
     ForrestTomlinFactorization *otherFTFactorization = (ForrestTomlinFactorization *)other;
@@ -33,7 +33,7 @@
   - The L and U matrices are as in a usual LU factorization
   - Q (and inv(Q)) are permutation matrices
 */
-class ForrestTomlinFactorization : public IBasisFactorization
+class ForrestTomlinFactorization final : public IBasisFactorization
 {
 public:
     ForrestTomlinFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle );
@@ -66,6 +66,22 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Sparse right hand sides are solved densely.
+    */
+    void sparseForwardTransformation( const double *y,
+                                      const unsigned *yIndices,
+                                      unsigned yNnz,
+                                      double *x,
+                                      unsigned *xIndices,
+                                      unsigned &xNnz ) const;
+    void sparseBackwardTransformation( const double *y,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz,
+                                       double *x,
+                                       unsigned *xIndices,
+                                       unsigned &xNnz ) const;
+
     /*
       Store/restore the basis factorization.
     */
@@ -73,12 +73,46 @@ public:
     */
     virtual void backwardTransformation( const double *y, double *x ) const = 0;
 
+    /*
+      Variants of the transformations for sparse right hand sides. y is
+      dense, and must be zero outside of the yNnz indices listed in
+      yIndices. On exit, x is dense, and the indices of its non-zero
+      entries are listed in xIndices (which needs room for m entries).
+      xIndices may also list a few entries that cancelled out to zero.
+    */
+    virtual void sparseForwardTransformation( const double *y,
+                                              const unsigned *yIndices,
+                                              unsigned yNnz,
+                                              double *x,
+                                              unsigned *xIndices,
+                                              unsigned &xNnz ) const = 0;
+    virtual void sparseBackwardTransformation( const double *y,
+                                               const unsigned *yIndices,
+                                               unsigned yNnz,
+                                               double *x,
+                                               unsigned *xIndices,
+                                               unsigned &xNnz ) const = 0;
+
     /*
       Store/restore the basis factorization.
     */
     virtual void storeFactorization( IBasisFactorization *other ) = 0;
     virtual void restoreFactorization( const IBasisFactorization *other ) = 0;
 
+    /*
+      Initialize this factorization from the factorization of a basis
+      with one less row. The new basis has the old basis in its top
+      left corner, and a last column that is all zeros except for its
+      diagonal entry; lastRow is the last row of the new basis.
+      Returns false if this is not supported, in which case a fresh
+      basis should be obtained instead.
+    */
+    virtual bool extendFactorization( const IBasisFactorization */* other */,
+                                      const double */* lastRow */ )
+    {
+        return false;
+    }
+
 	/*
       Ask the basis factorization to obtain a fresh basis
       (through the previously-provided oracle).
@@ -118,6 +152,22 @@ public:
 
 protected:
     const BasisColumnOracle *_basisColumnOracle;
+
+    /*
+      List the indices of the non-zero entries of a dense vector
+    */
+    static void listNonZeros( const double *x, unsigned m, unsigned *xIndices, unsigned &xNnz )
+    {
+        xNnz = 0;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            if ( x[i] != 0.0 )
+            {
+                xIndices[xNnz] = i;
+                ++xNnz;
+            }
+        }
+    }
 };
 
 #endif // __IBasisFactorization_h__
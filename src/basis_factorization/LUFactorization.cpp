@@ -159,6 +159,28 @@ void LUFactorization::backwardTransformation( const double *y, double *x ) const
     _luFactors.backwardTransformation( _z, x );
 }
 
+void LUFactorization::sparseForwardTransformation( const double *y,
+                                                   const unsigned */* yIndices */,
+                                                   unsigned /* yNnz */,
+                                                   double *x,
+                                                   unsigned *xIndices,
+                                                   unsigned &xNnz ) const
+{
+    forwardTransformation( y, x );
+    listNonZeros( x, _m, xIndices, xNnz );
+}
+
+void LUFactorization::sparseBackwardTransformation( const double *y,
+                                                    const unsigned */* yIndices */,
+                                                    unsigned /* yNnz */,
+                                                    double *x,
+                                                    unsigned *xIndices,
+                                                    unsigned &xNnz ) const
+{
+    backwardTransformation( y, x );
+    listNonZeros( x, _m, xIndices, xNnz );
+}
+
 void LUFactorization::clearFactorization()
 {
 	List<EtaMatrix *>::iterator it;
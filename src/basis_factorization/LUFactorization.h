@@ -25,7 +25,7 @@
 class EtaMatrix;
 class LPElement;
 
-class LUFactorization : public IBasisFactorization
+class LUFactorization final : public IBasisFactorization
 {
 public:
     LUFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle );
@@ -89,6 +89,22 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Sparse right hand sides are solved densely.
+    */
+    void sparseForwardTransformation( const double *y,
+                                      const unsigned *yIndices,
+                                      unsigned yNnz,
+                                      double *x,
+                                      unsigned *xIndices,
+                                      unsigned &xNnz ) const;
+    void sparseBackwardTransformation( const double *y,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz,
+                                       double *x,
+                                       unsigned *xIndices,
+                                       unsigned &xNnz ) const;
+
     /*
       Store and restore the basis factorization. Storing triggers
       condesning the etas.
@@ -25,12 +25,20 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     , _B( m )
 	, _m( m )
     , _sparseLUFactors( m )
+    , _factorized( false )
     , _sparseGaussianEliminator( m )
     , _statistics( NULL )
+    , _refactorizationCost( 0 )
+    , _freshFactorsNnz( 0 )
+    , _factorsNnz( 0 )
+    , _accumulatedUpdateCost( 0 )
     , _z1( NULL )
     , _z2( NULL )
     , _z3( NULL )
     , _z4( NULL )
+    , _sparseZ( NULL )
+    , _sparseZIndices( NULL )
+    , _sparseZMarks( NULL )
 {
     _z1 = new double[m];
     if ( !_z1 )
@@ -47,6 +55,20 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     _z4 = new double[m];
     if ( !_z4 )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::z4" );
+
+    _sparseZ = new double[m];
+    if ( !_sparseZ )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::sparseZ" );
+    std::fill_n( _sparseZ, m, 0.0 );
+
+    _sparseZIndices = new unsigned[m];
+    if ( !_sparseZIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::sparseZIndices" );
+
+    _sparseZMarks = new bool[m];
+    if ( !_sparseZMarks )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::sparseZMarks" );
+    std::fill_n( _sparseZMarks, m, false );
 }
 
 SparseFTFactorization::~SparseFTFactorization()
@@ -81,6 +103,24 @@ void SparseFTFactorization::freeIfNeeded()
         delete[] _z4;
         _z4 = NULL;
     }
+
+    if ( _sparseZ )
+    {
+        delete[] _sparseZ;
+        _sparseZ = NULL;
+    }
+
+    if ( _sparseZIndices )
+    {
+        delete[] _sparseZIndices;
+        _sparseZIndices = NULL;
+    }
+
+    if ( _sparseZMarks )
+    {
+        delete[] _sparseZMarks;
+        _sparseZMarks = NULL;
+    }
 }
 
 const double *SparseFTFactorization::getBasis() const
@@ -104,7 +144,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     // p = vRowDiagonalIndex
     // t = lastNonZeroEntryInU
 
-    if ( _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+    if ( refactorizationDue() )
     {
         obtainFreshBasis();
         return;
@@ -139,6 +179,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     unsigned lastNonZeroEntryInU = 0;
     DEBUG( bool foundNonZeroEntry = false );
 
+    _factorsNnz -= _sparseLUFactors._Vt->getRow( columnIndex )->getNnz();
     _sparseLUFactors._Vt->clear( columnIndex );
     for ( unsigned i = 0; i < _m; ++i )
     {
@@ -156,6 +197,8 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
         _sparseLUFactors._V->set( i, columnIndex, _z4[i] );
     }
 
+    _factorsNnz += _sparseLUFactors._Vt->getRow( columnIndex )->getNnz();
+
     double pivotElement = _z4[vRowDiagonalIndex];
 
     /*
@@ -170,6 +213,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     {
         _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = pivotElement;
         ASSERT( uColumnIndex == lastNonZeroEntryInU ); // Otherwise, singular matrix
+        recordUpdateCost();
         return;
     }
 
@@ -223,6 +267,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     if ( !haveSpike )
     {
         _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = pivotElement;
+        recordUpdateCost();
         return;
     }
 
@@ -294,17 +339,21 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
       step we performed in the eta file
     */
     _etas.append( sparseEtaMatrix );
+    _factorsNnz += sparseEtaMatrix->_sparseColumn.size();
 
     /*
       Step 6:
 
       Finally, copy the (eliminated) spike row back into V and Vt
     */
+    _factorsNnz -= _sparseLUFactors._V->getRow( vRowDiagonalIndex )->getNnz();
     _sparseLUFactors._V->updateSingleRow( vRowDiagonalIndex, _z3 );
     for ( unsigned i = 0; i < _m; ++i )
         _sparseLUFactors._Vt->set( i, vRowDiagonalIndex, _z3[i] );
+    _factorsNnz += _sparseLUFactors._V->getRow( vRowDiagonalIndex )->getNnz();
 
     _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = _z3[columnIndex];
+    recordUpdateCost();
 }
 
 void SparseFTFactorization::forwardTransformation( const double *y, double *x ) const
@@ -343,6 +392,64 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
     _sparseLUFactors.fBackwardTransformation( _z2, x );
 }
 
+void SparseFTFactorization::sparseForwardTransformation( const double *y,
+                                                         const unsigned *yIndices,
+                                                         unsigned yNnz,
+                                                         double *x,
+                                                         unsigned *xIndices,
+                                                         unsigned &xNnz ) const
+{
+    if ( yNnz > GlobalConfiguration::HYPER_SPARSE_DENSITY_THRESHOLD * _m )
+    {
+        forwardTransformation( y, x );
+        listNonZeros( x, _m, xIndices, xNnz );
+        return;
+    }
+
+    unsigned zNnz;
+
+    // Eliminate F
+    _sparseLUFactors.fForwardTransformation( y, yIndices, yNnz, _sparseZ, _sparseZIndices, zNnz );
+
+    // Eliminate H
+    hSparseForwardTransformation( zNnz );
+
+    // Eliminate V
+    std::fill_n( x, _m, 0.0 );
+    _sparseLUFactors.vForwardTransformation( _sparseZ, _sparseZIndices, zNnz, x, xIndices, xNnz );
+
+    clearSparseZ( zNnz );
+}
+
+void SparseFTFactorization::sparseBackwardTransformation( const double *y,
+                                                          const unsigned *yIndices,
+                                                          unsigned yNnz,
+                                                          double *x,
+                                                          unsigned *xIndices,
+                                                          unsigned &xNnz ) const
+{
+    if ( yNnz > GlobalConfiguration::HYPER_SPARSE_DENSITY_THRESHOLD * _m )
+    {
+        backwardTransformation( y, x );
+        listNonZeros( x, _m, xIndices, xNnz );
+        return;
+    }
+
+    unsigned zNnz;
+
+    // Eliminate V
+    _sparseLUFactors.vBackwardTransformation( y, yIndices, yNnz, _sparseZ, _sparseZIndices, zNnz );
+
+    // Eliminate H
+    hSparseBackwardTransformation( zNnz );
+
+    // Eliminate F
+    std::fill_n( x, _m, 0.0 );
+    _sparseLUFactors.fBackwardTransformation( _sparseZ, _sparseZIndices, zNnz, x, xIndices, xNnz );
+
+    clearSparseZ( zNnz );
+}
+
 void SparseFTFactorization::clearFactorization()
 {
     List<SparseEtaMatrix *>::iterator it;
@@ -355,6 +462,7 @@ void SparseFTFactorization::clearFactorization()
 void SparseFTFactorization::factorizeBasis()
 {
     clearFactorization();
+    _factorized = false;
 
     try
     {
@@ -368,10 +476,47 @@ void SparseFTFactorization::factorizeBasis()
             throw e;
     }
 
+    _factorized = true;
+
+    _refactorizationCost = _sparseGaussianEliminator.getNumOperations();
+    for ( unsigned i = 0; i < _m; ++i )
+        _refactorizationCost += _B._columns[i]->getNnz();
+
+    _freshFactorsNnz = countFactorsNnz();
+    _factorsNnz = _freshFactorsNnz;
+    _accumulatedUpdateCost = 0;
+
     if ( _statistics )
         _statistics->incNumBasisRefactorizations();
 }
 
+unsigned long long SparseFTFactorization::countFactorsNnz() const
+{
+    unsigned long long result = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        result += _sparseLUFactors._F->getRow( i )->getNnz();
+        result += _sparseLUFactors._V->getRow( i )->getNnz();
+    }
+
+    for ( const auto &eta : _etas )
+        result += eta->_sparseColumn.size();
+
+    return result;
+}
+
+bool SparseFTFactorization::refactorizationDue() const
+{
+    return _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD ||
+        _accumulatedUpdateCost > _refactorizationCost;
+}
+
+void SparseFTFactorization::recordUpdateCost()
+{
+    if ( _factorsNnz > _freshFactorsNnz )
+        _accumulatedUpdateCost += _factorsNnz - _freshFactorsNnz;
+}
+
 void SparseFTFactorization::storeFactorization( IBasisFactorization *other )
 {
     SparseFTFactorization *otherSparseFTFactorization = (SparseFTFactorization *)other;
@@ -382,6 +527,11 @@ void SparseFTFactorization::storeFactorization( IBasisFactorization *other )
 
     // Store the new basis and factorization
     _sparseLUFactors.storeToOther( &otherSparseFTFactorization->_sparseLUFactors );
+
+    otherSparseFTFactorization->_refactorizationCost = _refactorizationCost;
+    otherSparseFTFactorization->_freshFactorsNnz = _freshFactorsNnz;
+    otherSparseFTFactorization->_factorsNnz = _factorsNnz;
+    otherSparseFTFactorization->_accumulatedUpdateCost = 0;
 }
 
 void SparseFTFactorization::restoreFactorization( const IBasisFactorization *other )
@@ -396,6 +546,65 @@ void SparseFTFactorization::restoreFactorization( const IBasisFactorization *oth
 
     // Store the new basis and factorization
     otherSparseFTFactorization->_sparseLUFactors.storeToOther( &_sparseLUFactors );
+    _factorized = true;
+
+    _refactorizationCost = otherSparseFTFactorization->_refactorizationCost;
+    _freshFactorsNnz = otherSparseFTFactorization->_freshFactorsNnz;
+    _factorsNnz = otherSparseFTFactorization->_factorsNnz;
+    _accumulatedUpdateCost = 0;
+}
+
+bool SparseFTFactorization::extendFactorization( const IBasisFactorization *other, const double *lastRow )
+{
+    const SparseFTFactorization *otherSparseFTFactorization = (const SparseFTFactorization *)other;
+
+    ASSERT( _m == otherSparseFTFactorization->_m + 1 );
+
+    double d = lastRow[_m - 1];
+    if ( !otherSparseFTFactorization->_factorized || FloatUtils::isZero( d ) )
+        return false;
+
+    clearFactorization();
+
+    /*
+      The new basis is bordered by a row r and a column d * e_m:
+
+          | B  0 |   | F  0 |   | H  0 |   | V  0 |
+          | r  d | = | g  1 | * | 0  1 | * | 0  d |
+
+      So F only gains a row g, such that g * H * V = r. This is
+      obtained by eliminating V and H from r, as in a BTRAN. The etas
+      only involve the old indices, and are kept as they are.
+    */
+    otherSparseFTFactorization->_sparseLUFactors.vBackwardTransformation( lastRow, _z1 );
+    otherSparseFTFactorization->hBackwardTransformation( _z1, _z2 );
+
+    otherSparseFTFactorization->_sparseLUFactors.extendIntoOther( &_sparseLUFactors, _z2, d );
+
+    for ( const auto &eta : otherSparseFTFactorization->_etas )
+    {
+        SparseEtaMatrix *copy = new SparseEtaMatrix( *eta );
+        if ( !copy )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                           "SparseFTFactorization::extendFactorization" );
+        copy->_m = _m;
+        _etas.append( copy );
+    }
+
+    _factorized = true;
+
+    // The extension adds a row to F, which is not attributed to the updates
+    _refactorizationCost = otherSparseFTFactorization->_refactorizationCost;
+    _factorsNnz = countFactorsNnz();
+    _freshFactorsNnz = otherSparseFTFactorization->_freshFactorsNnz;
+    if ( _factorsNnz > otherSparseFTFactorization->_factorsNnz )
+        _freshFactorsNnz += _factorsNnz - otherSparseFTFactorization->_factorsNnz;
+    _accumulatedUpdateCost = otherSparseFTFactorization->_accumulatedUpdateCost;
+
+    if ( _statistics )
+        _statistics->incNumBasisExtensions();
+
+    return true;
 }
 
 void SparseFTFactorization::invertBasis( double *result )
@@ -485,6 +694,67 @@ void SparseFTFactorization::hBackwardTransformation( const double *y, double *x
     }
 }
 
+void SparseFTFactorization::hSparseForwardTransformation( unsigned &zNnz ) const
+{
+    for ( unsigned i = 0; i < zNnz; ++i )
+        _sparseZMarks[_sparseZIndices[i]] = true;
+
+    for ( const auto &eta : _etas )
+    {
+        unsigned pivotIndex = eta->_columnIndex;
+
+        double delta = 0.0;
+        for ( const auto &entry : eta->_sparseColumn )
+            delta += entry._value * _sparseZ[entry._index];
+
+        if ( delta == 0.0 )
+            continue;
+
+        _sparseZ[pivotIndex] -= delta;
+        if ( !_sparseZMarks[pivotIndex] )
+        {
+            _sparseZMarks[pivotIndex] = true;
+            _sparseZIndices[zNnz] = pivotIndex;
+            ++zNnz;
+        }
+    }
+}
+
+void SparseFTFactorization::hSparseBackwardTransformation( unsigned &zNnz ) const
+{
+    for ( unsigned i = 0; i < zNnz; ++i )
+        _sparseZMarks[_sparseZIndices[i]] = true;
+
+    for ( auto eta = _etas.rbegin(); eta != _etas.rend(); ++eta )
+    {
+        double pivotValue = _sparseZ[(*eta)->_columnIndex];
+        if ( pivotValue == 0.0 )
+            continue;
+
+        for ( const auto &entry : (*eta)->_sparseColumn )
+        {
+            unsigned entryIndex = entry._index;
+            _sparseZ[entryIndex] -= entry._value * pivotValue;
+
+            if ( !_sparseZMarks[entryIndex] )
+            {
+                _sparseZMarks[entryIndex] = true;
+                _sparseZIndices[zNnz] = entryIndex;
+                ++zNnz;
+            }
+        }
+    }
+}
+
+void SparseFTFactorization::clearSparseZ( unsigned zNnz ) const
+{
+    for ( unsigned i = 0; i < zNnz; ++i )
+    {
+        _sparseZ[_sparseZIndices[i]] = 0.0;
+        _sparseZMarks[_sparseZIndices[i]] = false;
+    }
+}
+
 void SparseFTFactorization::fixPForL()
 {
     if ( !_sparseLUFactors._usePForF )
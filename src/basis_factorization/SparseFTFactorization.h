@@ -36,7 +36,7 @@
   with an extra matrix H that replaces the eta matrices. This factorization
   makes use of the previous LU factorization, but makes the necessary changes.
 */
-class SparseFTFactorization : public IBasisFactorization
+class SparseFTFactorization final : public IBasisFactorization
 {
 public:
     SparseFTFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle );
@@ -69,12 +69,37 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hyper-sparse variants of the transformations. Each of F, H and V
+      is only applied to the entries that can become non-zero, so the
+      cost is proportional to the fill rather than to m. Right hand
+      sides that are not sparse enough are solved densely.
+    */
+    void sparseForwardTransformation( const double *y,
+                                      const unsigned *yIndices,
+                                      unsigned yNnz,
+                                      double *x,
+                                      unsigned *xIndices,
+                                      unsigned &xNnz ) const;
+    void sparseBackwardTransformation( const double *y,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz,
+                                       double *x,
+                                       unsigned *xIndices,
+                                       unsigned &xNnz ) const;
+
     /*
       Store and restore the basis factorization.
     */
     void storeFactorization( IBasisFactorization *other );
     void restoreFactorization( const IBasisFactorization *other );
 
+    /*
+      Extend the factorization of a basis with one less row. This
+      borders the LU factors without refactorizing, and keeps the etas.
+    */
+    bool extendFactorization( const IBasisFactorization *other, const double *lastRow );
+
 	/*
       Ask the basis factorization to obtain a fresh basis
       (through the previously-provided oracle).
@@ -97,6 +122,11 @@ public:
     const double *getBasis() const;
     const SparseMatrix *getSparseBasis() const;
 
+    /*
+      Have the Basis Factoriaztion object start reporting statistics.
+    */
+    void setStatistics( Statistics *statistics );
+
     /*
       Debug
     */
@@ -124,6 +154,11 @@ private:
     */
     SparseLUFactors _sparseLUFactors;
 
+    /*
+      Whether the LU factors currently represent the basis.
+    */
+    bool _factorized;
+
     /*
       The Gaussian eliminator, to compute basis factorizations
     */
@@ -134,6 +169,21 @@ private:
     */
     Statistics *_statistics;
 
+    /*
+      The adaptive refactorization policy. Every update makes the
+      subsequent FTRAN and BTRAN calls more expensive, by the number of
+      non-zeros it adds to the factors: a new eta, and fill-in in V.
+      Once the extra work accumulated since the last refactorization
+      exceeds the cost of that refactorization, it is cheaper to
+      refactorize. The cost of a refactorization is measured as the
+      number of operations performed by the eliminator, plus the size
+      of the basis that is extracted for it.
+    */
+    unsigned long long _refactorizationCost;
+    unsigned long long _freshFactorsNnz;
+    unsigned long long _factorsNnz;
+    unsigned long long _accumulatedUpdateCost;
+
     /*
       Work memory.
     */
@@ -142,12 +192,34 @@ private:
     double *_z3;
     double *_z4;
 
+    /*
+      Work memory for the hyper-sparse transformations: a vector that
+      is all zeros between calls, the indices of its non-zero entries,
+      and flags marking these indices.
+    */
+    double *_sparseZ;
+    unsigned *_sparseZIndices;
+    bool *_sparseZMarks;
+
     /*
       Transformations on the H matrix (the list of etas)
     */
     void hForwardTransformation( const double *y, double *x ) const;
     void hBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hyper-sparse transformations on the H matrix, performed in place
+      on _sparseZ. Entries that become non-zero are added to its list
+      of indices.
+    */
+    void hSparseForwardTransformation( unsigned &zNnz ) const;
+    void hSparseBackwardTransformation( unsigned &zNnz ) const;
+
+    /*
+      Reset _sparseZ and its marks to all zeros
+    */
+    void clearSparseZ( unsigned zNnz ) const;
+
     /*
       Free any allocated memory.
     */
@@ -175,9 +247,13 @@ private:
 	void clearFactorization();
 
     /*
-      Have the Basis Factoriaztion object start reporting statistics.
+      Helpers for the adaptive refactorization policy: count the
+      non-zeros in F, V and the etas; decide whether a refactorization
+      is due; and account for the cost of the update just performed.
     */
-    void setStatistics( Statistics *statistics );
+    unsigned long long countFactorsNnz() const;
+    bool refactorizationDue() const;
+    void recordUpdateCost();
 
     static void log( const String &message );
 };
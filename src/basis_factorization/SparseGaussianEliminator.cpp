@@ -26,21 +26,51 @@
 
 SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
     : _m( m )
+    , _pivotRowColumns( NULL )
+    , _pivotRowValues( NULL )
+    , _pivotRowNnz( 0 )
     , _work( NULL )
-    , _work2( NULL )
+    , _newRowColumns( NULL )
+    , _newRowValues( NULL )
     , _statistics( NULL )
     , _numURowElements( NULL )
     , _numUColumnElements( NULL )
+    , _rowBucketHead( NULL )
+    , _rowBucketNext( NULL )
+    , _rowBucketPrev( NULL )
+    , _rowBucket( NULL )
+    , _columnBucketHead( NULL )
+    , _columnBucketNext( NULL )
+    , _columnBucketPrev( NULL )
+    , _columnBucket( NULL )
+    , _numSingletonPivots( 0 )
+    , _numMarkowitzPivots( 0 )
+    , _numOperations( 0 )
 {
+    _pivotRowColumns = new unsigned[_m];
+    if ( !_pivotRowColumns )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::pivotRowColumns" );
+
+    _pivotRowValues = new double[_m];
+    if ( !_pivotRowValues )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::pivotRowValues" );
+
     _work = new double[_m];
     if ( !_work )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseGaussianEliminator::work" );
 
-    _work2 = new double[_m];
-    if ( !_work2 )
+    _newRowColumns = new unsigned[_m];
+    if ( !_newRowColumns )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
-                                       "SparseGaussianEliminator::work2" );
+                                       "SparseGaussianEliminator::newRowColumns" );
+
+    _newRowValues = new double[_m];
+    if ( !_newRowValues )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::newRowValues" );
 
     _numURowElements = new unsigned[_m];
     if ( !_numURowElements )
@@ -51,20 +81,78 @@ SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
     if ( !_numUColumnElements )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseGaussianEliminator::numUColumnElements" );
+
+    _rowBucketHead = new unsigned[_m + 1];
+    if ( !_rowBucketHead )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowBucketHead" );
+
+    _rowBucketNext = new unsigned[_m];
+    if ( !_rowBucketNext )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowBucketNext" );
+
+    _rowBucketPrev = new unsigned[_m];
+    if ( !_rowBucketPrev )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowBucketPrev" );
+
+    _rowBucket = new unsigned[_m];
+    if ( !_rowBucket )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowBucket" );
+
+    _columnBucketHead = new unsigned[_m + 1];
+    if ( !_columnBucketHead )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnBucketHead" );
+
+    _columnBucketNext = new unsigned[_m];
+    if ( !_columnBucketNext )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnBucketNext" );
+
+    _columnBucketPrev = new unsigned[_m];
+    if ( !_columnBucketPrev )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnBucketPrev" );
+
+    _columnBucket = new unsigned[_m];
+    if ( !_columnBucket )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnBucket" );
 }
 
 SparseGaussianEliminator::~SparseGaussianEliminator()
 {
+    if ( _pivotRowColumns )
+    {
+        delete[] _pivotRowColumns;
+        _pivotRowColumns = NULL;
+    }
+
+    if ( _pivotRowValues )
+    {
+        delete[] _pivotRowValues;
+        _pivotRowValues = NULL;
+    }
+
     if ( _work )
     {
         delete[] _work;
         _work = NULL;
     }
 
-    if ( _work2 )
+    if ( _newRowColumns )
     {
-        delete[] _work2;
-        _work2 = NULL;
+        delete[] _newRowColumns;
+        _newRowColumns = NULL;
+    }
+
+    if ( _newRowValues )
+    {
+        delete[] _newRowValues;
+        _newRowValues = NULL;
     }
 
     if ( _numURowElements )
@@ -78,6 +166,54 @@ SparseGaussianEliminator::~SparseGaussianEliminator()
         delete[] _numUColumnElements;
         _numUColumnElements = NULL;
     }
+
+    if ( _rowBucketHead )
+    {
+        delete[] _rowBucketHead;
+        _rowBucketHead = NULL;
+    }
+
+    if ( _rowBucketNext )
+    {
+        delete[] _rowBucketNext;
+        _rowBucketNext = NULL;
+    }
+
+    if ( _rowBucketPrev )
+    {
+        delete[] _rowBucketPrev;
+        _rowBucketPrev = NULL;
+    }
+
+    if ( _rowBucket )
+    {
+        delete[] _rowBucket;
+        _rowBucket = NULL;
+    }
+
+    if ( _columnBucketHead )
+    {
+        delete[] _columnBucketHead;
+        _columnBucketHead = NULL;
+    }
+
+    if ( _columnBucketNext )
+    {
+        delete[] _columnBucketNext;
+        _columnBucketNext = NULL;
+    }
+
+    if ( _columnBucketPrev )
+    {
+        delete[] _columnBucketPrev;
+        _columnBucketPrev = NULL;
+    }
+
+    if ( _columnBucket )
+    {
+        delete[] _columnBucket;
+        _columnBucket = NULL;
+    }
 }
 
 void SparseGaussianEliminator::initializeFactorization( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors )
@@ -109,6 +245,13 @@ void SparseGaussianEliminator::initializeFactorization( const SparseColumnsOfBas
 
     // Use same matrix P for L and V
     _sparseLUFactors->_usePForF = false;
+
+    initializeBuckets();
+
+    std::fill_n( _work, _m, 0.0 );
+    _numSingletonPivots = 0;
+    _numMarkowitzPivots = 0;
+    _numOperations = 0;
 }
 
 void SparseGaussianEliminator::permute()
@@ -141,6 +284,9 @@ void SparseGaussianEliminator::run( const SparseColumnsOfBasis *A, SparseLUFacto
     // Do the work
     factorize();
 
+    if ( _statistics )
+        reportFillIn( A );
+
     // DEBUG({
     //         // Check that the factorization is correct
     //         double *product = new double[_m * _m];
@@ -202,178 +348,385 @@ void SparseGaussianEliminator::factorize()
         */
         eliminate();
     }
+
+    log( Stringf( "Factorization done: %u singleton pivots, %u Markowitz pivots",
+                  _numSingletonPivots,
+                  _numMarkowitzPivots ) );
 }
 
 void SparseGaussianEliminator::choosePivot()
 {
     log( "Choose pivot invoked" );
 
+    // An empty row or column means that the matrix is singular
+    if ( _rowBucketHead[0] != _m || _columnBucketHead[0] != _m )
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Have a zero row or column" );
+
+    // If there's a singleton row, use it as the pivot row
+    if ( _rowBucketHead[1] != _m )
+    {
+        chooseSingletonRowPivot();
+        ++_numSingletonPivots;
+        return;
+    }
+
+    // If there's a singleton column, use it as the pivot column
+    if ( _columnBucketHead[1] != _m )
+    {
+        chooseSingletonColumnPivot();
+        ++_numSingletonPivots;
+        return;
+    }
+
+    chooseMarkowitzPivot();
+    ++_numMarkowitzPivots;
+}
+
+void SparseGaussianEliminator::chooseSingletonRowPivot()
+{
+    _vPivotRow = _rowBucketHead[1];
+    _uPivotRow = _sparseLUFactors->_P._rowOrdering[_vPivotRow];
+
+    // Get the singleton element
+    const SparseUnsortedArray *sparseRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+
+    ASSERT( sparseRow->getNnz() == 1U );
+
+    const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+
+    _vPivotColumn = entry->_index;
+    _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
+    _pivotElement = entry->_value;
+
+    log( Stringf( "Choose pivot selected a pivot (singleton row): V[%u,%u] = %lf",
+                  _vPivotRow,
+                  _vPivotColumn,
+                  _pivotElement ) );
+}
+
+void SparseGaussianEliminator::chooseSingletonColumnPivot()
+{
+    _vPivotColumn = _columnBucketHead[1];
+    _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
+
+    // Get the singleton element
+    const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( _vPivotColumn );
+    const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+    unsigned nnz = sparseColumn->getNnz();
+
+    // There may be some elements in higher rows - we need just the one
+    // in the active submatrix.
+
+    DEBUG( bool found = false; );
+
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        unsigned vRow = entry[i]._index;
+        unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+
+        if ( uRow >= _eliminationStep )
+        {
+            DEBUG( found = true; );
+
+            _vPivotRow = vRow;
+            _uPivotRow = uRow;
+            _pivotElement = entry[i]._value;
+
+            break;
+        }
+    }
+
+    ASSERT( found );
+
+    log( Stringf( "Choose pivot selected a pivot (singleton column): V[%u,%u] = %lf",
+                  _vPivotRow,
+                  _vPivotColumn,
+                  _pivotElement ) );
+}
+
+void SparseGaussianEliminator::chooseMarkowitzPivot()
+{
     /*
       Apply the Markowitz rule: in the active sub-matrix,
       let p_i denote the number of non-zero elements in the i'th
       equation, and let q_j denote the number of non-zero elements
       in the q'th column.
 
-      We pick a pivot a_ij \neq 0 that minimizes (p_i - 1)(q_i - 1).
-    */
+      We pick a pivot a_ij \neq 0 that minimizes (p_i - 1)(q_i - 1),
+      among the elements whose magnitude is at least a fraction of
+      the largest element in their column (threshold partial pivoting).
 
-    const SparseUnsortedArray *sparseRow;
-    const SparseUnsortedArray *sparseColumn;
-    const SparseUnsortedArray::Entry *entry;
-    unsigned nnz;
+      Columns and rows are scanned in order of increasing count. Once
+      all columns and rows with count k have been scanned, any other
+      element has a cost of at least k^2, so the search can stop if
+      the best pivot is at least as cheap. The search also stops after
+      a fixed number of columns and rows have been scanned, provided
+      that some pivot has been found.
+    */
+    unsigned minimalCost = _m * _m;
+    double absPivotElement = 0.0;
+    bool found = false;
+    unsigned numScanned = 0;
 
-    // If there's a singleton row, use it as the pivot row
-    for ( unsigned i = _eliminationStep; i < _m; ++i )
+    for ( unsigned count = 2; count <= _m; ++count )
     {
-        if ( _numURowElements[i] == 1 )
+        for ( unsigned vColumn = _columnBucketHead[count];
+              vColumn != _m;
+              vColumn = _columnBucketNext[vColumn] )
         {
-            _uPivotRow = i;
-            _vPivotRow = _sparseLUFactors->_P._columnOrdering[i];
-
-            // Get the singleton element
-            sparseRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+            considerColumn( vColumn, minimalCost, absPivotElement, found );
+            ++numScanned;
 
-            ASSERT( sparseRow->getNnz() == 1U );
+            if ( found && numScanned >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT )
+                break;
+        }
 
-            entry = sparseRow->getArray();
+        if ( found && ( numScanned >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT ||
+                        minimalCost <= ( count - 1 ) * count ) )
+            break;
 
-            _vPivotColumn = entry->_index;
-            _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
-            _pivotElement = entry->_value;
+        for ( unsigned vRow = _rowBucketHead[count];
+              vRow != _m;
+              vRow = _rowBucketNext[vRow] )
+        {
+            considerRow( vRow, minimalCost, absPivotElement, found );
+            ++numScanned;
 
-            log( Stringf( "Choose pivot selected a pivot (singleton row): V[%u,%u] = %lf",
-                          _vPivotRow,
-                          _vPivotColumn,
-                          _pivotElement ) );
-            return;
+            if ( found && numScanned >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT )
+                break;
         }
+
+        if ( found && ( numScanned >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT ||
+                        minimalCost <= count * count ) )
+            break;
     }
 
-    // If there's a singleton column, use it as the pivot column
-    for ( unsigned i = _eliminationStep; i < _m; ++i )
+    if ( !found )
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Couldn't find a pivot" );
+
+    log( Stringf( "Choose pivot selected a pivot: V[%u,%u] = %lf (cost %u)", _vPivotRow, _vPivotColumn, _pivotElement, minimalCost ) );
+}
+
+double SparseGaussianEliminator::maxInActiveColumn( unsigned vColumn ) const
+{
+    const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+    const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+    unsigned nnz = sparseColumn->getNnz();
+
+    double maxInColumn = 0;
+    for ( unsigned i = 0; i < nnz; ++i )
     {
-        if ( _numUColumnElements[i] == 1 )
-        {
-            _uPivotColumn = i;
-            _vPivotColumn = _sparseLUFactors->_Q._rowOrdering[i];
+        // Ignore entries that are not in the active submatrix
+        unsigned uRow = _sparseLUFactors->_P._rowOrdering[entry[i]._index];
+        if ( uRow < _eliminationStep )
+            continue;
 
-            // Get the singleton element
-            sparseColumn = _sparseLUFactors->_Vt->getRow( _vPivotColumn );
-            entry = sparseColumn->getArray();
-            nnz = sparseColumn->getNnz();
+        double contender = FloatUtils::abs( entry[i]._value );
+        if ( FloatUtils::gt( contender, maxInColumn ) )
+            maxInColumn = contender;
+    }
 
-            // There may be some elements in higher rows - we need just the one
-            // in the active submatrix.
+    return maxInColumn;
+}
 
-            DEBUG( bool found = false; );
+void SparseGaussianEliminator::considerColumn( unsigned vColumn,
+                                               unsigned &minimalCost,
+                                               double &absPivotElement,
+                                               bool &found )
+{
+    double maxInColumn = maxInActiveColumn( vColumn );
+    if ( FloatUtils::isZero( maxInColumn ) )
+    {
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Have a zero column" );
+    }
 
-            for ( unsigned i = 0; i < nnz; ++i )
-            {
-                unsigned vRow = entry[i]._index;
-                unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+    unsigned uColumn = _sparseLUFactors->_Q._columnOrdering[vColumn];
+    const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+    const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+    unsigned nnz = sparseColumn->getNnz();
+    _numOperations += 2 * nnz;
 
-                if ( uRow >= _eliminationStep )
-                {
-                    DEBUG( found = true; );
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        unsigned vRow = entry[i]._index;
+        unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
 
-                    _vPivotRow = vRow;
-                    _uPivotRow = uRow;
-                    _pivotElement = entry[i]._value;
+        // Ignore entries that are not in the active submatrix
+        if ( uRow < _eliminationStep )
+            continue;
 
-                    break;
-                }
-            }
+        double contender = entry[i]._value;
+        double absContender = FloatUtils::abs( contender );
 
-            ASSERT( found );
+        // Only consider large-enough elements
+        if ( !FloatUtils::gt( absContender,
+                              maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
+            continue;
 
-            log( Stringf( "Choose pivot selected a pivot (singleton column): V[%u,%u] = %lf",
-                          _vPivotRow,
-                          _vPivotColumn,
-                          _pivotElement ) );
-            return;
+        unsigned cost = ( _numURowElements[uRow] - 1 ) * ( _numUColumnElements[uColumn] - 1 );
+        if ( !found ||
+             ( cost < minimalCost ) ||
+             ( ( cost == minimalCost ) && FloatUtils::gt( absContender, absPivotElement ) ) )
+        {
+            minimalCost = cost;
+            _uPivotRow = uRow;
+            _uPivotColumn = uColumn;
+            _vPivotRow = vRow;
+            _vPivotColumn = vColumn;
+            _pivotElement = contender;
+            absPivotElement = absContender;
+
+            found = true;
         }
     }
+}
 
-    // No singletons, apply the Markowitz rule. Find the element with acceptable
-    // magnitude that has the smallet Markowitz value.
-    // Fail if no elements exists that are within acceptable magnitude
-
-    // Todo: more clever heuristics to reduce the search space
-    unsigned minimalCost = _m * _m;
-    _pivotElement = 0.0;
-    double absPivotElement = 0.0;
+void SparseGaussianEliminator::considerRow( unsigned vRow,
+                                            unsigned &minimalCost,
+                                            double &absPivotElement,
+                                            bool &found )
+{
+    unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+    const SparseUnsortedArray *sparseRow = _sparseLUFactors->_V->getRow( vRow );
+    const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+    unsigned nnz = sparseRow->getNnz();
+    _numOperations += nnz;
 
-    bool found = false;
-    for ( unsigned uColumn = _eliminationStep; uColumn < _m; ++uColumn )
+    for ( unsigned i = 0; i < nnz; ++i )
     {
-        unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
-        sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+        unsigned vColumn = entry[i]._index;
+        unsigned uColumn = _sparseLUFactors->_Q._columnOrdering[vColumn];
 
-        double maxInColumn = 0;
-        nnz = sparseColumn->getNnz();
-        entry = sparseColumn->getArray();
+        // Ignore entries that are not in the active submatrix
+        if ( uColumn < _eliminationStep )
+            continue;
 
-        for ( unsigned i = 0; i < nnz; ++i )
-        {
-            // Ignore entrying that are not in the active submatrix
-            unsigned vRow = entry[i]._index;
-            unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
-            if ( uRow < _eliminationStep )
-                continue;
-
-            double contender = FloatUtils::abs( entry[i]._value );
-            if ( FloatUtils::gt( contender, maxInColumn ) )
-                maxInColumn = contender;
-        }
+        unsigned cost = ( _numURowElements[uRow] - 1 ) * ( _numUColumnElements[uColumn] - 1 );
+        if ( found && cost > minimalCost )
+            continue;
 
-        if ( FloatUtils::isZero( maxInColumn ) )
-        {
-            throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
-                                           "Have a zero column" );
-        }
+        double contender = entry[i]._value;
+        double absContender = FloatUtils::abs( contender );
 
-        for ( unsigned i = 0; i < nnz; ++i )
-        {
-            unsigned vRow = entry[i]._index;
-            unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+        if ( found && ( cost == minimalCost ) && !FloatUtils::gt( absContender, absPivotElement ) )
+            continue;
 
-            // Ignore entrying that are not in the active submatrix
-            if ( uRow < _eliminationStep )
-                continue;
+        // Only consider large-enough elements
+        _numOperations += _numUColumnElements[uColumn];
+        if ( !FloatUtils::gt( absContender,
+                              maxInActiveColumn( vColumn ) *
+                              GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
+            continue;
 
-            double contender = entry[i]._value;
-            double absContender = FloatUtils::abs( contender );
+        minimalCost = cost;
+        _uPivotRow = uRow;
+        _uPivotColumn = uColumn;
+        _vPivotRow = vRow;
+        _vPivotColumn = vColumn;
+        _pivotElement = contender;
+        absPivotElement = absContender;
 
-            // Only consider large-enough elements
-            if ( FloatUtils::gt( absContender,
-                                 maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
-            {
-                unsigned cost = ( _numURowElements[uRow] - 1 ) * ( _numUColumnElements[uColumn] - 1 );
-
-                ASSERT( ( cost != minimalCost ) || found );
-
-                if ( ( cost < minimalCost ) ||
-                     ( ( cost == minimalCost ) && FloatUtils::gt( absContender, absPivotElement ) ) )
-                {
-                    minimalCost = cost;
-                    _uPivotRow = uRow;
-                    _uPivotColumn = uColumn;
-                    _vPivotRow = vRow;
-                    _vPivotColumn = vColumn;
-                    _pivotElement = contender;
-                    absPivotElement = absContender;
-
-                    found = true;
-                }
-            }
-        }
+        found = true;
     }
+}
 
-    if ( !found )
-        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
-                                       "Couldn't find a pivot" );
+void SparseGaussianEliminator::initializeBuckets()
+{
+    // Initially, U = V and so the indices coincide
+    std::fill_n( _rowBucketHead, _m + 1, _m );
+    std::fill_n( _columnBucketHead, _m + 1, _m );
 
-    log( Stringf( "Choose pivot selected a pivot: V[%u,%u] = %lf (cost %u)", _vPivotRow, _vPivotColumn, _pivotElement, minimalCost ) );
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        insertRowIntoBucket( i, _numURowElements[i] );
+        insertColumnIntoBucket( i, _numUColumnElements[i] );
+    }
+}
+
+void SparseGaussianEliminator::insertRowIntoBucket( unsigned vRow, unsigned count )
+{
+    _rowBucket[vRow] = count;
+    _rowBucketPrev[vRow] = _m;
+    _rowBucketNext[vRow] = _rowBucketHead[count];
+    if ( _rowBucketHead[count] != _m )
+        _rowBucketPrev[_rowBucketHead[count]] = vRow;
+    _rowBucketHead[count] = vRow;
+}
+
+void SparseGaussianEliminator::removeRowFromBucket( unsigned vRow )
+{
+    unsigned next = _rowBucketNext[vRow];
+    unsigned prev = _rowBucketPrev[vRow];
+
+    if ( prev != _m )
+        _rowBucketNext[prev] = next;
+    else
+        _rowBucketHead[_rowBucket[vRow]] = next;
+
+    if ( next != _m )
+        _rowBucketPrev[next] = prev;
+}
+
+void SparseGaussianEliminator::updateRowBucket( unsigned vRow )
+{
+    unsigned count = _numURowElements[_sparseLUFactors->_P._rowOrdering[vRow]];
+    if ( count == _rowBucket[vRow] )
+        return;
+
+    removeRowFromBucket( vRow );
+    insertRowIntoBucket( vRow, count );
+}
+
+void SparseGaussianEliminator::insertColumnIntoBucket( unsigned vColumn, unsigned count )
+{
+    _columnBucket[vColumn] = count;
+    _columnBucketPrev[vColumn] = _m;
+    _columnBucketNext[vColumn] = _columnBucketHead[count];
+    if ( _columnBucketHead[count] != _m )
+        _columnBucketPrev[_columnBucketHead[count]] = vColumn;
+    _columnBucketHead[count] = vColumn;
+}
+
+void SparseGaussianEliminator::removeColumnFromBucket( unsigned vColumn )
+{
+    unsigned next = _columnBucketNext[vColumn];
+    unsigned prev = _columnBucketPrev[vColumn];
+
+    if ( prev != _m )
+        _columnBucketNext[prev] = next;
+    else
+        _columnBucketHead[_columnBucket[vColumn]] = next;
+
+    if ( next != _m )
+        _columnBucketPrev[next] = prev;
+}
+
+void SparseGaussianEliminator::updateColumnBucket( unsigned vColumn )
+{
+    unsigned count = _numUColumnElements[_sparseLUFactors->_Q._columnOrdering[vColumn]];
+    if ( count == _columnBucket[vColumn] )
+        return;
+
+    removeColumnFromBucket( vColumn );
+    insertColumnIntoBucket( vColumn, count );
+}
+
+void SparseGaussianEliminator::reportFillIn( const SparseColumnsOfBasis *A )
+{
+    unsigned long long basisNnz = 0;
+    unsigned long long factorsNnz = 0;
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        basisNnz += A->_columns[i]->getNnz();
+        factorsNnz += _sparseLUFactors->_F->getRow( i )->getNnz();
+        factorsNnz += _sparseLUFactors->_V->getRow( i )->getNnz();
+    }
+
+    _statistics->addBasisFactorizationNonZeros( basisNnz, factorsNnz );
 }
 
 void SparseGaussianEliminator::eliminate()
@@ -385,19 +738,37 @@ void SparseGaussianEliminator::eliminate()
       We know that V[_vPivotRow, _vPivotColumn] = U[k,k].
     */
 
-    // Get the pivot row in dense format, due to repeated access
-    _sparseLUFactors->_V->getRowDense( _vPivotRow, _work );
-
     /*
       The pivot row is not eliminated per se, but it is excluded
-      from the active submatrix, so we adjust the element counters
+      from the active submatrix, so we adjust the element counters.
+      Also collect its remaining active entries, which are the only
+      ones that can change in the rows being eliminated.
     */
     _numURowElements[_eliminationStep] = 0;
-    for ( unsigned uColumn = _eliminationStep; uColumn < _m; ++uColumn )
+    _pivotRowNnz = 0;
+
+    removeRowFromBucket( _vPivotRow );
+    removeColumnFromBucket( _vPivotColumn );
+
+    const SparseUnsortedArray *pivotRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+    const SparseUnsortedArray::Entry *pivotRowEntry = pivotRow->getArray();
+    _numOperations += pivotRow->getNnz();
+    for ( unsigned i = 0; i < pivotRow->getNnz(); ++i )
     {
-        unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
-        if ( !FloatUtils::isZero( _work[vColumn] ) )
-            --_numUColumnElements[uColumn];
+        unsigned vColumn = pivotRowEntry[i]._index;
+        unsigned uColumn = _sparseLUFactors->_Q._columnOrdering[vColumn];
+        if ( uColumn < _eliminationStep || FloatUtils::isZero( pivotRowEntry[i]._value ) )
+            continue;
+
+        --_numUColumnElements[uColumn];
+        if ( uColumn == _eliminationStep )
+            continue;
+
+        updateColumnBucket( vColumn );
+
+        _pivotRowColumns[_pivotRowNnz] = vColumn;
+        _pivotRowValues[_pivotRowNnz] = pivotRowEntry[i]._value;
+        ++_pivotRowNnz;
     }
 
     // Process all rows below the pivot row
@@ -423,32 +794,29 @@ void SparseGaussianEliminator::eliminate()
         */
         double rowMultiplier = - entry[index]._value / _pivotElement;
 
-        // Get the row being eliminated in dense format
-        _sparseLUFactors->_V->getRowDense( vRow, _work2 );
+        // Scatter the row being eliminated into the (all-zero) work vector
+        SparseUnsortedArray *row = _sparseLUFactors->_V->getRow( vRow );
+        const SparseUnsortedArray::Entry *rowEntry = row->getArray();
+        unsigned rowNnz = row->getNnz();
+        _numOperations += rowNnz + _pivotRowNnz;
+        for ( unsigned i = 0; i < rowNnz; ++i )
+            _work[rowEntry[i]._index] = rowEntry[i]._value;
 
         // Eliminate the sub-diagonal entry
         --_numUColumnElements[_eliminationStep];
         --_numURowElements[uRow];
         sparseColumn->erase( index );
-        _work2[_vPivotColumn] = 0;
+        _work[_vPivotColumn] = 0;
 
-        // Handle the rest of the row
-        for ( unsigned vColumnIndex = 0; vColumnIndex < _m; ++vColumnIndex )
+        // Handle the rest of the row. Only the pivot row's columns change.
+        for ( unsigned i = 0; i < _pivotRowNnz; ++i )
         {
+            unsigned vColumnIndex = _pivotRowColumns[i];
             unsigned uColumnIndex = _sparseLUFactors->_Q._columnOrdering[vColumnIndex];
 
-            // Only care about the active submatirx
-            if ( uColumnIndex <= _eliminationStep )
-                continue;
-
-            // If the value does not change, skip
-            if ( FloatUtils::isZero( _work[vColumnIndex] ) )
-                continue;
-
-            // Value will change
-            double oldValue = _work2[vColumnIndex];
+            double oldValue = _work[vColumnIndex];
             bool wasZero = FloatUtils::isZero( oldValue );
-            double newValue = oldValue + ( rowMultiplier * _work[vColumnIndex] );
+            double newValue = oldValue + ( rowMultiplier * _pivotRowValues[i] );
             bool isZero = FloatUtils::isZero( newValue );
 
             if ( !wasZero && isZero )
@@ -456,14 +824,16 @@ void SparseGaussianEliminator::eliminate()
                 newValue = 0;
                 --_numUColumnElements[uColumnIndex];
                 --_numURowElements[uRow];
+                updateColumnBucket( vColumnIndex );
             }
             else if ( wasZero && !isZero )
             {
                 ++_numUColumnElements[uColumnIndex];
                 ++_numURowElements[uRow];
+                updateColumnBucket( vColumnIndex );
             }
 
-            _work2[vColumnIndex] = newValue;
+            _work[vColumnIndex] = newValue;
 
             // Transposed matrix is updated immediately, regular matrix will
             // be updated when entire row has been processed
@@ -471,7 +841,40 @@ void SparseGaussianEliminator::eliminate()
                 _sparseLUFactors->_Vt->set( vColumnIndex, vRow, newValue );
         }
 
-        _sparseLUFactors->_V->updateSingleRow( vRow, _work2 );
+        updateRowBucket( vRow );
+
+        /*
+          Gather the updated row: its previous entries, and any fill-in
+          from the pivot row. The work vector is reset along the way.
+        */
+        unsigned newRowNnz = 0;
+        for ( unsigned i = 0; i < rowNnz; ++i )
+        {
+            unsigned vColumn = rowEntry[i]._index;
+            if ( _work[vColumn] != 0 )
+            {
+                _newRowColumns[newRowNnz] = vColumn;
+                _newRowValues[newRowNnz] = _work[vColumn];
+                ++newRowNnz;
+                _work[vColumn] = 0;
+            }
+        }
+
+        for ( unsigned i = 0; i < _pivotRowNnz; ++i )
+        {
+            unsigned vColumn = _pivotRowColumns[i];
+            if ( _work[vColumn] != 0 )
+            {
+                _newRowColumns[newRowNnz] = vColumn;
+                _newRowValues[newRowNnz] = _work[vColumn];
+                ++newRowNnz;
+                _work[vColumn] = 0;
+            }
+        }
+
+        row->clear();
+        for ( unsigned i = 0; i < newRowNnz; ++i )
+            row->append( _newRowColumns[i], _newRowValues[i] );
 
         /*
           Store the row multiplier in matrix F, using F = PLP'.
@@ -496,6 +899,11 @@ void SparseGaussianEliminator::setStatistics( Statistics *statistics )
     _statistics = statistics;
 }
 
+unsigned long long SparseGaussianEliminator::getNumOperations() const
+{
+    return _numOperations;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
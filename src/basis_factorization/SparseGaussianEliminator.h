@@ -39,6 +39,12 @@ public:
     */
     void setStatistics( Statistics *statistics );
 
+    /*
+      The number of elementary operations (entries scanned or updated)
+      performed by the last factorization, as a measure of its cost.
+    */
+    unsigned long long getNumOperations() const;
+
 private:
     /*
       The dimension of the (square) matrix being factorized
@@ -61,10 +67,20 @@ private:
     SparseLUFactors *_sparseLUFactors;
 
     /*
-      Work memory
+      The active entries of the current pivot row, excluding the
+      pivot element itself
+    */
+    unsigned *_pivotRowColumns;
+    double *_pivotRowValues;
+    unsigned _pivotRowNnz;
+
+    /*
+      Work memory. The dense work vector is kept all-zero between
+      eliminated rows.
     */
     double *_work;
-    double *_work2;
+    unsigned *_newRowColumns;
+    double *_newRowValues;
 
     /*
       An object for reporting statistics
@@ -78,7 +94,67 @@ private:
     unsigned *_numURowElements;
     unsigned *_numUColumnElements;
 
+    /*
+      The rows and columns of the active submatrix, bucketed by their
+      number of non-zero elements. Each bucket is a doubly-linked list
+      of (fixed) indices in V, and _m serves as the null link.
+
+      The bases produced by layered networks are mostly triangular, and
+      their singleton rows and columns are found in constant time in
+      bucket 1. For the remaining nucleus, the Markowitz search scans
+      the buckets in order of increasing count, and stops once the
+      cheapest possible pivot among the unscanned ones cannot beat the
+      best one found so far.
+    */
+    unsigned *_rowBucketHead;
+    unsigned *_rowBucketNext;
+    unsigned *_rowBucketPrev;
+    unsigned *_rowBucket;
+    unsigned *_columnBucketHead;
+    unsigned *_columnBucketNext;
+    unsigned *_columnBucketPrev;
+    unsigned *_columnBucket;
+
+    /*
+      Pivot counts for the last factorization, for logging purposes
+    */
+    unsigned _numSingletonPivots;
+    unsigned _numMarkowitzPivots;
+
+    /*
+      The cost of the last factorization
+    */
+    unsigned long long _numOperations;
+
     void choosePivot();
+    void chooseSingletonRowPivot();
+    void chooseSingletonColumnPivot();
+    void chooseMarkowitzPivot();
+
+    /*
+      Markowitz search helpers. considerColumn() and considerRow() check
+      the threshold-acceptable elements of the given active column or
+      row, and update the best pivot found so far.
+    */
+    double maxInActiveColumn( unsigned vColumn ) const;
+    void considerColumn( unsigned vColumn, unsigned &minimalCost, double &absPivotElement, bool &found );
+    void considerRow( unsigned vRow, unsigned &minimalCost, double &absPivotElement, bool &found );
+
+    /*
+      Maintaining the count buckets
+    */
+    void initializeBuckets();
+    void insertRowIntoBucket( unsigned vRow, unsigned count );
+    void removeRowFromBucket( unsigned vRow );
+    void updateRowBucket( unsigned vRow );
+    void insertColumnIntoBucket( unsigned vColumn, unsigned count );
+    void removeColumnFromBucket( unsigned vColumn );
+    void updateColumnBucket( unsigned vColumn );
+
+    /*
+      Report the fill-in of the completed factorization
+    */
+    void reportFillIn( const SparseColumnsOfBasis *A );
     void initializeFactorization( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors );
     void factorize();
     void permute();
@@ -153,6 +153,28 @@ void SparseLUFactorization::backwardTransformation( const double *y, double *x )
     _sparseLUFactors.backwardTransformation( _z, x );
 }
 
+void SparseLUFactorization::sparseForwardTransformation( const double *y,
+                                                         const unsigned */* yIndices */,
+                                                         unsigned /* yNnz */,
+                                                         double *x,
+                                                         unsigned *xIndices,
+                                                         unsigned &xNnz ) const
+{
+    forwardTransformation( y, x );
+    listNonZeros( x, _m, xIndices, xNnz );
+}
+
+void SparseLUFactorization::sparseBackwardTransformation( const double *y,
+                                                          const unsigned */* yIndices */,
+                                                          unsigned /* yNnz */,
+                                                          double *x,
+                                                          unsigned *xIndices,
+                                                          unsigned &xNnz ) const
+{
+    backwardTransformation( y, x );
+    listNonZeros( x, _m, xIndices, xNnz );
+}
+
 void SparseLUFactorization::clearFactorization()
 {
 	List<EtaMatrix *>::iterator it;
@@ -25,7 +25,7 @@
 class EtaMatrix;
 class LPElement;
 
-class SparseLUFactorization : public IBasisFactorization
+class SparseLUFactorization final : public IBasisFactorization
 {
 public:
     SparseLUFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle );
@@ -84,6 +84,22 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Sparse right hand sides are solved densely.
+    */
+    void sparseForwardTransformation( const double *y,
+                                      const unsigned *yIndices,
+                                      unsigned yNnz,
+                                      double *x,
+                                      unsigned *xIndices,
+                                      unsigned &xNnz ) const;
+    void sparseBackwardTransformation( const double *y,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz,
+                                       double *x,
+                                       unsigned *xIndices,
+                                       unsigned &xNnz ) const;
+
     /*
       Store and restore the basis factorization. Storing triggers
       condesning the etas.
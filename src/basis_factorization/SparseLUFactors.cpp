@@ -33,6 +33,12 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     , _z( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
+    , _sparseWorkVector( NULL )
+    , _reach( NULL )
+    , _dfsStack( NULL )
+    , _dfsPosition( NULL )
+    , _reachMarks( NULL )
+    , _reachStamp( 0 )
 {
     _F = new SparseUnsortedArrays();
     if ( !_F )
@@ -65,6 +71,28 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     _workVector = new double[m];
     if ( !_workVector )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::workVector" );
+
+    _sparseWorkVector = new double[m];
+    if ( !_sparseWorkVector )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::sparseWorkVector" );
+    std::fill_n( _sparseWorkVector, m, 0.0 );
+
+    _reach = new unsigned[m];
+    if ( !_reach )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::reach" );
+
+    _dfsStack = new unsigned[m];
+    if ( !_dfsStack )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsStack" );
+
+    _dfsPosition = new unsigned[m];
+    if ( !_dfsPosition )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsPosition" );
+
+    _reachMarks = new unsigned[m];
+    if ( !_reachMarks )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::reachMarks" );
+    std::fill_n( _reachMarks, m, 0 );
 }
 
 SparseLUFactors::~SparseLUFactors()
@@ -116,6 +144,36 @@ SparseLUFactors::~SparseLUFactors()
         delete[] _workVector;
         _workVector = NULL;
     }
+
+    if ( _sparseWorkVector )
+    {
+        delete[] _sparseWorkVector;
+        _sparseWorkVector = NULL;
+    }
+
+    if ( _reach )
+    {
+        delete[] _reach;
+        _reach = NULL;
+    }
+
+    if ( _dfsStack )
+    {
+        delete[] _dfsStack;
+        _dfsStack = NULL;
+    }
+
+    if ( _dfsPosition )
+    {
+        delete[] _dfsPosition;
+        _dfsPosition = NULL;
+    }
+
+    if ( _reachMarks )
+    {
+        delete[] _reachMarks;
+        _reachMarks = NULL;
+    }
 }
 
 void SparseLUFactors::dump() const
@@ -404,6 +462,206 @@ void SparseLUFactors::vBackwardTransformation( const double *y, double *x ) cons
     }
 }
 
+unsigned SparseLUFactors::computeReach( const SparseUnsortedArrays *graph,
+                                       const unsigned *first,
+                                       const unsigned *second,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz ) const
+{
+    // A fresh stamp un-marks all nodes at once
+    ++_reachStamp;
+    if ( _reachStamp == 0 )
+    {
+        std::fill_n( _reachMarks, _m, 0 );
+        _reachStamp = 1;
+    }
+
+    unsigned reachSize = 0;
+
+    for ( unsigned i = 0; i < yNnz; ++i )
+    {
+        unsigned start = yIndices[i];
+        if ( _reachMarks[start] == _reachStamp )
+            continue;
+
+        _reachMarks[start] = _reachStamp;
+        _dfsStack[0] = start;
+        _dfsPosition[0] = 0;
+        unsigned stackSize = 1;
+
+        while ( stackSize > 0 )
+        {
+            unsigned node = _dfsStack[stackSize - 1];
+            unsigned row = first ? second[first[node]] : node;
+
+            const SparseUnsortedArray *successors = graph->getRow( row );
+            const SparseUnsortedArray::Entry *entry = successors->getArray();
+            unsigned nnz = successors->getNnz();
+
+            // Descend into the next unvisited successor, if there is one
+            unsigned &position = _dfsPosition[stackSize - 1];
+            while ( position < nnz && _reachMarks[entry[position]._index] == _reachStamp )
+                ++position;
+
+            if ( position < nnz )
+            {
+                unsigned successor = entry[position]._index;
+                _reachMarks[successor] = _reachStamp;
+                _dfsStack[stackSize] = successor;
+                _dfsPosition[stackSize] = 0;
+                ++stackSize;
+            }
+            else
+            {
+                // All successors are done
+                _reach[reachSize] = node;
+                ++reachSize;
+                --stackSize;
+            }
+        }
+    }
+
+    return reachSize;
+}
+
+void SparseLUFactors::fForwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                              double *x, unsigned *xIndices, unsigned &xNnz ) const
+{
+    /*
+      Column j of F is stored in row j of Ft, and x[j] is eliminated
+      from the entries of that column.
+    */
+    unsigned reachSize = computeReach( _Ft, NULL, NULL, yIndices, yNnz );
+
+    for ( unsigned i = 0; i < yNnz; ++i )
+        x[yIndices[i]] = y[yIndices[i]];
+
+    xNnz = 0;
+    for ( int i = reachSize - 1; i >= 0; --i )
+    {
+        unsigned fColumn = _reach[i];
+        xIndices[xNnz] = fColumn;
+        ++xNnz;
+
+        double xElement = x[fColumn];
+        if ( xElement == 0.0 )
+            continue;
+
+        const SparseUnsortedArray *sparseColumn = _Ft->getRow( fColumn );
+        const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+        unsigned nnz = sparseColumn->getNnz();
+
+        for ( unsigned j = 0; j < nnz; ++j )
+            x[entry[j]._index] -= xElement * entry[j]._value;
+    }
+}
+
+void SparseLUFactors::fBackwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                               double *x, unsigned *xIndices, unsigned &xNnz ) const
+{
+    /*
+      Row j of F is eliminated from x, once x[j] is final.
+    */
+    unsigned reachSize = computeReach( _F, NULL, NULL, yIndices, yNnz );
+
+    for ( unsigned i = 0; i < yNnz; ++i )
+        x[yIndices[i]] = y[yIndices[i]];
+
+    xNnz = 0;
+    for ( int i = reachSize - 1; i >= 0; --i )
+    {
+        unsigned fRow = _reach[i];
+        xIndices[xNnz] = fRow;
+        ++xNnz;
+
+        double xElement = x[fRow];
+        if ( xElement == 0.0 )
+            continue;
+
+        const SparseUnsortedArray *sparseRow = _F->getRow( fRow );
+        const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+        unsigned nnz = sparseRow->getNnz();
+
+        for ( unsigned j = 0; j < nnz; ++j )
+            x[entry[j]._index] -= xElement * entry[j]._value;
+    }
+}
+
+void SparseLUFactors::vForwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                              double *x, unsigned *xIndices, unsigned &xNnz ) const
+{
+    /*
+      The nodes are the rows of V. Row vRow determines the entry of x
+      for its diagonal column, which is then eliminated from the other
+      rows through that column of V. The work vector is all zeros
+      between calls.
+    */
+    unsigned reachSize = computeReach( _Vt, _P._rowOrdering, _Q._rowOrdering, yIndices, yNnz );
+
+    for ( unsigned i = 0; i < yNnz; ++i )
+        _sparseWorkVector[yIndices[i]] = y[yIndices[i]];
+
+    xNnz = 0;
+    for ( int i = reachSize - 1; i >= 0; --i )
+    {
+        unsigned vRow = _reach[i];
+        unsigned vColumn = _Q._rowOrdering[_P._rowOrdering[vRow]];
+        xIndices[xNnz] = vColumn;
+        ++xNnz;
+
+        double xElement = x[vColumn] = ( _sparseWorkVector[vRow] / _vDiagonalElements[vRow] );
+        if ( xElement == 0.0 )
+            continue;
+
+        const SparseUnsortedArray *sparseColumn = _Vt->getRow( vColumn );
+        const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+        unsigned nnz = sparseColumn->getNnz();
+
+        for ( unsigned j = 0; j < nnz; ++j )
+            _sparseWorkVector[entry[j]._index] -= xElement * entry[j]._value;
+    }
+
+    for ( unsigned i = 0; i < reachSize; ++i )
+        _sparseWorkVector[_reach[i]] = 0.0;
+}
+
+void SparseLUFactors::vBackwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                               double *x, unsigned *xIndices, unsigned &xNnz ) const
+{
+    /*
+      The nodes are the columns of V. Column vColumn determines the
+      entry of x for its diagonal row, which is then eliminated from
+      the other columns through that row of V.
+    */
+    unsigned reachSize = computeReach( _V, _Q._columnOrdering, _P._columnOrdering, yIndices, yNnz );
+
+    for ( unsigned i = 0; i < yNnz; ++i )
+        _sparseWorkVector[yIndices[i]] = y[yIndices[i]];
+
+    xNnz = 0;
+    for ( int i = reachSize - 1; i >= 0; --i )
+    {
+        unsigned vColumn = _reach[i];
+        unsigned vRow = _P._columnOrdering[_Q._columnOrdering[vColumn]];
+        xIndices[xNnz] = vRow;
+        ++xNnz;
+
+        double xElement = x[vRow] = ( _sparseWorkVector[vColumn] / _vDiagonalElements[vRow] );
+        if ( xElement == 0.0 )
+            continue;
+
+        const SparseUnsortedArray *sparseRow = _V->getRow( vRow );
+        const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+        unsigned nnz = sparseRow->getNnz();
+
+        for ( unsigned j = 0; j < nnz; ++j )
+            _sparseWorkVector[entry[j]._index] -= xElement * entry[j]._value;
+    }
+
+    for ( unsigned i = 0; i < reachSize; ++i )
+        _sparseWorkVector[_reach[i]] = 0.0;
+}
+
 void SparseLUFactors::forwardTransformation( const double *y, double *x ) const
 {
     /*
@@ -559,6 +817,58 @@ void SparseLUFactors::storeToOther( SparseLUFactors *other ) const
     other->_usePForF = false;
 }
 
+void SparseLUFactors::extendIntoOther( SparseLUFactors *other, const double *g, double d ) const
+{
+    ASSERT( _m + 1 == other->_m );
+    ASSERT( !FloatUtils::isZero( d ) );
+
+    double *row = other->_workVector;
+
+    // F gets g as its new last row, and a unit last column
+    _F->storeIntoOther( other->_F );
+    other->_F->addEmptyColumn();
+    memcpy( row, g, sizeof(double) * _m );
+    row[_m] = 0.0;
+    other->_F->addLastRow( row );
+
+    _Ft->storeIntoOther( other->_Ft );
+    other->_Ft->addEmptyColumn();
+    std::fill_n( row, other->_m, 0.0 );
+    other->_Ft->addLastRow( row );
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !FloatUtils::isZero( g[i] ) )
+            other->_Ft->append( i, _m, g[i] );
+    }
+
+    // V and Vt only get a new diagonal element
+    row[_m] = d;
+
+    _V->storeIntoOther( other->_V );
+    other->_V->addEmptyColumn();
+    other->_V->addLastRow( row );
+
+    _Vt->storeIntoOther( other->_Vt );
+    other->_Vt->addEmptyColumn();
+    other->_Vt->addLastRow( row );
+
+    memcpy( other->_vDiagonalElements, _vDiagonalElements, sizeof(double) * _m );
+    other->_vDiagonalElements[_m] = d;
+
+    // The new row and column are last in L and U
+    const PermutationMatrix *permutations[] = { &_P, &_Q, &_PForF };
+    PermutationMatrix *otherPermutations[] = { &other->_P, &other->_Q, &other->_PForF };
+    for ( unsigned i = 0; i < 3; ++i )
+    {
+        memcpy( otherPermutations[i]->_rowOrdering, permutations[i]->_rowOrdering, sizeof(unsigned) * _m );
+        memcpy( otherPermutations[i]->_columnOrdering, permutations[i]->_columnOrdering, sizeof(unsigned) * _m );
+        otherPermutations[i]->_rowOrdering[_m] = _m;
+        otherPermutations[i]->_columnOrdering[_m] = _m;
+    }
+
+    other->_usePForF = _usePForF;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -110,6 +110,29 @@ public:
     void vForwardTransformation( const double *y, double *x ) const;
     void vBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hyper-sparse variants of the above, for right hand sides with
+      few non-zero entries. The non-zero pattern of the solution is
+      first found by a depth-first search over the graph of the
+      triangular factor (Gilbert-Peierls), and only these entries are
+      then eliminated, in topological order. The cost is thus
+      proportional to the number of operations, and not to m.
+
+      y and x are dense, and the indices of their non-zero entries are
+      listed in yIndices and xIndices. y must be zero outside of its
+      listed indices, and x must be all zeros on entry. xIndices needs
+      room for m entries, and may list a few entries that cancelled
+      out to zero.
+    */
+    void fForwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                 double *x, unsigned *xIndices, unsigned &xNnz ) const;
+    void fBackwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                  double *x, unsigned *xIndices, unsigned &xNnz ) const;
+    void vForwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                 double *x, unsigned *xIndices, unsigned &xNnz ) const;
+    void vBackwardTransformation( const double *y, const unsigned *yIndices, unsigned yNnz,
+                                  double *x, unsigned *xIndices, unsigned &xNnz ) const;
+
     /*
       Compute the inverse of the factorized basis
     */
@@ -122,15 +145,54 @@ public:
     double *_workMatrix;
     double *_workVector;
 
+    /*
+      Work memory for the hyper-sparse transformations: a vector that
+      is all zeros between calls, the reachable nodes in post order,
+      the depth-first search stack, and the markings of visited nodes
+      (by the current stamp).
+    */
+    double *_sparseWorkVector;
+    unsigned *_reach;
+    unsigned *_dfsStack;
+    unsigned *_dfsPosition;
+    unsigned *_reachMarks;
+    mutable unsigned _reachStamp;
+
     /*
       Clone this SparseLUFactors object into another object
     */
     void storeToOther( SparseLUFactors *other ) const;
 
+    /*
+      Store the factors into another object of dimension _m + 1, whose
+      matrix is bordered by an extra row and column:
+
+          | A  0 |   | F  0 |   | V  0 |
+          | r  d | = | g  1 | * | 0  d |
+
+      The caller provides g (of size _m), which solves g * V = r.
+      The other object's permutations are extended by the identity.
+    */
+    void extendIntoOther( SparseLUFactors *other, const double *g, double d ) const;
+
     /*
       For debugging purposes
     */
     void dump() const;
+
+private:
+    /*
+      Find all nodes reachable from the non-zero entries of y, and
+      store them in _reach in post order, i.e. every node appears after
+      all of its successors. The successors of node k are the entries
+      in row k of the graph, or in row second[first[k]] if these
+      permutations are provided. Returns the number of nodes found.
+    */
+    unsigned computeReach( const SparseUnsortedArrays *graph,
+                           const unsigned *first,
+                           const unsigned *second,
+                           const unsigned *yIndices,
+                           unsigned yNnz ) const;
 };
 
 #endif // __SparseLUFactors_h__
@@ -52,6 +52,14 @@ public:
      */
     virtual void addEmptyColumn() = 0;
 
+    /*
+      Remove the last row/column of the matrix. The last column
+      is assumed to be all zeroes. These operations undo addLastRow()
+      and addEmptyColumn(), respectively.
+    */
+    virtual void removeLastRow() = 0;
+    virtual void removeLastColumn() = 0;
+
     /*
       A mechanism for storing a set of changes to the matrix,
       and then executing them all at once to reduce overhead
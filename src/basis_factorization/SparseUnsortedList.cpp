@@ -48,7 +48,7 @@ void SparseUnsortedList::initialize( const double *V, unsigned size )
         if ( FloatUtils::isZero( V[i] ) )
             continue;
 
-        _list.append( Entry( i, V[i] ) );
+        _list.push_back( Entry( i, V[i] ) );
     }
 }
 
@@ -80,7 +80,7 @@ double SparseUnsortedList::get( unsigned entry ) const
 
 void SparseUnsortedList::dump() const
 {
-    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _list.size() );
+    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", getNnz() );
     for ( const auto &entry : _list )
         printf( "\tEntry %u: %6.2lf\n", entry._index, entry._value );
     printf( "\n" );
@@ -119,22 +119,22 @@ void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
     other->_list = _list;
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::begin() const
+SparseUnsortedList::const_iterator SparseUnsortedList::begin() const
 {
     return _list.begin();
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::end() const
+SparseUnsortedList::const_iterator SparseUnsortedList::end() const
 {
     return _list.end();
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::begin()
+SparseUnsortedList::iterator SparseUnsortedList::begin()
 {
     return _list.begin();
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::end()
+SparseUnsortedList::iterator SparseUnsortedList::end()
 {
     return _list.end();
 }
@@ -157,18 +157,18 @@ void SparseUnsortedList::set( unsigned index, double value )
     }
 
     if ( !isZero )
-        _list.append( Entry( index, value ) );
+        _list.push_back( Entry( index, value ) );
 }
 
 void SparseUnsortedList::append( unsigned index, double value )
 {
-    _list.append( Entry( index, value ) );
+    _list.push_back( Entry( index, value ) );
 }
 
 void SparseUnsortedList::addLastEntry( double entry )
 {
     if ( !FloatUtils::isZero( entry ) )
-        _list.append( Entry( _size, entry ) );
+        _list.push_back( Entry( _size, entry ) );
 
     ++_size;
 }
@@ -178,11 +178,22 @@ void SparseUnsortedList::incrementSize()
     ++_size;
 }
 
+void SparseUnsortedList::decrementSize()
+{
+    ASSERT( _size > 0 );
+    DEBUG({
+            for ( const auto &entry : _list )
+                ASSERT( entry._index != _size - 1 );
+        });
+
+    --_size;
+}
+
 void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
 {
-    List<Entry>::iterator sourceIt = _list.end();
-    List<Entry>::iterator targetIt = _list.end();
-    List<Entry>::iterator it;
+    iterator sourceIt = _list.end();
+    iterator targetIt = _list.end();
+    iterator it;
 
     for ( it = _list.begin(); it != _list.end(); ++it )
     {
@@ -215,12 +226,23 @@ void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
     // Both source and target entries
     targetIt->_value += sourceIt->_value;
 
-    _list.erase( sourceIt );
-    if ( FloatUtils::isZero( targetIt->_value ) )
-         _list.erase( targetIt );
+    // Erasing shifts the later entries, so erase the later entry first
+    bool eraseTarget = FloatUtils::isZero( targetIt->_value );
+    if ( sourceIt > targetIt )
+    {
+        _list.erase( sourceIt );
+        if ( eraseTarget )
+            _list.erase( targetIt );
+    }
+    else
+    {
+        if ( eraseTarget )
+            _list.erase( targetIt );
+        _list.erase( sourceIt );
+    }
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::erase( List<SparseUnsortedList::Entry>::iterator it )
+SparseUnsortedList::iterator SparseUnsortedList::erase( iterator it )
 {
     return _list.erase( it );
 }
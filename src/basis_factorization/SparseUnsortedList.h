@@ -19,11 +19,25 @@
 #include "HashMap.h"
 #include "SparseMatrix.h"
 
+#include <vector>
+
+/*
+  A sparse vector, stored as an unsorted list of (index, value)
+  entries. The entries are kept contiguously in memory, so that
+  iterating over them and copying the list stream through memory, and
+  the list's capacity is retained when it is cleared or overwritten.
+*/
 class SparseUnsortedList
 {
 public:
     struct Entry
     {
+        Entry()
+            : _index( 0 )
+            , _value( 0 )
+        {
+        }
+
         Entry( unsigned index, double value )
             : _index( index )
             , _value( value )
@@ -84,6 +98,11 @@ public:
     void addLastEntry( double entry );
     void incrementSize();
 
+    /*
+      Decrease the list size. The last entry is assumed to be zero.
+    */
+    void decrementSize();
+
     /*
       Cloning
     */
@@ -93,15 +112,19 @@ public:
     /*
       Retrieve entries
     */
-    List<Entry>::const_iterator begin() const;
-    List<Entry>::const_iterator end() const;
-    List<Entry>::iterator begin();
-    List<Entry>::iterator end();
+    typedef std::vector<Entry>::iterator iterator;
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    iterator begin();
+    iterator end();
 
     /*
-      Erasing an element by iterator
+      Erasing an element by iterator. Returns an iterator to the
+      element that followed the erased one.
     */
-    List<Entry>::iterator erase( List<Entry>::iterator it );
+    iterator erase( iterator it );
 
     /*
       Addes the coefficient for entry 'source' to entry 'target'
@@ -122,7 +145,7 @@ public:
 
 private:
     unsigned _size;
-    List<Entry> _list;
+    std::vector<Entry> _list;
 };
 
 #endif // __SparseUnsortedList_h__
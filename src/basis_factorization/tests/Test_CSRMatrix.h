@@ -136,6 +136,92 @@ public:
                 TS_ASSERT_EQUALS( csr1.get( i, j ), expected[i*4 + j] );
     }
 
+    void test_add_many_rows()
+    {
+        double M1[] = {
+            1, 0, 0, 0,
+            0, 2, 0, 0,
+        };
+
+        CSRMatrix csr1;
+        csr1.initialize( M1, 2, 4 );
+
+        // Grow well beyond the initial capacity
+        for ( unsigned i = 2; i < 100; ++i )
+        {
+            double row[] = { 0, 0, 0, 0 };
+            row[i % 4] = i;
+            row[( i + 1 ) % 4] = -1;
+            TS_ASSERT_THROWS_NOTHING( csr1.addLastRow( row ) );
+        }
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 198U );
+
+        CSRMatrix csr2;
+        csr1.storeIntoOther( &csr2 );
+
+        TS_ASSERT_EQUALS( csr2.get( 0, 0 ), 1.0 );
+        TS_ASSERT_EQUALS( csr2.get( 1, 1 ), 2.0 );
+        for ( unsigned i = 2; i < 100; ++i )
+        {
+            TS_ASSERT_EQUALS( csr2.get( i, i % 4 ), (double)i );
+            TS_ASSERT_EQUALS( csr2.get( i, ( i + 1 ) % 4 ), -1.0 );
+            TS_ASSERT_EQUALS( csr2.get( i, ( i + 2 ) % 4 ), 0.0 );
+        }
+
+        // The copy can keep growing
+        double row[] = { 5, 0, 0, 0 };
+        TS_ASSERT_THROWS_NOTHING( csr2.addLastRow( row ) );
+        TS_ASSERT_EQUALS( csr2.get( 100, 0 ), 5.0 );
+        TS_ASSERT_EQUALS( csr2.getNnz(), 199U );
+    }
+
+    void test_remove_last_row_and_column()
+    {
+        double M1[] = {
+            0, 0, 0, 0,
+            5, 8, 0, 0,
+            0, 0, 3, 0,
+        };
+
+        CSRMatrix csr1;
+        csr1.initialize( M1, 3, 4 );
+
+        double row4[] = { 1, 2, 0, 0, 1 };
+        double row5[] = { 0, 2, -3, 0, 0, 1 };
+
+        csr1.addEmptyColumn();
+        csr1.addLastRow( row4 );
+        csr1.addEmptyColumn();
+        csr1.addLastRow( row5 );
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 9U );
+
+        TS_ASSERT_THROWS_NOTHING( csr1.removeLastRow() );
+        TS_ASSERT_THROWS_NOTHING( csr1.removeLastColumn() );
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 6U );
+
+        TS_ASSERT_THROWS_NOTHING( csr1.removeLastRow() );
+        TS_ASSERT_THROWS_NOTHING( csr1.removeLastColumn() );
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 3U );
+
+        double dense[12];
+        csr1.toDense( dense );
+        for ( unsigned i = 0; i < 12; ++i )
+            TS_ASSERT_EQUALS( dense[i], M1[i] );
+
+        // The matrix can grow again
+        double row6[] = { 0, 0, 7, 0, 1 };
+        csr1.addEmptyColumn();
+        csr1.addLastRow( row6 );
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 5U );
+        TS_ASSERT_EQUALS( csr1.get( 3, 2 ), 7.0 );
+        TS_ASSERT_EQUALS( csr1.get( 3, 4 ), 1.0 );
+    }
+
     void test_add_last_column()
     {
         {
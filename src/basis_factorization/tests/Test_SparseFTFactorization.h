@@ -375,6 +375,175 @@ public:
         TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a3, d3 ) );
         TS_ASSERT( memcmp( d3other, d3, sizeof(double) * 3 ) );
     }
+
+    void test_extend_factorization()
+    {
+        SparseFTFactorization basis( 3, *oracle );
+
+        double B[] = {
+            1, 2, 0,
+            0, 1, 4,
+            3, 0, 1,
+        };
+        oracle->storeBasis( 3, B );
+        basis.obtainFreshBasis();
+
+        double a1[] = { 2, 1, 1 };
+        basis.updateToAdjacentBasis( 0, NULL, a1 );
+
+        // The new basis has the current basis in its top left corner
+        double extendedB[] = {
+            2,  2, 0, 0,
+            1,  1, 4, 0,
+            1,  0, 1, 0,
+            1, -1, 2, 1,
+        };
+
+        SparseFTFactorization extendedBasis( 4, *oracle );
+        double lastRow[] = { 1, -1, 2, 1 };
+        TS_ASSERT( extendedBasis.extendFactorization( &basis, lastRow ) );
+
+        // Compare against a fresh factorization of the same basis
+        SparseFTFactorization freshBasis( 4, *oracle );
+        oracle->storeBasis( 4, extendedB );
+        freshBasis.obtainFreshBasis();
+
+        double y[] = { 1, 2, 3, 4 };
+        double x[4];
+        double expected[4];
+
+        TS_ASSERT_THROWS_NOTHING( extendedBasis.forwardTransformation( y, x ) );
+        TS_ASSERT_THROWS_NOTHING( freshBasis.forwardTransformation( y, expected ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
+
+        TS_ASSERT_THROWS_NOTHING( extendedBasis.backwardTransformation( y, x ) );
+        TS_ASSERT_THROWS_NOTHING( freshBasis.backwardTransformation( y, expected ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
+
+        // The extended factorization supports further updates
+        double a2[] = { 0, 1, 1, 3 };
+        TS_ASSERT_THROWS_NOTHING( extendedBasis.updateToAdjacentBasis( 1, NULL, a2 ) );
+        TS_ASSERT_THROWS_NOTHING( freshBasis.updateToAdjacentBasis( 1, NULL, a2 ) );
+
+        TS_ASSERT_THROWS_NOTHING( extendedBasis.forwardTransformation( y, x ) );
+        TS_ASSERT_THROWS_NOTHING( freshBasis.forwardTransformation( y, expected ) );
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
+
+        // A factorization that was never computed cannot be extended
+        SparseFTFactorization emptyBasis( 3, *oracle );
+        SparseFTFactorization otherExtendedBasis( 4, *oracle );
+        TS_ASSERT( !otherExtendedBasis.extendFactorization( &emptyBasis, lastRow ) );
+    }
+
+    void test_sparse_transformations()
+    {
+        // The basis needs to be large enough for unit vectors to count as sparse
+        const unsigned m = 12;
+        SparseFTFactorization basis( m, *oracle );
+
+        double B[m * m];
+        std::fill_n( B, m * m, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            B[i * m + i] = 2;
+            if ( i > 0 )
+                B[i * m + i - 1] = 1;
+            if ( i % 3 == 0 && i + 2 < m )
+                B[i * m + i + 2] = -1;
+        }
+        oracle->storeBasis( m, B );
+        basis.obtainFreshBasis();
+
+        // Introduce an eta matrix
+        double a1[m];
+        std::fill_n( a1, m, 0.0 );
+        a1[1] = 1;
+        a1[4] = 3;
+        a1[7] = -2;
+        basis.updateToAdjacentBasis( 4, NULL, a1 );
+
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            double y[m];
+            std::fill_n( y, m, 0.0 );
+            y[i] = 1;
+
+            double x[m];
+            double expected[m];
+            unsigned xIndices[m];
+            unsigned xNnz;
+
+            TS_ASSERT_THROWS_NOTHING( basis.sparseForwardTransformation( y, &i, 1, x, xIndices, xNnz ) );
+            basis.forwardTransformation( y, expected );
+            for ( unsigned j = 0; j < m; ++j )
+                TS_ASSERT( FloatUtils::areEqual( x[j], expected[j] ) );
+            TS_ASSERT( xNnz <= m );
+
+            TS_ASSERT_THROWS_NOTHING( basis.sparseBackwardTransformation( y, &i, 1, x, xIndices, xNnz ) );
+            basis.backwardTransformation( y, expected );
+            for ( unsigned j = 0; j < m; ++j )
+                TS_ASSERT( FloatUtils::areEqual( x[j], expected[j] ) );
+            TS_ASSERT( xNnz <= m );
+        }
+    }
+
+    void test_adaptive_refactorization()
+    {
+        const unsigned m = 6;
+        SparseFTFactorization basis( m, *oracle );
+        Statistics statistics;
+        basis.setStatistics( &statistics );
+
+        double B[m * m];
+        std::fill_n( B, m * m, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+            B[i * m + i] = 1;
+        oracle->storeBasis( m, B );
+        basis.obtainFreshBasis();
+        TS_ASSERT_EQUALS( statistics.getNumBasisRefactorizations(), 1U );
+
+        /*
+          Replace columns with dense ones. Each update fills in the
+          factors, so the accumulated cost of the updates quickly
+          exceeds that of refactorizing the small basis, long before
+          the fixed threshold is reached.
+        */
+        double column[m];
+        double y[m];
+        double x[m];
+        for ( unsigned k = 0; k < 10; ++k )
+        {
+            unsigned columnIndex = k % m;
+            for ( unsigned i = 0; i < m; ++i )
+            {
+                column[i] = 1 + ( ( i + k ) % 3 );
+                if ( i == columnIndex )
+                    column[i] += 10;
+                B[i * m + columnIndex] = column[i];
+            }
+
+            // The oracle should reflect the new basis, in case of a refactorization
+            oracle->storeBasis( m, B );
+            TS_ASSERT_THROWS_NOTHING( basis.updateToAdjacentBasis( columnIndex, NULL, column ) );
+
+            // Check that B * x = y for x = ( 1, ..., 1 )
+            for ( unsigned i = 0; i < m; ++i )
+            {
+                y[i] = 0;
+                for ( unsigned j = 0; j < m; ++j )
+                    y[i] += B[i * m + j];
+            }
+
+            TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( y, x ) );
+            for ( unsigned i = 0; i < m; ++i )
+                TS_ASSERT( FloatUtils::areEqual( x[i], 1 ) );
+        }
+
+        TS_ASSERT( statistics.getNumBasisRefactorizations() > 1U );
+    }
 };
 
 //
@@ -334,6 +334,132 @@ public:
             TS_ASSERT_THROWS_NOTHING( delete ge );
         }
     }
+
+    unsigned countNonZeros( const SparseUnsortedArrays *matrix, unsigned m )
+    {
+        unsigned result = 0;
+        for ( unsigned i = 0; i < m; ++i )
+            result += matrix->getRow( i )->getNnz();
+        return result;
+    }
+
+    void test_permuted_triangular_with_nucleus()
+    {
+        /*
+          A permuted lower-triangular matrix, similar to the bases of
+          layered networks: it is factorized by singleton pivots alone,
+          with no fill-in.
+        */
+        {
+            double A[] =
+            {
+                0, 0, 3, 0, 0,
+                1, 0, 2, 0, 0,
+                0, 0, 1, 0, 4,
+                0, 5, 0, 1, 0,
+                2, 0, 0, -1, 0,
+            };
+
+            SparseLUFactors lu5( 5 );
+            SparseColumnsOfBasis sparseCols( 5 );
+            basisIntoSparseColumns( A, 5, sparseCols );
+
+            SparseGaussianEliminator *ge = NULL;
+
+            TS_ASSERT( ge = new SparseGaussianEliminator( 5 ) );
+            TS_ASSERT_THROWS_NOTHING( ge->run( &sparseCols, &lu5 ) );
+
+            double result[25];
+            computeMatrixFromFactorization( &lu5, result );
+
+            for ( unsigned i = 0; i < 25; ++i )
+                TS_ASSERT( FloatUtils::areEqual( A[i], result[i] ) );
+
+            TS_ASSERT_EQUALS( countNonZeros( lu5._F, 5 ) + countNonZeros( lu5._V, 5 ), 9U );
+
+            TS_ASSERT_THROWS_NOTHING( delete ge );
+        }
+
+        /*
+          A triangular matrix with a dense 3x3 nucleus that requires the
+          Markowitz search.
+        */
+        {
+            double A[] =
+            {
+                1, 0, 0, 0, 0, 0,
+                2, 4, 1, 3, 0, 0,
+                0, 1, 2, 2, 0, 0,
+                0, 3, 1, 1, 0, 0,
+                1, 0, 0, 5, 2, 0,
+                0, 1, 0, 0, 1, 3,
+            };
+
+            SparseLUFactors lu6( 6 );
+            SparseColumnsOfBasis sparseCols( 6 );
+            basisIntoSparseColumns( A, 6, sparseCols );
+
+            SparseGaussianEliminator *ge = NULL;
+
+            TS_ASSERT( ge = new SparseGaussianEliminator( 6 ) );
+            TS_ASSERT_THROWS_NOTHING( ge->run( &sparseCols, &lu6 ) );
+
+            double result[36];
+            computeMatrixFromFactorization( &lu6, result );
+
+            for ( unsigned i = 0; i < 36; ++i )
+                TS_ASSERT( FloatUtils::areEqual( A[i], result[i] ) );
+
+            double At[36];
+            transposeMatrix( A, At, 6 );
+            computeTransposedMatrixFromFactorization( &lu6, result );
+
+            for ( unsigned i = 0; i < 36; ++i )
+                TS_ASSERT( FloatUtils::areEqual( At[i], result[i] ) );
+
+            TS_ASSERT_THROWS_NOTHING( delete ge );
+        }
+    }
+
+    void test_markowitz_avoids_fill_in()
+    {
+        /*
+          An arrowhead matrix: pivoting on the top-left element first
+          would fill the entire matrix, whereas the Markowitz rule picks
+          the diagonal elements first and causes no fill-in.
+        */
+        double A[] =
+        {
+            4, 1, 1, 1, 1, 1,
+            1, 4, 0, 0, 0, 0,
+            1, 0, 4, 0, 0, 0,
+            1, 0, 0, 4, 0, 0,
+            1, 0, 0, 0, 4, 0,
+            1, 0, 0, 0, 0, 4,
+        };
+
+        SparseLUFactors lu6( 6 );
+        SparseColumnsOfBasis sparseCols( 6 );
+        basisIntoSparseColumns( A, 6, sparseCols );
+
+        Statistics statistics;
+
+        SparseGaussianEliminator *ge = NULL;
+
+        TS_ASSERT( ge = new SparseGaussianEliminator( 6 ) );
+        ge->setStatistics( &statistics );
+        TS_ASSERT_THROWS_NOTHING( ge->run( &sparseCols, &lu6 ) );
+
+        double result[36];
+        computeMatrixFromFactorization( &lu6, result );
+
+        for ( unsigned i = 0; i < 36; ++i )
+            TS_ASSERT( FloatUtils::areEqual( A[i], result[i] ) );
+
+        TS_ASSERT_EQUALS( countNonZeros( lu6._F, 6 ) + countNonZeros( lu6._V, 6 ), 16U );
+
+        TS_ASSERT_THROWS_NOTHING( delete ge );
+    }
 };
 
 //
@@ -354,6 +354,78 @@ public:
             TS_ASSERT( FloatUtils::areEqual( x2[i], expected2[i] ) );
     }
 
+    void checkSparseTransformation( unsigned type, const double *y, const unsigned *yIndices, unsigned yNnz )
+    {
+        double expected[4];
+        double x[] = { 0, 0, 0, 0 };
+        unsigned xIndices[4];
+        unsigned xNnz = 0;
+
+        switch ( type )
+        {
+        case 0:
+            lu->fForwardTransformation( y, expected );
+            TS_ASSERT_THROWS_NOTHING( lu->fForwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz ) );
+            break;
+
+        case 1:
+            lu->fBackwardTransformation( y, expected );
+            TS_ASSERT_THROWS_NOTHING( lu->fBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz ) );
+            break;
+
+        case 2:
+            lu->vForwardTransformation( y, expected );
+            TS_ASSERT_THROWS_NOTHING( lu->vForwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz ) );
+            break;
+
+        case 3:
+            lu->vBackwardTransformation( y, expected );
+            TS_ASSERT_THROWS_NOTHING( lu->vBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz ) );
+            break;
+        }
+
+        for ( unsigned i = 0; i < 4; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
+
+        // Every non-zero entry of the result is listed
+        TS_ASSERT( xNnz <= 4 );
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            if ( FloatUtils::isZero( expected[i] ) )
+                continue;
+
+            bool listed = false;
+            for ( unsigned j = 0; j < xNnz; ++j )
+                if ( xIndices[j] == i )
+                    listed = true;
+            TS_ASSERT( listed );
+        }
+    }
+
+    void test_hyper_sparse_transformations()
+    {
+        for ( unsigned type = 0; type < 4; ++type )
+        {
+            // Unit vectors
+            for ( unsigned i = 0; i < 4; ++i )
+            {
+                double y[] = { 0, 0, 0, 0 };
+                y[i] = 1;
+                checkSparseTransformation( type, y, &i, 1 );
+            }
+
+            // Two non-zero entries
+            double y[] = { 0, -3, 0, 2 };
+            unsigned yIndices[] = { 3, 1 };
+            checkSparseTransformation( type, y, yIndices, 2 );
+
+            // All entries
+            double yDense[] = { 1, 2, 3, 4 };
+            unsigned yDenseIndices[] = { 0, 1, 2, 3 };
+            checkSparseTransformation( type, yDense, yDenseIndices, 4 );
+        }
+    }
+
     void test_invert_basis()
     {
         /*
@@ -151,6 +151,32 @@ public:
             TS_ASSERT( FloatUtils::areEqual( expected2[i], dense[i] ) );
     }
 
+    void test_increment_and_decrement_size()
+    {
+        SparseUnsortedList v1( 3 );
+
+        v1.set( 0, 4 );
+        v1.set( 2, 3 );
+
+        v1.incrementSize();
+        v1.set( 3, 5 );
+        TS_ASSERT_EQUALS( v1.getSize(), 4U );
+        TS_ASSERT_EQUALS( v1.getNnz(), 3U );
+
+        v1.set( 3, 0 );
+        TS_ASSERT_THROWS_NOTHING( v1.decrementSize() );
+        TS_ASSERT_EQUALS( v1.getSize(), 3U );
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+
+        double dense[3];
+        TS_ASSERT_THROWS_NOTHING( v1.toDense( dense ) );
+
+        double expected[3] = { 4, 0, 3 };
+
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT( FloatUtils::areEqual( expected[i], dense[i] ) );
+    }
+
     void test_merge_entries()
     {
         SparseUnsortedList v1( 5 );
@@ -173,6 +199,42 @@ public:
         TS_ASSERT_THROWS_NOTHING( v1.mergeEntries( 2, 4 ) );
 
         TS_ASSERT_EQUALS( v1.getNnz(), 0U );
+
+        // The source entry follows the target entry, and they cancel out
+        v1.set( 1, 2 );
+        v1.set( 3, 5 );
+        v1.set( 4, -5 );
+
+        TS_ASSERT_THROWS_NOTHING( v1.mergeEntries( 4, 3 ) );
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 1U );
+        TS_ASSERT_EQUALS( v1.get( 1 ), 2 );
+        TS_ASSERT_EQUALS( v1.get( 3 ), 0 );
+    }
+
+    void test_erase_while_iterating()
+    {
+        double dense[6] = {
+            1, 0, 2, 3, 0, 4
+        };
+
+        SparseUnsortedList v1( dense, 6 );
+
+        // Erase the odd values
+        auto it = v1.begin();
+        while ( it != v1.end() )
+        {
+            if ( ( (int)it->_value ) % 2 == 1 )
+                it = v1.erase( it );
+            else
+                ++it;
+        }
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+        TS_ASSERT_EQUALS( v1.get( 2 ), 2 );
+        TS_ASSERT_EQUALS( v1.get( 5 ), 4 );
+        TS_ASSERT_EQUALS( v1.get( 0 ), 0 );
+        TS_ASSERT_EQUALS( v1.get( 3 ), 0 );
     }
 };
 
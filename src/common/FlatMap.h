@@ -0,0 +1,217 @@
+/*********************                                                        */
+/*! \file FlatMap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __FlatMap_h__
+#define __FlatMap_h__
+
+#include "CommonError.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+  A map with the same interface as Map, which stores its entries
+  contiguously in insertion order. It is intended for the bounds of
+  the variables that participate in a piecewise linear constraint.
+  Most constraints have a handful of variables, and for these a scan
+  over a small array is much cheaper than walking a tree. Once a map
+  grows past INDEX_THRESHOLD entries (e.g., a large max constraint),
+  it also keeps a hash index from each key to its slot, so that
+  lookups remain constant time.
+*/
+template<class Key, class Value>
+class FlatMap
+{
+    typedef std::vector<std::pair<Key, Value>> Super;
+public:
+    typedef typename Super::iterator iterator;
+    typedef typename Super::const_iterator const_iterator;
+
+    Value &operator[]( const Key &key )
+    {
+        iterator it = find( key );
+        if ( it != _container.end() )
+            return it->second;
+
+        _container.push_back( std::make_pair( key, Value() ) );
+        indexLastEntry();
+        return _container.back().second;
+    }
+
+    const Value &operator[]( const Key &key ) const
+    {
+        return at( key );
+    }
+
+    const Value &at( const Key &key ) const
+    {
+        const_iterator it = find( key );
+        if ( it == _container.end() )
+            throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        return it->second;
+    }
+
+    Value &at( const Key &key )
+    {
+        iterator it = find( key );
+        if ( it == _container.end() )
+            throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        return it->second;
+    }
+
+    Value get( const Key &key ) const
+    {
+        return at( key );
+    }
+
+    bool empty() const
+    {
+        return _container.empty();
+    }
+
+    unsigned size() const
+    {
+        return _container.size();
+    }
+
+    void insert( const Key &key, Value value )
+    {
+        if ( !exists( key ) )
+        {
+            _container.push_back( std::make_pair( key, value ) );
+            indexLastEntry();
+        }
+    }
+
+    bool exists( const Key &key ) const
+    {
+        return find( key ) != _container.end();
+    }
+
+    void erase( const Key &key )
+    {
+        iterator it = find( key );
+        if ( it == _container.end() )
+            throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        erase( it );
+    }
+
+    iterator erase( iterator it )
+    {
+        // Erasing shifts the later entries, so their slots change
+        unsigned slot = it - _container.begin();
+        _container.erase( it );
+        if ( !_index.empty() )
+            buildIndex();
+        return _container.begin() + slot;
+    }
+
+    iterator begin()
+    {
+        return _container.begin();
+    }
+
+    iterator end()
+    {
+        return _container.end();
+    }
+
+    const_iterator begin() const
+    {
+        return _container.begin();
+    }
+
+    const_iterator end() const
+    {
+        return _container.end();
+    }
+
+    void clear()
+    {
+        _container.clear();
+        _index.clear();
+    }
+
+    static const unsigned INDEX_THRESHOLD = 16;
+
+private:
+    Super _container;
+
+    /*
+      The slot of each key, kept only once the map has more than
+      INDEX_THRESHOLD entries; empty otherwise.
+    */
+    std::unordered_map<Key, unsigned> _index;
+
+    void buildIndex()
+    {
+        _index.clear();
+        if ( _container.size() <= INDEX_THRESHOLD )
+            return;
+
+        for ( unsigned i = 0; i < _container.size(); ++i )
+            _index[_container[i].first] = i;
+    }
+
+    void indexLastEntry()
+    {
+        if ( !_index.empty() )
+            _index[_container.back().first] = _container.size() - 1;
+        else if ( _container.size() > INDEX_THRESHOLD )
+            buildIndex();
+    }
+
+    iterator find( const Key &key )
+    {
+        if ( !_index.empty() )
+        {
+            auto slot = _index.find( key );
+            return ( slot == _index.end() ) ? _container.end() : _container.begin() + slot->second;
+        }
+
+        iterator it = _container.begin();
+        while ( it != _container.end() && !( it->first == key ) )
+            ++it;
+        return it;
+    }
+
+    const_iterator find( const Key &key ) const
+    {
+        if ( !_index.empty() )
+        {
+            auto slot = _index.find( key );
+            return ( slot == _index.end() ) ? _container.end() : _container.begin() + slot->second;
+        }
+
+        const_iterator it = _container.begin();
+        while ( it != _container.end() && !( it->first == key ) )
+            ++it;
+        return it;
+    }
+};
+
+#endif // __FlatMap_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
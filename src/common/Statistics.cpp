@@ -28,6 +28,8 @@ Statistics::Statistics()
     , _numPrecisionRestorations( 0 )
     , _numSimplexSteps( 0 )
     , _timeSimplexStepsMicro( 0 )
+    , _numDualSimplexSteps( 0 )
+    , _timeDualSimplexStepsMicro( 0 )
     , _timeMainLoopMicro( 0 )
     , _timeConstraintFixingStepsMicro( 0 )
     , _numConstraintFixingSteps( 0 )
@@ -49,6 +51,8 @@ Statistics::Statistics()
     , _numTableauBoundHopping( 0 )
     , _numTightenedBounds( 0 )
     , _numTighteningsFromSymbolicBoundTightening( 0 )
+    , _numTighteningsFromBackSubstitutionBoundTightening( 0 )
+    , _numTighteningsFromLpBoundTightening( 0 )
     , _numRowsExaminedByRowTightener( 0 )
     , _numTighteningsFromRows( 0 )
     , _numBoundTighteningsOnExplicitBasis( 0 )
@@ -58,6 +62,9 @@ Statistics::Statistics()
     , _numBoundTighteningsOnConstraintMatrix( 0 )
     , _numTighteningsFromConstraintMatrix( 0 )
     , _numBasisRefactorizations( 0 )
+    , _numBasisExtensions( 0 )
+    , _totalBasisNonZeros( 0 )
+    , _totalBasisFactorsNonZeros( 0 )
     , _pseNumIterations( 0 )
     , _pseNumResetReferenceSpace( 0 )
     , _ppNumEliminatedVars( 0 )
@@ -66,6 +73,8 @@ Statistics::Statistics()
     , _ppNumEquationsRemoved( 0 )
     , _totalTimePerformingValidCaseSplitsMicro( 0 )
     , _totalTimePerformingSymbolicBoundTightening( 0 )
+    , _totalTimePerformingBackSubstitutionBoundTightening( 0 )
+    , _totalTimePerformingLpBoundTightening( 0 )
     , _totalTimeHandlingStatisticsMicro( 0 )
     , _totalNumberOfValidCaseSplits( 0 )
     , _totalTimeExplicitBasisBoundTighteningMicro( 0 )
@@ -106,7 +115,14 @@ void Statistics::print()
     printf( "\t\tPreprocessing time: %llu milli (%02u:%02u:%02u)\n",
             _preprocessingTimeMicro / 1000, hours, minutes - ( hours * 60 ), seconds - ( minutes * 60 ) );
 
-    unsigned long long totalUnknown = totalElapsed - _timeMainLoopMicro - _preprocessingTimeMicro;
+    seconds = _totalTimePerformingLpBoundTightening / 1000000;
+    minutes = seconds / 60;
+    hours = minutes / 60;
+    printf( "\t\tLP bound tightening time: %llu milli (%02u:%02u:%02u)\n",
+            _totalTimePerformingLpBoundTightening / 1000, hours, minutes - ( hours * 60 ), seconds - ( minutes * 60 ) );
+
+    unsigned long long totalUnknown = totalElapsed - _timeMainLoopMicro - _preprocessingTimeMicro -
+        _totalTimePerformingLpBoundTightening;
 
     seconds = totalUnknown / 1000000;
     minutes = seconds / 60;
@@ -119,6 +135,10 @@ void Statistics::print()
             , printPercents( _timeSimplexStepsMicro, _timeMainLoopMicro )
             , _timeSimplexStepsMicro / 1000
             );
+    printf( "\t\t[%.2lf%%] Dual simplex steps: %llu milli\n"
+            , printPercents( _timeDualSimplexStepsMicro, _timeMainLoopMicro )
+            , _timeDualSimplexStepsMicro / 1000
+            );
     printf( "\t\t[%.2lf%%] Explicit-basis bound tightening: %llu milli\n"
             , printPercents( _totalTimeExplicitBasisBoundTighteningMicro, _timeMainLoopMicro )
             , _totalTimeExplicitBasisBoundTighteningMicro / 1000
@@ -164,8 +184,14 @@ void Statistics::print()
             , _totalTimePerformingSymbolicBoundTightening / 1000
             );
 
+    printf( "\t\t[%.2lf%%] Back-Substitution Bound Tightening: %llu milli\n"
+            , printPercents( _totalTimePerformingBackSubstitutionBoundTightening, _timeMainLoopMicro )
+            , _totalTimePerformingBackSubstitutionBoundTightening / 1000
+            );
+
     unsigned long long total =
         _timeSimplexStepsMicro +
+        _timeDualSimplexStepsMicro +
         _timeConstraintFixingStepsMicro +
         _totalTimePerformingValidCaseSplitsMicro +
         _totalTimeHandlingStatisticsMicro +
@@ -175,7 +201,8 @@ void Statistics::print()
         _totalTimeConstraintMatrixBoundTighteningMicro +
         _totalTimeApplyingStoredTighteningsMicro +
         _totalTimeSmtCoreMicro +
-        _totalTimePerformingSymbolicBoundTightening;
+        _totalTimePerformingSymbolicBoundTightening +
+        _totalTimePerformingBackSubstitutionBoundTightening;
 
     printf( "\t\t[%.2lf%%] Unaccounted for: %llu milli\n"
             , printPercents( _timeMainLoopMicro - total, _timeMainLoopMicro )
@@ -195,12 +222,16 @@ void Statistics::print()
     printf( "\t--- Engine Statistics ---\n" );
     printf( "\tNumber of main loop iterations: %llu\n"
             "\t\t%llu iterations were simplex steps. Total time: %llu milli. Average: %.2lf milli.\n"
+            "\t\t%llu iterations were dual simplex steps. Total time: %llu milli. Average: %.2lf milli.\n"
             "\t\t%llu iterations were constraint-fixing steps. "
             "Total time: %llu milli. Average: %.2lf milli\n"
             , _numMainLoopIterations
             , _numSimplexSteps
             , _timeSimplexStepsMicro / 1000
             , printAverage( _timeSimplexStepsMicro / 1000, _numSimplexSteps )
+            , _numDualSimplexSteps
+            , _timeDualSimplexStepsMicro / 1000
+            , printAverage( _timeDualSimplexStepsMicro / 1000, _numDualSimplexSteps )
             , _numConstraintFixingSteps
             , _timeConstraintFixingStepsMicro / 1000
             , printAverage( _timeConstraintFixingStepsMicro / 1000, _numConstraintFixingSteps )
@@ -277,6 +308,12 @@ void Statistics::print()
     printf( "\t--- Basis Factorization statistics ---\n" );
     printf( "\tNumber of basis refactorizations: %llu\n",
             _numBasisRefactorizations );
+    printf( "\tNumber of basis extensions by new rows: %llu\n",
+            _numBasisExtensions );
+    printf( "\tNon-zeros in factorized bases: %llu. In their LU factors: %llu (fill ratio: %.2lf)\n"
+            , _totalBasisNonZeros
+            , _totalBasisFactorsNonZeros
+            , printAverage( _totalBasisFactorsNonZeros, _totalBasisNonZeros ) );
 
     printf( "\t--- Projected Steepest Edge Statistics ---\n" );
     printf( "\tNumber of iterations: %llu.\n", _pseNumIterations );
@@ -287,6 +324,12 @@ void Statistics::print()
 
     printf( "\t--- SBT ---\n" );
     printf( "\tNumber of tightened bounds: %llu\n", _numTighteningsFromSymbolicBoundTightening );
+
+    printf( "\t--- Back-Substitution ---\n" );
+    printf( "\tNumber of tightened bounds: %llu\n", _numTighteningsFromBackSubstitutionBoundTightening );
+
+    printf( "\t--- LP Bound Tightening ---\n" );
+    printf( "\tNumber of tightened bounds: %llu\n", _numTighteningsFromLpBoundTightening );
 }
 
 double Statistics::printPercents( unsigned long long part, unsigned long long total ) const
@@ -345,6 +388,16 @@ void Statistics::addTimeSimplexSteps( unsigned long long time )
     _timeSimplexStepsMicro += time;
 }
 
+void Statistics::incNumDualSimplexSteps()
+{
+    ++_numDualSimplexSteps;
+}
+
+void Statistics::addTimeDualSimplexSteps( unsigned long long time )
+{
+    _timeDualSimplexStepsMicro += time;
+}
+
 void Statistics::addTimeMainLoop( unsigned long long time )
 {
     _timeMainLoopMicro += time;
@@ -502,6 +555,17 @@ void Statistics::incNumBasisRefactorizations()
     ++_numBasisRefactorizations;
 }
 
+void Statistics::incNumBasisExtensions()
+{
+    ++_numBasisExtensions;
+}
+
+void Statistics::addBasisFactorizationNonZeros( unsigned long long basisNnz, unsigned long long factorsNnz )
+{
+    _totalBasisNonZeros += basisNnz;
+    _totalBasisFactorsNonZeros += factorsNnz;
+}
+
 void Statistics::pseIncNumIterations()
 {
     ++_pseNumIterations;
@@ -560,6 +624,16 @@ void Statistics::addTimeForSymbolicBoundTightening( unsigned long long time )
     _totalTimePerformingSymbolicBoundTightening += time;
 }
 
+void Statistics::addTimeForBackSubstitutionBoundTightening( unsigned long long time )
+{
+    _totalTimePerformingBackSubstitutionBoundTightening += time;
+}
+
+void Statistics::addTimeForLpBoundTightening( unsigned long long time )
+{
+    _totalTimePerformingLpBoundTightening += time;
+}
+
 void Statistics::addTimeForStatistics( unsigned long long time )
 {
     _totalTimeHandlingStatisticsMicro += time;
@@ -615,6 +689,11 @@ unsigned long long Statistics::getNumTableauPivots() const
     return _numTableauPivots;
 }
 
+double Statistics::getCurrentDegradation() const
+{
+    return _currentDegradation;
+}
+
 double Statistics::getMaxDegradation() const
 {
     return _maxDegradation;
@@ -630,11 +709,21 @@ unsigned long long Statistics::getTimeSimplexStepsMicro() const
     return _timeSimplexStepsMicro;
 }
 
+unsigned long long Statistics::getNumDualSimplexSteps() const
+{
+    return _numDualSimplexSteps;
+}
+
 unsigned long long Statistics::getNumConstraintFixingSteps() const
 {
     return _numConstraintFixingSteps;
 }
 
+unsigned long long Statistics::getNumBasisRefactorizations() const
+{
+    return _numBasisRefactorizations;
+}
+
 unsigned long long Statistics::getNumSimplexPivotSelectionsIgnoredForStability() const
 {
     return _numSimplexPivotSelectionsIgnoredForStability;
@@ -649,6 +738,7 @@ unsigned long long Statistics::getTotalTime() const
 {
     unsigned long long total =
         _timeSimplexStepsMicro +
+        _timeDualSimplexStepsMicro +
         _timeConstraintFixingStepsMicro +
         _totalTimePerformingValidCaseSplitsMicro +
         _totalTimeHandlingStatisticsMicro +
@@ -684,6 +774,16 @@ void Statistics::incNumTighteningsFromSymbolicBoundTightening( unsigned incremen
     _numTighteningsFromSymbolicBoundTightening += increment;
 }
 
+void Statistics::incNumTighteningsFromBackSubstitutionBoundTightening( unsigned increment )
+{
+    _numTighteningsFromBackSubstitutionBoundTightening += increment;
+}
+
+void Statistics::incNumTighteningsFromLpBoundTightening( unsigned increment )
+{
+    _numTighteningsFromLpBoundTightening += increment;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
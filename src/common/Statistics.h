@@ -46,6 +46,8 @@ public:
     void incNumSimplexSteps();
     void addTimeMainLoop( unsigned long long time );
     void addTimeSimplexSteps( unsigned long long time );
+    void incNumDualSimplexSteps();
+    void addTimeDualSimplexSteps( unsigned long long time );
     void addTimeConstraintFixingSteps( unsigned long long time );
     void incNumConstraintFixingSteps();
     unsigned long long getNumMainLoopIterations() const;
@@ -56,6 +58,8 @@ public:
     void setCurrentDegradation( double degradation );
     void addTimeForValidCaseSplit( unsigned long long time );
     void addTimeForSymbolicBoundTightening( unsigned long long time );
+    void addTimeForBackSubstitutionBoundTightening( unsigned long long time );
+    void addTimeForLpBoundTightening( unsigned long long time );
     void addTimeForStatistics( unsigned long long time );
     void addTimeForExplicitBasisBoundTightening( unsigned long long time );
     void addTimeForConstraintMatrixBoundTightening( unsigned long long time );
@@ -63,10 +67,13 @@ public:
     void addTimeForPrecisionRestoration( unsigned long long time );
     void addTimeForApplyingStoredTightenings( unsigned long long time );
     void incNumPrecisionRestorations();
+    double getCurrentDegradation() const;
     double getMaxDegradation() const;
     unsigned getNumPrecisionRestorations() const;
     unsigned long long getTimeSimplexStepsMicro() const;
+    unsigned long long getNumDualSimplexSteps() const;
     unsigned long long getNumConstraintFixingSteps() const;
+    unsigned long long getNumBasisRefactorizations() const;
 
     /*
       Tableau related statistics.
@@ -124,11 +131,15 @@ public:
     void incNumBoundsProposedByPlConstraints();
 
     void incNumTighteningsFromSymbolicBoundTightening( unsigned increment );
+    void incNumTighteningsFromBackSubstitutionBoundTightening( unsigned increment );
+    void incNumTighteningsFromLpBoundTightening( unsigned increment );
 
     /*
       Basis factorization statistics
     */
     void incNumBasisRefactorizations();
+    void incNumBasisExtensions();
+    void addBasisFactorizationNonZeros( unsigned long long basisNnz, unsigned long long factorsNnz );
 
     /*
       Projected Steepest Edge related statistics.
@@ -177,6 +188,11 @@ private:
     // Total time spent on performing simplex steps, in microseconds
     unsigned long long _timeSimplexStepsMicro;
 
+    // Number of dual simplex steps performed when re-solving after
+    // splits, and the total time spent on them, in microseconds
+    unsigned long long _numDualSimplexSteps;
+    unsigned long long _timeDualSimplexStepsMicro;
+
     // Total time spent in the main loop, in microseconds
     unsigned long long _timeMainLoopMicro;
 
@@ -243,6 +259,12 @@ private:
     // The number of bounds tightened via symbolic bound tightening
     unsigned long long _numTighteningsFromSymbolicBoundTightening;
 
+    // The number of bounds tightened via back-substitution in the network-level reasoner
+    unsigned long long _numTighteningsFromBackSubstitutionBoundTightening;
+
+    // The number of bounds tightened by solving LP relaxations before the search
+    unsigned long long _numTighteningsFromLpBoundTightening;
+
     // Number of pivot rows examined by the row tightener, and consequent tightenings
     // proposed.
     unsigned long long _numRowsExaminedByRowTightener;
@@ -267,6 +289,15 @@ private:
     // Basis factorization statistics
     unsigned long long _numBasisRefactorizations;
 
+    // Number of times the basis factorization was extended by a new row,
+    // instead of being refactorized
+    unsigned long long _numBasisExtensions;
+
+    // Total number of non-zero entries in the bases that were factorized,
+    // and in their LU factors. The ratio between the two measures fill-in.
+    unsigned long long _totalBasisNonZeros;
+    unsigned long long _totalBasisFactorsNonZeros;
+
     // Projected steepest edge statistics
     unsigned long long _pseNumIterations;
     unsigned long long _pseNumResetReferenceSpace;
@@ -282,6 +313,12 @@ private:
 
     unsigned long long _totalTimePerformingSymbolicBoundTightening;
 
+    unsigned long long _totalTimePerformingBackSubstitutionBoundTightening;
+
+    // Total amount of time spent tightening bounds with LP relaxations, before
+    // the main loop
+    unsigned long long _totalTimePerformingLpBoundTightening;
+
     // Total amount of time handling statistics printing
     unsigned long long _totalTimeHandlingStatisticsMicro;
 
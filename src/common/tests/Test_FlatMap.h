@@ -0,0 +1,164 @@
+/*********************                                                        */
+/*! \file Test_FlatMap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief [[ Add one-line brief description here ]]
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FlatMap.h"
+#include "MockErrno.h"
+
+class FlatMapTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    void test_brackets_and_exists()
+    {
+        FlatMap<unsigned, double> map;
+
+        TS_ASSERT( map.empty() );
+        TS_ASSERT( !map.exists( 3 ) );
+
+        map[3] = 1.5;
+        map[1] = -2;
+
+        TS_ASSERT_EQUALS( map.size(), 2U );
+        TS_ASSERT( map.exists( 3 ) );
+        TS_ASSERT( map.exists( 1 ) );
+        TS_ASSERT( !map.exists( 2 ) );
+        TS_ASSERT_EQUALS( map[3], 1.5 );
+        TS_ASSERT_EQUALS( map.get( 1 ), -2 );
+
+        // Overwriting does not add an entry
+        map[3] = 4;
+        TS_ASSERT_EQUALS( map.size(), 2U );
+        TS_ASSERT_EQUALS( map[3], 4 );
+
+        const FlatMap<unsigned, double> &constMap = map;
+        TS_ASSERT_EQUALS( constMap[1], -2 );
+        TS_ASSERT_THROWS_EQUALS( constMap[7],
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+    }
+
+    void test_erase_and_copy()
+    {
+        FlatMap<unsigned, double> map;
+
+        map[1] = 1;
+        map[2] = 2;
+        map[3] = 3;
+
+        FlatMap<unsigned, double> copy = map;
+
+        TS_ASSERT_THROWS_NOTHING( map.erase( 2 ) );
+        TS_ASSERT( !map.exists( 2 ) );
+        TS_ASSERT_EQUALS( map.size(), 2U );
+        TS_ASSERT_EQUALS( map[3], 3 );
+
+        TS_ASSERT_THROWS_EQUALS( map.erase( 2 ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        // The copy is not affected
+        TS_ASSERT( copy.exists( 2 ) );
+        TS_ASSERT_EQUALS( copy.size(), 3U );
+
+        copy.clear();
+        TS_ASSERT( copy.empty() );
+    }
+
+    void test_iteration()
+    {
+        FlatMap<unsigned, double> map;
+
+        map.insert( 5, 1 );
+        map.insert( 2, 3 );
+        map.insert( 5, 7 );
+
+        TS_ASSERT_EQUALS( map.size(), 2U );
+
+        double sum = 0;
+        for ( const auto &pair : map )
+            sum += pair.first * pair.second;
+
+        TS_ASSERT_EQUALS( sum, 5 * 1 + 2 * 3 );
+    }
+
+    void test_large_map_is_indexed()
+    {
+        FlatMap<unsigned, double> map;
+
+        unsigned size = 3 * FlatMap<unsigned, double>::INDEX_THRESHOLD;
+        for ( unsigned i = 0; i < size; ++i )
+            map[10 * i] = i;
+
+        TS_ASSERT_EQUALS( map.size(), size );
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            TS_ASSERT( map.exists( 10 * i ) );
+            TS_ASSERT( !map.exists( 10 * i + 1 ) );
+            TS_ASSERT_EQUALS( map.get( 10 * i ), i );
+        }
+
+        // Erasing shifts the later entries
+        TS_ASSERT_THROWS_NOTHING( map.erase( 0 ) );
+        TS_ASSERT_THROWS_NOTHING( map.erase( 100 ) );
+        TS_ASSERT_EQUALS( map.size(), size - 2 );
+        TS_ASSERT( !map.exists( 0 ) );
+        TS_ASSERT( !map.exists( 100 ) );
+        for ( unsigned i = 1; i < size; ++i )
+        {
+            if ( i != 10 )
+                TS_ASSERT_EQUALS( map[10 * i], i );
+        }
+
+        map.insert( 100, 7 );
+        TS_ASSERT_EQUALS( map.get( 100 ), 7 );
+
+        // Insertion order is kept
+        auto it = map.begin();
+        TS_ASSERT_EQUALS( it->first, 10U );
+
+        // Shrinking below the threshold falls back to scanning
+        while ( map.size() > 2 )
+            map.erase( map.begin() );
+        TS_ASSERT( map.exists( 100 ) );
+        TS_ASSERT_EQUALS( map.get( 100 ), 7 );
+
+        map.clear();
+        TS_ASSERT( !map.exists( 100 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
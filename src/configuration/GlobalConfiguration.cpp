@@ -39,14 +39,21 @@ const double GlobalConfiguration::BASIC_COSTS_MULTIPLICATIVE_TOLERANCE = 0.001 *
 const double GlobalConfiguration::SPARSE_FORREST_TOMLIN_DIAGONAL_ELEMENT_TOLERANCE = 0.00001;
 const unsigned GlobalConfiguration::DEGRADATION_CHECKING_FREQUENCY = 100;
 const double GlobalConfiguration::DEGRADATION_THRESHOLD = 0.1;
+const double GlobalConfiguration::DEGRADATION_REFACTORIZATION_THRESHOLD = 0.001;
 const double GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD = 0.0001;
 const bool GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS = false;
+const bool GlobalConfiguration::USE_INCREMENTAL_TABLEAU_STATES = true;
 const double GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD = 0.1;
+const unsigned GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT = 4;
 const unsigned GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS = 5;
+const unsigned GlobalConfiguration::PARTIAL_PRICING_BLOCK_SIZE = 1000;
+const unsigned GlobalConfiguration::PARTIAL_PRICING_CANDIDATE_POOL_SIZE = 50;
 const unsigned GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD = 20;
 const unsigned GlobalConfiguration::SPLITTING_HEURISTICS = DivideStrategy::ReLUViolation;
 const unsigned GlobalConfiguration::BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY = 100;
 const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS = 20;
+const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_MIN_ROWS_PER_WORKER = 100;
+const double GlobalConfiguration::ROW_BOUND_TIGHTENER_ACTIVITY_RECOMPUTATION_THRESHOLD = 1000;
 const double GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD = 0.0000000001;
 
 const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
@@ -54,6 +61,10 @@ const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
 const bool GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING = true;
 const bool GlobalConfiguration::USE_LINEAR_CONCRETIZATION = true;
 const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.00000005;
+const bool GlobalConfiguration::USE_BACK_SUBSTITUTION_BOUND_TIGHTENING = true;
+
+const unsigned GlobalConfiguration::LP_TIGHTENING_BISECTION_STEPS = 3;
+const unsigned GlobalConfiguration::LP_TIGHTENING_TIMEOUT_IN_SECONDS = 5;
 
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
@@ -67,6 +78,12 @@ const unsigned GlobalConfiguration::MAX_ITERATIONS_WITHOUT_PROGRESS = 10000;
 const unsigned GlobalConfiguration::PSE_ITERATIONS_BEFORE_RESET = 1000;
 const double GlobalConfiguration::PSE_GAMMA_ERROR_THRESHOLD = 0.001;
 const double GlobalConfiguration::PSE_GAMMA_UPDATE_TOLERANCE = 0.000000001;
+const double GlobalConfiguration::DEVEX_WEIGHT_ERROR_THRESHOLD = 3.0;
+
+const bool GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_SPLITS = false;
+const unsigned GlobalConfiguration::DUAL_SIMPLEX_MAX_STEPS_AFTER_SPLIT = 50;
+const double GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT = 0.0001;
+const double GlobalConfiguration::DUAL_SIMPLEX_INFEASIBILITY_RELATIVE_TOLERANCE = 0.000000001;
 
 const double GlobalConfiguration::RELU_CONSTRAINT_COMPARISON_TOLERANCE = 0.001;
 const double GlobalConfiguration::ABS_CONSTRAINT_COMPARISON_TOLERANCE = 0.001;
@@ -74,24 +91,31 @@ const double GlobalConfiguration::ABS_CONSTRAINT_COMPARISON_TOLERANCE = 0.001;
 const bool GlobalConfiguration::ONLY_AUX_INITIAL_BASIS = false;
 
 const GlobalConfiguration::ExplicitBasisBoundTighteningType GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE =
-    GlobalConfiguration::COMPUTE_INVERTED_BASIS_MATRIX;
+    GlobalConfiguration::COMPUTE_SPARSE_BASIS_ROWS;
 const bool GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION = false;
+const unsigned GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_ROWS = 200;
+const unsigned long long GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_WORK = 200000;
 
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
     GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
+const double GlobalConfiguration::HYPER_SPARSE_DENSITY_THRESHOLD = 0.1;
 
 // Logging
 const bool GlobalConfiguration::DNC_MANAGER_LOGGING = false;
+const bool GlobalConfiguration::PORTFOLIO_MANAGER_LOGGING = false;
 const bool GlobalConfiguration::ENGINE_LOGGING = false;
 const bool GlobalConfiguration::TABLEAU_LOGGING = false;
 const bool GlobalConfiguration::SMT_CORE_LOGGING = false;
 const bool GlobalConfiguration::DANTZIGS_RULE_LOGGING = false;
 const bool GlobalConfiguration::BASIS_FACTORIZATION_LOGGING = false;
 const bool GlobalConfiguration::PROJECTED_STEEPEST_EDGE_LOGGING = false;
+const bool GlobalConfiguration::DEVEX_RULE_LOGGING = false;
+const bool GlobalConfiguration::DUAL_SIMPLEX_LOGGING = false;
 const bool GlobalConfiguration::GAUSSIAN_ELIMINATION_LOGGING = false;
 const bool GlobalConfiguration::QUERY_LOADER_LOGGING = false;
 const bool GlobalConfiguration::SYMBOLIC_BOUND_TIGHTENER_LOGGING = false;
+const bool GlobalConfiguration::LP_BOUND_TIGHTENER_LOGGING = false;
 
 const bool GlobalConfiguration::USE_SMART_FIX = false;
 const bool GlobalConfiguration::USE_LEAST_FIX = false;
@@ -113,13 +137,21 @@ void GlobalConfiguration::print()
     printf( "  BASIC_COSTS_MULTIPLICATIVE_TOLERANCE: %.15lf\n", BASIC_COSTS_MULTIPLICATIVE_TOLERANCE );
     printf( "  DEGRADATION_CHECKING_FREQUENCY: %u\n", DEGRADATION_CHECKING_FREQUENCY );
     printf( "  DEGRADATION_THRESHOLD: %.15lf\n", DEGRADATION_THRESHOLD );
+    printf( "  DEGRADATION_REFACTORIZATION_THRESHOLD: %.15lf\n", DEGRADATION_REFACTORIZATION_THRESHOLD );
     printf( "  ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD: %.15lf\n", ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD );
     printf( "  USE_COLUMN_MERGING_EQUATIONS: %s\n", USE_COLUMN_MERGING_EQUATIONS ? "Yes" : "No" );
+    printf( "  USE_INCREMENTAL_TABLEAU_STATES: %s\n", USE_INCREMENTAL_TABLEAU_STATES ? "Yes" : "No" );
     printf( "  GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD: %.15lf\n", GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD );
+    printf( "  GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT: %u\n", GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT );
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
+    printf( "  PARTIAL_PRICING_BLOCK_SIZE: %u\n", PARTIAL_PRICING_BLOCK_SIZE );
+    printf( "  PARTIAL_PRICING_CANDIDATE_POOL_SIZE: %u\n", PARTIAL_PRICING_CANDIDATE_POOL_SIZE );
     printf( "  CONSTRAINT_VIOLATION_THRESHOLD: %u\n", CONSTRAINT_VIOLATION_THRESHOLD );
     printf( "  BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY );
+    printf( "  ROW_BOUND_TIGHTENER_MIN_ROWS_PER_WORKER: %u\n", ROW_BOUND_TIGHTENER_MIN_ROWS_PER_WORKER );
+    printf( "  ROW_BOUND_TIGHTENER_ACTIVITY_RECOMPUTATION_THRESHOLD: %.15lf\n",
+            ROW_BOUND_TIGHTENER_ACTIVITY_RECOMPUTATION_THRESHOLD );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
     printf( "  USE_HARRIS_RATIO_TEST: %s\n", USE_HARRIS_RATIO_TEST ? "Yes" : "No" );
 
@@ -129,6 +161,11 @@ void GlobalConfiguration::print()
             PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS ? "Yes" : "No" );
     printf( "  PSE_ITERATIONS_BEFORE_RESET: %u\n", PSE_ITERATIONS_BEFORE_RESET );
     printf( "  PSE_GAMMA_ERROR_THRESHOLD: %.15lf\n", PSE_GAMMA_ERROR_THRESHOLD );
+    printf( "  DEVEX_WEIGHT_ERROR_THRESHOLD: %.15lf\n", DEVEX_WEIGHT_ERROR_THRESHOLD );
+    printf( "  USE_DUAL_SIMPLEX_AFTER_SPLITS: %s\n", USE_DUAL_SIMPLEX_AFTER_SPLITS ? "Yes" : "No" );
+    printf( "  DUAL_SIMPLEX_MAX_STEPS_AFTER_SPLIT: %u\n", DUAL_SIMPLEX_MAX_STEPS_AFTER_SPLIT );
+    printf( "  DUAL_STEEPEST_EDGE_MIN_WEIGHT: %.15lf\n", DUAL_STEEPEST_EDGE_MIN_WEIGHT );
+    printf( "  DUAL_SIMPLEX_INFEASIBILITY_RELATIVE_TOLERANCE: %.15lf\n", DUAL_SIMPLEX_INFEASIBILITY_RELATIVE_TOLERANCE );
     printf( "  RELU_CONSTRAINT_COMPARISON_TOLERANCE: %.15lf\n", RELU_CONSTRAINT_COMPARISON_TOLERANCE );
 
     String basisBoundTighteningType;
@@ -142,6 +179,10 @@ void GlobalConfiguration::print()
         basisBoundTighteningType = "Use implicit inverted basis matrix";
         break;
 
+    case COMPUTE_SPARSE_BASIS_ROWS:
+        basisBoundTighteningType = "Compute sparse basis rows";
+        break;
+
     default:
         basisBoundTighteningType = "Unknown";
         break;
@@ -150,6 +191,11 @@ void GlobalConfiguration::print()
     printf( "  EXPLICIT_BASIS_BOUND_TIGHTENING_INVERT_BASIS: %s\n", basisBoundTighteningType.ascii() );
     printf( "  EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION: %s\n",
             EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION ? "Yes" : "No" );
+    printf( "  EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_ROWS: %u\n", EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_ROWS );
+    printf( "  EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_WORK: %llu\n",
+            EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_WORK );
+    printf( "  LP_TIGHTENING_BISECTION_STEPS: %u\n", LP_TIGHTENING_BISECTION_STEPS );
+    printf( "  LP_TIGHTENING_TIMEOUT_IN_SECONDS: %u\n", LP_TIGHTENING_TIMEOUT_IN_SECONDS );
     printf( "  REFACTORIZATION_THRESHOLD: %u\n", REFACTORIZATION_THRESHOLD );
 
     String basisFactorizationType;
@@ -165,6 +211,7 @@ void GlobalConfiguration::print()
         basisFactorizationType = "Unknown";
 
     printf( "  BASIS_FACTORIZATION_TYPE: %s\n", basisFactorizationType.ascii() );
+    printf( "  HYPER_SPARSE_DENSITY_THRESHOLD: %.2lf\n", HYPER_SPARSE_DENSITY_THRESHOLD );
     printf( "****************************\n" );
 }
 
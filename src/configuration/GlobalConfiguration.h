@@ -92,6 +92,10 @@ public:
     // The threshold of degradation above which restoration is required
     static const double DEGRADATION_THRESHOLD;
 
+    // The threshold of degradation above which the basis is refactorized and the basic assignment
+    // is recomputed, as a cheaper alternative to restoration
+    static const double DEGRADATION_REFACTORIZATION_THRESHOLD;
+
     // If a pivot element in a simplex iteration is smaller than this threshold, the engine will attempt
     // to pick another element.
     static const double ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD;
@@ -100,13 +104,30 @@ public:
     // to be merged (instead of a new row added).
     static const bool USE_COLUMN_MERGING_EQUATIONS;
 
+    // If true, stored tableau states do not include a copy of the constraint matrix. Instead,
+    // when a state is restored, any rows that were added to the tableau after it was stored are
+    // removed. This is only applicable when column merging is disabled.
+    static const bool USE_INCREMENTAL_TABLEAU_STATES;
+
     // If a pivot element in a Gaussian elimination iteration is smaller than this threshold times
     // the largest element in the column, the elimination engine will attempt to pick another pivot.
     static const double GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD;
 
+    // The Markowitz pivot search of the sparse Gaussian eliminator stops after scanning this
+    // many rows and columns, once an acceptable pivot has been found.
+    static const unsigned GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT;
+
     // How many potential pivots should the engine inspect (at most) in every simplex iteration?
     static const unsigned MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS;
 
+    // Partial pricing: tableaus with more non-basic variables than this only price a block of
+    // this many non-basics in every simplex iteration, starting where the previous block ended.
+    static const unsigned PARTIAL_PRICING_BLOCK_SIZE;
+
+    // The maximal number of entry candidates kept between simplex iterations when partial
+    // pricing is used. When the pool is full, candidates with small reduced costs are evicted.
+    static const unsigned PARTIAL_PRICING_CANDIDATE_POOL_SIZE;
+
     // The number of violations of a constraints after which the SMT core will initiate a case split
     static const unsigned CONSTRAINT_VIOLATION_THRESHOLD;
 
@@ -119,6 +140,15 @@ public:
     // due to tiny increments in bounds. This number limits the number of iterations it can perform.
     static const unsigned ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS;
 
+    // When bound tightening on the constraint matrix uses several threads, each thread is
+    // given at least this many rows. Smaller passes are not worth the cost of the threads.
+    static const unsigned ROW_BOUND_TIGHTENER_MIN_ROWS_PER_WORKER;
+
+    // Row activities are updated incrementally as bounds change. Removing a term larger than this
+    // (in absolute value) may lose precision to cancellation, so the activities of that row are
+    // recomputed from scratch before the row is next used to derive bounds.
+    static const double ROW_BOUND_TIGHTENER_ACTIVITY_RECOMPUTATION_THRESHOLD;
+
     // If the cost function error exceeds this threshold, it is recomputed
     static const double COST_FUNCTION_ERROR_THRESHOLD;
 
@@ -131,6 +161,28 @@ public:
     // PSE's Gamma function's update tolerance
     static const double PSE_GAMMA_UPDATE_TOLERANCE;
 
+    // Devex resets its reference framework once the approximate weight of an entering variable
+    // exceeds its accurate weight by more than this factor
+    static const double DEVEX_WEIGHT_ERROR_THRESHOLD;
+
+    // Whether the LP of a child node should be re-solved using the dual
+    // simplex method, starting from the basis inherited from its parent.
+    // This is the default of each engine's configuration, and can be
+    // turned on with --dual-simplex.
+    static const bool USE_DUAL_SIMPLEX_AFTER_SPLITS;
+
+    // The maximal number of dual simplex steps performed after a split.
+    // Once exceeded, the engine falls back to the primal simplex method.
+    static const unsigned DUAL_SIMPLEX_MAX_STEPS_AFTER_SPLIT;
+
+    // A lower bound on the dual steepest edge weights, for numerical stability
+    static const double DUAL_STEEPEST_EDGE_MIN_WEIGHT;
+
+    // When a dual simplex pivot row is used to prove infeasibility, the
+    // shortfall must exceed the additive bound tolerance plus this
+    // factor times the magnitude of the row's terms
+    static const double DUAL_SIMPLEX_INFEASIBILITY_RELATIVE_TOLERANCE;
+
     // The tolerance for checking whether f = Relu( b )
     static const double RELU_CONSTRAINT_COMPARISON_TOLERANCE;
 
@@ -149,6 +201,9 @@ public:
         COMPUTE_INVERTED_BASIS_MATRIX = 0,
         // Use the inverted basis matrix without using it, via transformations
         USE_IMPLICIT_INVERTED_BASIS_MATRIX = 1,
+        // Compute a bounded number of rows of the inverted basis matrix with sparse
+        // transformations, starting with the basic variables of unfixed constraints
+        COMPUTE_SPARSE_BASIS_ROWS = 2,
     };
 
     // When doing bound tightening using the explicit basis matrix, should the basis matrix be inverted?
@@ -157,6 +212,12 @@ public:
     // When doing explicit bound tightening, should we repeat until saturation?
     static const bool EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION;
 
+    // The budgets of a single round of explicit bound tightening with sparse basis rows: the
+    // number of rows, and the number of entries of the BTRAN results and rows of A processed.
+    // Rounds resume from where the previous one stopped.
+    static const unsigned EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_ROWS;
+    static const unsigned long long EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_WORK;
+
     /*
       Symbolic bound tightening options
     */
@@ -171,6 +232,20 @@ public:
     // Symbolic tightening rounding constant
     static const double SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
 
+    // Whether the network-level reasoner should tighten bounds by back-substitution
+    static const bool USE_BACK_SUBSTITUTION_BOUND_TIGHTENING;
+
+    /*
+      LP-based bound tightening options
+    */
+
+    // The maximal number of feasibility checks used to bisect each bound. The
+    // first check compares the bound against zero, if that can fix the phase
+    static const unsigned LP_TIGHTENING_BISECTION_STEPS;
+
+    // The timeout for each of the feasibility checks
+    static const unsigned LP_TIGHTENING_TIMEOUT_IN_SECONDS;
+
     /*
       Constraint fixing heuristics
     */
@@ -187,7 +262,9 @@ public:
       Basis factorization options
     */
 
-    // The number of accumualted eta matrices, after which the basis will be refactorized
+    // The number of accumualted eta matrices, after which the basis will be refactorized. The sparse
+    // Forrest-Tomlin factorization may refactorize sooner, once the extra cost of the updates
+    // exceeds that of a refactorization.
 	static const unsigned REFACTORIZATION_THRESHOLD;
 
     // The kind of basis factorization algorithm in use
@@ -199,19 +276,27 @@ public:
     };
     static const BasisFactorizationType BASIS_FACTORIZATION_TYPE;
 
+    // Right hand sides with a larger fraction of non-zero entries are
+    // solved densely, instead of by the hyper-sparse FTRAN/BTRAN
+    static const double HYPER_SPARSE_DENSITY_THRESHOLD;
+
     /*
       Logging options
     */
     static const bool DNC_MANAGER_LOGGING;
+    static const bool PORTFOLIO_MANAGER_LOGGING;
     static const bool ENGINE_LOGGING;
     static const bool TABLEAU_LOGGING;
     static const bool SMT_CORE_LOGGING;
     static const bool DANTZIGS_RULE_LOGGING;
     static const bool BASIS_FACTORIZATION_LOGGING;
     static const bool PROJECTED_STEEPEST_EDGE_LOGGING;
+    static const bool DEVEX_RULE_LOGGING;
+    static const bool DUAL_SIMPLEX_LOGGING;
     static const bool GAUSSIAN_ELIMINATION_LOGGING;
     static const bool QUERY_LOADER_LOGGING;
     static const bool SYMBOLIC_BOUND_TIGHTENER_LOGGING;
+    static const bool LP_BOUND_TIGHTENER_LOGGING;
 };
 
 #endif // __GlobalConfiguration_h__
@@ -45,6 +45,15 @@ void OptionParser::initialize()
         ( "dnc",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::DNC_MODE]) ),
           "Use the divide-and-conquer solving mode" )
+        ( "portfolio",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::PORTFOLIO_MODE]) ),
+          "Run differently configured engines in parallel on the same query" )
+        ( "lp-tightening",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::LP_BOUND_TIGHTENING]) ),
+          "Tighten the bounds of the ReLUs with LP relaxations before solving" )
+        ( "dual-simplex",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::DUAL_SIMPLEX]) ),
+          "Re-solve child nodes with the dual simplex method after splits" )
         ( "input",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::INPUT_FILE_PATH]) ),
           "Neural netowrk file" )
@@ -57,9 +66,15 @@ void OptionParser::initialize()
         ( "summary-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::SUMMARY_FILE]) ),
           "Summary file" )
+        ( "basis-factorization",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::BASIS_FACTORIZATION]) ),
+          "The basis factorization to use: lu, sparse-lu, ft or sparse-ft" )
+        ( "entry-strategy",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::ENTRY_STRATEGY]) ),
+          "The rule for picking the entering variable: pse, devex, dantzig or bland" )
         ( "num-workers",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_WORKERS]) ),
-          "(DNC) Number of workers" )
+          "(DNC/portfolio/bound tightening) Number of workers" )
         ( "initial-divides",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_INITIAL_DIVIDES]) ),
           "(DNC) Number of times to initially bisect the input region" )
@@ -82,6 +97,9 @@ void OptionParser::initialize()
         ( "timeout-factor",
           boost::program_options::value<float>( &((*_floatOptions)[Options::TIMEOUT_FACTOR]) ),
           "(DNC) The timeout factor" )
+        ( "divide-strategy",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::DIVIDE_STRATEGY]) ),
+          "(DNC) How to divide a query: largest-interval, earliest-relu or relu-violation" )
         ( "help",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::HELP]) ),
           "Prints the help message")
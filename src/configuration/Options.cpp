@@ -42,6 +42,9 @@ void Options::initializeDefaultValues()
       Bool options
     */
     _boolOptions[DNC_MODE] = false;
+    _boolOptions[PORTFOLIO_MODE] = false;
+    _boolOptions[LP_BOUND_TIGHTENING] = false;
+    _boolOptions[DUAL_SIMPLEX] = false;
     _boolOptions[PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS] = false;
 
     /*
@@ -67,6 +70,9 @@ void Options::initializeDefaultValues()
     _stringOptions[PROPERTY_FILE_PATH] = "";
     _stringOptions[INPUT_QUERY_FILE_PATH] = "";
     _stringOptions[SUMMARY_FILE] = "";
+    _stringOptions[BASIS_FACTORIZATION] = "";
+    _stringOptions[ENTRY_STRATEGY] = "pse";
+    _stringOptions[DIVIDE_STRATEGY] = "largest-interval";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -34,6 +34,15 @@ public:
         // Should DNC mode be on or off
         DNC_MODE,
 
+        // Should portfolio mode be on or off
+        PORTFOLIO_MODE,
+
+        // Should bounds be tightened with LP relaxations before solving
+        LP_BOUND_TIGHTENING,
+
+        // Should child nodes be re-solved with the dual simplex method
+        DUAL_SIMPLEX,
+
         // Help flag
         HELP,
 
@@ -42,8 +51,10 @@ public:
     };
 
     enum IntOptions {
-        // DNC options
+        // DNC, portfolio and bound tightening options
         NUM_WORKERS = 0,
+
+        // DNC options
         NUM_INITIAL_DIVIDES,
         NUM_ONLINE_DIVIDES,
         INITIAL_TIMEOUT,
@@ -67,6 +78,15 @@ public:
         PROPERTY_FILE_PATH,
         INPUT_QUERY_FILE_PATH,
         SUMMARY_FILE,
+
+        // The basis factorization type, overriding the default
+        BASIS_FACTORIZATION,
+
+        // The rule for picking the entering variable
+        ENTRY_STRATEGY,
+
+        // DNC options
+        DIVIDE_STRATEGY,
     };
 
     /*
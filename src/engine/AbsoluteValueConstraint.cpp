@@ -30,6 +30,26 @@ AbsoluteValueConstraint::AbsoluteValueConstraint( unsigned b, unsigned f )
     setPhaseStatus( PhaseStatus::PHASE_NOT_FIXED );
 }
 
+AbsoluteValueConstraint::AbsoluteValueConstraint( const String &serializedAbs )
+    : _haveEliminatedVariables( false )
+{
+    String constraintType = serializedAbs.substring( 0, 13 );
+    ASSERT( constraintType == String( "absoluteValue" ) );
+
+    // Remove the constraint type in serialized form
+    String serializedValues = serializedAbs.substring( 14, serializedAbs.length() - 14 );
+    List<String> values = serializedValues.tokenize( "," );
+
+    ASSERT( values.size() == 2 );
+
+    auto var = values.begin();
+    _f = atoi( var->ascii() );
+    ++var;
+    _b = atoi( var->ascii() );
+
+    setPhaseStatus( PhaseStatus::PHASE_NOT_FIXED );
+}
+
 PiecewiseLinearConstraint *AbsoluteValueConstraint::duplicateConstraint() const
 {
     AbsoluteValueConstraint *clone = new AbsoluteValueConstraint( _b, _f );
@@ -426,9 +446,24 @@ void AbsoluteValueConstraint::setPhaseStatus( PhaseStatus phaseStatus )
     _phaseStatus = phaseStatus;
 }
 
+unsigned AbsoluteValueConstraint::getB() const
+{
+    return _b;
+}
+
+unsigned AbsoluteValueConstraint::getF() const
+{
+    return _f;
+}
+
+AbsoluteValueConstraint::PhaseStatus AbsoluteValueConstraint::getPhaseStatus() const
+{
+    return _phaseStatus;
+}
+
 bool AbsoluteValueConstraint::supportsSymbolicBoundTightening() const
 {
-    return false;
+    return true;
 }
 
 //
@@ -29,6 +29,7 @@ public:
     };
 
     AbsoluteValueConstraint( unsigned b, unsigned f );
+    AbsoluteValueConstraint( const String &serializedAbs );
 
     /*
       Return a clone of the constraint.
@@ -130,6 +131,17 @@ public:
      */
     String serializeToString() const;
 
+    /*
+      Get the indices of the B and F variables.
+    */
+    unsigned getB() const;
+    unsigned getF() const;
+
+    /*
+      Get the current phase status.
+    */
+    PhaseStatus getPhaseStatus() const;
+
     /*
       Return true if and only if this piecewise linear constraint supports
       symbolic bound tightening.
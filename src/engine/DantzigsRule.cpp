@@ -23,54 +23,48 @@ bool DantzigsRule::select( ITableau &tableau,
                            const List<unsigned> &candidates,
                            const Set<unsigned> &excluded )
 {
-    List<unsigned> remainingCandidates = candidates;
-
-    List<unsigned>::iterator it = remainingCandidates.begin();
-    while ( it != remainingCandidates.end() )
-    {
-        if ( excluded.exists( *it ) )
-            it = remainingCandidates.erase( it );
-        else
-            ++it;
-    }
-
-    if ( remainingCandidates.empty() )
-        return false;
-
     // Dantzig's rule
     const double *costFunction = tableau.getCostFunction();
 
     unsigned n = tableau.getN();
     unsigned m = tableau.getM();
 
-    String cost;
-    for ( unsigned i = 0; i < n - m; ++i )
+    if ( GlobalConfiguration::DANTZIGS_RULE_LOGGING )
     {
-        if ( FloatUtils::isZero( costFunction[i] ) )
-            continue;
+        // The cost function may be longer than a single Stringf can hold
+        String cost = "Cost function: ";
+        for ( unsigned i = 0; i < n - m; ++i )
+        {
+            if ( FloatUtils::isZero( costFunction[i] ) )
+                continue;
 
-        if ( FloatUtils::isPositive( costFunction[i] ) )
-             cost += "+";
-        cost += Stringf( "%.3lf*nb[%u] ", costFunction[i], i );
+            if ( FloatUtils::isPositive( costFunction[i] ) )
+                cost += "+";
+            cost += Stringf( "%.3lf*nb[%u] ", costFunction[i], i );
+        }
+        log( cost );
     }
-    log( Stringf( "Cost function: %s\n", cost.ascii() ) );
 
-    List<unsigned>::const_iterator candidate = remainingCandidates.begin();
-    unsigned maxIndex = *candidate;
-    double maxValue = FloatUtils::abs( costFunction[maxIndex] );
-    ++candidate;
-
-    while ( candidate != remainingCandidates.end() )
+    bool found = false;
+    unsigned maxIndex = 0;
+    double maxValue = 0.0;
+    for ( const auto &candidate : candidates )
     {
-        double contenderValue = FloatUtils::abs( costFunction[*candidate] );
-        if ( FloatUtils::gt( contenderValue, maxValue ) )
+        if ( excluded.exists( candidate ) )
+            continue;
+
+        double contenderValue = FloatUtils::abs( costFunction[candidate] );
+        if ( !found || FloatUtils::gt( contenderValue, maxValue ) )
         {
-            maxIndex = *candidate;
+            found = true;
+            maxIndex = candidate;
             maxValue = contenderValue;
         }
-        ++candidate;
     }
 
+    if ( !found )
+        return false;
+
     log( Stringf( "Largest coefficient: %.3lf. Corresponding variable: %u\n", maxValue, maxIndex ) );
 
     tableau.setEnteringVariableIndex( maxIndex );
@@ -0,0 +1,200 @@
+/*********************                                                        */
+/*! \file DevexRule.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "DevexRule.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "TableauRow.h"
+
+DevexRule::DevexRule()
+    : _referenceFramework( NULL )
+    , _weights( NULL )
+    , _m( 0 )
+    , _n( 0 )
+    , _resetNeeded( false )
+{
+}
+
+DevexRule::~DevexRule()
+{
+    freeIfNeeded();
+}
+
+void DevexRule::freeIfNeeded()
+{
+    if ( _referenceFramework )
+    {
+        delete[] _referenceFramework;
+        _referenceFramework = NULL;
+    }
+
+    if ( _weights )
+    {
+        delete[] _weights;
+        _weights = NULL;
+    }
+}
+
+void DevexRule::initialize( const ITableau &tableau )
+{
+    freeIfNeeded();
+
+    _n = tableau.getN();
+    _m = tableau.getM();
+
+    _referenceFramework = new char[_n];
+    if ( !_referenceFramework )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DevexRule::referenceFramework" );
+
+    _weights = new double[_n - _m];
+    if ( !_weights )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DevexRule::weights" );
+
+    resetReferenceFramework( tableau );
+}
+
+void DevexRule::resetReferenceFramework( const ITableau &tableau )
+{
+    memset( _referenceFramework, 0, _n * sizeof(char) );
+
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        _weights[i] = 1.0;
+        _referenceFramework[tableau.nonBasicIndexToVariable( i )] = 1;
+    }
+
+    _resetNeeded = false;
+}
+
+bool DevexRule::select( ITableau &tableau,
+                        const List<unsigned> &candidates,
+                        const Set<unsigned> &excluded )
+{
+    const double *costFunction = tableau.getCostFunction();
+
+    bool found = false;
+    unsigned bestCandidate = 0;
+    double bestValue = 0.0;
+    for ( const auto &contender : candidates )
+    {
+        if ( excluded.exists( contender ) )
+            continue;
+
+        double contenderValue = ( costFunction[contender] * costFunction[contender] ) / _weights[contender];
+        if ( !found || contenderValue > bestValue )
+        {
+            found = true;
+            bestCandidate = contender;
+            bestValue = contenderValue;
+        }
+    }
+
+    if ( !found )
+    {
+        log( "No candidates, select returning false" );
+        return false;
+    }
+
+    tableau.setEnteringVariableIndex( bestCandidate );
+    return true;
+}
+
+void DevexRule::prePivotHook( const ITableau &tableau, bool fakePivot )
+{
+    // If the pivot is fake, the weights do not change
+    if ( fakePivot )
+        return;
+
+    unsigned entering = tableau.getEnteringVariable();
+    unsigned enteringIndex = tableau.getEnteringVariableIndex();
+    unsigned leavingIndex = tableau.getLeavingVariableIndex();
+
+    const double *changeColumn = tableau.getChangeColumn();
+    const TableauRow &pivotRow = *tableau.getPivotRow();
+
+    double pivotElement = changeColumn[leavingIndex];
+    ASSERT( !FloatUtils::isZero( pivotElement ) );
+
+    /*
+      The accurate reference weight of the entering variable only
+      depends on the change column, so it is cheap to compute. Use it
+      to check how far the approximate weights have drifted.
+    */
+    double accurateWeight = _referenceFramework[entering] ? 1.0 : 0.0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( _referenceFramework[tableau.basicIndexToVariable( i )] )
+            accurateWeight += changeColumn[i] * changeColumn[i];
+    }
+
+    if ( _weights[enteringIndex] > GlobalConfiguration::DEVEX_WEIGHT_ERROR_THRESHOLD * accurateWeight )
+    {
+        log( Stringf( "Weight error: approximate = %.10lf, accurate = %.10lf",
+                      _weights[enteringIndex], accurateWeight ) );
+        _resetNeeded = true;
+    }
+
+    // Update the weights of the remaining non-basic variables
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        if ( i == enteringIndex || FloatUtils::isZero( pivotRow[i] ) )
+            continue;
+
+        double ratio = pivotRow[i] / pivotElement;
+        double weight = ratio * ratio * accurateWeight;
+        if ( weight > _weights[i] )
+            _weights[i] = weight;
+    }
+
+    // The leaving variable takes the entering variable's index
+    _weights[enteringIndex] = FloatUtils::max( accurateWeight / ( pivotElement * pivotElement ), 1.0 );
+}
+
+void DevexRule::postPivotHook( const ITableau &tableau, bool fakePivot )
+{
+    if ( fakePivot || !_resetNeeded )
+        return;
+
+    log( "Resetting the reference framework" );
+    resetReferenceFramework( tableau );
+}
+
+void DevexRule::resizeHook( const ITableau &tableau )
+{
+    initialize( tableau );
+}
+
+double DevexRule::getWeight( unsigned index ) const
+{
+    return _weights[index];
+}
+
+void DevexRule::log( const String &message )
+{
+    if ( GlobalConfiguration::DEVEX_RULE_LOGGING )
+        printf( "DevexRule: %s\n", message.ascii() );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
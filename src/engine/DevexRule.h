@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file DevexRule.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DevexRule_h__
+#define __DevexRule_h__
+
+#include "EntrySelectionStrategy.h"
+
+class String;
+
+/*
+  The Devex pricing rule. Like projected steepest edge, Devex picks
+  the candidate maximizing
+
+              costFunction[i]^2
+              -----------------
+                  weight[i]
+
+  but its weights are only approximations of the reference norms.
+  After every pivot, the weights are updated from the pivot row and
+  the change column alone, which the tableau computes anyway, so no
+  additional FTRAN/BTRAN operations are needed. The reference
+  framework is reset whenever the weights drift too far from their
+  accurate values.
+*/
+class DevexRule : public EntrySelectionStrategy
+{
+public:
+    DevexRule();
+    ~DevexRule();
+
+    /*
+      Allocate and initialize data structures according to the size of the tableau.
+    */
+    void initialize( const ITableau &tableau );
+
+    /*
+      Apply the Devex pivot selection rule.
+    */
+    bool select( ITableau &tableau,
+                 const List<unsigned> &candidates,
+                 const Set<unsigned> &excluded );
+
+    /*
+      We use this hook to update the weights according to the entering
+      and leaving variables.
+    */
+    void prePivotHook( const ITableau &tableau, bool fakePivot );
+
+    /*
+      We use this hook to reset the reference framework if needed.
+    */
+    void postPivotHook( const ITableau &tableau, bool fakePivot );
+
+    /*
+      This hook is called when the tableau has been resized.
+    */
+    void resizeHook( const ITableau &tableau );
+
+    /*
+      For debugging purposes.
+    */
+    double getWeight( unsigned index ) const;
+
+private:
+    /*
+      Indicates whether a variable, basic or non basic, is in the reference framework.
+    */
+    char *_referenceFramework;
+
+    /*
+      The approximate weights of the non-basic variables.
+    */
+    double *_weights;
+
+    /*
+      Tableau dimensions.
+    */
+    unsigned _m;
+    unsigned _n;
+
+    /*
+      Set by the pre-pivot hook when the weights have become too
+      inaccurate.
+    */
+    bool _resetNeeded;
+
+    /*
+      Reset the reference framework and the weights, according to the
+      current non-basic variables.
+    */
+    void resetReferenceFramework( const ITableau &tableau );
+
+    /*
+      Free all data structures.
+    */
+    void freeIfNeeded();
+
+    static void log( const String &message );
+};
+
+#endif // __DevexRule_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -24,10 +24,10 @@
 #include "MarabouError.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "ReLUDivider.h"
 #include "TimeUtils.h"
 #include "Vector.h"
 #include <atomic>
-#include <chrono>
 #include <cmath>
 #include <thread>
 
@@ -67,6 +67,9 @@ DnCManager::DnCManager( unsigned numWorkers, unsigned initialDivides,
     , _numUnsolvedSubQueries( 0 )
     , _verbosity( verbosity )
     , _constraintViolationThreshold( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+    , _lpBoundTightening( false )
+    , _entryStrategy( EngineConfiguration::PROJECTED_STEEPEST_EDGE )
+    , _useDualSimplexAfterSplits( GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_SPLITS )
 {
 }
 
@@ -79,13 +82,7 @@ void DnCManager::freeMemoryIfNeeded()
 {
     if ( _workload )
     {
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
-        {
-            _workload->pop( subQuery );
-            delete subQuery;
-        }
-
+        // The queue deletes any remaining subqueries
         delete _workload;
         _workload = NULL;
     }
@@ -112,9 +109,9 @@ void DnCManager::solve( unsigned timeoutInSeconds )
     for ( unsigned i = 0; i < _numWorkers; ++i )
         quitThreads.append( _engines[i]->getQuitRequested() );
 
-    // Partition the input query into initial subqueries, and place these
-    // queries in the queue
-    _workload = new WorkerQueue( 0 );
+    // Partition the input query into initial subqueries, and distribute
+    // these queries among the workers' deques
+    _workload = new WorkerQueue( _numWorkers );
     if ( !_workload )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
@@ -124,21 +121,18 @@ void DnCManager::solve( unsigned timeoutInSeconds )
     // Create objects shared across workers
     _numUnsolvedSubQueries = subQueries.size();
     std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
+    unsigned workerId = 0;
     for ( auto &subQuery : subQueries )
     {
-        if ( !workload->push( subQuery ) )
-        {
-            // This should never happen
-            ASSERT( false );
-        }
+        _workload->push( workerId, subQuery );
+        workerId = ( workerId + 1 ) % _numWorkers;
     }
 
     // Spawn threads and start solving
     std::list<std::thread> threads;
     for ( unsigned threadId = 0; threadId < _numWorkers; ++threadId )
     {
-        threads.push_back( std::thread( dncSolve, workload,
+        threads.push_back( std::thread( dncSolve, _workload,
                                         _engines[ threadId ],
                                         std::ref( _numUnsolvedSubQueries ),
                                         std::ref( shouldQuitSolving ),
@@ -147,14 +141,20 @@ void DnCManager::solve( unsigned timeoutInSeconds )
     }
 
     // Wait until either all subQueries are solved or a satisfying assignment is
-    // found by some worker
+    // found by some worker. The workers notify the queue when this happens.
     while ( !shouldQuitSolving.load() )
     {
         updateTimeoutReached( startTime, timeoutInMicroSeconds );
         if ( _timeoutReached )
+        {
             shouldQuitSolving = true;
+            _workload->notifyAll();
+        }
         else
-            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        {
+            _workload->waitForQuit( shouldQuitSolving,
+                                    getRemainingTime( startTime, timeoutInMicroSeconds ) );
+        }
     }
 
 
@@ -312,22 +312,30 @@ bool DnCManager::createEngines()
     // Create the base engine
     _baseEngine = std::make_shared<Engine>();
 
-    InputQuery *baseInputQuery = new InputQuery();
-
-    *baseInputQuery = *_baseInputQuery;
+    InputQuery baseInputQuery = *_baseInputQuery;
 
-    if ( !_baseEngine->processInputQuery( *baseInputQuery ) )
+    if ( !_baseEngine->processInputQuery( baseInputQuery ) )
         // Solved by preprocessing, we are done!
         return false;
 
-    // Create engines for each thread
+    // The workers are still idle, so the LP-based bound tightening can
+    // use all of the threads
+    if ( _lpBoundTightening && !_baseEngine->performLpBoundTightening( _numWorkers ) )
+        return false;
+
+    /*
+      Create engines for each thread. The input query is only processed
+      once, by the base engine, and the workers copy its result.
+    */
     for ( unsigned i = 0; i < _numWorkers; ++i )
     {
         auto engine = std::make_shared<Engine>( _verbosity );
-        InputQuery *inputQuery = new InputQuery();
-        *inputQuery = *baseInputQuery;
-        engine->processInputQuery( *inputQuery );
-        engine->setConstraintViolationThreshold( _constraintViolationThreshold );
+        EngineConfiguration configuration = engine->getConfiguration();
+        configuration._entryStrategy = _entryStrategy;
+        configuration._useDualSimplexAfterSplits = _useDualSimplexAfterSplits;
+        configuration._constraintViolationThreshold = _constraintViolationThreshold;
+        engine->setConfiguration( configuration );
+        engine->initializeFromEngine( *_baseEngine );
         _engines.append( engine );
     }
 
@@ -345,9 +353,10 @@ void DnCManager::initialDivide( SubQueries &subQueries )
     }
     else
     {
-        // Default
+        ASSERT( _divideStrategy == DivideStrategy::EarliestReLU ||
+                _divideStrategy == DivideStrategy::ReLUViolation );
         queryDivider = std::unique_ptr<QueryDivider>
-            ( new LargestIntervalDivider( inputVariables ) );
+            ( new ReLUDivider( _baseEngine, _divideStrategy ) );
     }
 
     String queryId;
@@ -390,6 +399,22 @@ void DnCManager::updateTimeoutReached( timespec startTime, unsigned long long
         timeoutInMicroSeconds;
 }
 
+unsigned long long DnCManager::getRemainingTime( timespec startTime, unsigned long long
+                                                 timeoutInMicroSeconds ) const
+{
+    if ( timeoutInMicroSeconds == 0 )
+        return 0;
+
+    struct timespec now = TimeUtils::sampleMicro();
+    unsigned long long timePassed = TimeUtils::timePassed( startTime, now );
+
+    // Never return 0, which would mean no timeout
+    if ( timePassed >= timeoutInMicroSeconds )
+        return 1;
+
+    return timeoutInMicroSeconds - timePassed;
+}
+
 void DnCManager::log( const String &message )
 {
     if ( GlobalConfiguration::DNC_MANAGER_LOGGING )
@@ -401,6 +426,21 @@ void DnCManager::setConstraintViolationThreshold( unsigned threshold )
     _constraintViolationThreshold = threshold;
 }
 
+void DnCManager::setLpBoundTightening( bool lpBoundTightening )
+{
+    _lpBoundTightening = lpBoundTightening;
+}
+
+void DnCManager::setEntryStrategy( EngineConfiguration::EntryStrategy entryStrategy )
+{
+    _entryStrategy = entryStrategy;
+}
+
+void DnCManager::setDualSimplexAfterSplits( bool useDualSimplex )
+{
+    _useDualSimplexAfterSplits = useDualSimplex;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
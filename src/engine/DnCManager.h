@@ -21,6 +21,7 @@
 #include "InputQuery.h"
 #include "SubQuery.h"
 #include "Vector.h"
+#include "WorkerQueue.h"
 
 #include <atomic>
 
@@ -75,6 +76,23 @@ public:
 
     void setConstraintViolationThreshold( unsigned threshold );
 
+    /*
+      Whether the base engine should tighten the bounds with LP
+      relaxations before the query is divided
+    */
+    void setLpBoundTightening( bool lpBoundTightening );
+
+    /*
+      The rule each worker engine uses for picking the entering variable
+    */
+    void setEntryStrategy( EngineConfiguration::EntryStrategy entryStrategy );
+
+    /*
+      Whether the worker engines re-solve child nodes with the dual
+      simplex method
+    */
+    void setDualSimplexAfterSplits( bool useDualSimplex );
+
 private:
     /*
       Create and run a DnCWorker
@@ -108,6 +126,13 @@ private:
     void updateTimeoutReached( timespec startTime,
                                unsigned long long timeoutInMicroSeconds );
 
+    /*
+      The time left until the timeout is reached, in microseconds. Returns
+      0 if there is no timeout.
+    */
+    unsigned long long getRemainingTime( timespec startTime,
+                                         unsigned long long timeoutInMicroSeconds ) const;
+
     static void log( const String &message );
 
     /*
@@ -172,7 +197,7 @@ private:
     DnCExitCode _exitCode;
 
     /*
-      Set of subQueries to be solved by workers
+      Set of subQueries to be solved by workers, with a deque per worker
     */
     WorkerQueue *_workload;
 
@@ -196,6 +221,21 @@ private:
     */
     unsigned _constraintViolationThreshold;
 
+    /*
+      Whether to perform LP-based bound tightening on the base engine
+    */
+    bool _lpBoundTightening;
+
+    /*
+      The entry strategy of each worker engine
+    */
+    EngineConfiguration::EntryStrategy _entryStrategy;
+
+    /*
+      Whether the worker engines use the dual simplex method after splits
+    */
+    bool _useDualSimplexAfterSplits;
+
 };
 
 #endif // __DnCManager_h__
@@ -19,10 +19,8 @@
 #include "File.h"
 #include "MStringf.h"
 #include "Options.h"
-#include "PropertyParser.h"
+#include "OptionsQueryLoader.h"
 #include "MarabouError.h"
-#include "QueryLoader.h"
-#include "AcasParser.h"
 
 DnCMarabou::DnCMarabou()
     : _dncManager( nullptr )
@@ -32,63 +30,13 @@ DnCMarabou::DnCMarabou()
 
 void DnCMarabou::run()
 {
-    String inputQueryFilePath = Options::get()->getString( Options::INPUT_QUERY_FILE_PATH );
-    if ( inputQueryFilePath.length() > 0 )
-    {
-        /*
-          Step 1: extract the query
-        */
-        if ( !File::exists( inputQueryFilePath ) )
-        {
-            printf( "Error: the specified inputQuery file (%s) doesn't exist!\n", inputQueryFilePath.ascii() );
-            throw MarabouError( MarabouError::FILE_DOESNT_EXIST, inputQueryFilePath.ascii() );
-        }
-
-        printf( "InputQuery: %s\n", inputQueryFilePath.ascii() );
-        _inputQuery = QueryLoader::loadQuery( inputQueryFilePath );
-    }
-    else
-    {
-        /*
-          Step 1: extract the network
-        */
-        String networkFilePath = Options::get()->getString( Options::INPUT_FILE_PATH );
-        if ( !File::exists( networkFilePath ) )
-        {
-            printf( "Error: the specified network file (%s) doesn't exist!\n",
-                    networkFilePath.ascii() );
-            throw MarabouError( MarabouError::FILE_DOESNT_EXIST,
-                                networkFilePath.ascii() );
-        }
-        printf( "Network: %s\n", networkFilePath.ascii() );
-
-        /*
-          Step 2: extract the property in question
-        */
-        String propertyFilePath = Options::get()->getString( Options::PROPERTY_FILE_PATH );
-        if ( propertyFilePath != "" )
-        {
-            if ( !File::exists( propertyFilePath ) )
-            {
-                printf( "Error: the specified property file (%s) doesn't exist!\n",
-                        propertyFilePath.ascii() );
-                throw MarabouError( MarabouError::FILE_DOESNT_EXIST,
-                                    propertyFilePath.ascii() );
-            }
-            printf( "Property: %s\n", propertyFilePath.ascii() );
-        }
-        else
-            printf( "Property: None\n" );
-
-        AcasParser acasParser( networkFilePath );
-        acasParser.generateQuery( _inputQuery );
-        if ( propertyFilePath != "" )
-            PropertyParser().parse( propertyFilePath, _inputQuery );
-    }
-    printf( "\n" );
+    /*
+      Step 1: extract the query
+    */
+    OptionsQueryLoader::loadQuery( _inputQuery );
 
     /*
-      Step 3: initialize the DNC core
+      Step 2: initialize the DNC core
     */
     unsigned initialDivides = Options::get()->getInt( Options::NUM_INITIAL_DIVIDES );
     unsigned initialTimeout = Options::get()->getInt( Options::INITIAL_TIMEOUT );
@@ -107,12 +55,27 @@ void DnCMarabou::run()
         splitThreshold = GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD;
     }
 
+    String divideStrategyString = Options::get()->getString( Options::DIVIDE_STRATEGY );
+    DivideStrategy divideStrategy = DivideStrategy::LargestInterval;
+    if ( divideStrategyString == "earliest-relu" )
+        divideStrategy = DivideStrategy::EarliestReLU;
+    else if ( divideStrategyString == "relu-violation" )
+        divideStrategy = DivideStrategy::ReLUViolation;
+    else if ( divideStrategyString != "largest-interval" )
+        printf( "Invalid divide strategy %s, using largest-interval.\n\n",
+                divideStrategyString.ascii() );
+
     _dncManager = std::unique_ptr<DnCManager>
       ( new DnCManager( numWorkers, initialDivides, initialTimeout,
                         onlineDivides, timeoutFactor,
-                        DivideStrategy::LargestInterval, &_inputQuery,
+                        divideStrategy, &_inputQuery,
                         verbosity ) );
     _dncManager->setConstraintViolationThreshold( splitThreshold );
+    _dncManager->setLpBoundTightening( Options::get()->getBool( Options::LP_BOUND_TIGHTENING ) );
+    _dncManager->setEntryStrategy( EngineConfiguration::parseEntryStrategy
+                                   ( Options::get()->getString( Options::ENTRY_STRATEGY ) ) );
+    if ( Options::get()->getBool( Options::DUAL_SIMPLEX ) )
+        _dncManager->setDualSimplexAfterSplits( true );
 
     struct timespec start = TimeUtils::sampleMicro();
 
@@ -22,12 +22,11 @@
 #include "MarabouError.h"
 #include "MStringf.h"
 #include "PiecewiseLinearCaseSplit.h"
+#include "ReLUDivider.h"
 #include "SubQuery.h"
 
 #include <atomic>
-#include <chrono>
 #include <cmath>
-#include <thread>
 
 DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
                       std::atomic_uint &numUnsolvedSubQueries,
@@ -51,23 +50,27 @@ DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
 
 void DnCWorker::setQueryDivider( DivideStrategy divideStrategy )
 {
-    // For now, there is only one strategy
-    ASSERT( divideStrategy == DivideStrategy::LargestInterval );
     if ( divideStrategy == DivideStrategy::LargestInterval )
     {
         const List<unsigned> &inputVariables = _engine->getInputVariables();
         _queryDivider = std::unique_ptr<LargestIntervalDivider>
             ( new LargestIntervalDivider( inputVariables ) );
     }
+    else
+    {
+        ASSERT( divideStrategy == DivideStrategy::EarliestReLU ||
+                divideStrategy == DivideStrategy::ReLUViolation );
+        _queryDivider = std::unique_ptr<ReLUDivider>
+            ( new ReLUDivider( _engine, divideStrategy ) );
+    }
 }
 
 void DnCWorker::popOneSubQueryAndSolve()
 {
     SubQuery *subQuery = NULL;
-    // Boost queue stores the next element into the passed-in pointer
-    // and returns true if the pop is successful (aka, the queue is not empty
-    // in most cases)
-    if ( _workload->pop( subQuery ) )
+    // Take a subQuery from this worker's deque, or steal one from another
+    // worker. The pop fails only if solving is over.
+    if ( _workload->waitAndPop( _threadId, subQuery, *_shouldQuitSolving ) )
     {
         String queryId = subQuery->_queryId;
         auto split = std::move( subQuery->_split );
@@ -93,27 +96,27 @@ void DnCWorker::popOneSubQueryAndSolve()
             // If UNSAT, continue to solve
             *_numUnsolvedSubQueries -= 1;
             if ( _numUnsolvedSubQueries->load() == 0 )
-                *_shouldQuitSolving = true;
+                quitSolving();
             delete subQuery;
         }
         else if ( result == IEngine::TIMEOUT )
         {
             // If TIMEOUT, split the current input region and add the
-            // new subQueries to the current queue
+            // new subQueries to this worker's deque. The new subQueries
+            // are counted before they are pushed, since other workers
+            // may steal and solve them right away. The engine is first
+            // brought back to the state of the sub-query, so that the
+            // divider sees its bounds and not those of the search.
+            _engine->restoreState( *_initialState );
             SubQueries subQueries;
             _queryDivider->createSubQueries( pow( 2, _onlineDivides ),
                                              queryId, *split,
                                              (unsigned)timeoutInSeconds *
                                              _timeoutFactor, subQueries );
+            *_numUnsolvedSubQueries += subQueries.size();
             for ( auto &newSubQuery : subQueries )
-            {
-                if ( !_workload->push( std::move( newSubQuery ) ) )
-                {
-                    throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
-                }
+                _workload->push( _threadId, newSubQuery );
 
-                *_numUnsolvedSubQueries += 1;
-            }
             *_numUnsolvedSubQueries -= 1;
             delete subQuery;
         }
@@ -129,7 +132,7 @@ void DnCWorker::popOneSubQueryAndSolve()
             // We must set the quit flag to true  if the result is not UNSAT or
             // TIMEOUT. This way, the DnCManager will kill all the DnCWorkers.
 
-            *_shouldQuitSolving = true;
+            quitSolving();
             if ( result == IEngine::SAT )
             {
                 // case SAT
@@ -151,11 +154,12 @@ void DnCWorker::popOneSubQueryAndSolve()
             }
         }
     }
-    else
-    {
-        // If the queue is empty but the pop fails, wait and retry
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
-    }
+}
+
+void DnCWorker::quitSolving()
+{
+    *_shouldQuitSolving = true;
+    _workload->notifyAll();
 }
 
 void DnCWorker::printProgress( String queryId, IEngine::ExitCode result ) const
@@ -20,6 +20,7 @@
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "WorkerQueue.h"
 
 #include <atomic>
 
@@ -33,8 +34,9 @@ public:
                DivideStrategy divideStrategy );
 
     /*
-      Pop one subQuery, solve it and handle the result
-      Return true if the DnCWorker should continue running
+      Pop one subQuery, solve it and handle the result. If no subQuery
+      is available, block until one becomes available or until
+      solving is over.
     */
     void popOneSubQueryAndSolve();
 
@@ -44,6 +46,11 @@ private:
     */
     void setQueryDivider( DivideStrategy divideStrategy );
 
+    /*
+      Signal the manager and the other workers that solving is over
+    */
+    void quitSolving();
+
     /*
       Convert the exitCode to string
     */
@@ -55,7 +62,8 @@ private:
     void printProgress( String queryId, IEngine::ExitCode result ) const;
 
     /*
-      The queue of subqueries (shared across threads)
+      The queue of subqueries (shared across threads). This worker
+      pushes the subqueries it creates into its own deque.
     */
     WorkerQueue *_workload;
     std::shared_ptr<IEngine> _engine;
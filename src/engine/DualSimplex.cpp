@@ -0,0 +1,310 @@
+/*********************                                                        */
+/*! \file DualSimplex.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "DualSimplex.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "TableauRow.h"
+
+DualSimplex::DualSimplex()
+    : _weights( NULL )
+    , _rho( NULL )
+    , _tau( NULL )
+    , _unitVector( NULL )
+    , _leavingIndex( 0 )
+    , _leavingDelta( 0.0 )
+    , _totalInfeasibility( 0.0 )
+    , _m( 0 )
+{
+}
+
+DualSimplex::~DualSimplex()
+{
+    freeIfNeeded();
+}
+
+void DualSimplex::freeIfNeeded()
+{
+    if ( _weights )
+    {
+        delete[] _weights;
+        _weights = NULL;
+    }
+
+    if ( _rho )
+    {
+        delete[] _rho;
+        _rho = NULL;
+    }
+
+    if ( _tau )
+    {
+        delete[] _tau;
+        _tau = NULL;
+    }
+
+    if ( _unitVector )
+    {
+        delete[] _unitVector;
+        _unitVector = NULL;
+    }
+}
+
+void DualSimplex::initialize( const ITableau &tableau )
+{
+    if ( tableau.getM() != _m || !_weights )
+    {
+        freeIfNeeded();
+
+        _m = tableau.getM();
+
+        _weights = new double[_m];
+        if ( !_weights )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSimplex::weights" );
+
+        _rho = new double[_m];
+        if ( !_rho )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSimplex::rho" );
+
+        _tau = new double[_m];
+        if ( !_tau )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSimplex::tau" );
+
+        _unitVector = new double[_m];
+        if ( !_unitVector )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSimplex::unitVector" );
+    }
+
+    std::fill_n( _weights, _m, 1.0 );
+}
+
+bool DualSimplex::selectLeavingVariable( const ITableau &tableau, unsigned &leavingIndex )
+{
+    // The tableau may have grown since the last initialization
+    if ( tableau.getM() != _m )
+        initialize( tableau );
+
+    bool found = false;
+    double bestScore = 0.0;
+    _totalInfeasibility = 0.0;
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !tableau.basicOutOfBounds( i ) )
+            continue;
+
+        unsigned variable = tableau.basicIndexToVariable( i );
+        double value = tableau.getBasicAssignment( i );
+        double delta = tableau.basicTooLow( i ) ?
+            tableau.getLowerBound( variable ) - value :
+            tableau.getUpperBound( variable ) - value;
+
+        _totalInfeasibility += FloatUtils::abs( delta );
+
+        double score = ( delta * delta ) / _weights[i];
+        if ( !found || score > bestScore )
+        {
+            found = true;
+            bestScore = score;
+            _leavingIndex = i;
+            _leavingDelta = delta;
+        }
+    }
+
+    if ( !found )
+        return false;
+
+    leavingIndex = _leavingIndex;
+
+    // Compute the leaving row of inv(B), and use it to refresh its weight
+    std::fill_n( _unitVector, _m, 0.0 );
+    _unitVector[_leavingIndex] = 1.0;
+    tableau.backwardTransformation( _unitVector, _rho );
+
+    double weight = 0.0;
+    for ( unsigned i = 0; i < _m; ++i )
+        weight += _rho[i] * _rho[i];
+    _weights[_leavingIndex] = FloatUtils::max( weight, GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT );
+
+    log( Stringf( "Leaving variable: x%u, delta = %.10lf",
+                  tableau.basicIndexToVariable( _leavingIndex ), _leavingDelta ) );
+    return true;
+}
+
+bool DualSimplex::selectEnteringVariable( ITableau &tableau,
+                                          const TableauRow &pivotRow,
+                                          unsigned &enteringIndex ) const
+{
+    bool leavingIncreases = FloatUtils::isPositive( _leavingDelta );
+
+    bool found = false;
+    double bestPivotEntry = 0.0;
+
+    for ( unsigned i = 0; i < pivotRow._size; ++i )
+    {
+        double coefficient = pivotRow._row[i]._coefficient;
+        if ( FloatUtils::isZero( coefficient ) )
+            continue;
+
+        unsigned variable = pivotRow._row[i]._var;
+        double value = tableau.getValue( variable );
+        double lb = tableau.getLowerBound( variable );
+        double ub = tableau.getUpperBound( variable );
+
+        // The direction in which the non-basic needs to move
+        bool increase = ( coefficient > 0 ) == leavingIncreases;
+        if ( increase )
+        {
+            double tighterUb =
+                ub -
+                ( GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE +
+                  GlobalConfiguration::BOUND_COMPARISON_MULTIPLICATIVE_TOLERANCE * FloatUtils::abs( ub ) );
+            if ( value >= tighterUb )
+                continue;
+        }
+        else
+        {
+            double tighterLb =
+                lb +
+                ( GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE +
+                  GlobalConfiguration::BOUND_COMPARISON_MULTIPLICATIVE_TOLERANCE * FloatUtils::abs( lb ) );
+            if ( value <= tighterLb )
+                continue;
+        }
+
+        // After the pivot, the entering variable becomes basic. Avoid
+        // trading one infeasibility for another.
+        double newValue = value + _leavingDelta / coefficient;
+        if ( FloatUtils::lt( newValue, lb ) || FloatUtils::gt( newValue, ub ) )
+            continue;
+
+        double pivotEntry = FloatUtils::abs( coefficient );
+        if ( !found || pivotEntry > bestPivotEntry )
+        {
+            found = true;
+            bestPivotEntry = pivotEntry;
+            enteringIndex = i;
+        }
+    }
+
+    return found;
+}
+
+bool DualSimplex::pivotRowIsInfeasible( ITableau &tableau, const TableauRow &pivotRow ) const
+{
+    /*
+      Compute how far the leaving variable can move towards its
+      violated bound, if every non-basic variable is moved to the
+      bound that helps it most. If that is not enough, the row is
+      infeasible.
+
+      Every non-zero coefficient counts: a tiny coefficient on a
+      variable with a wide range can still contribute a significant
+      change. The row is computed numerically, so its error grows with
+      the magnitude of its terms, and the tolerance is scaled
+      accordingly.
+    */
+    bool leavingIncreases = FloatUtils::isPositive( _leavingDelta );
+
+    double requiredChange = FloatUtils::abs( _leavingDelta );
+    double maxChange = 0.0;
+    double magnitude = requiredChange;
+    for ( unsigned i = 0; i < pivotRow._size; ++i )
+    {
+        double coefficient = pivotRow._row[i]._coefficient;
+        if ( coefficient == 0.0 )
+            continue;
+
+        unsigned variable = pivotRow._row[i]._var;
+        double value = tableau.getValue( variable );
+
+        bool increase = ( coefficient > 0 ) == leavingIncreases;
+        double bound = increase ? tableau.getUpperBound( variable ) : tableau.getLowerBound( variable );
+        if ( !FloatUtils::isFinite( bound ) )
+            return false;
+
+        maxChange += FloatUtils::abs( coefficient * ( bound - value ) );
+        magnitude += FloatUtils::abs( coefficient * bound ) + FloatUtils::abs( coefficient * value );
+    }
+
+    double tolerance =
+        GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE +
+        GlobalConfiguration::DUAL_SIMPLEX_INFEASIBILITY_RELATIVE_TOLERANCE * magnitude;
+
+    return requiredChange - maxChange > tolerance;
+}
+
+void DualSimplex::prePivotHook( const ITableau &tableau )
+{
+    ASSERT( tableau.getLeavingVariableIndex() == _leavingIndex );
+
+    const double *changeColumn = tableau.getChangeColumn();
+    double alpha = changeColumn[_leavingIndex];
+    ASSERT( !FloatUtils::isZero( alpha ) );
+
+    // tau = inv(B) * rho
+    tableau.forwardTransformation( _rho, _tau );
+
+    /*
+      After the pivot, row i of inv(B) becomes
+
+          row_i - ( alpha_i / alpha_r ) * row_r
+
+      and the leaving row is divided by alpha_r. Since tau_i is the
+      inner product of row_i and row_r, the new squared norms follow
+      without recomputing the rows.
+    */
+    double leavingWeight = _weights[_leavingIndex];
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( i == _leavingIndex || FloatUtils::isZero( changeColumn[i] ) )
+            continue;
+
+        double ratio = changeColumn[i] / alpha;
+        double weight = _weights[i] - 2 * ratio * _tau[i] + ratio * ratio * leavingWeight;
+        _weights[i] = FloatUtils::max( weight, GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT );
+    }
+
+    _weights[_leavingIndex] = FloatUtils::max( leavingWeight / ( alpha * alpha ),
+                                               GlobalConfiguration::DUAL_STEEPEST_EDGE_MIN_WEIGHT );
+}
+
+double DualSimplex::getTotalInfeasibility() const
+{
+    return _totalInfeasibility;
+}
+
+double DualSimplex::getWeight( unsigned basicIndex ) const
+{
+    return _weights[basicIndex];
+}
+
+void DualSimplex::log( const String &message )
+{
+    if ( GlobalConfiguration::DUAL_SIMPLEX_LOGGING )
+        printf( "DualSimplex: %s\n", message.ascii() );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
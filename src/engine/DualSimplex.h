@@ -0,0 +1,150 @@
+/*********************                                                        */
+/*! \file DualSimplex.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DualSimplex_h__
+#define __DualSimplex_h__
+
+class ITableau;
+class String;
+class TableauRow;
+
+/*
+  Pivot selection for the dual simplex method. A case split typically
+  only tightens a few bounds, leaving a handful of basic variables out
+  of bounds. Rather than restarting the primal search, the dual method
+  picks an out-of-bounds basic variable to leave the basis, and moves
+  it straight to its violated bound.
+
+  Queries have no objective function, so the textbook dual ratio test
+  does not apply: all reduced costs are zero. The entering variable is
+  instead the one with the largest pivot element among those that stay
+  within their bounds after the pivot.
+
+  The leaving variable is picked according to the dual steepest edge
+  rule, i.e. the one maximizing
+
+              infeasibility^2
+              ---------------
+                  ||rho||^2
+
+  where rho is the leaving variable's row of inv(B). The squared row
+  norms (the weights) are updated after every pivot, using one extra
+  FTRAN.
+*/
+class DualSimplex
+{
+public:
+    DualSimplex();
+    ~DualSimplex();
+
+    /*
+      Allocate data structures according to the size of the tableau,
+      and reset all weights to 1.
+    */
+    void initialize( const ITableau &tableau );
+
+    /*
+      Pick the out-of-bounds basic variable that should leave the
+      basis. Returns false if all basic variables are within bounds.
+    */
+    bool selectLeavingVariable( const ITableau &tableau, unsigned &leavingIndex );
+
+    /*
+      Given the pivot row of the leaving variable, pick a non-basic
+      variable that can move the leaving variable to its violated bound
+      while remaining within its own bounds after the pivot. Larger
+      pivot elements are preferred. Returns false if no such variable
+      exists.
+    */
+    bool selectEnteringVariable( ITableau &tableau,
+                                 const TableauRow &pivotRow,
+                                 unsigned &enteringIndex ) const;
+
+    /*
+      Return true if the pivot row proves that the leaving variable
+      cannot reach its violated bound, i.e. that the current query is
+      infeasible. The proof is only as accurate as the row, so callers
+      should only rely on it for a row computed from a fresh basis
+      factorization.
+    */
+    bool pivotRowIsInfeasible( ITableau &tableau, const TableauRow &pivotRow ) const;
+
+    /*
+      Update the weights according to the entering and leaving
+      variables. Should be invoked before the tableau performs the
+      pivot, when the change column is already available.
+    */
+    void prePivotHook( const ITableau &tableau );
+
+    /*
+      The sum of the distances of the basic variables from their
+      violated bounds, as observed by the last call to
+      selectLeavingVariable().
+    */
+    double getTotalInfeasibility() const;
+
+    /*
+      For debugging purposes.
+    */
+    double getWeight( unsigned basicIndex ) const;
+
+private:
+    /*
+      The squared norms of the rows of inv(B).
+    */
+    double *_weights;
+
+    /*
+      The leaving variable's row of inv(B), and inv(B) times it.
+    */
+    double *_rho;
+    double *_tau;
+
+    /*
+      Work space.
+    */
+    double *_unitVector;
+
+    /*
+      The currently selected leaving variable, and its distance from
+      its violated bound.
+    */
+    unsigned _leavingIndex;
+    double _leavingDelta;
+
+    /*
+      The total infeasibility of the basic variables.
+    */
+    double _totalInfeasibility;
+
+    /*
+      Tableau dimension.
+    */
+    unsigned _m;
+
+    void freeIfNeeded();
+
+    static void log( const String &message );
+};
+
+#endif // __DualSimplex_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -20,9 +20,11 @@
 #include "EngineState.h"
 #include "InfeasibleQueryException.h"
 #include "InputQuery.h"
+#include "LPBoundTightener.h"
 #include "MStringf.h"
 #include "MalformedBasisException.h"
 #include "MarabouError.h"
+#include "MaxConstraint.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Preprocessor.h"
 #include "TableauRow.h"
@@ -47,6 +49,9 @@ Engine::Engine( unsigned verbosity )
     , _verbosity( verbosity )
     , _lastNumVisitedStates( 0 )
     , _lastIterationWithProgress( 0 )
+    , _dualSimplexActive( false )
+    , _numDualSimplexSteps( 0 )
+    , _dualSimplexInfeasibility( 0.0 )
 {
     _smtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
@@ -170,13 +175,19 @@ bool Engine::solve( unsigned timeoutInSeconds )
             _basisRestorationPerformed = Engine::NO_RESTORATION_PERFORMED;
 
             // Possible restoration due to preceision degradation
-            if ( shouldCheckDegradation() && highDegradation() )
+            if ( shouldCheckDegradation() )
             {
-                performPrecisionRestoration( PrecisionRestorer::RESTORE_BASICS );
-                continue;
+                if ( highDegradation() )
+                {
+                    performPrecisionRestoration( PrecisionRestorer::RESTORE_BASICS );
+                    continue;
+                }
+
+                refactorizeOnModerateDegradation();
             }
 
-            if ( _tableau->basisMatrixAvailable() )
+            if ( _configuration._useExplicitBasisBoundTightening &&
+                 _tableau->basisMatrixAvailable() )
                 explicitBasisBoundTightening();
 
             if ( splitJustPerformed )
@@ -184,6 +195,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
                 do
                 {
                     performSymbolicBoundTightening();
+                    performBackSubstitutionBoundTightening();
                 }
                 while ( applyAllValidConstraintCaseSplits() );
                 splitJustPerformed = false;
@@ -194,6 +206,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
             {
                 _smtCore.performSplit();
                 splitJustPerformed = true;
+                activateDualSimplex();
                 continue;
             }
 
@@ -205,6 +218,8 @@ bool Engine::solve( unsigned timeoutInSeconds )
 
             if ( allVarsWithinBounds() )
             {
+                deactivateDualSimplex();
+
                 // The linear portion of the problem has been solved.
                 // Check the status of the PL constraints
                 collectViolatedPlConstraints();
@@ -243,13 +258,19 @@ bool Engine::solve( unsigned timeoutInSeconds )
                 checkBoundCompliancyWithDebugSolution();
 
                 while ( applyAllValidConstraintCaseSplits() )
+                {
                     performSymbolicBoundTightening();
+                    performBackSubstitutionBoundTightening();
+                }
 
                 continue;
             }
 
             // We have out-of-bounds variables.
-            performSimplexStep();
+            if ( _dualSimplexActive )
+                performDualSimplexStep();
+            else
+                performSimplexStep();
             continue;
         }
         catch ( const MalformedBasisException & )
@@ -258,6 +279,8 @@ bool Engine::solve( unsigned timeoutInSeconds )
             printf( "MalformedBasisException caught!\n" );
             //
 
+            deactivateDualSimplex();
+
             if ( _basisRestorationPerformed == Engine::NO_RESTORATION_PERFORMED )
             {
                 if ( _numVisitedStatesAtPreviousRestoration != _statistics.getNumVisitedTreeStates() )
@@ -296,6 +319,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
             else
             {
                 splitJustPerformed = true;
+                activateDualSimplex();
             }
 
         }
@@ -537,6 +561,148 @@ void Engine::performSimplexStep()
     _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
 }
 
+void Engine::activateDualSimplex()
+{
+    if ( !_configuration._useDualSimplexAfterSplits )
+        return;
+
+    _dualSimplex.initialize( *_tableau );
+    _dualSimplexActive = true;
+    _numDualSimplexSteps = 0;
+    _dualSimplexInfeasibility = FloatUtils::infinity();
+}
+
+void Engine::deactivateDualSimplex()
+{
+    _dualSimplexActive = false;
+}
+
+void Engine::performDualSimplexStep()
+{
+    /*
+      A split has tightened some bounds, so the current basis is
+      typically only a few pivots away from a feasible one. The dual
+      method pivots out-of-bounds basic variables directly to their
+      violated bounds, instead of minimizing the sum of infeasibilities
+      from scratch. Since there is no objective function to optimize,
+      the dual ratio test degenerates: we pick the entering variable
+      for stability, and hand control back to the primal method after a
+      bounded number of steps.
+    */
+    if ( _numDualSimplexSteps >= GlobalConfiguration::DUAL_SIMPLEX_MAX_STEPS_AFTER_SPLIT )
+    {
+        deactivateDualSimplex();
+        performSimplexStep();
+        return;
+    }
+
+    // Statistics
+    _statistics.incNumDualSimplexSteps();
+    struct timespec start = TimeUtils::sampleMicro();
+    ++_numDualSimplexSteps;
+
+    unsigned leavingIndex;
+    if ( !_dualSimplex.selectLeavingVariable( *_tableau, leavingIndex ) )
+    {
+        // All basic variables are within bounds
+        deactivateDualSimplex();
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.addTimeDualSimplexSteps( TimeUtils::timePassed( start, end ) );
+        return;
+    }
+
+    /*
+      Nothing guarantees that a dual pivot does not push other basic
+      variables out of bounds. If the previous step did not reduce the
+      total infeasibility, the primal method is likely to do better.
+    */
+    double infeasibility = _dualSimplex.getTotalInfeasibility();
+    if ( !FloatUtils::lt( infeasibility, _dualSimplexInfeasibility ) )
+    {
+        deactivateDualSimplex();
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.addTimeDualSimplexSteps( TimeUtils::timePassed( start, end ) );
+        return;
+    }
+    _dualSimplexInfeasibility = infeasibility;
+
+    _tableau->setLeavingVariableIndex( leavingIndex );
+    _tableau->computePivotRow();
+    const TableauRow &pivotRow = *_tableau->getPivotRow();
+
+    unsigned enteringIndex;
+    if ( !_dualSimplex.selectEnteringVariable( *_tableau, pivotRow, enteringIndex ) )
+    {
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.addTimeDualSimplexSteps( TimeUtils::timePassed( start, end ) );
+
+        if ( _tableau->getBasicAssignmentStatus() != ITableau::BASIC_ASSIGNMENT_JUST_COMPUTED )
+        {
+            // This failure might have resulted from a corrupt basic assignment.
+            _tableau->computeAssignment();
+            return;
+        }
+
+        if ( _dualSimplex.pivotRowIsInfeasible( *_tableau, pivotRow ) )
+        {
+            // Only trust the proof if the row was computed from a fresh
+            // factorization. Otherwise, refactorize and recompute the
+            // assignment; the next step recomputes the row.
+            if ( _tableau->basisMatrixAvailable() )
+                throw InfeasibleQueryException();
+
+            _tableau->refreshBasisFactorization();
+            _tableau->computeAssignment();
+            return;
+        }
+
+        deactivateDualSimplex();
+        return;
+    }
+
+    _tableau->setEnteringVariableIndex( enteringIndex );
+    _tableau->computeChangeColumn();
+
+    double pivotEntry = _tableau->getChangeColumn()[leavingIndex];
+    if ( FloatUtils::abs( pivotEntry ) < GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+    {
+        // Avoid unstable pivots: refresh the factorization, or let the
+        // primal method handle this node.
+        if ( !_tableau->basisMatrixAvailable() )
+            _tableau->refreshBasisFactorization();
+        else
+            deactivateDualSimplex();
+
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.addTimeDualSimplexSteps( TimeUtils::timePassed( start, end ) );
+        return;
+    }
+
+    // The leaving variable moves to its violated bound
+    unsigned leavingVariable = _tableau->basicIndexToVariable( leavingIndex );
+    bool leavingIncreases = _tableau->basicTooLow( leavingIndex );
+    double leavingDelta = leavingIncreases ?
+        _tableau->getLowerBound( leavingVariable ) - _tableau->getBasicAssignment( leavingIndex ) :
+        _tableau->getUpperBound( leavingVariable ) - _tableau->getBasicAssignment( leavingIndex );
+
+    _tableau->setLeavingVariableIncreases( leavingIncreases );
+    _tableau->setChangeRatio( leavingDelta / pivotRow[enteringIndex] );
+
+    _rowBoundTightener->examinePivotRow();
+
+    // Perform the actual pivot
+    _dualSimplex.prePivotHook( *_tableau );
+    _activeEntryStrategy->prePivotHook( _tableau, false );
+    _tableau->performPivot();
+    _activeEntryStrategy->postPivotHook( _tableau, false );
+
+    // The cost function is only maintained for primal steps
+    _costFunctionManager->invalidateCostFunction();
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.addTimeDualSimplexSteps( TimeUtils::timePassed( start, end ) );
+}
+
 void Engine::fixViolatedPlConstraintIfPossible()
 {
     List<PiecewiseLinearConstraint::Fix> fixes;
@@ -1013,15 +1179,46 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
         _tableau->setUpperBound( i, _preprocessedQuery.getUpperBound( i ) );
     }
 
+    registerTableauWatchers();
+
+    _rowBoundTightener->setDimensions();
+    _constraintBoundTightener->setDimensions();
+
+    _tableau->initializeTableau( initialBasis );
+
+    _costFunctionManager->initialize();
+    _tableau->registerCostFunctionManager( _costFunctionManager );
+    _activeEntryStrategy->initialize( _tableau );
+
+    _statistics.setNumPlConstraints( _plConstraints.size() );
+}
+
+void Engine::initializeTableau( const TableauState &tableauState )
+{
+    registerTableauWatchers();
+
+    // Restoring the state also initializes the cost function manager
+    _tableau->registerCostFunctionManager( _costFunctionManager );
+    _tableau->restoreState( tableauState );
+
+    adjustWorkMemorySize();
+
+    _rowBoundTightener->setDimensions();
+    _constraintBoundTightener->setDimensions();
+
+    _activeEntryStrategy->initialize( _tableau );
+
+    _statistics.setNumPlConstraints( _plConstraints.size() );
+}
+
+void Engine::registerTableauWatchers()
+{
     _tableau->registerToWatchAllVariables( _rowBoundTightener );
     _tableau->registerResizeWatcher( _rowBoundTightener );
 
     _tableau->registerToWatchAllVariables( _constraintBoundTightener );
     _tableau->registerResizeWatcher( _constraintBoundTightener );
 
-    _rowBoundTightener->setDimensions();
-    _constraintBoundTightener->setDimensions();
-
     // Register the constraint bound tightener to all the PL constraints
     for ( auto &plConstraint : _preprocessedQuery.getPiecewiseLinearConstraints() )
         plConstraint->registerConstraintBoundTightener( _constraintBoundTightener );
@@ -1032,14 +1229,6 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
         constraint->registerAsWatcher( _tableau );
         constraint->setStatistics( &_statistics );
     }
-
-    _tableau->initializeTableau( initialBasis );
-
-    _costFunctionManager->initialize();
-    _tableau->registerCostFunctionManager( _costFunctionManager );
-    _activeEntryStrategy->initialize( _tableau );
-
-    _statistics.setNumPlConstraints( _plConstraints.size() );
 }
 
 void Engine::initializeNetworkLevelReasoning()
@@ -1110,6 +1299,37 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
     return true;
 }
 
+void Engine::initializeFromEngine( const Engine &other )
+{
+    log( "initializeFromEngine starting\n" );
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    // The preprocessed query already includes the auxiliary variables
+    _preprocessingEnabled = other._preprocessingEnabled;
+    other._preprocessor.storeVariableMappingsIntoOther( _preprocessor );
+    _preprocessedQuery = other._preprocessedQuery;
+
+    storeEquationsInDegradationChecker();
+    initializeNetworkLevelReasoning();
+
+    // Copy the initial tableau, including its basis factorization
+    TableauState *tableauState = new TableauState;
+    if ( !tableauState )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::tableauState" );
+
+    other._tableau->storeCompleteState( *tableauState );
+    initializeTableau( *tableauState );
+    delete tableauState;
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.setPreprocessingTime( TimeUtils::timePassed( start, end ) );
+
+    log( "initializeFromEngine done\n" );
+
+    _smtCore.storeDebuggingSolution( _preprocessedQuery._debuggingSolution );
+}
+
 void Engine::extractSolution( InputQuery &inputQuery )
 {
     for ( unsigned i = 0; i < inputQuery.getNumberOfVariables(); ++i )
@@ -1555,6 +1775,21 @@ bool Engine::highDegradation()
     return result;
 }
 
+void Engine::refactorizeOnModerateDegradation()
+{
+    /*
+      A milder degradation typically stems from an aging basis
+      factorization. Refactorizing and recomputing the basic
+      assignment is much cheaper than a precision restoration.
+    */
+    if ( FloatUtils::gt( _statistics.getCurrentDegradation(),
+                         GlobalConfiguration::DEGRADATION_REFACTORIZATION_THRESHOLD ) )
+    {
+        _tableau->refreshBasisFactorization();
+        _tableau->computeAssignment();
+    }
+}
+
 void Engine::tightenBoundsOnConstraintMatrix()
 {
     struct timespec start = TimeUtils::sampleMicro();
@@ -1587,6 +1822,23 @@ void Engine::explicitBasisBoundTightening()
     case GlobalConfiguration::USE_IMPLICIT_INVERTED_BASIS_MATRIX:
         _rowBoundTightener->examineImplicitInvertedBasisMatrix( saturation );
         break;
+
+    case GlobalConfiguration::COMPUTE_SPARSE_BASIS_ROWS:
+    {
+        // Bounds on the variables of unfixed constraints may fix their phases
+        List<unsigned> priorityVariables;
+        for ( const auto &constraint : _plConstraints )
+        {
+            if ( constraint->isActive() && !constraint->phaseFixed() )
+            {
+                for ( const auto &variable : constraint->getParticipatingVariables() )
+                    priorityVariables.append( variable );
+            }
+        }
+
+        _rowBoundTightener->examineSparseBasisRows( priorityVariables, saturation );
+        break;
+    }
     }
 
     struct timespec end = TimeUtils::sampleMicro();
@@ -1601,6 +1853,9 @@ void Engine::performPrecisionRestoration( PrecisionRestorer::RestoreBasics resto
     double before = _degradationChecker.computeDegradation( *_tableau );
     //
 
+    // The restored basis is unrelated to the dual simplex weights
+    deactivateDualSimplex();
+
     _precisionRestorer.restorePrecision( *this, *_tableau, _smtCore, restoreBasics );
     struct timespec end = TimeUtils::sampleMicro();
     _statistics.addTimeForPrecisionRestoration( TimeUtils::timePassed( start, end ) );
@@ -1739,9 +1994,6 @@ void Engine::performSymbolicBoundTightening()
 
     unsigned numTightenedBounds = 0;
 
-    // Clear any previously stored information
-    _symbolicBoundTightener->clearReluStatuses();
-
     // Step 1: tell the SBT about input bounds; maybe they were tightened
     unsigned inputVariableIndex = 0;
     for ( const auto &inputVariable : _preprocessedQuery.getInputVariables() )
@@ -1761,20 +2013,44 @@ void Engine::performSymbolicBoundTightening()
         _symbolicBoundTightener->setInputUpperBound( inputVariable, max );
     }
 
-    // Step 2: tell the SBT about the state of the ReLU constraints
+    // Step 2: tell the SBT about the state of the ReLU and absolute value
+    // constraints. Max constraints have no phase information to report.
+    // Absolute value and max constraints must appear as neurons of the
+    // matching type in the SBT's topology: otherwise they would silently
+    // be ignored.
+    // The SBT keeps the results of its previous run, and only recomputes
+    // the layers affected by input bounds or phases that have changed.
     for ( const auto &constraint : _plConstraints )
     {
         if ( !constraint->supportsSymbolicBoundTightening() )
             throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_UNSUPPORTED_CONSTRAINT_TYPE );
 
-        ReluConstraint *relu = (ReluConstraint *)constraint;
-        unsigned b = relu->getB();
-        SymbolicBoundTightener::NodeIndex nodeIndex = _symbolicBoundTightener->nodeIndexFromB( b );
-        _symbolicBoundTightener->setReluStatus( nodeIndex._layer, nodeIndex._neuron, relu->getPhaseStatus() );
+        if ( ReluConstraint *relu = dynamic_cast<ReluConstraint *>( constraint ) )
+        {
+            unsigned b = relu->getB();
+            SymbolicBoundTightener::NodeIndex nodeIndex = _symbolicBoundTightener->nodeIndexFromB( b );
+            _symbolicBoundTightener->setReluStatus( nodeIndex._layer, nodeIndex._neuron, relu->getPhaseStatus() );
+        }
+        else if ( AbsoluteValueConstraint *abs = dynamic_cast<AbsoluteValueConstraint *>( constraint ) )
+        {
+            unsigned b = abs->getB();
+            if ( !_symbolicBoundTightener->hasAbsoluteValueNodeForB( b ) )
+                throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_UNSUPPORTED_CONSTRAINT_TYPE,
+                                    Stringf( "Absolute value constraint on x%u has no absolute value neuron in the SBT", b ).ascii() );
+
+            SymbolicBoundTightener::NodeIndex nodeIndex = _symbolicBoundTightener->nodeIndexFromB( b );
+            _symbolicBoundTightener->setAbsoluteValueStatus( nodeIndex._layer, nodeIndex._neuron, abs->getPhaseStatus() );
+        }
+        else if ( MaxConstraint *max = dynamic_cast<MaxConstraint *>( constraint ) )
+        {
+            if ( !_symbolicBoundTightener->hasMaxNodeForF( max->getF() ) )
+                throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_UNSUPPORTED_CONSTRAINT_TYPE,
+                                    Stringf( "Max constraint on x%u has no max neuron in the SBT", max->getF() ).ascii() );
+        }
     }
 
     // Step 3: perfrom the bound tightening
-    _symbolicBoundTightener->run();
+    _symbolicBoundTightener->run( _configuration._useLinearConcretization );
 
     // Stpe 4: extract any tighter bounds that were discovered
     for ( const auto &pair : _symbolicBoundTightener->getNodeIndexToFMapping() )
@@ -1804,6 +2080,132 @@ void Engine::performSymbolicBoundTightening()
     _statistics.incNumTighteningsFromSymbolicBoundTightening( numTightenedBounds );
 }
 
+void Engine::performBackSubstitutionBoundTightening()
+{
+    if ( ( !GlobalConfiguration::USE_BACK_SUBSTITUTION_BOUND_TIGHTENING ) ||
+         ( !_networkLevelReasoner ) )
+        return;
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    unsigned numTightenedBounds = 0;
+
+    // Step 1: report the current bounds of the inputs and of all the
+    // variables that correspond to neurons
+    _networkLevelReasoner->clearBounds();
+
+    for ( unsigned i = 0; i < _preprocessedQuery.getNumInputVariables(); ++i )
+    {
+        unsigned variable = _preprocessedQuery.inputVariableByIndex( i );
+        _networkLevelReasoner->setInputBounds( i,
+                                               _tableau->getLowerBound( variable ),
+                                               _tableau->getUpperBound( variable ) );
+    }
+
+    for ( const auto &pair : _networkLevelReasoner->getIndexToWeightedSumVariable() )
+    {
+        unsigned variable = pair.second;
+        _networkLevelReasoner->setWeightedSumBounds( pair.first._layer,
+                                                     pair.first._neuron,
+                                                     _tableau->getLowerBound( variable ),
+                                                     _tableau->getUpperBound( variable ) );
+    }
+
+    for ( const auto &pair : _networkLevelReasoner->getIndexToActivationResultVariable() )
+    {
+        unsigned variable = pair.second;
+        _networkLevelReasoner->setActivationResultBounds( pair.first._layer,
+                                                          pair.first._neuron,
+                                                          _tableau->getLowerBound( variable ),
+                                                          _tableau->getUpperBound( variable ) );
+    }
+
+    // Step 2: perform the back-substitution
+    _networkLevelReasoner->performBackSubstitution();
+
+    // Step 3: extract any tighter bounds that were discovered
+    List<Tightening> tightenings;
+    _networkLevelReasoner->getConstraintTightenings( tightenings );
+
+    for ( const auto &tightening : tightenings )
+    {
+        if ( tightening._type == Tightening::LB &&
+             FloatUtils::gt( tightening._value, _tableau->getLowerBound( tightening._variable ) ) )
+        {
+            _tableau->tightenLowerBound( tightening._variable, tightening._value );
+            ++numTightenedBounds;
+        }
+
+        if ( tightening._type == Tightening::UB &&
+             FloatUtils::lt( tightening._value, _tableau->getUpperBound( tightening._variable ) ) )
+        {
+            _tableau->tightenUpperBound( tightening._variable, tightening._value );
+            ++numTightenedBounds;
+        }
+    }
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.addTimeForBackSubstitutionBoundTightening( TimeUtils::timePassed( start, end ) );
+    _statistics.incNumTighteningsFromBackSubstitutionBoundTightening( numTightenedBounds );
+}
+
+bool Engine::performLpBoundTightening( unsigned numWorkers )
+{
+    log( "performLpBoundTightening starting\n" );
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    unsigned numTightenedBounds = 0;
+
+    // Step 1: create a copy of the query with the current bounds
+    InputQuery query = _preprocessedQuery;
+    for ( unsigned i = 0; i < query.getNumberOfVariables(); ++i )
+    {
+        query.setLowerBound( i, _tableau->getLowerBound( i ) );
+        query.setUpperBound( i, _tableau->getUpperBound( i ) );
+    }
+
+    // Step 2: tighten the bounds of the copy
+    LPBoundTightener lpBoundTightener( numWorkers );
+    bool feasible = lpBoundTightener.tighten( query );
+
+    // Step 3: apply the tighter bounds that were discovered
+    if ( feasible )
+    {
+        for ( unsigned i = 0; i < query.getNumberOfVariables(); ++i )
+        {
+            if ( FloatUtils::gt( query.getLowerBound( i ), _tableau->getLowerBound( i ) ) )
+            {
+                _tableau->tightenLowerBound( i, query.getLowerBound( i ) );
+                ++numTightenedBounds;
+            }
+
+            if ( FloatUtils::lt( query.getUpperBound( i ), _tableau->getUpperBound( i ) ) )
+            {
+                _tableau->tightenUpperBound( i, query.getUpperBound( i ) );
+                ++numTightenedBounds;
+            }
+        }
+    }
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.addTimeForLpBoundTightening( TimeUtils::timePassed( start, end ) );
+    _statistics.incNumTighteningsFromLpBoundTightening( numTightenedBounds );
+
+    log( Stringf( "performLpBoundTightening done. Tightened %u bounds\n", numTightenedBounds ) );
+
+    if ( !feasible )
+    {
+        _exitCode = Engine::UNSAT;
+        return false;
+    }
+
+    if ( _verbosity > 0 )
+        printf( "Engine::performLpBoundTightening: tightened %u bounds\n", numTightenedBounds );
+
+    return true;
+}
+
 bool Engine::shouldExitDueToTimeout( unsigned timeout ) const
 {
     enum {
@@ -1850,6 +2252,10 @@ void Engine::resetSmtCore()
 {
     _smtCore.freeMemory();
     _smtCore = SmtCore( this );
+
+    // The new SmtCore needs to follow this engine's configuration
+    _smtCore.setConstraintViolationThreshold( _configuration._constraintViolationThreshold );
+    _smtCore.setSplittingStrategy( _configuration._splittingStrategy );
 }
 
 void Engine::resetExitCode()
@@ -1966,17 +2372,140 @@ void Engine::updateScores()
 
 PiecewiseLinearConstraint *Engine::pickSplitPLConstraint()
 {
+    if ( _configuration._splittingStrategy == DivideStrategy::EarliestReLU )
+    {
+        if ( _plConstraintsInTopologicalOrder.size() != _plConstraints.size() )
+            storePLConstraintsInTopologicalOrder();
+
+        for ( const auto &constraint : _plConstraintsInTopologicalOrder )
+        {
+            if ( constraint->isActive() && !constraint->phaseFixed() )
+                return constraint;
+        }
+    }
+
     updateScores();
     auto constraint = *_candidatePlConstraints.begin();
     _candidatePlConstraints.erase( constraint );
     return constraint;
 }
 
+PiecewiseLinearConstraint *Engine::pickSplitPLConstraintForDivide( DivideStrategy strategy )
+{
+    if ( _plConstraintsInTopologicalOrder.size() != _plConstraints.size() )
+        storePLConstraintsInTopologicalOrder();
+
+    // Fix the phases of the constraints implied by the current bounds
+    performSymbolicBoundTightening();
+    performBackSubstitutionBoundTightening();
+
+    PiecewiseLinearConstraint *candidate = NULL;
+    unsigned maxViolations = 0;
+    for ( const auto &constraint : _plConstraintsInTopologicalOrder )
+    {
+        if ( !constraint->isActive() || constraint->phaseFixed() )
+            continue;
+
+        // The divider expects a two-way split, so only ReLUs qualify
+        if ( !dynamic_cast<ReluConstraint *>( constraint ) )
+            continue;
+
+        if ( strategy == DivideStrategy::EarliestReLU )
+            return constraint;
+
+        ASSERT( strategy == DivideStrategy::ReLUViolation );
+
+        // The counts cover the solving since the last reset(), i.e. the
+        // current sub-query. Ties, including the case where nothing was
+        // violated yet, are broken in favor of the earliest constraint
+        unsigned violations = _smtCore.getTotalViolationCounts( constraint );
+        if ( !candidate || violations > maxViolations )
+        {
+            candidate = constraint;
+            maxViolations = violations;
+        }
+    }
+
+    return candidate;
+}
+
+void Engine::storePLConstraintsInTopologicalOrder()
+{
+    _plConstraintsInTopologicalOrder.clear();
+
+    if ( !_networkLevelReasoner )
+    {
+        _plConstraintsInTopologicalOrder = _plConstraints;
+        return;
+    }
+
+    Map<unsigned, PiecewiseLinearConstraint *> variableToConstraint;
+    for ( const auto &constraint : _plConstraints )
+        for ( const auto &variable : constraint->getParticipatingVariables() )
+            variableToConstraint[variable] = constraint;
+
+    // The indices are sorted by layer, and then by neuron
+    Set<PiecewiseLinearConstraint *> ordered;
+    for ( const auto &pair : _networkLevelReasoner->getIndexToWeightedSumVariable() )
+    {
+        unsigned variable = pair.second;
+        if ( !variableToConstraint.exists( variable ) )
+            continue;
+
+        PiecewiseLinearConstraint *constraint = variableToConstraint[variable];
+        if ( ordered.exists( constraint ) )
+            continue;
+
+        _plConstraintsInTopologicalOrder.append( constraint );
+        ordered.insert( constraint );
+    }
+
+    for ( const auto &constraint : _plConstraints )
+        if ( !ordered.exists( constraint ) )
+            _plConstraintsInTopologicalOrder.append( constraint );
+}
+
 void Engine::setConstraintViolationThreshold( unsigned threshold )
 {
+    _configuration._constraintViolationThreshold = threshold;
     _smtCore.setConstraintViolationThreshold( threshold );
 }
 
+void Engine::setConfiguration( const EngineConfiguration &configuration )
+{
+    _configuration = configuration;
+
+    _smtCore.setConstraintViolationThreshold( _configuration._constraintViolationThreshold );
+    _smtCore.setSplittingStrategy( _configuration._splittingStrategy );
+    _rowBoundTightener->setNumWorkers( _configuration._numBoundTighteningWorkers );
+
+    switch ( _configuration._entryStrategy )
+    {
+    case EngineConfiguration::DANTZIG:
+        _activeEntryStrategy = &_dantzigsRule;
+        break;
+
+    case EngineConfiguration::BLAND:
+        _activeEntryStrategy = &_blandsRule;
+        break;
+
+    case EngineConfiguration::DEVEX:
+        _activeEntryStrategy = &_devexRule;
+        break;
+
+    default:
+        _activeEntryStrategy = _projectedSteepestEdgeRule;
+        break;
+    }
+
+    _activeEntryStrategy->setStatistics( &_statistics );
+}
+
+const EngineConfiguration &Engine::getConfiguration() const
+{
+    return _configuration;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
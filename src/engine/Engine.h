@@ -24,7 +24,10 @@
 #include "BlandsRule.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
+#include "DevexRule.h"
 #include "DivideStrategy.h"
+#include "DualSimplex.h"
+#include "EngineConfiguration.h"
 #include "IEngine.h"
 #include "InputQuery.h"
 #include "Map.h"
@@ -44,6 +47,7 @@ class EngineState;
 class InputQuery;
 class PiecewiseLinearConstraint;
 class String;
+class TableauState;
 
 class Engine : public IEngine, public SignalHandler::Signalable
 {
@@ -65,6 +69,15 @@ public:
     bool processInputQuery( InputQuery &inputQuery );
     bool processInputQuery( InputQuery &inputQuery, bool preprocess );
 
+    /*
+      Initialize the engine from another engine, which has already
+      successfully processed its input query (as part of DnC mode).
+      The preprocessed query and the initial tableau, including its
+      basis factorization, are copied from the other engine, so that
+      preprocessing and basis selection are not repeated.
+    */
+    void initializeFromEngine( const Engine &other );
+
     /*
       If the query is feasiable and has been successfully solved, this
       method can be used to extract the solution.
@@ -133,6 +146,11 @@ public:
     */
     PiecewiseLinearConstraint *pickSplitPLConstraint();
 
+    /*
+      Pick the unfixed ReLU constraint for dividing the query in DnC
+    */
+    PiecewiseLinearConstraint *pickSplitPLConstraintForDivide( DivideStrategy strategy );
+
     /*
       Update the scores of each candidate splitting PL constraints
     */
@@ -143,6 +161,23 @@ public:
     */
     void setConstraintViolationThreshold( unsigned threshold );
 
+    /*
+      Set the search parameters of this engine. Should be called before
+      the engine is initialized (via processInputQuery() or
+      initializeFromEngine()), so that the entry strategy is initialized
+      with the tableau.
+    */
+    void setConfiguration( const EngineConfiguration &configuration );
+    const EngineConfiguration &getConfiguration() const;
+
+    /*
+      Tighten the bounds of the weighted sums of the ReLUs by solving LP
+      relaxations of the query, using the given number of threads. Should
+      be called after the input query has been processed, and before
+      solving. Returns false if the query is found to be infeasible.
+    */
+    bool performLpBoundTightening( unsigned numWorkers );
+
     /*
       PSA: The following two methods are for DnC only and should be used very
       cautiously.
@@ -191,6 +226,12 @@ private:
     */
     Set<PiecewiseLinearConstraint *> _candidatePlConstraints;
 
+    /*
+      The piecewise-linear constraints, ordered by the layers of the
+      network in which they appear. Computed on demand for DnC.
+    */
+    List<PiecewiseLinearConstraint *> _plConstraintsInTopologicalOrder;
+
     /*
       Piecewise linear constraints that are currently violated.
     */
@@ -211,9 +252,15 @@ private:
     */
     BlandsRule _blandsRule;
     DantzigsRule _dantzigsRule;
+    DevexRule _devexRule;
     AutoProjectedSteepestEdgeRule _projectedSteepestEdgeRule;
     EntrySelectionStrategy *_activeEntryStrategy;
 
+    /*
+      The search parameters of this engine.
+    */
+    EngineConfiguration _configuration;
+
     /*
       Bound tightener.
     */
@@ -323,12 +370,40 @@ private:
     unsigned _lastNumVisitedStates;
     unsigned long long _lastIterationWithProgress;
 
+    /*
+      Dual simplex pivot selection, used for re-solving the tableau
+      after a split. _dualSimplexActive indicates whether the next
+      simplex steps should be dual steps, _numDualSimplexSteps
+      counts the dual steps performed since the last split, and
+      _dualSimplexInfeasibility is the total infeasibility observed
+      before the last dual step.
+    */
+    DualSimplex _dualSimplex;
+    bool _dualSimplexActive;
+    unsigned _numDualSimplexSteps;
+    double _dualSimplexInfeasibility;
+
     /*
       Perform a simplex step: compute the cost function, pick the
       entering and leaving variables and perform a pivot.
     */
     void performSimplexStep();
 
+    /*
+      Perform a dual simplex step: pick an out-of-bounds basic
+      variable, and pivot it out of the basis so that it reaches its
+      violated bound. If no suitable pivot exists, either prove that
+      the current query is infeasible or fall back to primal steps.
+    */
+    void performDualSimplexStep();
+
+    /*
+      Switch to dual simplex steps after the bounds have changed due
+      to a split, and back to primal steps.
+    */
+    void activateDualSimplex();
+    void deactivateDualSimplex();
+
     /*
       Perform a constraint-fixing step: select a violated piece-wise
       linear constraint and attempt to fix it.
@@ -399,6 +474,13 @@ private:
     bool shouldCheckDegradation();
     bool highDegradation();
 
+    /*
+      Refactorize the basis if the degradation measured by the last
+      call to highDegradation() is moderate, i.e. above
+      DEGRADATION_REFACTORIZATION_THRESHOLD.
+    */
+    void refactorizeOnModerateDegradation();
+
     /*
       Perform bound tightening on the constraint matrix A.
     */
@@ -440,6 +522,12 @@ private:
     */
     void performSymbolicBoundTightening();
 
+    /*
+      Perform a round of back-substitution bound tightening using the
+      network-level reasoner, starting from the current bounds.
+    */
+    void performBackSubstitutionBoundTightening();
+
     /*
       Check whether a timeout value has been provided and exceeded.
     */
@@ -468,6 +556,8 @@ private:
     void removeRedundantEquations( const double *constraintMatrix );
     void selectInitialVariablesForBasis( const double *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows );
     void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
+    void initializeTableau( const TableauState &tableauState );
+    void registerTableauWatchers();
     void initializeNetworkLevelReasoning();
     double *createConstraintMatrix();
     void addAuxiliaryVariables();
@@ -478,6 +568,13 @@ private:
       to handle case splits
     */
     void updateDirections();
+
+    /*
+      Order the PL constraints according to the layers of the network
+      in which they appear, using the network level reasoner. Constraints
+      that do not correspond to a neuron are placed last.
+    */
+    void storePLConstraintsInTopologicalOrder();
 };
 
 #endif // __Engine_h__
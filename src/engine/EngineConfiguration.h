@@ -0,0 +1,139 @@
+/*********************                                                        */
+/*! \file EngineConfiguration.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __EngineConfiguration_h__
+#define __EngineConfiguration_h__
+
+#include "DivideStrategy.h"
+#include "GlobalConfiguration.h"
+#include "MarabouError.h"
+#include "MStringf.h"
+
+/*
+  Search parameters that may differ between engines running in the same
+  process (e.g., in portfolio mode). The defaults are taken from the
+  GlobalConfiguration, so a default-constructed configuration reproduces
+  the behavior of a stand-alone engine.
+*/
+struct EngineConfiguration
+{
+    enum EntryStrategy {
+        PROJECTED_STEEPEST_EDGE = 0,
+        DANTZIG,
+        BLAND,
+        DEVEX,
+    };
+
+    EngineConfiguration()
+        : _entryStrategy( PROJECTED_STEEPEST_EDGE )
+        , _splittingStrategy( (DivideStrategy)GlobalConfiguration::SPLITTING_HEURISTICS )
+        , _constraintViolationThreshold( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+        , _useLinearConcretization( GlobalConfiguration::USE_LINEAR_CONCRETIZATION )
+        , _useExplicitBasisBoundTightening( true )
+        , _numBoundTighteningWorkers( 1 )
+        , _useDualSimplexAfterSplits( GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_SPLITS )
+    {
+    }
+
+    /*
+      Parse the name of an entry strategy, as given on the command
+      line. Throws if the name is unknown.
+    */
+    static EntryStrategy parseEntryStrategy( const String &name )
+    {
+        if ( name == "pse" )
+            return PROJECTED_STEEPEST_EDGE;
+        if ( name == "dantzig" )
+            return DANTZIG;
+        if ( name == "bland" )
+            return BLAND;
+        if ( name == "devex" )
+            return DEVEX;
+
+        throw MarabouError( MarabouError::UNKNOWN_ENTRY_STRATEGY, name.ascii() );
+    }
+
+    String toString() const
+    {
+        String entryStrategy =
+            ( _entryStrategy == PROJECTED_STEEPEST_EDGE ) ? "pse" :
+            ( _entryStrategy == DANTZIG ) ? "dantzig" :
+            ( _entryStrategy == DEVEX ) ? "devex" : "bland";
+
+        String splittingStrategy =
+            ( _splittingStrategy == DivideStrategy::EarliestReLU ) ? "earliest-relu" :
+            ( _splittingStrategy == DivideStrategy::ReLUViolation ) ? "relu-violation" :
+            "largest-interval";
+
+        return Stringf( "entry=%s, splitting=%s, threshold=%u, concretization=%s",
+                        entryStrategy.ascii(),
+                        splittingStrategy.ascii(),
+                        _constraintViolationThreshold,
+                        _useLinearConcretization ? "linear" : "constant" );
+    }
+
+    /*
+      The rule used for picking the entering variable
+    */
+    EntryStrategy _entryStrategy;
+
+    /*
+      How SmtCore picks the constraint to split on, once a constraint
+      has been violated too many times
+    */
+    DivideStrategy _splittingStrategy;
+
+    /*
+      The number of times a constraint may be violated before a split
+      is performed
+    */
+    unsigned _constraintViolationThreshold;
+
+    /*
+      Whether symbolic bound tightening uses linear (rather than constant)
+      concretization of inactive ReLUs
+    */
+    bool _useLinearConcretization;
+
+    /*
+      Whether bounds are tightened using the explicit basis whenever it
+      is available. Engines that only solve LPs, with no piecewise
+      linear constraints to fix, gain little from it.
+    */
+    bool _useExplicitBasisBoundTightening;
+
+    /*
+      The number of threads used for bound tightening on the
+      constraint matrix. Engines that share the process with other
+      engines (DnC, portfolio) leave the cores to them and use one.
+    */
+    unsigned _numBoundTighteningWorkers;
+
+    /*
+      Whether the LP of a child node is re-solved with the dual simplex
+      method, starting from the basis inherited from its parent
+    */
+    bool _useDualSimplexAfterSplits;
+};
+
+#endif // __EngineConfiguration_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
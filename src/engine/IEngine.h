@@ -16,6 +16,7 @@
 #ifndef __IEngine_h__
 #define __IEngine_h__
 
+#include "DivideStrategy.h"
 #include "List.h"
 
 #ifdef _WIN32
@@ -77,6 +78,14 @@ public:
     */
     virtual PiecewiseLinearConstraint *pickSplitPLConstraint() = 0;
 
+    /*
+      Methods for DnC: pick the unfixed ReLU constraint to split on
+      when dividing the current query, according to a divide strategy.
+      Other piecewise linear constraints are never picked. Returns NULL
+      if all ReLUs are fixed.
+    */
+    virtual PiecewiseLinearConstraint *pickSplitPLConstraintForDivide( DivideStrategy strategy ) = 0;
+
 };
 
 #endif // __IEngine_h__
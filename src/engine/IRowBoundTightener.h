@@ -56,6 +56,16 @@ public:
     */
     virtual void examineImplicitInvertedBasisMatrix( bool untilSaturation ) = 0;
 
+    /*
+      Derive and enqueue new bounds using some of the rows of the
+      inverse of the explicit basis matrix, computed one at a time with
+      sparse BTRANs. Rows whose basic variables appear in the given
+      list are examined first. Stops when the row or work budget
+      is exhausted.
+    */
+    virtual void examineSparseBasisRows( const List<unsigned> &priorityVariables,
+                                         bool untilSaturation ) = 0;
+
     /*
       Derive and enqueue new bounds for all varaibles, using the
       original constraint matrix A and right hands side vector b. Can
@@ -80,6 +90,12 @@ public:
       Have the Bound Tightener start reporting statistics.
      */
     virtual void setStatistics( Statistics *statistics ) = 0;
+
+    /*
+      Set the number of threads used when examining the constraint
+      matrix.
+    */
+    virtual void setNumWorkers( unsigned numWorkers ) = 0;
 };
 
 #endif // __IRowBoundTightener_h__
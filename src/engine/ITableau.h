@@ -126,13 +126,14 @@ public:
     virtual unsigned getLeavingVariableIndex() const = 0;
     virtual double getChangeRatio() const = 0;
     virtual void setChangeRatio( double changeRatio ) = 0;
+    virtual void setLeavingVariableIncreases( bool increases ) = 0;
     virtual bool performingFakePivot() const = 0;
     virtual void performPivot() = 0;
     virtual double ratioConstraintPerBasic( unsigned basicIndex, double coefficient, bool decrease ) = 0;
     virtual bool isBasic( unsigned variable ) const = 0;
     virtual void setNonBasicAssignment( unsigned variable, double value, bool updateBasics ) = 0;
     virtual void computeCostFunction() = 0;
-    virtual void getEntryCandidates( List<unsigned> &candidates ) const = 0;
+    virtual void getEntryCandidates( List<unsigned> &candidates ) = 0;
     virtual const double *getCostFunction() const = 0;
     virtual void computeChangeColumn() = 0;
     virtual const double *getChangeColumn() const = 0;
@@ -152,7 +153,6 @@ public:
     virtual unsigned getM() const = 0;
     virtual unsigned getN() const = 0;
     virtual void getTableauRow( unsigned index, TableauRow *row ) = 0;
-    virtual const double *getAColumn( unsigned variable ) const = 0;
     virtual void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const = 0;
     virtual void getSparseARow( unsigned row, SparseUnsortedList *result ) const = 0;
     virtual const SparseUnsortedList *getSparseAColumn( unsigned variable ) const = 0;
@@ -161,10 +161,17 @@ public:
     virtual void performDegeneratePivot() = 0;
     virtual void storeState( TableauState &state ) const = 0;
     virtual void restoreState( const TableauState &state ) = 0;
+    virtual void storeCompleteState( TableauState &state ) const = 0;
     virtual void setStatistics( Statistics *statistics ) = 0;
     virtual const double *getRightHandSide() const = 0;
     virtual void forwardTransformation( const double *y, double *x ) const = 0;
     virtual void backwardTransformation( const double *y, double *x ) const = 0;
+    virtual void sparseBackwardTransformation( const double *y,
+                                               const unsigned *yIndices,
+                                               unsigned yNnz,
+                                               double *x,
+                                               unsigned *xIndices,
+                                               unsigned &xNnz ) const = 0;
     virtual double getSumOfInfeasibilities() const = 0;
     virtual BasicAssignmentStatus getBasicAssignmentStatus() const = 0;
     virtual double getBasicAssignment( unsigned basicIndex ) const = 0;
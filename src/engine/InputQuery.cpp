@@ -13,12 +13,16 @@
 
  **/
 
+#include "AbsoluteValueConstraint.h"
 #include "AutoFile.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MStringf.h"
 #include "MarabouError.h"
+#include "MaxConstraint.h"
+#include "Set.h"
+#include "Vector.h"
 
 InputQuery::InputQuery()
     : _networkLevelReasoner( NULL )
@@ -203,6 +207,9 @@ void InputQuery::mergeIdenticalVariables( unsigned v1, unsigned v2 )
         }
     }
 
+    if ( _sbt )
+        _sbt->mergeVariables( v1, v2 );
+
     // TODO: update lower and upper bounds
 }
 
@@ -566,6 +573,372 @@ NetworkLevelReasoner *InputQuery::getNetworkLevelReasoner() const
     return _networkLevelReasoner;
 }
 
+/*
+  A neuron discovered while constructing the symbolic bound tightener.
+  f is the variable that holds the neuron's value. For ReLU and
+  absolute value neurons, b is the weighted sum that feeds the
+  activation.
+*/
+struct DiscoveredNeuron
+{
+    DiscoveredNeuron()
+        : _bias( 0 )
+        , _hasB( false )
+        , _b( 0 )
+        , _f( 0 )
+    {
+    }
+
+    double _bias;
+    Map<SymbolicBoundTightener::NodeIndex, double> _weights;
+    List<SymbolicBoundTightener::NodeIndex> _maxSources;
+    bool _hasB;
+    unsigned _b;
+    unsigned _f;
+};
+
+struct DiscoveredLayer
+{
+    DiscoveredLayer( SymbolicBoundTightener::LayerType type )
+        : _type( type )
+    {
+    }
+
+    SymbolicBoundTightener::LayerType _type;
+    Vector<DiscoveredNeuron> _neurons;
+};
+
+bool InputQuery::constructSymbolicBoundTightener()
+{
+    if ( _sbt )
+        return true;
+
+    // The SBT identifies input neuron i with variable i
+    unsigned numInputs = getNumInputVariables();
+    if ( numInputs == 0 )
+        return false;
+
+    for ( unsigned i = 0; i < numInputs; ++i )
+    {
+        if ( inputVariableByIndex( i ) != i )
+            return false;
+    }
+
+    // Index the activations by their b variables, and collect the
+    // variables that the constraints define
+    Map<unsigned, unsigned> activationBToF;
+    Set<unsigned> absoluteValueBs;
+    List<const MaxConstraint *> maxConstraints;
+    Set<unsigned> constraintOutputs;
+    Set<unsigned> maxElements;
+
+    for ( const auto &constraint : _plConstraints )
+    {
+        unsigned b;
+        unsigned f;
+
+        if ( const ReluConstraint *relu = dynamic_cast<const ReluConstraint *>( constraint ) )
+        {
+            b = relu->getB();
+            f = relu->getF();
+        }
+        else if ( const AbsoluteValueConstraint *abs = dynamic_cast<const AbsoluteValueConstraint *>( constraint ) )
+        {
+            b = abs->getB();
+            f = abs->getF();
+            absoluteValueBs.insert( b );
+        }
+        else if ( const MaxConstraint *max = dynamic_cast<const MaxConstraint *>( constraint ) )
+        {
+            if ( constraintOutputs.exists( max->getF() ) )
+                return false;
+
+            constraintOutputs.insert( max->getF() );
+            maxConstraints.append( max );
+            for ( unsigned element : max->getElements() )
+                maxElements.insert( element );
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+
+        if ( activationBToF.exists( b ) || constraintOutputs.exists( f ) )
+            return false;
+
+        activationBToF[b] = f;
+        constraintOutputs.insert( f );
+    }
+
+    // A weighted sum can be merged into the activation it feeds only if
+    // nothing else refers to it
+    Map<unsigned, unsigned> equationCount;
+    List<const Equation *> pendingEquations;
+    for ( const auto &equation : _equations )
+    {
+        if ( equation._type != Equation::EQ )
+            continue;
+
+        pendingEquations.append( &equation );
+        for ( unsigned variable : equation.getParticipatingVariables() )
+        {
+            if ( !equationCount.exists( variable ) )
+                equationCount[variable] = 0;
+            ++equationCount[variable];
+        }
+    }
+
+    Vector<DiscoveredLayer> layers;
+    Map<unsigned, SymbolicBoundTightener::NodeIndex> variableToNode;
+
+    DiscoveredLayer inputLayer( SymbolicBoundTightener::INPUT );
+    for ( unsigned i = 0; i < numInputs; ++i )
+    {
+        DiscoveredNeuron neuron;
+        neuron._f = i;
+        inputLayer._neurons.append( neuron );
+        variableToNode[i] = SymbolicBoundTightener::NodeIndex( 0, i );
+    }
+    layers.append( inputLayer );
+
+    Set<unsigned> handledActivations;
+    Set<unsigned> handledMaxConstraints;
+
+    // Every round only depends on the neurons of earlier rounds, and
+    // adds up to one layer of each type
+    bool progress = true;
+    while ( progress )
+    {
+        DiscoveredLayer weightedSums( SymbolicBoundTightener::WEIGHTED_SUM );
+        DiscoveredLayer relus( SymbolicBoundTightener::RELU );
+        DiscoveredLayer absoluteValues( SymbolicBoundTightener::ABSOLUTE_VALUE );
+        DiscoveredLayer maxes( SymbolicBoundTightener::MAX );
+        Set<unsigned> definedVariables;
+
+        // An equation with a single unhandled variable defines it as a
+        // weighted sum of handled ones
+        auto it = pendingEquations.begin();
+        while ( it != pendingEquations.end() )
+        {
+            const Equation &equation = **it;
+
+            Map<unsigned, double> coefficients;
+            for ( const auto &addend : equation._addends )
+            {
+                if ( !coefficients.exists( addend._variable ) )
+                    coefficients[addend._variable] = 0;
+                coefficients[addend._variable] += addend._coefficient;
+            }
+
+            unsigned numUnhandled = 0;
+            unsigned variable = 0;
+            for ( const auto &pair : coefficients )
+            {
+                if ( pair.second != 0 && !variableToNode.exists( pair.first ) )
+                {
+                    ++numUnhandled;
+                    variable = pair.first;
+                }
+            }
+
+            if ( numUnhandled == 0 )
+            {
+                // The equation only restricts handled variables
+                it = pendingEquations.erase( it );
+                continue;
+            }
+
+            if ( numUnhandled > 1 ||
+                 FloatUtils::isZero( coefficients[variable] ) ||
+                 definedVariables.exists( variable ) ||
+                 constraintOutputs.exists( variable ) )
+            {
+                ++it;
+                continue;
+            }
+
+            // c * variable + sum( a_i * x_i ) = scalar, so
+            // variable = scalar / c - sum( a_i / c * x_i )
+            double coefficient = coefficients[variable];
+            DiscoveredNeuron neuron;
+            neuron._bias = equation._scalar / coefficient;
+            for ( const auto &pair : coefficients )
+            {
+                if ( pair.first == variable || pair.second == 0 )
+                    continue;
+
+                SymbolicBoundTightener::NodeIndex source = variableToNode[pair.first];
+                if ( !neuron._weights.exists( source ) )
+                    neuron._weights[source] = 0;
+                neuron._weights[source] -= pair.second / coefficient;
+            }
+
+            definedVariables.insert( variable );
+
+            bool merge =
+                activationBToF.exists( variable ) &&
+                equationCount[variable] == 1 &&
+                !maxElements.exists( variable ) &&
+                !variableToNode.exists( activationBToF[variable] );
+
+            if ( merge )
+            {
+                neuron._hasB = true;
+                neuron._b = variable;
+                neuron._f = activationBToF[variable];
+                handledActivations.insert( variable );
+
+                if ( absoluteValueBs.exists( variable ) )
+                    absoluteValues._neurons.append( neuron );
+                else
+                    relus._neurons.append( neuron );
+            }
+            else
+            {
+                neuron._f = variable;
+                weightedSums._neurons.append( neuron );
+            }
+
+            it = pendingEquations.erase( it );
+        }
+
+        // Activations whose weighted sums are neurons of their own
+        for ( const auto &pair : activationBToF )
+        {
+            unsigned b = pair.first;
+            unsigned f = pair.second;
+
+            if ( handledActivations.exists( b ) ||
+                 !variableToNode.exists( b ) ||
+                 variableToNode.exists( f ) )
+                continue;
+
+            DiscoveredNeuron neuron;
+            neuron._weights[variableToNode[b]] = 1;
+            neuron._hasB = true;
+            neuron._b = b;
+            neuron._f = f;
+            handledActivations.insert( b );
+
+            if ( absoluteValueBs.exists( b ) )
+                absoluteValues._neurons.append( neuron );
+            else
+                relus._neurons.append( neuron );
+        }
+
+        // Max constraints whose elements are all handled
+        for ( const auto &max : maxConstraints )
+        {
+            unsigned f = max->getF();
+            if ( handledMaxConstraints.exists( f ) || variableToNode.exists( f ) )
+                continue;
+
+            Set<unsigned> elements = max->getElements();
+            bool ready = !elements.empty();
+            for ( unsigned element : elements )
+            {
+                if ( !variableToNode.exists( element ) )
+                    ready = false;
+            }
+
+            if ( !ready )
+                continue;
+
+            DiscoveredNeuron neuron;
+            neuron._f = f;
+            for ( unsigned element : elements )
+                neuron._maxSources.append( variableToNode[element] );
+            handledMaxConstraints.insert( f );
+
+            maxes._neurons.append( neuron );
+        }
+
+        progress = false;
+        for ( DiscoveredLayer *layer : { &weightedSums, &relus, &absoluteValues, &maxes } )
+        {
+            if ( layer->_neurons.empty() )
+                continue;
+
+            unsigned index = layers.size();
+            for ( unsigned i = 0; i < layer->_neurons.size(); ++i )
+                variableToNode[layer->_neurons[i]._f] = SymbolicBoundTightener::NodeIndex( index, i );
+
+            layers.append( *layer );
+            progress = true;
+        }
+    }
+
+    if ( layers.size() < 2 ||
+         handledActivations.size() != activationBToF.size() ||
+         handledMaxConstraints.size() != maxConstraints.size() )
+        return false;
+
+    // Report the topology
+    SymbolicBoundTightener *sbt = new SymbolicBoundTightener;
+
+    unsigned numberOfLayers = layers.size();
+    sbt->setNumberOfLayers( numberOfLayers );
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        sbt->setLayerSize( i, layers[i]._neurons.size() );
+        if ( i > 0 )
+            sbt->setLayerType( i, layers[i]._type );
+    }
+
+    for ( unsigned i = 1; i < numberOfLayers; ++i )
+    {
+        Set<unsigned> sourceLayers;
+        for ( unsigned j = 0; j < layers[i]._neurons.size(); ++j )
+        {
+            for ( const auto &pair : layers[i]._neurons[j]._weights )
+                sourceLayers.insert( pair.first._layer );
+        }
+
+        for ( unsigned source : sourceLayers )
+            sbt->addLayerDependency( source, i );
+    }
+
+    sbt->allocateWeightAndBiasSpace();
+
+    // Weights, biases, max sources and variables
+    for ( unsigned i = 1; i < numberOfLayers; ++i )
+    {
+        for ( unsigned j = 0; j < layers[i]._neurons.size(); ++j )
+        {
+            const DiscoveredNeuron &neuron = layers[i]._neurons[j];
+
+            if ( layers[i]._type == SymbolicBoundTightener::MAX )
+            {
+                for ( const auto &source : neuron._maxSources )
+                    sbt->addMaxSource( i, j, source._layer, source._neuron );
+            }
+            else
+            {
+                sbt->setBias( i, j, neuron._bias );
+                for ( const auto &pair : neuron._weights )
+                {
+                    if ( pair.second != 0 )
+                        sbt->setWeight( pair.first._layer, pair.first._neuron, i, j, pair.second );
+                }
+            }
+
+            if ( neuron._hasB )
+                sbt->setReluBVariable( i, j, neuron._b );
+            sbt->setReluFVariable( i, j, neuron._f );
+        }
+    }
+
+    for ( unsigned i = 0; i < numInputs; ++i )
+    {
+        sbt->setInputLowerBound( i, getLowerBound( i ) );
+        sbt->setInputUpperBound( i, getUpperBound( i ) );
+    }
+
+    _sbt = sbt;
+    return true;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -98,6 +98,24 @@ public:
     */
     void setSymbolicBoundTightener( SymbolicBoundTightener *sbt );
 
+    /*
+      Construct a symbolic bound tightener from the equations and the
+      piecewise-linear constraints of the query, for queries that do
+      not come with one (e.g., queries loaded from a file). The layers
+      are discovered from the input variables outwards: an equation
+      with a single unhandled variable defines a weighted sum neuron,
+      which is merged into a ReLU or an absolute value neuron if it
+      only feeds that activation; and a max constraint becomes a max
+      neuron once all of its elements are handled. Sources may lie in
+      any earlier layer, so residual connections are supported.
+
+      Nothing is constructed, and false is returned, if the input
+      variables are not variables 0 to n - 1, if the query has
+      constraints of other types, or if some constraint cannot be
+      placed in the topology.
+    */
+    bool constructSymbolicBoundTightener();
+
     /*
       Debugging methods
     */
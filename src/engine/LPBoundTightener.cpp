@@ -0,0 +1,430 @@
+/*********************                                                        */
+/*! \file LPBoundTightener.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "Engine.h"
+#include "EngineState.h"
+#include "Equation.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "LPBoundTightener.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "Map.h"
+#include "NetworkLevelReasoner.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "ReluConstraint.h"
+
+#include <atomic>
+#include <list>
+#include <thread>
+
+LPBoundTightener::LPBoundTightener( unsigned numWorkers )
+    : _numWorkers( numWorkers > 0 ? numWorkers : 1 )
+    , _numTightenedBounds( 0 )
+{
+}
+
+unsigned LPBoundTightener::getNumTightenedBounds() const
+{
+    return _numTightenedBounds;
+}
+
+bool LPBoundTightener::tighten( InputQuery &query )
+{
+    _numTightenedBounds = 0;
+
+    // Group the ReLUs by the layer of their weighted sum variables.
+    // ReLUs that the network-level reasoner does not know about are
+    // handled last.
+    Map<unsigned, unsigned> bToLayer;
+    NetworkLevelReasoner *nlr = query.getNetworkLevelReasoner();
+    if ( nlr )
+    {
+        for ( const auto &pair : nlr->getIndexToWeightedSumVariable() )
+            bToLayer[pair.second] = pair.first._layer;
+    }
+
+    List<Relu> relus;
+    Map<unsigned, List<Relu>> layerToRelus;
+    for ( const auto &constraint : query.getPiecewiseLinearConstraints() )
+    {
+        const ReluConstraint *relu = dynamic_cast<const ReluConstraint *>( constraint );
+        if ( !relu )
+            continue;
+
+        Relu entry;
+        entry._b = relu->getB();
+        entry._f = relu->getF();
+        relus.append( entry );
+
+        unsigned layer = bToLayer.exists( entry._b ) ? bToLayer[entry._b] : (unsigned)-1;
+        layerToRelus[layer].append( entry );
+    }
+
+    // The relaxation is built and processed once. The bounds tightened
+    // in each layer are then applied to the base engine, so that the
+    // following layers benefit from them. The triangles keep their
+    // original shapes, which remain sound.
+    InputQuery relaxation;
+    createRelaxation( query, relus, relaxation );
+
+    Engine baseEngine( 0 );
+    baseEngine.setConfiguration( getEngineConfiguration() );
+    if ( !baseEngine.processInputQuery( relaxation, false ) )
+        return false;
+
+    for ( const auto &layer : layerToRelus )
+    {
+        // Only the ReLUs whose phase is not yet fixed are tightened
+        Vector<unsigned> variables;
+        for ( const auto &relu : layer.second )
+        {
+            if ( FloatUtils::isNegative( query.getLowerBound( relu._b ) ) &&
+                 FloatUtils::isPositive( query.getUpperBound( relu._b ) ) )
+                variables.append( relu._b );
+        }
+
+        if ( variables.empty() )
+            continue;
+
+        log( Stringf( "Layer %d: tightening %u variables", (int)layer.first, variables.size() ) );
+
+        // Solve the relaxation, to check that it is feasible. The
+        // workers then start from the resulting assignment.
+        baseEngine.reset();
+        baseEngine.solve( GlobalConfiguration::LP_TIGHTENING_TIMEOUT_IN_SECONDS );
+        if ( baseEngine.getExitCode() == IEngine::UNSAT )
+        {
+            log( "The relaxation is infeasible" );
+            return false;
+        }
+
+        if ( baseEngine.getExitCode() != IEngine::SAT )
+        {
+            log( "Could not solve the relaxation, skipping the layer" );
+            continue;
+        }
+
+        // Every variable is known to be able to take its value in the
+        // satisfying assignment, which narrows the bisection
+        InputQuery assignment;
+        assignment.setNumberOfVariables( relaxation.getNumberOfVariables() );
+        baseEngine.extractSolution( assignment );
+
+        Vector<double> values;
+        Vector<double> lowerBounds;
+        Vector<double> upperBounds;
+        for ( const auto &variable : variables )
+        {
+            values.append( assignment.getSolutionValue( variable ) );
+            lowerBounds.append( query.getLowerBound( variable ) );
+            upperBounds.append( query.getUpperBound( variable ) );
+        }
+
+        tightenVariables( baseEngine, relaxation.getNumberOfVariables(),
+                          variables, values, lowerBounds, upperBounds );
+
+        PiecewiseLinearCaseSplit newBounds;
+        for ( unsigned i = 0; i < variables.size(); ++i )
+        {
+            if ( FloatUtils::gt( lowerBounds[i], upperBounds[i] ) )
+            {
+                log( Stringf( "Variable %u has no feasible value, the query is infeasible",
+                              variables[i] ) );
+                return false;
+            }
+
+            tightenLowerBound( query, variables[i], lowerBounds[i], newBounds );
+            tightenUpperBound( query, variables[i], upperBounds[i], newBounds );
+        }
+
+        // Propagate the new bounds to the activation results
+        for ( const auto &relu : layer.second )
+        {
+            tightenLowerBound( query, relu._f, query.getLowerBound( relu._b ), newBounds );
+            tightenUpperBound( query, relu._f,
+                               FloatUtils::max( query.getUpperBound( relu._b ), 0.0 ),
+                               newBounds );
+        }
+
+        baseEngine.applySplit( newBounds );
+    }
+
+    log( Stringf( "Done. Tightened %u bounds", _numTightenedBounds ) );
+
+    return true;
+}
+
+void LPBoundTightener::tightenLowerBound( InputQuery &query,
+                                          unsigned variable,
+                                          double value,
+                                          PiecewiseLinearCaseSplit &newBounds )
+{
+    if ( !FloatUtils::gt( value, query.getLowerBound( variable ) ) )
+        return;
+
+    query.setLowerBound( variable, value );
+    newBounds.storeBoundTightening( Tightening( variable, value, Tightening::LB ) );
+    ++_numTightenedBounds;
+}
+
+void LPBoundTightener::tightenUpperBound( InputQuery &query,
+                                          unsigned variable,
+                                          double value,
+                                          PiecewiseLinearCaseSplit &newBounds )
+{
+    if ( !FloatUtils::lt( value, query.getUpperBound( variable ) ) )
+        return;
+
+    query.setUpperBound( variable, value );
+    newBounds.storeBoundTightening( Tightening( variable, value, Tightening::UB ) );
+    ++_numTightenedBounds;
+}
+
+void LPBoundTightener::createRelaxation( const InputQuery &query,
+                                         const List<Relu> &relus,
+                                         InputQuery &relaxation )
+{
+    unsigned numberOfVariables = query.getNumberOfVariables();
+    relaxation.setNumberOfVariables( numberOfVariables );
+
+    for ( unsigned i = 0; i < numberOfVariables; ++i )
+    {
+        relaxation.setLowerBound( i, query.getLowerBound( i ) );
+        relaxation.setUpperBound( i, query.getUpperBound( i ) );
+    }
+
+    for ( const auto &equation : query.getEquations() )
+        relaxation.addEquation( equation );
+
+    for ( const auto &relu : relus )
+    {
+        unsigned b = relu._b;
+        unsigned f = relu._f;
+        double bLb = query.getLowerBound( b );
+        double bUb = query.getUpperBound( b );
+
+        if ( !FloatUtils::isNegative( bLb ) )
+        {
+            // Active phase: f = b
+            Equation equation;
+            equation.addAddend( 1, f );
+            equation.addAddend( -1, b );
+            equation.setScalar( 0 );
+            relaxation.addEquation( equation );
+            continue;
+        }
+
+        if ( !FloatUtils::isPositive( bUb ) )
+        {
+            // Inactive phase: f = 0
+            relaxation.setUpperBound( f, 0 );
+            continue;
+        }
+
+        // The triangle relaxation: f >= 0, f >= b, and
+        //   f <= ub * ( b - lb ) / ( ub - lb )
+        relaxation.setLowerBound( f, FloatUtils::max( relaxation.getLowerBound( f ), 0.0 ) );
+        relaxation.setUpperBound( f, FloatUtils::min( relaxation.getUpperBound( f ), bUb ) );
+
+        unsigned lowerSlack = relaxation.getNumberOfVariables();
+        unsigned upperSlack = lowerSlack + 1;
+        relaxation.setNumberOfVariables( lowerSlack + 2 );
+
+        // f - b - lowerSlack = 0, with lowerSlack >= 0
+        Equation lowerEquation;
+        lowerEquation.addAddend( 1, f );
+        lowerEquation.addAddend( -1, b );
+        lowerEquation.addAddend( -1, lowerSlack );
+        lowerEquation.setScalar( 0 );
+        relaxation.addEquation( lowerEquation );
+        relaxation.setLowerBound( lowerSlack, 0 );
+        relaxation.setUpperBound( lowerSlack, relaxation.getUpperBound( f ) - bLb );
+
+        // ( ub - lb ) f - ub b + upperSlack = - ub lb, with upperSlack >= 0
+        Equation upperEquation;
+        upperEquation.addAddend( bUb - bLb, f );
+        upperEquation.addAddend( -bUb, b );
+        upperEquation.addAddend( 1, upperSlack );
+        upperEquation.setScalar( -bUb * bLb );
+        relaxation.addEquation( upperEquation );
+        relaxation.setLowerBound( upperSlack, 0 );
+        relaxation.setUpperBound( upperSlack, bUb * ( bUb - bLb ) );
+    }
+}
+
+void LPBoundTightener::tightenVariables( const Engine &baseEngine,
+                                         unsigned numberOfVariables,
+                                         const Vector<unsigned> &variables,
+                                         const Vector<double> &values,
+                                         Vector<double> &lowerBounds,
+                                         Vector<double> &upperBounds ) const
+{
+    unsigned numWorkers = _numWorkers;
+    if ( numWorkers > variables.size() )
+        numWorkers = variables.size();
+
+    // The engines are copied from the base engine before the threads
+    // start, as in the DnC mode
+    Vector<Engine *> engines;
+    for ( unsigned i = 0; i < numWorkers; ++i )
+    {
+        Engine *engine = new Engine( 0 );
+        if ( !engine )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "LPBoundTightener::engine" );
+
+        engine->setConfiguration( getEngineConfiguration() );
+        engine->initializeFromEngine( baseEngine );
+        engines.append( engine );
+    }
+
+    // Each variable is handled by a single worker, which stores its
+    // results in the variable's entries. The results therefore do not
+    // depend on the number of workers or on the scheduling.
+    std::atomic_uint next( 0 );
+    auto work = [&]( Engine *engine )
+    {
+        EngineState initialState;
+        engine->storeState( initialState, true );
+
+        InputQuery solution;
+        solution.setNumberOfVariables( numberOfVariables );
+
+        unsigned i;
+        while ( ( i = next++ ) < variables.size() )
+        {
+            tightenVariable( *engine, initialState, solution, variables.get( i ),
+                             values.get( i ), lowerBounds[i], upperBounds[i] );
+        }
+    };
+
+    std::list<std::thread> threads;
+    for ( unsigned i = 0; i < numWorkers; ++i )
+        threads.push_back( std::thread( work, engines[i] ) );
+
+    for ( auto &thread : threads )
+        thread.join();
+
+    for ( auto &engine : engines )
+        delete engine;
+}
+
+void LPBoundTightener::tightenVariable( Engine &engine,
+                                        const EngineState &initialState,
+                                        InputQuery &solution,
+                                        unsigned variable,
+                                        double feasibleValue,
+                                        double &lb,
+                                        double &ub )
+{
+    double value;
+
+    // Lower bound: the minimum is known to lie in [low, high]. Every
+    // infeasible check raises low, and every feasible one lowers high.
+    // Zero is checked first, if that may fix the phase of the ReLU.
+    double low = lb;
+    double high = FloatUtils::min( ub, feasibleValue );
+    double probe = FloatUtils::isPositive( high ) ? 0 : ( low + high ) / 2;
+    for ( unsigned i = 0;
+          i < GlobalConfiguration::LP_TIGHTENING_BISECTION_STEPS && FloatUtils::lt( low, high );
+          ++i )
+    {
+        LpResult result = checkFeasibility( engine, initialState, solution,
+                                            Tightening( variable, probe, Tightening::UB ),
+                                            value );
+        if ( result == INFEASIBLE )
+            low = probe;
+        else if ( result == FEASIBLE )
+            high = FloatUtils::min( high, FloatUtils::max( value, low ) );
+        else
+            break;
+
+        probe = ( low + high ) / 2;
+    }
+    lb = low;
+
+    // Upper bound: symmetric, with the maximum in [low, high]
+    low = FloatUtils::max( lb, feasibleValue );
+    high = ub;
+    probe = FloatUtils::isNegative( low ) ? 0 : ( low + high ) / 2;
+    for ( unsigned i = 0;
+          i < GlobalConfiguration::LP_TIGHTENING_BISECTION_STEPS && FloatUtils::lt( low, high );
+          ++i )
+    {
+        LpResult result = checkFeasibility( engine, initialState, solution,
+                                            Tightening( variable, probe, Tightening::LB ),
+                                            value );
+        if ( result == INFEASIBLE )
+            high = probe;
+        else if ( result == FEASIBLE )
+            low = FloatUtils::max( low, FloatUtils::min( value, high ) );
+        else
+            break;
+
+        probe = ( low + high ) / 2;
+    }
+    ub = high;
+}
+
+LPBoundTightener::LpResult LPBoundTightener::checkFeasibility( Engine &engine,
+                                                               const EngineState &initialState,
+                                                               InputQuery &solution,
+                                                               const Tightening &bound,
+                                                               double &value )
+{
+    engine.restoreState( initialState );
+    engine.reset();
+
+    PiecewiseLinearCaseSplit split;
+    split.storeBoundTightening( bound );
+    engine.applySplit( split );
+    engine.solve( GlobalConfiguration::LP_TIGHTENING_TIMEOUT_IN_SECONDS );
+
+    IEngine::ExitCode exitCode = engine.getExitCode();
+    if ( exitCode == IEngine::UNSAT )
+        return INFEASIBLE;
+
+    if ( exitCode != IEngine::SAT )
+        return UNKNOWN;
+
+    engine.extractSolution( solution );
+    value = solution.getSolutionValue( bound._variable );
+    return FEASIBLE;
+}
+
+EngineConfiguration LPBoundTightener::getEngineConfiguration()
+{
+    // The relaxation has no piecewise linear constraints, and each
+    // feasibility check takes only a few pivots. Tightening bounds
+    // using the explicit basis would dominate the running time.
+    EngineConfiguration configuration;
+    configuration._useExplicitBasisBoundTightening = false;
+    return configuration;
+}
+
+void LPBoundTightener::log( const String &message )
+{
+    if ( GlobalConfiguration::LP_BOUND_TIGHTENER_LOGGING )
+        printf( "LPBoundTightener: %s\n", message.ascii() );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,153 @@
+/*********************                                                        */
+/*! \file LPBoundTightener.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __LPBoundTightener_h__
+#define __LPBoundTightener_h__
+
+#include "EngineConfiguration.h"
+#include "InputQuery.h"
+#include "List.h"
+#include "Tightening.h"
+#include "Vector.h"
+
+class Engine;
+class EngineState;
+class PiecewiseLinearCaseSplit;
+class String;
+
+/*
+  A root-level pass that tightens the bounds of the weighted sum
+  variables of ReLUs by solving LP relaxations of the network.
+
+  The relaxation keeps all the equations of the query, replaces every
+  ReLU by its triangle relaxation, and drops all other piecewise
+  linear constraints. Since the simplex engine only checks
+  feasibility, the smallest and largest values of a variable are found
+  by bisection: we repeatedly ask whether the variable can be below
+  (above) some value, and use the assignment of every feasible answer
+  to shrink the search interval. The first value tried is 0, which
+  fixes the phase of the ReLU if the answer is negative.
+
+  The network is processed layer by layer, according to the topology
+  of the network-level reasoner, so that each layer benefits from the
+  bounds tightened in earlier layers. Within a layer, the variables are
+  split among worker threads, each with its own copy of an engine that
+  has processed the relaxation.
+*/
+class LPBoundTightener
+{
+public:
+    LPBoundTightener( unsigned numWorkers );
+
+    /*
+      Tighten the bounds of the given query, which must have a
+      network-level reasoner. The bounds of the query are updated in
+      place. Returns false if the relaxation, and hence the query, is
+      infeasible.
+    */
+    bool tighten( InputQuery &query );
+
+    unsigned getNumTightenedBounds() const;
+
+private:
+    enum LpResult {
+        FEASIBLE = 0,
+        INFEASIBLE,
+        UNKNOWN,
+    };
+
+    struct Relu
+    {
+        unsigned _b;
+        unsigned _f;
+    };
+
+    unsigned _numWorkers;
+    unsigned _numTightenedBounds;
+
+    /*
+      Store a tighter bound in the query, and record it so that it is
+      also applied to the relaxation
+    */
+    void tightenLowerBound( InputQuery &query,
+                            unsigned variable,
+                            double value,
+                            PiecewiseLinearCaseSplit &newBounds );
+    void tightenUpperBound( InputQuery &query,
+                            unsigned variable,
+                            double value,
+                            PiecewiseLinearCaseSplit &newBounds );
+
+    /*
+      Build the LP relaxation of the query, according to its current
+      bounds. Every ReLU whose phase is not fixed adds two slack
+      variables.
+    */
+    static void createRelaxation( const InputQuery &query,
+                                  const List<Relu> &relus,
+                                  InputQuery &relaxation );
+
+    /*
+      Compute the bounds of the given variables in the relaxation
+      processed by the base engine, using the worker threads. The
+      lower and upper bounds are passed in with their current values,
+      along with a value that each variable is known to be able to take.
+    */
+    void tightenVariables( const Engine &baseEngine,
+                           unsigned numberOfVariables,
+                           const Vector<unsigned> &variables,
+                           const Vector<double> &values,
+                           Vector<double> &lowerBounds,
+                           Vector<double> &upperBounds ) const;
+
+    /*
+      Find the bounds of a single variable by bisection
+    */
+    static void tightenVariable( Engine &engine,
+                                 const EngineState &initialState,
+                                 InputQuery &solution,
+                                 unsigned variable,
+                                 double feasibleValue,
+                                 double &lb,
+                                 double &ub );
+
+    /*
+      Check whether the relaxation is feasible with the given bound.
+      If it is, the value of the bound's variable in the satisfying
+      assignment is stored in value.
+    */
+    static LpResult checkFeasibility( Engine &engine,
+                                      const EngineState &initialState,
+                                      InputQuery &solution,
+                                      const Tightening &bound,
+                                      double &value );
+
+    /*
+      The configuration of the engines that solve the relaxation
+    */
+    static EngineConfiguration getEngineConfiguration();
+
+    static void log( const String &message );
+};
+
+#endif // __LPBoundTightener_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
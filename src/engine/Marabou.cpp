@@ -24,12 +24,15 @@
 #include "MarabouError.h"
 #include "QueryLoader.h"
 
+#include <thread>
+
 #ifdef _WIN32
 #undef ERROR
 #endif
 
 Marabou::Marabou( unsigned verbosity )
     : _acasParser( NULL )
+    , _numWorkers( 1 )
     , _engine( verbosity )
 {
 }
@@ -117,11 +120,39 @@ void Marabou::prepareInputQuery()
         }
         _engine.setConstraintViolationThreshold( splitThreshold );
     }
+
+    String entryStrategyString = Options::get()->getString( Options::ENTRY_STRATEGY );
+    EngineConfiguration configuration = _engine.getConfiguration();
+    configuration._entryStrategy = EngineConfiguration::parseEntryStrategy( entryStrategyString );
+    if ( Options::get()->getBool( Options::DUAL_SIMPLEX ) )
+        configuration._useDualSimplexAfterSplits = true;
+
+    // A single engine can use the idle cores for bound tightening
+    int numWorkers = Options::get()->getInt( Options::NUM_WORKERS );
+    if ( numWorkers <= 0 )
+    {
+        printf( "Invalid number of workers %d, using a single worker.\n\n",
+                numWorkers );
+        numWorkers = 1;
+    }
+
+    _numWorkers = numWorkers;
+    unsigned numCores = std::thread::hardware_concurrency();
+    if ( numCores > 0 && _numWorkers > numCores )
+        _numWorkers = numCores;
+    configuration._numBoundTighteningWorkers = _numWorkers;
+
+    _engine.setConfiguration( configuration );
 }
 
 void Marabou::solveQuery()
 {
-    if ( _engine.processInputQuery( _inputQuery ) )
+    bool feasible = _engine.processInputQuery( _inputQuery );
+
+    if ( feasible && Options::get()->getBool( Options::LP_BOUND_TIGHTENING ) )
+        feasible = _engine.performLpBoundTightening( _numWorkers );
+
+    if ( feasible )
         _engine.solve( Options::get()->getInt( Options::TIMEOUT ) );
 
     if ( _engine.getExitCode() == Engine::SAT )
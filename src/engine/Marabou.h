@@ -55,6 +55,11 @@ private:
     */
     AcasParser *_acasParser;
 
+    /*
+      The number of threads used for bound tightening, at least 1
+    */
+    unsigned _numWorkers;
+
     /*
       The solver
     */
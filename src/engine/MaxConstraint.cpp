@@ -33,11 +33,16 @@
 
 MaxConstraint::MaxConstraint( unsigned f, const Set<unsigned> &elements )
     : _f( f )
-    , _elements( elements )
+    , _numElements( 0 )
     , _maxIndexSet( false )
     , _maxLowerBound( FloatUtils::negativeInfinity() )
     , _obsolete( false )
 {
+    for ( unsigned element : elements )
+    {
+        _elements[element] = true;
+        ++_numElements;
+    }
 }
 
 MaxConstraint::MaxConstraint( const String &serializedMax )
@@ -67,7 +72,7 @@ MaxConstraint::~MaxConstraint()
 
 PiecewiseLinearConstraint *MaxConstraint::duplicateConstraint() const
 {
-    MaxConstraint *clone = new MaxConstraint( _f, _elements );
+    MaxConstraint *clone = new MaxConstraint( _f, getElements() );
     *clone = *this;
     return clone;
 }
@@ -81,14 +86,14 @@ void MaxConstraint::restoreState( const PiecewiseLinearConstraint *state )
 void MaxConstraint::registerAsWatcher( ITableau *tableau )
 {
     tableau->registerToWatchVariable( this, _f );
-    for ( unsigned element : _elements )
+    for ( unsigned element : getElements() )
         tableau->registerToWatchVariable( this, element );
 }
 
 void MaxConstraint::unregisterAsWatcher( ITableau *tableau )
 {
     tableau->unregisterToWatchVariable( this, _f );
-    for ( unsigned element : _elements )
+    for ( unsigned element : getElements() )
         tableau->unregisterToWatchVariable( this, element );
 }
 
@@ -114,26 +119,25 @@ void MaxConstraint::notifyLowerBound( unsigned variable, double value )
 
     bool maxErased = false;
 
-    if ( _elements.exists( variable ) && FloatUtils::gt( value, _maxLowerBound ) )
+    if ( isElement( variable ) && FloatUtils::gt( value, _maxLowerBound ) )
     {
         _maxLowerBound = value;
-        List<unsigned> toRemove;
-        for ( auto element : _elements )
+
+        // Elements whose upper bound is below the new lower bound can
+        // no longer be the max
+        for ( const auto &entry : _upperBounds )
         {
-			if ( element == variable )
-				continue;
-            if ( _upperBounds.exists( element ) &&
-                 FloatUtils::lt( _upperBounds[element], value ) )
+            unsigned element = entry.first;
+            if ( element == variable || !isElement( element ) )
+                continue;
+
+            if ( FloatUtils::lt( entry.second, value ) )
             {
-                toRemove.append( element );
+                removeElement( element );
+                if ( _maxIndex == element )
+                    maxErased = true;
             }
         }
-        for ( unsigned removeVar : toRemove )
-        {
-            _elements.erase( removeVar );
-            if ( _maxIndex == removeVar )
-                maxErased = true;
-        }
     }
 
 	if ( maxErased )
@@ -165,10 +169,8 @@ void MaxConstraint::notifyUpperBound( unsigned variable, double value )
 
     _upperBounds[variable] = value;
 
-    if ( _elements.exists( variable ) && FloatUtils::lt( value, _maxLowerBound ) )
-    {
-        _elements.erase( variable );
-    }
+    if ( isElement( variable ) && FloatUtils::lt( value, _maxLowerBound ) )
+        removeElement( variable );
 
     // There is no need to recompute the max lower bound and max index here.
 
@@ -190,24 +192,42 @@ void MaxConstraint::notifyUpperBound( unsigned variable, double value )
 
 void MaxConstraint::getEntailedTightenings( List<Tightening> &tightenings ) const
 {
-    // Lower and upper bounds for the f variable
-    double fLB = _lowerBounds.exists( _f ) ? _lowerBounds.get( _f ) : FloatUtils::negativeInfinity();
-    double fUB = _upperBounds.exists( _f ) ? _upperBounds.get( _f ) : FloatUtils::infinity();
-
-    // Compute the maximal bounds (lower and upper) for the elements
+    /*
+      The bounds are stored in flat arrays, so go over each of them
+      once rather than looking up every element. Eliminated elements
+      may still have stored bounds, and are skipped.
+    */
+
+    // Lower and upper bounds for the f variable, and the maximal
+    // bounds (lower and upper) for the elements
+    double fLB = FloatUtils::negativeInfinity();
+    double fUB = FloatUtils::infinity();
     double maxElementLB = FloatUtils::negativeInfinity();
     double maxElementUB = FloatUtils::negativeInfinity();
 
-    for ( const auto &element : _elements )
+    for ( const auto &entry : _lowerBounds )
     {
-        if ( _lowerBounds.exists( element ) )
-            maxElementLB = FloatUtils::max( _lowerBounds[element], maxElementLB );
+        if ( entry.first == _f )
+            fLB = entry.second;
+        else if ( isElement( entry.first ) )
+            maxElementLB = FloatUtils::max( entry.second, maxElementLB );
+    }
 
-        if ( !_upperBounds.exists( element ) )
-            maxElementUB = FloatUtils::infinity();
-        else
-            maxElementUB = FloatUtils::max( _upperBounds[element], maxElementUB );
-	}
+    unsigned numElementUpperBounds = 0;
+    for ( const auto &entry : _upperBounds )
+    {
+        if ( entry.first == _f )
+            fUB = entry.second;
+        else if ( isElement( entry.first ) )
+        {
+            maxElementUB = FloatUtils::max( entry.second, maxElementUB );
+            ++numElementUpperBounds;
+        }
+    }
+
+    // An element without an upper bound is unbounded
+    if ( numElementUpperBounds < _numElements )
+        maxElementUB = FloatUtils::infinity();
 
     // fUB and maxElementUB need to be equal. If not, the lower of the two wins.
     if ( FloatUtils::areDisequal( fUB, maxElementUB ) )
@@ -218,22 +238,38 @@ void MaxConstraint::getEntailedTightenings( List<Tightening> &tightenings ) cons
 		}
 	    else
 		{
-		    for ( const auto &element : _elements )
-			{
-			    if ( !_upperBounds.exists( element ) || FloatUtils::gt( _upperBounds[element], fUB ) )
-                    tightenings.append( Tightening( element, fUB, Tightening::UB ) );
-			}
+            for ( const auto &entry : _upperBounds )
+            {
+                if ( entry.first != _f &&
+                     isElement( entry.first ) &&
+                     FloatUtils::gt( entry.second, fUB ) )
+                    tightenings.append( Tightening( entry.first, fUB, Tightening::UB ) );
+            }
+
+            // Elements without upper bounds are rare; look them up
+            if ( numElementUpperBounds < _numElements )
+            {
+                for ( const auto &element : _elements )
+                {
+                    if ( element.second && !_upperBounds.exists( element.first ) )
+                        tightenings.append( Tightening( element.first, fUB, Tightening::UB ) );
+                }
+            }
 		}
 	}
 
     // fLB cannot be smaller than maxElementLB
     if ( FloatUtils::lt( fLB, maxElementLB ) )
         tightenings.append( Tightening( _f, maxElementLB, Tightening::LB ) );
-    else if ( _elements.size() == 1 )
+    else if ( _numElements == 1 )
     {
         // Special case: there is only one element. In that case, the tighter lower
         // bound (in this case, f's) wins.
-        tightenings.append( Tightening( *_elements.begin(), fLB, Tightening::LB ) );
+        for ( const auto &element : _elements )
+        {
+            if ( element.second )
+                tightenings.append( Tightening( element.first, fLB, Tightening::LB ) );
+        }
     }
 
     // TODO: can we derive additional bounds?
@@ -241,14 +277,17 @@ void MaxConstraint::getEntailedTightenings( List<Tightening> &tightenings ) cons
 
 bool MaxConstraint::participatingVariable( unsigned variable ) const
 {
-    return ( variable == _f ) || _elements.exists( variable );
+    return ( variable == _f ) || isElement( variable );
 }
 
 List<unsigned> MaxConstraint::getParticipatingVariables() const
 {
     List<unsigned> result;
-    for ( auto element : _elements )
-        result.append( element );
+    for ( const auto &element : _elements )
+    {
+        if ( element.second )
+            result.append( element.first );
+    }
     result.append( _f );
     return result;
 }
@@ -265,8 +304,12 @@ bool MaxConstraint::satisfied() const
 void MaxConstraint::resetMaxIndex()
 {
     double maxValue = FloatUtils::negativeInfinity();
-    for ( auto element : _elements )
+    for ( const auto &entry : _elements )
     {
+        if ( !entry.second )
+            continue;
+
+        unsigned element = entry.first;
         ASSERT( _assignment.exists( element ) );
         double elementValue = _assignment.get( element );
         if ( elementValue > maxValue )
@@ -297,7 +340,7 @@ List<PiecewiseLinearConstraint::Fix> MaxConstraint::getPossibleFixes() const
     if ( FloatUtils::gt( fValue, maxVal ) )
 	{
 	    fixes.append( PiecewiseLinearConstraint::Fix( _f, maxVal ) );
-	    for ( auto elem : _elements )
+	    for ( unsigned elem : getElements() )
 		{
 		    fixes.append( PiecewiseLinearConstraint::Fix( elem, fValue ) );
 		}
@@ -308,7 +351,7 @@ List<PiecewiseLinearConstraint::Fix> MaxConstraint::getPossibleFixes() const
 
         unsigned greaterVar;
         unsigned numGreater = 0;
-        for ( auto elem: _elements )
+        for ( unsigned elem : getElements() )
         {
             if ( _assignment.exists( elem ) && FloatUtils::gt( _assignment[elem], fValue ) )
             {
@@ -342,7 +385,7 @@ List<PiecewiseLinearCaseSplit> MaxConstraint::getCaseSplits() const
     ASSERT(	_assignment.exists( _f ) );
 
     List<PiecewiseLinearCaseSplit> splits;
-    for ( unsigned element : _elements )
+    for ( unsigned element : getElements() )
 	{
         splits.append( getSplit( element ) );
 	}
@@ -351,13 +394,13 @@ List<PiecewiseLinearCaseSplit> MaxConstraint::getCaseSplits() const
 
 bool MaxConstraint::phaseFixed() const
 {
-    return _elements.size() == 1;
+    return _numElements == 1;
 }
 
 PiecewiseLinearCaseSplit MaxConstraint::getValidCaseSplit() const
 {
     ASSERT( phaseFixed() );
-    return getSplit( *( _elements.begin() ) );
+    return getSplit( *( getElements().begin() ) );
 }
 
 PiecewiseLinearCaseSplit MaxConstraint::getSplit( unsigned argMax ) const
@@ -375,7 +418,7 @@ PiecewiseLinearCaseSplit MaxConstraint::getSplit( unsigned argMax ) const
     // store bound tightenings as well
     // go over all other elements;
     // their upper bound cannot exceed upper bound of argmax
-    for ( unsigned other : _elements )
+    for ( unsigned other : getElements() )
 	{
 	    if ( argMax == other )
             continue;
@@ -401,14 +444,41 @@ PiecewiseLinearCaseSplit MaxConstraint::getSplit( unsigned argMax ) const
 
 void MaxConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
-    _lowerBounds[newIndex] = _lowerBounds[oldIndex];
-    _upperBounds[newIndex] = _upperBounds[oldIndex];
+    ASSERT( !_assignment.exists( newIndex ) &&
+            !_lowerBounds.exists( newIndex ) &&
+            !_upperBounds.exists( newIndex ) );
+
+    if ( _assignment.exists( oldIndex ) )
+    {
+        double value = _assignment.get( oldIndex );
+        _assignment.erase( oldIndex );
+        _assignment.insert( newIndex, value );
+    }
+
+    if ( _lowerBounds.exists( oldIndex ) )
+    {
+        double lb = _lowerBounds.get( oldIndex );
+        _lowerBounds.erase( oldIndex );
+        _lowerBounds.insert( newIndex, lb );
+    }
+
+    if ( _upperBounds.exists( oldIndex ) )
+    {
+        double ub = _upperBounds.get( oldIndex );
+        _upperBounds.erase( oldIndex );
+        _upperBounds.insert( newIndex, ub );
+    }
+
     if ( oldIndex == _f )
         _f = newIndex;
     else
 	{
-	    _elements.erase( oldIndex );
-	    _elements.insert( newIndex );
+	    if ( _elements.exists( oldIndex ) )
+	    {
+	        bool candidate = _elements.get( oldIndex );
+	        _elements.erase( oldIndex );
+	        _elements.insert( newIndex, candidate );
+	    }
 	}
 }
 
@@ -419,14 +489,15 @@ bool MaxConstraint::constraintObsolete() const
 
 void MaxConstraint::eliminateVariable( unsigned var, double /*value*/ )
 {
-    _elements.erase( var );
+    if ( isElement( var ) )
+        removeElement( var );
     if ( var == _f || getParticipatingVariables().size() == 1 )
         _obsolete = true;
 }
 
 void MaxConstraint::addAuxiliaryEquations( InputQuery &inputQuery )
 {
-    for ( auto element : _elements )
+    for ( unsigned element : getElements() )
     {
         // Create an aux variable
         unsigned auxVariable = inputQuery.getNumberOfVariables();
@@ -451,11 +522,44 @@ String MaxConstraint::serializeToString() const
 {
     // Output format: max,f,element_1,element_2,element_3,...
     Stringf output = Stringf( "max,%u", _f );
-    for ( const auto &element : _elements )
+    for ( unsigned element : getElements() )
         output += Stringf( ",%u", element );
     return output;
 }
 
+bool MaxConstraint::isElement( unsigned variable ) const
+{
+    return _elements.exists( variable ) && _elements.get( variable );
+}
+
+void MaxConstraint::removeElement( unsigned variable )
+{
+    ASSERT( isElement( variable ) );
+    _elements[variable] = false;
+    --_numElements;
+}
+
+Set<unsigned> MaxConstraint::getElements() const
+{
+    Set<unsigned> elements;
+    for ( const auto &element : _elements )
+    {
+        if ( element.second )
+            elements.insert( element.first );
+    }
+    return elements;
+}
+
+unsigned MaxConstraint::getF() const
+{
+    return _f;
+}
+
+bool MaxConstraint::supportsSymbolicBoundTightening() const
+{
+    return true;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -16,6 +16,7 @@
 #ifndef __MaxConstraint_h__
 #define __MaxConstraint_h__
 
+#include "FlatMap.h"
 #include "Map.h"
 #include "PiecewiseLinearConstraint.h"
 
@@ -122,9 +123,35 @@ class MaxConstraint : public PiecewiseLinearConstraint
     */
     String serializeToString() const;
 
+    /*
+      Get the index of the F variable.
+    */
+    unsigned getF() const;
+
+    /*
+      Get the elements that may still be the max, in ascending order.
+    */
+    Set<unsigned> getElements() const;
+
+    /*
+      Return true if and only if this piecewise linear constraint supports
+      symbolic bound tightening. The tightener must also have a max
+      neuron for the constraint; this is checked by the engine.
+    */
+    bool supportsSymbolicBoundTightening() const;
+
  private:
     unsigned _f;
-    Set<unsigned> _elements;
+
+    /*
+      The elements of the max, in the same kind of flat index as the
+      bounds. An element that is known not to be the max (because of
+      its bounds, or because it was eliminated) is kept with a false
+      flag, so that membership tests and removals are a single lookup.
+      _numElements counts the elements that are still candidates.
+    */
+    FlatMap<unsigned, bool> _elements;
+    unsigned _numElements;
     unsigned _maxIndex;
     bool _maxIndexSet;
     double _maxLowerBound;
@@ -132,6 +159,12 @@ class MaxConstraint : public PiecewiseLinearConstraint
 
     void resetMaxIndex();
 
+    /*
+      Membership and removal of the elements that may still be the max
+    */
+    bool isElement( unsigned variable ) const;
+    void removeElement( unsigned variable );
+
     /*
       Returns the phase where variable argMax has maximum value.
     */
@@ -14,6 +14,8 @@
  **/
 
 #include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "MStringf.h"
 #include "NetworkLevelReasoner.h"
 #include "MarabouError.h"
@@ -24,6 +26,20 @@ NetworkLevelReasoner::NetworkLevelReasoner()
     , _maxLayerSize( 0 )
     , _work1( NULL )
     , _work2( NULL )
+    , _weightedSumLowerBounds( NULL )
+    , _weightedSumUpperBounds( NULL )
+    , _lowerBounds( NULL )
+    , _upperBounds( NULL )
+    , _lowerRelaxations( NULL )
+    , _upperRelaxations( NULL )
+    , _lowerRelaxationBiases( NULL )
+    , _upperRelaxationBiases( NULL )
+    , _workLower( NULL )
+    , _workUpper( NULL )
+    , _workLowerNext( NULL )
+    , _workUpperNext( NULL )
+    , _workLowerBias( NULL )
+    , _workUpperBias( NULL )
 {
 }
 
@@ -60,6 +76,93 @@ void NetworkLevelReasoner::freeMemoryIfNeeded()
         delete[] _work2;
         _work2 = NULL;
     }
+
+    freeLayerArrays( _weightedSumLowerBounds );
+    freeLayerArrays( _weightedSumUpperBounds );
+    freeLayerArrays( _lowerBounds );
+    freeLayerArrays( _upperBounds );
+    freeLayerArrays( _lowerRelaxations );
+    freeLayerArrays( _upperRelaxations );
+    freeLayerArrays( _lowerRelaxationBiases );
+    freeLayerArrays( _upperRelaxationBiases );
+
+    if ( _workLower )
+    {
+        delete[] _workLower;
+        _workLower = NULL;
+    }
+
+    if ( _workUpper )
+    {
+        delete[] _workUpper;
+        _workUpper = NULL;
+    }
+
+    if ( _workLowerNext )
+    {
+        delete[] _workLowerNext;
+        _workLowerNext = NULL;
+    }
+
+    if ( _workUpperNext )
+    {
+        delete[] _workUpperNext;
+        _workUpperNext = NULL;
+    }
+
+    if ( _workLowerBias )
+    {
+        delete[] _workLowerBias;
+        _workLowerBias = NULL;
+    }
+
+    if ( _workUpperBias )
+    {
+        delete[] _workUpperBias;
+        _workUpperBias = NULL;
+    }
+}
+
+void NetworkLevelReasoner::freeLayerArrays( double **&arrays )
+{
+    if ( !arrays )
+        return;
+
+    for ( unsigned i = 0; i < _numberOfLayers; ++i )
+    {
+        if ( arrays[i] )
+        {
+            delete[] arrays[i];
+            arrays[i] = NULL;
+        }
+    }
+
+    delete[] arrays;
+    arrays = NULL;
+}
+
+double **NetworkLevelReasoner::allocateLayerArrays( bool relaxations )
+{
+    double **arrays = new double*[_numberOfLayers];
+    if ( !arrays )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NetworkLevelReasoner::layerArrays" );
+
+    for ( unsigned i = 0; i < _numberOfLayers; ++i )
+    {
+        if ( relaxations && i == 0 )
+        {
+            arrays[i] = NULL;
+            continue;
+        }
+
+        unsigned size = relaxations ? _layerSizes[i - 1] * _layerSizes[i] : _layerSizes[i];
+        arrays[i] = new double[size];
+        if ( !arrays[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "NetworkLevelReasoner::layerArrays[i]" );
+        std::fill_n( arrays[i], size, 0 );
+    }
+
+    return arrays;
 }
 
 void NetworkLevelReasoner::setNumberOfLayers( unsigned numberOfLayers )
@@ -99,6 +202,32 @@ void NetworkLevelReasoner::allocateWeightMatrices()
     _work2 = new double[_maxLayerSize];
     if ( !_work2 )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "NetworkLevelReasoner::work2" );
+
+    _weightedSumLowerBounds = allocateLayerArrays( false );
+    _weightedSumUpperBounds = allocateLayerArrays( false );
+    _lowerBounds = allocateLayerArrays( false );
+    _upperBounds = allocateLayerArrays( false );
+    _lowerRelaxations = allocateLayerArrays( true );
+    _upperRelaxations = allocateLayerArrays( true );
+    _lowerRelaxationBiases = allocateLayerArrays( false );
+    _upperRelaxationBiases = allocateLayerArrays( false );
+
+    _workLower = new double[_maxLayerSize * _maxLayerSize];
+    _workUpper = new double[_maxLayerSize * _maxLayerSize];
+    _workLowerNext = new double[_maxLayerSize * _maxLayerSize];
+    _workUpperNext = new double[_maxLayerSize * _maxLayerSize];
+    _workLowerBias = new double[_maxLayerSize];
+    _workUpperBias = new double[_maxLayerSize];
+    if ( !_workLower || !_workUpper || !_workLowerNext || !_workUpperNext ||
+         !_workLowerBias || !_workUpperBias )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NetworkLevelReasoner::backSubstitutionWork" );
+
+    _inputIndexToNeuron.clear();
+    for ( unsigned i = 0; i < _layerSizes[0]; ++i )
+        _inputIndexToNeuron[i] = i;
+    _fixedInputNeurons.clear();
+
+    clearBounds();
 }
 
 void NetworkLevelReasoner::setNeuronActivationFunction( unsigned layer, unsigned neuron, ActivationFunction activationFuction )
@@ -119,6 +248,12 @@ void NetworkLevelReasoner::setBias( unsigned layer, unsigned neuron, double bias
     _bias[Index( layer, neuron )] = bias;
 }
 
+void NetworkLevelReasoner::addMaxSource( unsigned layer, unsigned neuron, unsigned sourceNeuron )
+{
+    ASSERT( layer > 0 );
+    _maxSources[Index( layer, neuron )].append( sourceNeuron );
+}
+
 void NetworkLevelReasoner::evaluate( double *input, double *output )
 {
     memcpy( _work1, input, sizeof(double) * _layerSizes[0] );
@@ -154,6 +289,24 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
                         _work2[targetNeuron] = 0;
                     break;
 
+                case AbsoluteValue:
+                    if ( _work2[targetNeuron] < 0 )
+                        _work2[targetNeuron] = -_work2[targetNeuron];
+                    break;
+
+                case Max:
+                    {
+                        ASSERT( _maxSources.exists( index ) );
+                        const List<unsigned> &sources = _maxSources[index];
+                        _work2[targetNeuron] = _work1[*sources.begin()];
+                        for ( const auto &source : sources )
+                        {
+                            if ( _work1[source] > _work2[targetNeuron] )
+                                _work2[targetNeuron] = _work1[source];
+                        }
+                    }
+                    break;
+
                 default:
                     ASSERT( false );
                     break;
@@ -171,6 +324,362 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
     memcpy( output, _work1, sizeof(double) * _layerSizes[_numberOfLayers - 1] );
 }
 
+void NetworkLevelReasoner::clearBounds()
+{
+    for ( unsigned layer = 0; layer < _numberOfLayers; ++layer )
+    {
+        unsigned layerSize = _layerSizes[layer];
+
+        std::fill_n( _weightedSumLowerBounds[layer], layerSize, FloatUtils::negativeInfinity() );
+        std::fill_n( _weightedSumUpperBounds[layer], layerSize, FloatUtils::infinity() );
+        std::fill_n( _lowerBounds[layer], layerSize, FloatUtils::negativeInfinity() );
+        std::fill_n( _upperBounds[layer], layerSize, FloatUtils::infinity() );
+    }
+
+    for ( const auto &fixed : _fixedInputNeurons )
+    {
+        _lowerBounds[0][fixed.first] = fixed.second;
+        _upperBounds[0][fixed.first] = fixed.second;
+    }
+}
+
+void NetworkLevelReasoner::setInputBounds( unsigned index, double lb, double ub )
+{
+    ASSERT( _inputIndexToNeuron.exists( index ) );
+    unsigned neuron = _inputIndexToNeuron[index];
+
+    _lowerBounds[0][neuron] = lb;
+    _upperBounds[0][neuron] = ub;
+}
+
+void NetworkLevelReasoner::setWeightedSumBounds( unsigned layer, unsigned neuron, double lb, double ub )
+{
+    ASSERT( layer > 0 && layer < _numberOfLayers );
+    _weightedSumLowerBounds[layer][neuron] = lb;
+    _weightedSumUpperBounds[layer][neuron] = ub;
+}
+
+void NetworkLevelReasoner::setActivationResultBounds( unsigned layer, unsigned neuron, double lb, double ub )
+{
+    ASSERT( layer > 0 && layer < _numberOfLayers );
+    _lowerBounds[layer][neuron] = lb;
+    _upperBounds[layer][neuron] = ub;
+}
+
+void NetworkLevelReasoner::performBackSubstitution()
+{
+    for ( unsigned i = 0; i < _layerSizes[0]; ++i )
+    {
+        if ( !FloatUtils::isFinite( _lowerBounds[0][i] ) || !FloatUtils::isFinite( _upperBounds[0][i] ) )
+            return;
+    }
+
+    for ( unsigned layer = 1; layer < _numberOfLayers; ++layer )
+    {
+        computeWeightedSumBounds( layer );
+
+        for ( unsigned neuron = 0; neuron < _layerSizes[layer]; ++neuron )
+        {
+            Index index( layer, neuron );
+            if ( _neuronToActivationFunction.exists( index ) &&
+                 _neuronToActivationFunction[index] == Max )
+                computeMaxRelaxation( layer, neuron );
+            else
+                computeRelaxation( layer, neuron );
+        }
+    }
+}
+
+void NetworkLevelReasoner::computeWeightedSumBounds( unsigned layer )
+{
+    unsigned layerSize = _layerSizes[layer];
+    unsigned sourceLayerSize = _layerSizes[layer - 1];
+
+    // Start from the weighted sums, in terms of the previous layer
+    memcpy( _workLower, _weights[layer - 1], sizeof(double) * sourceLayerSize * layerSize );
+    memcpy( _workUpper, _weights[layer - 1], sizeof(double) * sourceLayerSize * layerSize );
+
+    for ( unsigned neuron = 0; neuron < layerSize; ++neuron )
+    {
+        Index index( layer, neuron );
+        _workLowerBias[neuron] = _bias.exists( index ) ? _bias[index] : 0;
+        _workUpperBias[neuron] = _workLowerBias[neuron];
+    }
+
+    // Substitute the relaxations of the earlier layers, all the way
+    // back to the input layer
+    for ( unsigned current = layer - 1; current > 0; --current )
+        substituteRelaxations( current, layerSize );
+
+    // Concretize, using the input bounds
+    unsigned inputLayerSize = _layerSizes[0];
+    double rounding = inputLayerSize * GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
+
+    for ( unsigned neuron = 0; neuron < layerSize; ++neuron )
+    {
+        double lb = _workLowerBias[neuron];
+        double ub = _workUpperBias[neuron];
+
+        for ( unsigned input = 0; input < inputLayerSize; ++input )
+        {
+            double lowerCoefficient = _workLower[input * layerSize + neuron];
+            double upperCoefficient = _workUpper[input * layerSize + neuron];
+
+            lb += lowerCoefficient *
+                ( lowerCoefficient > 0 ? _lowerBounds[0][input] : _upperBounds[0][input] );
+            ub += upperCoefficient *
+                ( upperCoefficient > 0 ? _upperBounds[0][input] : _lowerBounds[0][input] );
+        }
+
+        lb -= rounding;
+        ub += rounding;
+
+        if ( lb > _weightedSumLowerBounds[layer][neuron] )
+            _weightedSumLowerBounds[layer][neuron] = lb;
+        if ( ub < _weightedSumUpperBounds[layer][neuron] )
+            _weightedSumUpperBounds[layer][neuron] = ub;
+    }
+}
+
+void NetworkLevelReasoner::substituteRelaxations( unsigned layer, unsigned targetLayerSize )
+{
+    unsigned layerSize = _layerSizes[layer];
+    unsigned sourceLayerSize = _layerSizes[layer - 1];
+
+    std::fill_n( _workLowerNext, sourceLayerSize * targetLayerSize, 0 );
+    std::fill_n( _workUpperNext, sourceLayerSize * targetLayerSize, 0 );
+
+    for ( unsigned neuron = 0; neuron < layerSize; ++neuron )
+    {
+        for ( unsigned target = 0; target < targetLayerSize; ++target )
+        {
+            /*
+              A lower expression needs the lower relaxation of a
+              neuron with a positive coefficient, and its upper
+              relaxation otherwise. The converse holds for upper
+              expressions.
+            */
+            double lowerCoefficient = _workLower[neuron * targetLayerSize + target];
+            if ( lowerCoefficient != 0 )
+            {
+                bool positive = lowerCoefficient > 0;
+                const double *relaxation = positive ? _lowerRelaxations[layer] : _upperRelaxations[layer];
+                const double *relaxationBias = positive ? _lowerRelaxationBiases[layer] : _upperRelaxationBiases[layer];
+
+                _workLowerBias[target] += lowerCoefficient * relaxationBias[neuron];
+                for ( unsigned source = 0; source < sourceLayerSize; ++source )
+                    _workLowerNext[source * targetLayerSize + target] +=
+                        lowerCoefficient * relaxation[source * layerSize + neuron];
+            }
+
+            double upperCoefficient = _workUpper[neuron * targetLayerSize + target];
+            if ( upperCoefficient != 0 )
+            {
+                bool positive = upperCoefficient > 0;
+                const double *relaxation = positive ? _upperRelaxations[layer] : _lowerRelaxations[layer];
+                const double *relaxationBias = positive ? _upperRelaxationBiases[layer] : _lowerRelaxationBiases[layer];
+
+                _workUpperBias[target] += upperCoefficient * relaxationBias[neuron];
+                for ( unsigned source = 0; source < sourceLayerSize; ++source )
+                    _workUpperNext[source * targetLayerSize + target] +=
+                        upperCoefficient * relaxation[source * layerSize + neuron];
+            }
+        }
+    }
+
+    std::swap( _workLower, _workLowerNext );
+    std::swap( _workUpper, _workUpperNext );
+}
+
+void NetworkLevelReasoner::computeRelaxation( unsigned layer, unsigned neuron )
+{
+    unsigned layerSize = _layerSizes[layer];
+    unsigned sourceLayerSize = _layerSizes[layer - 1];
+    Index index( layer, neuron );
+
+    double lb = _weightedSumLowerBounds[layer][neuron];
+    double ub = _weightedSumUpperBounds[layer][neuron];
+
+    /*
+      Both relaxations are of the form slope * weightedSum + intercept.
+      Without an activation function, the result is the weighted sum
+      itself.
+    */
+    double lowerSlope = 1;
+    double lowerIntercept = 0;
+    double upperSlope = 1;
+    double upperIntercept = 0;
+    double activationLb = lb;
+    double activationUb = ub;
+
+    if ( _neuronToActivationFunction.exists( index ) )
+    {
+        switch ( _neuronToActivationFunction[index] )
+        {
+        case ReLU:
+            if ( ub <= 0 )
+            {
+                // Inactive phase
+                lowerSlope = 0;
+                upperSlope = 0;
+                activationLb = 0;
+                activationUb = 0;
+            }
+            else if ( lb < 0 )
+            {
+                // The upper relaxation passes through (lb, 0) and (ub, ub).
+                // The lower relaxation is either 0 or the weighted sum,
+                // whichever has the smaller area.
+                upperSlope = ub / ( ub - lb );
+                upperIntercept = -upperSlope * lb;
+                lowerSlope = ( ub > -lb ) ? 1 : 0;
+                activationLb = 0;
+            }
+            break;
+
+        case AbsoluteValue:
+            if ( ub <= 0 )
+            {
+                // Negative phase
+                lowerSlope = -1;
+                upperSlope = -1;
+                activationLb = -ub;
+                activationUb = -lb;
+            }
+            else if ( lb < 0 )
+            {
+                // The upper relaxation passes through (lb, -lb) and (ub, ub).
+                // The lower relaxation is 0.
+                upperSlope = ( ub + lb ) / ( ub - lb );
+                upperIntercept = -lb - upperSlope * lb;
+                lowerSlope = 0;
+                activationLb = 0;
+                activationUb = FloatUtils::max( -lb, ub );
+            }
+            break;
+
+        default:
+            ASSERT( false );
+            break;
+        }
+    }
+
+    const double *weights = _weights[layer - 1];
+    double bias = _bias.exists( index ) ? _bias[index] : 0;
+
+    for ( unsigned source = 0; source < sourceLayerSize; ++source )
+    {
+        unsigned entry = source * layerSize + neuron;
+        _lowerRelaxations[layer][entry] = lowerSlope * weights[entry];
+        _upperRelaxations[layer][entry] = upperSlope * weights[entry];
+    }
+
+    _lowerRelaxationBiases[layer][neuron] = lowerSlope * bias + lowerIntercept;
+    _upperRelaxationBiases[layer][neuron] = upperSlope * bias + upperIntercept;
+
+    if ( activationLb > _lowerBounds[layer][neuron] )
+        _lowerBounds[layer][neuron] = activationLb;
+    if ( activationUb < _upperBounds[layer][neuron] )
+        _upperBounds[layer][neuron] = activationUb;
+}
+
+void NetworkLevelReasoner::computeMaxRelaxation( unsigned layer, unsigned neuron )
+{
+    unsigned layerSize = _layerSizes[layer];
+    unsigned sourceLayerSize = _layerSizes[layer - 1];
+    Index index( layer, neuron );
+
+    ASSERT( _maxSources.exists( index ) );
+    const List<unsigned> &sources = _maxSources[index];
+
+    const double *sourceLbs = _lowerBounds[layer - 1];
+    const double *sourceUbs = _upperBounds[layer - 1];
+
+    // The lower relaxation is the source with the largest lower bound
+    unsigned bestSource = *sources.begin();
+    for ( const auto &source : sources )
+    {
+        if ( sourceLbs[source] > sourceLbs[bestSource] )
+            bestSource = source;
+    }
+
+    // If that source is always the largest, the upper relaxation is
+    // the same; otherwise, it is the largest upper bound.
+    bool bestSourceDominates = true;
+    double maxUb = sourceUbs[bestSource];
+    for ( const auto &source : sources )
+    {
+        if ( source == bestSource )
+            continue;
+
+        if ( sourceUbs[source] > sourceLbs[bestSource] )
+            bestSourceDominates = false;
+        if ( sourceUbs[source] > maxUb )
+            maxUb = sourceUbs[source];
+    }
+
+    for ( unsigned source = 0; source < sourceLayerSize; ++source )
+    {
+        _lowerRelaxations[layer][source * layerSize + neuron] = 0;
+        _upperRelaxations[layer][source * layerSize + neuron] = 0;
+    }
+
+    _lowerRelaxations[layer][bestSource * layerSize + neuron] = 1;
+    _lowerRelaxationBiases[layer][neuron] = 0;
+
+    if ( bestSourceDominates )
+    {
+        _upperRelaxations[layer][bestSource * layerSize + neuron] = 1;
+        _upperRelaxationBiases[layer][neuron] = 0;
+    }
+    else
+    {
+        _upperRelaxationBiases[layer][neuron] = maxUb;
+    }
+
+    if ( sourceLbs[bestSource] > _lowerBounds[layer][neuron] )
+        _lowerBounds[layer][neuron] = sourceLbs[bestSource];
+    if ( maxUb < _upperBounds[layer][neuron] )
+        _upperBounds[layer][neuron] = maxUb;
+}
+
+double NetworkLevelReasoner::getLowerBound( unsigned layer, unsigned neuron ) const
+{
+    ASSERT( layer < _numberOfLayers );
+    return _lowerBounds[layer][neuron];
+}
+
+double NetworkLevelReasoner::getUpperBound( unsigned layer, unsigned neuron ) const
+{
+    ASSERT( layer < _numberOfLayers );
+    return _upperBounds[layer][neuron];
+}
+
+void NetworkLevelReasoner::getConstraintTightenings( List<Tightening> &tightenings ) const
+{
+    for ( const auto &pair : _indexToWeightedSumVariable )
+    {
+        double lb = _weightedSumLowerBounds[pair.first._layer][pair.first._neuron];
+        double ub = _weightedSumUpperBounds[pair.first._layer][pair.first._neuron];
+
+        if ( FloatUtils::isFinite( lb ) )
+            tightenings.append( Tightening( pair.second, lb, Tightening::LB ) );
+        if ( FloatUtils::isFinite( ub ) )
+            tightenings.append( Tightening( pair.second, ub, Tightening::UB ) );
+    }
+
+    for ( const auto &pair : _indexToActivationResultVariable )
+    {
+        double lb = _lowerBounds[pair.first._layer][pair.first._neuron];
+        double ub = _upperBounds[pair.first._layer][pair.first._neuron];
+
+        if ( FloatUtils::isFinite( lb ) )
+            tightenings.append( Tightening( pair.second, lb, Tightening::LB ) );
+        if ( FloatUtils::isFinite( ub ) )
+            tightenings.append( Tightening( pair.second, ub, Tightening::UB ) );
+    }
+}
+
 void NetworkLevelReasoner::setWeightedSumVariable( unsigned layer, unsigned neuron, unsigned variable )
 {
     _indexToWeightedSumVariable[Index( layer, neuron )] = variable;
@@ -217,6 +726,10 @@ void NetworkLevelReasoner::storeIntoOther( NetworkLevelReasoner &other ) const
     for ( const auto &pair : _bias )
         other.setBias( pair.first._layer, pair.first._neuron, pair.second );
 
+    other._maxSources = _maxSources;
+    other._inputIndexToNeuron = _inputIndexToNeuron;
+    other._fixedInputNeurons = _fixedInputNeurons;
+
     other._indexToWeightedSumVariable = _indexToWeightedSumVariable;
     other._indexToActivationResultVariable = _indexToActivationResultVariable;
     other._indexToWeightedSumAssignment = _indexToWeightedSumAssignment;
@@ -244,7 +757,9 @@ const Map<NetworkLevelReasoner::Index, double> &NetworkLevelReasoner::getIndexTo
 }
 
 void NetworkLevelReasoner::updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
-                                                  const Map<unsigned, unsigned> &mergedVariables )
+                                                  const Map<unsigned, unsigned> &mergedVariables,
+                                                  const Map<unsigned, double> &fixedVariableValues,
+                                                  const Map<unsigned, unsigned> &inputIndexToVariable )
 {
     // First, do a pass to handle any merged variables
     auto bIt = _indexToWeightedSumVariable.begin();
@@ -328,6 +843,32 @@ void NetworkLevelReasoner::updateVariableIndices( const Map<unsigned, unsigned>
             continue;
         }
     }
+
+    // Finally, handle any input variables that have become fixed. The
+    // remaining input variables keep their order, so their indices
+    // are compacted.
+    Map<unsigned, unsigned> newInputIndexToNeuron;
+    unsigned currentIndex = 0;
+    for ( const auto &pair : _inputIndexToNeuron )
+    {
+        ASSERT( inputIndexToVariable.exists( pair.first ) );
+        unsigned variable = inputIndexToVariable.get( pair.first );
+
+        if ( mergedVariables.exists( variable ) )
+            throw MarabouError( MarabouError::MERGED_INPUT_VARIABLE );
+
+        if ( oldIndexToNewIndex.exists( variable ) )
+        {
+            newInputIndexToNeuron[currentIndex] = pair.second;
+            ++currentIndex;
+        }
+        else
+        {
+            _fixedInputNeurons[pair.second] = fixedVariableValues.get( variable );
+        }
+    }
+
+    _inputIndexToNeuron = newInputIndexToNeuron;
 }
 
 //
@@ -16,7 +16,9 @@
 #ifndef __NetworkLevelReasoner_h__
 #define __NetworkLevelReasoner_h__
 
+#include "List.h"
 #include "Map.h"
+#include "Tightening.h"
 
 /*
   A class for performing operations that require knowledge of network
@@ -64,6 +66,8 @@ public:
     */
     enum ActivationFunction {
         ReLU,
+        AbsoluteValue,
+        Max,
     };
 
     void setNumberOfLayers( unsigned numberOfLayers );
@@ -73,6 +77,13 @@ public:
     void setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight );
     void setBias( unsigned layer, unsigned neuron, double bias );
 
+    /*
+      A max neuron has no weights or bias: its value is the maximum of
+      a set of neurons in the previous layer. Note that the AcasParser,
+      currently the only builder of an NLR, only creates ReLU networks.
+    */
+    void addMaxSource( unsigned layer, unsigned neuron, unsigned sourceNeuron );
+
     /*
       Mapping from node indices to the variables representing their
       weighted sum values and activation result values.
@@ -96,6 +107,34 @@ public:
     */
     void evaluate( double *input, double *output );
 
+    /*
+      Bound tightening by back-substitution (as in DeepPoly/CROWN).
+      Every neuron is given a linear lower and a linear upper
+      relaxation in terms of the neurons of the previous layer. The
+      bounds of a weighted sum are computed by substituting these
+      relaxations back, layer by layer, until the expression only
+      involves the input neurons, and only then concretizing it.
+
+      Before running, the caller clears the bounds of the previous
+      run and reports the current bounds of the input neurons and of
+      any other neurons whose bounds are known. Nothing is computed
+      unless all input bounds are finite.
+    */
+    void clearBounds();
+    void setInputBounds( unsigned index, double lb, double ub );
+    void setWeightedSumBounds( unsigned layer, unsigned neuron, double lb, double ub );
+    void setActivationResultBounds( unsigned layer, unsigned neuron, double lb, double ub );
+    void performBackSubstitution();
+
+    /*
+      After running, extract the bounds of the activation results
+      (or, for the input layer, of the inputs themselves), or the
+      bounds of all variables mapped to neurons
+    */
+    double getLowerBound( unsigned layer, unsigned neuron ) const;
+    double getUpperBound( unsigned layer, unsigned neuron ) const;
+    void getConstraintTightenings( List<Tightening> &tightenings ) const;
+
     /*
       Duplicate the reasoner
     */
@@ -103,10 +142,15 @@ public:
 
     /*
       Methods that are typically invoked by the preprocessor,
-      to inform us of changes in variable indices
+      to inform us of changes in variable indices. The query's mapping
+      from input indices to variables, before the update, is needed to
+      identify the inputs; input variables that have become fixed are
+      removed from the input indexing used by setInputBounds().
     */
     void updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
-                                const Map<unsigned, unsigned> &mergedVariables );
+                                const Map<unsigned, unsigned> &mergedVariables,
+                                const Map<unsigned, double> &fixedVariableValues,
+                                const Map<unsigned, unsigned> &inputIndexToVariable );
 
 private:
     unsigned _numberOfLayers;
@@ -114,6 +158,7 @@ private:
     Map<Index, ActivationFunction> _neuronToActivationFunction;
     double **_weights;
     Map<Index, double> _bias;
+    Map<Index, List<unsigned>> _maxSources;
 
     unsigned _maxLayerSize;
 
@@ -122,12 +167,72 @@ private:
 
     void freeMemoryIfNeeded();
 
+    /*
+      Allocate or free an array per layer. A relaxation array of layer
+      i is sized like the weights between layers i - 1 and i; other
+      arrays have an entry per neuron of layer i.
+    */
+    double **allocateLayerArrays( bool relaxations );
+    void freeLayerArrays( double **&arrays );
+
+    /*
+      The concrete bounds of the weighted sums and of the activation
+      results of every layer
+    */
+    double **_weightedSumLowerBounds;
+    double **_weightedSumUpperBounds;
+    double **_lowerBounds;
+    double **_upperBounds;
+
+    /*
+      The linear relaxations of every layer, in terms of the
+      activation results of the previous layer. They are laid out
+      like the weights: entry i * targetLayerSize + j is the
+      coefficient of source neuron i in the relaxation of target
+      neuron j.
+    */
+    double **_lowerRelaxations;
+    double **_upperRelaxations;
+    double **_lowerRelaxationBiases;
+    double **_upperRelaxationBiases;
+
+    /*
+      Work space for back-substitution: the lower and upper
+      expressions of the weighted sums of the current layer, in terms
+      of the neurons of some earlier layer
+    */
+    double *_workLower;
+    double *_workUpper;
+    double *_workLowerNext;
+    double *_workUpperNext;
+    double *_workLowerBias;
+    double *_workUpperBias;
+
+    /*
+      Helpers for back-substitution: computing the concrete bounds of
+      the weighted sums of a layer, substituting the relaxations of a
+      layer into the current expressions, and computing the
+      relaxation of a single neuron.
+    */
+    void computeWeightedSumBounds( unsigned layer );
+    void substituteRelaxations( unsigned layer, unsigned targetLayerSize );
+    void computeRelaxation( unsigned layer, unsigned neuron );
+    void computeMaxRelaxation( unsigned layer, unsigned neuron );
+
     /*
       Mappings of indices to weighted sum and activation result variables
     */
     Map<Index, unsigned> _indexToWeightedSumVariable;
     Map<Index, unsigned> _indexToActivationResultVariable;
 
+    /*
+      To account for input variables that were fixed and eliminated
+      by the preprocessor: the mapping from input indices to input
+      neurons, and the values of the fixed input neurons
+    */
+    Map<unsigned, unsigned> _inputIndexToNeuron;
+    Map<unsigned, double> _fixedInputNeurons;
+
     /*
       Store the assignment to all variables when evaluate() is called
     */
@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file OptionsQueryLoader.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Build the input query described by the command-line options
+ **
+ ** The query is either read from a query file, or generated from an
+ ** ACAS network file and an optional property file.
+ **/
+
+#include "AcasParser.h"
+#include "File.h"
+#include "MarabouError.h"
+#include "Options.h"
+#include "OptionsQueryLoader.h"
+#include "PropertyParser.h"
+#include "QueryLoader.h"
+
+void OptionsQueryLoader::loadQuery( InputQuery &inputQuery )
+{
+    String inputQueryFilePath = Options::get()->getString( Options::INPUT_QUERY_FILE_PATH );
+    if ( inputQueryFilePath.length() > 0 )
+    {
+        /*
+          Step 1: extract the query
+        */
+        if ( !File::exists( inputQueryFilePath ) )
+        {
+            printf( "Error: the specified inputQuery file (%s) doesn't exist!\n", inputQueryFilePath.ascii() );
+            throw MarabouError( MarabouError::FILE_DOESNT_EXIST, inputQueryFilePath.ascii() );
+        }
+
+        printf( "InputQuery: %s\n", inputQueryFilePath.ascii() );
+        inputQuery = QueryLoader::loadQuery( inputQueryFilePath );
+    }
+    else
+    {
+        /*
+          Step 1: extract the network
+        */
+        String networkFilePath = Options::get()->getString( Options::INPUT_FILE_PATH );
+        if ( !File::exists( networkFilePath ) )
+        {
+            printf( "Error: the specified network file (%s) doesn't exist!\n",
+                    networkFilePath.ascii() );
+            throw MarabouError( MarabouError::FILE_DOESNT_EXIST,
+                                networkFilePath.ascii() );
+        }
+        printf( "Network: %s\n", networkFilePath.ascii() );
+
+        /*
+          Step 2: extract the property in question
+        */
+        String propertyFilePath = Options::get()->getString( Options::PROPERTY_FILE_PATH );
+        if ( propertyFilePath != "" )
+        {
+            if ( !File::exists( propertyFilePath ) )
+            {
+                printf( "Error: the specified property file (%s) doesn't exist!\n",
+                        propertyFilePath.ascii() );
+                throw MarabouError( MarabouError::FILE_DOESNT_EXIST,
+                                    propertyFilePath.ascii() );
+            }
+            printf( "Property: %s\n", propertyFilePath.ascii() );
+        }
+        else
+            printf( "Property: None\n" );
+
+        AcasParser acasParser( networkFilePath );
+        acasParser.generateQuery( inputQuery );
+        if ( propertyFilePath != "" )
+            PropertyParser().parse( propertyFilePath, inputQuery );
+    }
+    printf( "\n" );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
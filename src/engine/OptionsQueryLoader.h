@@ -0,0 +1,42 @@
+/*********************                                                        */
+/*! \file OptionsQueryLoader.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Build the input query described by the command-line options
+ **
+ ** The query is either read from a query file, or generated from an
+ ** ACAS network file and an optional property file.
+ **/
+
+#ifndef __OptionsQueryLoader_h__
+#define __OptionsQueryLoader_h__
+
+#include "InputQuery.h"
+
+class OptionsQueryLoader
+{
+public:
+    /*
+      Load the query file if one was given; otherwise, parse the
+      network and the property. The query is stored into inputQuery.
+      Throws if any of the files is missing.
+    */
+    static void loadQuery( InputQuery &inputQuery );
+};
+
+#endif // __OptionsQueryLoader_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
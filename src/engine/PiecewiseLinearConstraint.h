@@ -16,6 +16,7 @@
 #ifndef __PiecewiseLinearConstraint_h__
 #define __PiecewiseLinearConstraint_h__
 
+#include "FlatMap.h"
 #include "FloatUtils.h"
 #include "ITableau.h"
 #include "List.h"
@@ -251,9 +252,15 @@ public:
 
 protected:
     bool _constraintActive;
-	Map<unsigned, double> _assignment;
-    Map<unsigned, double> _lowerBounds;
-    Map<unsigned, double> _upperBounds;
+
+    /*
+      The current assignment and bounds of the participating
+      variables. Constraints have few participating variables, so
+      these are stored in flat arrays rather than in trees.
+    */
+    FlatMap<unsigned, double> _assignment;
+    FlatMap<unsigned, double> _lowerBounds;
+    FlatMap<unsigned, double> _upperBounds;
 
     /*
       The score denotes priority for splitting. When score is negative, the PL constraint
@@ -0,0 +1,352 @@
+/*********************                                                        */
+/*! \file PortfolioManager.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Solve one query with several differently configured engines
+ **
+ ** Each engine runs on its own thread with its own EngineConfiguration.
+ ** The first engine to reach sat or unsat asks the others to quit, and
+ ** its result is reported.
+ **/
+
+#include "Debug.h"
+#include "GetCPUData.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "PortfolioManager.h"
+#include <thread>
+
+void PortfolioManager::portfolioSolve( std::shared_ptr<Engine> engine,
+                                       unsigned timeoutInSeconds,
+                                       const List<std::atomic_bool *> &quitThreads,
+                                       std::atomic_uint &winningEngine,
+                                       unsigned threadId )
+{
+    unsigned cpuId = 0;
+    getCPUId( cpuId );
+    log( Stringf( "Thread #%u on CPU %u: %s", threadId, cpuId,
+                  engine->getConfiguration().toString().ascii() ) );
+
+    engine->solve( timeoutInSeconds );
+
+    Engine::ExitCode result = engine->getExitCode();
+    if ( result != Engine::SAT && result != Engine::UNSAT )
+        return;
+
+    // Only the first engine to finish determines the result
+    unsigned noWinner = quitThreads.size();
+    if ( !winningEngine.compare_exchange_strong( noWinner, threadId ) )
+        return;
+
+    log( Stringf( "Thread #%u finished first, stopping all engines", threadId ) );
+    for ( auto &quitThread : quitThreads )
+        *quitThread = true;
+}
+
+PortfolioManager::PortfolioManager( unsigned numEngines, InputQuery *inputQuery,
+                                    unsigned verbosity )
+    : _numEngines( numEngines )
+    , _baseInputQuery( inputQuery )
+    , _exitCode( PortfolioManager::NOT_DONE )
+    , _winningEngine( numEngines )
+    , _verbosity( verbosity )
+    , _constraintViolationThreshold( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+    , _lpBoundTightening( false )
+{
+}
+
+EngineConfiguration PortfolioManager::getConfiguration( unsigned index,
+                                                        unsigned constraintViolationThreshold )
+{
+    enum {
+        NUM_BASE_CONFIGURATIONS = 6,
+    };
+
+    EngineConfiguration configuration;
+    configuration._constraintViolationThreshold = constraintViolationThreshold;
+
+    switch ( index % NUM_BASE_CONFIGURATIONS )
+    {
+    case 0:
+        // The default configuration
+        break;
+
+    case 1:
+        configuration._entryStrategy = EngineConfiguration::DANTZIG;
+        break;
+
+    case 2:
+        configuration._splittingStrategy = DivideStrategy::EarliestReLU;
+        break;
+
+    case 3:
+        // Split eagerly
+        configuration._constraintViolationThreshold =
+            ( constraintViolationThreshold + 3 ) / 4;
+        break;
+
+    case 4:
+        configuration._useLinearConcretization = !configuration._useLinearConcretization;
+        break;
+
+    case 5:
+        // Split lazily
+        configuration._constraintViolationThreshold = 4 * constraintViolationThreshold;
+        break;
+    }
+
+    // Additional rounds of engines differ in their splitting thresholds
+    configuration._constraintViolationThreshold *= ( 1 + index / NUM_BASE_CONFIGURATIONS );
+
+    if ( configuration._constraintViolationThreshold == 0 )
+        configuration._constraintViolationThreshold = 1;
+
+    return configuration;
+}
+
+void PortfolioManager::solve( unsigned timeoutInSeconds )
+{
+    // Preprocess the input query and create an engine for each of the threads
+    if ( !createEngines() )
+    {
+        _exitCode = PortfolioManager::UNSAT;
+        return;
+    }
+
+    // Prepare the mechanism through which we can ask the engines to quit
+    List<std::atomic_bool *> quitThreads;
+    for ( unsigned i = 0; i < _numEngines; ++i )
+        quitThreads.append( _engines[i]->getQuitRequested() );
+
+    // Spawn threads and start solving. The engines enforce the timeout
+    // themselves, and the first engine to finish stops the others.
+    std::list<std::thread> threads;
+    for ( unsigned threadId = 0; threadId < _numEngines; ++threadId )
+    {
+        threads.push_back( std::thread( portfolioSolve,
+                                        _engines[threadId],
+                                        timeoutInSeconds,
+                                        std::cref( quitThreads ),
+                                        std::ref( _winningEngine ),
+                                        threadId ) );
+    }
+
+    for ( auto &thread : threads )
+        thread.join();
+
+    updatePortfolioExitCode();
+}
+
+PortfolioManager::PortfolioExitCode PortfolioManager::getExitCode() const
+{
+    return _exitCode;
+}
+
+unsigned PortfolioManager::getWinningEngine() const
+{
+    return _winningEngine.load();
+}
+
+void PortfolioManager::updatePortfolioExitCode()
+{
+    unsigned winningEngine = _winningEngine.load();
+    if ( winningEngine < _numEngines )
+    {
+        if ( _engines[winningEngine]->getExitCode() == Engine::SAT )
+            _exitCode = PortfolioManager::SAT;
+        else
+            _exitCode = PortfolioManager::UNSAT;
+        return;
+    }
+
+    bool hasTimeout = false;
+    bool hasQuitRequested = false;
+    bool hasError = false;
+    for ( auto &engine : _engines )
+    {
+        Engine::ExitCode result = engine->getExitCode();
+        if ( result == Engine::TIMEOUT )
+            hasTimeout = true;
+        else if ( result == Engine::QUIT_REQUESTED )
+            hasQuitRequested = true;
+        else if ( result == Engine::ERROR )
+            hasError = true;
+    }
+
+    if ( hasTimeout )
+        _exitCode = PortfolioManager::TIMEOUT;
+    else if ( hasQuitRequested )
+        _exitCode = PortfolioManager::QUIT_REQUESTED;
+    else if ( hasError )
+        _exitCode = PortfolioManager::ERROR;
+    else
+    {
+        ASSERT( false ); // This should never happen
+        _exitCode = PortfolioManager::NOT_DONE;
+    }
+}
+
+String PortfolioManager::getResultString()
+{
+    switch ( _exitCode )
+    {
+    case PortfolioManager::SAT:
+        return "sat";
+    case PortfolioManager::UNSAT:
+        return "unsat";
+    case PortfolioManager::ERROR:
+        return "ERROR";
+    case PortfolioManager::NOT_DONE:
+        return "NOT_DONE";
+    case PortfolioManager::QUIT_REQUESTED:
+        return "QUIT_REQUESTED";
+    case PortfolioManager::TIMEOUT:
+        return "TIMEOUT";
+    default:
+        ASSERT( false );
+        return "";
+    }
+}
+
+void PortfolioManager::getSolution( std::map<int, double> &ret )
+{
+    ASSERT( _exitCode == PortfolioManager::SAT );
+
+    std::shared_ptr<Engine> engine = _engines[_winningEngine.load()];
+    InputQuery *inputQuery = engine->getInputQuery();
+    engine->extractSolution( *( inputQuery ) );
+
+    for ( unsigned i = 0; i < inputQuery->getNumberOfVariables(); ++i )
+        ret[i] = inputQuery->getSolutionValue( i );
+}
+
+void PortfolioManager::printResult()
+{
+    std::cout << std::endl;
+
+    unsigned winningEngine = _winningEngine.load();
+    if ( winningEngine < _numEngines )
+        printf( "Result found by engine #%u (%s)\n\n", winningEngine,
+                _engines[winningEngine]->getConfiguration().toString().ascii() );
+
+    switch ( _exitCode )
+    {
+    case PortfolioManager::SAT:
+    {
+        std::cout << "sat\n" << std::endl;
+
+        std::shared_ptr<Engine> engine = _engines[winningEngine];
+        InputQuery *inputQuery = engine->getInputQuery();
+        engine->extractSolution( *( inputQuery ) );
+
+        Vector<double> inputVector( inputQuery->getNumInputVariables() );
+        Vector<double> outputVector( inputQuery->getNumOutputVariables() );
+        double *inputs( inputVector.data() );
+        double *outputs( outputVector.data() );
+
+        printf( "Input assignment:\n" );
+        for ( unsigned i = 0; i < inputQuery->getNumInputVariables(); ++i )
+        {
+            printf( "\tx%u = %lf\n", i, inputQuery->getSolutionValue( inputQuery->inputVariableByIndex( i ) ) );
+            inputs[i] = inputQuery->getSolutionValue( inputQuery->inputVariableByIndex( i ) );
+        }
+
+        NetworkLevelReasoner *nlr = inputQuery->getNetworkLevelReasoner();
+        if ( nlr )
+            nlr->evaluate( inputs, outputs );
+
+        printf( "\n" );
+        printf( "Output:\n" );
+        for ( unsigned i = 0; i < inputQuery->getNumOutputVariables(); ++i )
+        {
+            if ( nlr )
+                printf( "\tnlr y%u = %lf\n", i, outputs[i] );
+            else
+                printf( "\ty%u = %lf\n", i, inputQuery->getSolutionValue( inputQuery->outputVariableByIndex( i ) ) );
+        }
+        printf( "\n" );
+        break;
+    }
+    case PortfolioManager::UNSAT:
+        std::cout << "unsat" << std::endl;
+        break;
+    case PortfolioManager::ERROR:
+        std::cout << "ERROR" << std::endl;
+        break;
+    case PortfolioManager::NOT_DONE:
+        std::cout << "NOT_DONE" << std::endl;
+        break;
+    case PortfolioManager::QUIT_REQUESTED:
+        std::cout << "QUIT_REQUESTED" << std::endl;
+        break;
+    case PortfolioManager::TIMEOUT:
+        std::cout << "TIMEOUT" << std::endl;
+        break;
+    default:
+        ASSERT( false );
+    }
+}
+
+bool PortfolioManager::createEngines()
+{
+    // Create the base engine
+    _baseEngine = std::make_shared<Engine>();
+
+    InputQuery baseInputQuery = *_baseInputQuery;
+
+    if ( !_baseEngine->processInputQuery( baseInputQuery ) )
+        // Solved by preprocessing, we are done!
+        return false;
+
+    // The engines have not started yet, so the LP-based bound
+    // tightening can use all of the threads
+    if ( _lpBoundTightening && !_baseEngine->performLpBoundTightening( _numEngines ) )
+        return false;
+
+    /*
+      Create a differently configured engine for each thread. The input
+      query is only processed once, by the base engine, and the other
+      engines copy its result. The configuration has to be set before
+      the copy, so that the entry strategy is initialized properly.
+    */
+    for ( unsigned i = 0; i < _numEngines; ++i )
+    {
+        auto engine = std::make_shared<Engine>( _verbosity );
+        engine->setConfiguration( getConfiguration( i, _constraintViolationThreshold ) );
+        engine->initializeFromEngine( *_baseEngine );
+        _engines.append( engine );
+    }
+
+    return true;
+}
+
+void PortfolioManager::log( const String &message )
+{
+    if ( GlobalConfiguration::PORTFOLIO_MANAGER_LOGGING )
+        printf( "PortfolioManager: %s\n", message.ascii() );
+}
+
+void PortfolioManager::setConstraintViolationThreshold( unsigned threshold )
+{
+    _constraintViolationThreshold = threshold;
+}
+
+void PortfolioManager::setLpBoundTightening( bool lpBoundTightening )
+{
+    _lpBoundTightening = lpBoundTightening;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,186 @@
+/*********************                                                        */
+/*! \file PortfolioManager.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Solve one query with several differently configured engines
+ **
+ ** Each engine runs on its own thread with its own EngineConfiguration.
+ ** The first engine to reach sat or unsat asks the others to quit, and
+ ** its result is reported.
+ **/
+
+#ifndef __PortfolioManager_h__
+#define __PortfolioManager_h__
+
+#include "Engine.h"
+#include "EngineConfiguration.h"
+#include "InputQuery.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+/*
+  Solve a single query by running several differently configured
+  engines in parallel, each on its own thread. The first engine to
+  reach a definite answer (sat or unsat) wins, and the others are
+  asked to quit.
+*/
+class PortfolioManager
+{
+public:
+
+    enum PortfolioExitCode
+        {
+            UNSAT = 0,
+            SAT = 1,
+            ERROR = 2,
+            TIMEOUT = 3,
+            QUIT_REQUESTED = 4,
+
+            NOT_DONE = 999,
+        };
+
+    PortfolioManager( unsigned numEngines, InputQuery *inputQuery,
+                      unsigned verbosity );
+
+    /*
+      Run the portfolio on the input query
+    */
+    void solve( unsigned timeoutInSeconds );
+
+    /*
+      Return the PortfolioExitCode of the PortfolioManager
+    */
+    PortfolioExitCode getExitCode() const;
+
+    /*
+      Get the string representation of the exitcode
+    */
+    String getResultString();
+
+    /*
+      Print the result of portfolio solving
+    */
+    void printResult();
+
+    /*
+      Store the solution into the map
+    */
+    void getSolution( std::map<int, double> &ret );
+
+    /*
+      The base constraint violation threshold, from which the
+      thresholds of the individual engines are derived
+    */
+    void setConstraintViolationThreshold( unsigned threshold );
+
+    /*
+      Whether the base engine should tighten the bounds with LP
+      relaxations before the engines are created
+    */
+    void setLpBoundTightening( bool lpBoundTightening );
+
+    /*
+      The configuration used by the engine with the given index. The
+      first few engines use a fixed set of diverse configurations; any
+      additional engines reuse these with progressively larger
+      constraint violation thresholds.
+    */
+    static EngineConfiguration getConfiguration( unsigned index,
+                                                 unsigned constraintViolationThreshold );
+
+    /*
+      The index of the engine that determined the result, or the number
+      of engines if no engine did
+    */
+    unsigned getWinningEngine() const;
+
+private:
+    /*
+      Run a single engine, and ask all engines to quit if it reaches a
+      definite answer before any other engine does
+    */
+    static void portfolioSolve( std::shared_ptr<Engine> engine,
+                                unsigned timeoutInSeconds,
+                                const List<std::atomic_bool *> &quitThreads,
+                                std::atomic_uint &winningEngine,
+                                unsigned threadId );
+
+    /*
+      Process the input query with the base engine, and create a
+      differently configured engine for each thread
+    */
+    bool createEngines();
+
+    /*
+      Read the exit codes of the engines, and update the manager's
+      exitCode.
+    */
+    void updatePortfolioExitCode();
+
+    static void log( const String &message );
+
+    /*
+      The base engine that is used to process the input query
+    */
+    std::shared_ptr<Engine> _baseEngine;
+
+    /*
+      The engines that are run in different threads
+    */
+    Vector<std::shared_ptr<Engine>> _engines;
+
+    /*
+      The number of engines (and threads) in the portfolio
+    */
+    unsigned _numEngines;
+
+    /*
+      The query to solve
+    */
+    InputQuery *_baseInputQuery;
+
+    /*
+      The exit code of the PortfolioManager.
+    */
+    PortfolioExitCode _exitCode;
+
+    /*
+      The index of the engine that determined the result
+    */
+    std::atomic_uint _winningEngine;
+
+    /*
+      The level of verbosity
+    */
+    unsigned _verbosity;
+
+    /*
+      The base constraint violation threshold
+    */
+    unsigned _constraintViolationThreshold;
+
+    /*
+      Whether to perform LP-based bound tightening on the base engine
+    */
+    bool _lpBoundTightening;
+};
+
+#endif // __PortfolioManager_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
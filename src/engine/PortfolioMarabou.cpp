@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file PortfolioMarabou.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Entry point of the portfolio solving mode
+ **
+ ** Loads the query described by the command-line options and hands it
+ ** to a PortfolioManager, which races several differently configured
+ ** engines on it.
+ **/
+
+#include "PortfolioMarabou.h"
+#include "File.h"
+#include "MStringf.h"
+#include "Options.h"
+#include "OptionsQueryLoader.h"
+#include "MarabouError.h"
+
+PortfolioMarabou::PortfolioMarabou()
+    : _portfolioManager( nullptr )
+    , _inputQuery( InputQuery() )
+{
+}
+
+void PortfolioMarabou::run()
+{
+    /*
+      Step 1: extract the query
+    */
+    OptionsQueryLoader::loadQuery( _inputQuery );
+
+    /*
+      Step 2: initialize the portfolio
+    */
+    int numEngines = Options::get()->getInt( Options::NUM_WORKERS );
+    unsigned verbosity = Options::get()->getInt( Options::VERBOSITY );
+    unsigned timeoutInSeconds = Options::get()->getInt( Options::TIMEOUT );
+
+    if ( numEngines <= 0 )
+    {
+        printf( "Invalid number of workers %d, using a single engine.\n\n",
+                numEngines );
+        numEngines = 1;
+    }
+
+    int splitThreshold = Options::get()->getInt( Options::SPLIT_THRESHOLD );
+    if ( splitThreshold < 0 )
+    {
+        printf( "Invalid constraint violation threshold value %d,"
+                " using default value %u.\n\n", splitThreshold,
+                GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD );
+        splitThreshold = GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD;
+    }
+
+    _portfolioManager = std::unique_ptr<PortfolioManager>
+      ( new PortfolioManager( numEngines, &_inputQuery, verbosity ) );
+    _portfolioManager->setConstraintViolationThreshold( splitThreshold );
+    _portfolioManager->setLpBoundTightening( Options::get()->getBool( Options::LP_BOUND_TIGHTENING ) );
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    _portfolioManager->solve( timeoutInSeconds );
+
+    struct timespec end = TimeUtils::sampleMicro();
+
+    unsigned long long totalElapsed = TimeUtils::timePassed( start, end );
+    displayResults( totalElapsed );
+}
+
+void PortfolioMarabou::displayResults( unsigned long long microSecondsElapsed ) const
+{
+    std::cout << "Total Time: " << microSecondsElapsed / 1000000 << std::endl;
+    _portfolioManager->printResult();
+    String resultString = _portfolioManager->getResultString();
+    // Create a summary file, if requested
+    String summaryFilePath = Options::get()->getString( Options::SUMMARY_FILE );
+    if ( summaryFilePath != "" )
+    {
+        File summaryFile( summaryFilePath );
+        summaryFile.open( File::MODE_WRITE_TRUNCATE );
+
+        // Field #1: result
+        summaryFile.write( resultString );
+
+        // Field #2: total elapsed time
+        summaryFile.write( Stringf( " %u ", microSecondsElapsed / 1000000 ) );
+
+        // Field #3: number of visited tree states
+        summaryFile.write( Stringf( "0 " ) );
+
+        // Field #4: average pivot time in micro seconds
+        summaryFile.write( Stringf( "0" ) );
+
+        summaryFile.write( "\n" );
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
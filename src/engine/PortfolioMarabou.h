@@ -0,0 +1,53 @@
+/*********************                                                        */
+/*! \file PortfolioMarabou.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Entry point of the portfolio solving mode
+ **
+ ** Loads the query described by the command-line options and hands it
+ ** to a PortfolioManager, which races several differently configured
+ ** engines on it.
+ **/
+
+#ifndef __PortfolioMarabou_h__
+#define __PortfolioMarabou_h__
+
+#include "PortfolioManager.h"
+#include "Options.h"
+#include "InputQuery.h"
+
+class PortfolioMarabou
+{
+public:
+    PortfolioMarabou();
+
+    /*
+      Entry point of this class
+    */
+    void run();
+
+private:
+    std::unique_ptr<PortfolioManager> _portfolioManager;
+    InputQuery _inputQuery;
+    /*
+      Display the results
+    */
+    void displayResults( unsigned long long microSecondsElapsed ) const;
+};
+
+#endif // __PortfolioMarabou_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -25,7 +25,8 @@
 #include "SymbolicBoundTightener.h"
 #include "Tightening.h"
 
-// TODO: get rid of this include
+// TODO: get rid of these includes
+#include "AbsoluteValueConstraint.h"
 #include "ReluConstraint.h"
 
 #ifdef _WIN32
@@ -666,10 +667,25 @@ void Preprocessor::eliminateVariables()
                 if ( !(*constraint)->supportsSymbolicBoundTightening() )
                     throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_UNSUPPORTED_CONSTRAINT_TYPE );
 
-                ReluConstraint *relu = (ReluConstraint *)(*constraint);
-                unsigned b = relu->getB();
-                SymbolicBoundTightener::NodeIndex nodeIndex = _preprocessed._sbt->nodeIndexFromB( b );
-                _preprocessed._sbt->setEliminatedRelu( nodeIndex._layer, nodeIndex._neuron, relu->getPhaseStatus() );
+                if ( ReluConstraint *relu = dynamic_cast<ReluConstraint *>( *constraint ) )
+                {
+                    unsigned b = relu->getB();
+                    SymbolicBoundTightener::NodeIndex nodeIndex = _preprocessed._sbt->nodeIndexFromB( b );
+                    _preprocessed._sbt->setEliminatedRelu( nodeIndex._layer, nodeIndex._neuron, relu->getPhaseStatus() );
+                }
+                else if ( AbsoluteValueConstraint *abs = dynamic_cast<AbsoluteValueConstraint *>( *constraint ) )
+                {
+                    unsigned b = abs->getB();
+                    if ( !_preprocessed._sbt->hasAbsoluteValueNodeForB( b ) )
+                        throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_UNSUPPORTED_CONSTRAINT_TYPE,
+                                            Stringf( "Absolute value constraint on x%u has no absolute value neuron in the SBT", b ).ascii() );
+
+                    if ( abs->getPhaseStatus() != AbsoluteValueConstraint::PHASE_NOT_FIXED )
+                    {
+                        SymbolicBoundTightener::NodeIndex nodeIndex = _preprocessed._sbt->nodeIndexFromB( b );
+                        _preprocessed._sbt->setEliminatedAbsoluteValue( nodeIndex._layer, nodeIndex._neuron, abs->getPhaseStatus() );
+                    }
+                }
             }
 
             if ( _statistics )
@@ -700,7 +716,17 @@ void Preprocessor::eliminateVariables()
 
     // Let the NLR know of changes in indices and merged variables
     if ( _preprocessed._networkLevelReasoner )
-        _preprocessed._networkLevelReasoner->updateVariableIndices( _oldIndexToNewIndex, _mergedVariables );
+    {
+        // The input mapping of the query has not been adjusted yet
+        Map<unsigned, unsigned> inputIndexToVariable;
+        for ( unsigned i = 0; i < _preprocessed.getNumInputVariables(); ++i )
+            inputIndexToVariable[i] = _preprocessed.inputVariableByIndex( i );
+
+        _preprocessed._networkLevelReasoner->updateVariableIndices( _oldIndexToNewIndex,
+                                                                    _mergedVariables,
+                                                                    _fixedVariables,
+                                                                    inputIndexToVariable );
+    }
 
     // Update the lower/upper bound maps
     for ( unsigned i = 0; i < _preprocessed.getNumberOfVariables(); ++i )
@@ -767,6 +793,13 @@ unsigned Preprocessor::getNewIndex( unsigned oldIndex ) const
     return oldIndex;
 }
 
+void Preprocessor::storeVariableMappingsIntoOther( Preprocessor &other ) const
+{
+    other._fixedVariables = _fixedVariables;
+    other._mergedVariables = _mergedVariables;
+    other._oldIndexToNewIndex = _oldIndexToNewIndex;
+}
+
 void Preprocessor::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
@@ -55,6 +55,13 @@ public:
     */
     unsigned getNewIndex( unsigned oldIndex ) const;
 
+    /*
+      Copy the information about fixed, merged and re-indexed
+      variables into another preprocessor. The preprocessed query
+      itself is not copied.
+    */
+    void storeVariableMappingsIntoOther( Preprocessor &other ) const;
+
 private:
     /*
       Transform all equations of type GE or LE to type EQ.
@@ -112,23 +112,6 @@ bool ProjectedSteepestEdgeRule::select( ITableau &tableau,
                                         const List<unsigned> &candidates,
                                         const Set<unsigned> &excluded )
 {
-    List<unsigned> remainingCandidates = candidates;
-
-    List<unsigned>::iterator it = remainingCandidates.begin();
-    while ( it != remainingCandidates.end() )
-    {
-        if ( excluded.exists( *it ) )
-            it = remainingCandidates.erase( it );
-        else
-            ++it;
-    }
-
-    if ( remainingCandidates.empty() )
-    {
-        log( "No candidates, select returning false" );
-        return false;
-    }
-
     // Obtain the cost function
     const double *costFunction = tableau.getCostFunction();
 
@@ -143,28 +126,30 @@ bool ProjectedSteepestEdgeRule::select( ITableau &tableau,
       is maximal.
     */
 
-    it = remainingCandidates.begin();
-    unsigned bestCandidate = *it;
-    double gammaValue = _gamma[*it];
-    double bestValue =
-        ( gammaValue < DBL_EPSILON ) ? 0 : ( costFunction[*it] * costFunction[*it] ) / gammaValue;
-
-    ++it;
-
-    while ( it != remainingCandidates.end() )
+    bool found = false;
+    unsigned bestCandidate = 0;
+    double bestValue = 0.0;
+    for ( const auto &contender : candidates )
     {
-        unsigned contender = *it;
-        gammaValue = _gamma[*it];
+        if ( excluded.exists( contender ) )
+            continue;
+
+        double gammaValue = _gamma[contender];
         double contenderValue =
-            ( gammaValue < DBL_EPSILON ) ? 0 : ( costFunction[*it] * costFunction[*it] ) / gammaValue;
+            ( gammaValue < DBL_EPSILON ) ? 0 : ( costFunction[contender] * costFunction[contender] ) / gammaValue;
 
-        if ( contenderValue > bestValue )
+        if ( !found || contenderValue > bestValue )
         {
+            found = true;
             bestCandidate = contender;
             bestValue = contenderValue;
         }
+    }
 
-        ++it;
+    if ( !found )
+    {
+        log( "No candidates, select returning false" );
+        return false;
     }
 
     tableau.setEnteringVariableIndex( bestCandidate );
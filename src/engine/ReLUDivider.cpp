@@ -0,0 +1,120 @@
+/*********************                                                        */
+/*! \file ReLUDivider.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "EngineState.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "PiecewiseLinearConstraint.h"
+#include "ReLUDivider.h"
+
+#include <math.h>
+
+ReLUDivider::ReLUDivider( std::shared_ptr<IEngine> engine,
+                          DivideStrategy divideStrategy )
+    : _engine( engine )
+    , _divideStrategy( divideStrategy )
+{
+    ASSERT( _divideStrategy == DivideStrategy::EarliestReLU ||
+            _divideStrategy == DivideStrategy::ReLUViolation );
+}
+
+void ReLUDivider::createSubQueries( unsigned numNewSubqueries,
+                                    const String queryIdPrefix,
+                                    const PiecewiseLinearCaseSplit
+                                    &previousSplit,
+                                    const unsigned timeoutInSeconds,
+                                    SubQueries &subQueries )
+{
+    unsigned numBisects = (unsigned)log2( numNewSubqueries );
+
+    List<PiecewiseLinearCaseSplit> splits;
+    splits.append( previousSplit );
+
+    // Repeatedly split every case on the phases of a ReLU
+    for ( unsigned i = 0; i < numBisects; ++i )
+    {
+        List<PiecewiseLinearCaseSplit> newSplits;
+        for ( const auto &split : splits )
+        {
+            PiecewiseLinearConstraint *relu = getReLUToSplit( split );
+            if ( !relu )
+            {
+                // All ReLUs are fixed, the split cannot be divided further
+                newSplits.append( split );
+                continue;
+            }
+
+            for ( const auto &phaseSplit : relu->getCaseSplits() )
+            {
+                PiecewiseLinearCaseSplit newSplit = split;
+                for ( const auto &bound : phaseSplit.getBoundTightenings() )
+                    newSplit.storeBoundTightening( bound );
+                for ( const auto &equation : phaseSplit.getEquations() )
+                    newSplit.addEquation( equation );
+                newSplits.append( newSplit );
+            }
+        }
+        splits = newSplits;
+    }
+
+    unsigned queryIdSuffix = 1; // For query id
+    // Create a new subquery for each newly created case split
+    for ( const auto &split : splits )
+    {
+        // Create a new query id
+        String queryId;
+        if ( queryIdPrefix == "" )
+            queryId = queryIdPrefix + Stringf( "%u", queryIdSuffix++ );
+        else
+            queryId = queryIdPrefix + Stringf( "-%u", queryIdSuffix++ );
+
+        // Construct the new subquery and add it to subqueries
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit( split ) );
+        subQuery->_timeoutInSeconds = timeoutInSeconds;
+        subQueries.append( subQuery );
+    }
+}
+
+PiecewiseLinearConstraint *ReLUDivider::getReLUToSplit( const PiecewiseLinearCaseSplit
+                                                        &split )
+{
+    EngineState *stateBeforeSplit = new EngineState;
+    if ( !stateBeforeSplit )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "ReLUDivider::stateBeforeSplit" );
+
+    _engine->storeState( *stateBeforeSplit, true );
+    _engine->applySplit( split );
+
+    PiecewiseLinearConstraint *relu =
+        _engine->pickSplitPLConstraintForDivide( _divideStrategy );
+
+    _engine->restoreState( *stateBeforeSplit );
+    delete stateBeforeSplit;
+
+    return relu;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,77 @@
+/*********************                                                        */
+/*! \file ReLUDivider.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __ReLUDivider_h__
+#define __ReLUDivider_h__
+
+#include "DivideStrategy.h"
+#include "IEngine.h"
+#include "List.h"
+#include "QueryDivider.h"
+
+#include <memory>
+
+class PiecewiseLinearConstraint;
+
+/*
+  A query divider that splits on the phases of ReLU constraints,
+  rather than on the input region. The ReLU to split on is picked by
+  the engine, according to the divide strategy:
+
+  - EarliestReLU: the unfixed ReLU in the earliest layer of the network
+  - ReLUViolation: the unfixed ReLU that has been violated the most
+    times since the engine was last reset. A DnC worker resets its
+    engine before each sub-query, so these are the violations seen
+    while solving the sub-query that is being divided. The initial
+    division happens before any solving, and picks the earliest ReLU.
+*/
+class ReLUDivider : public QueryDivider
+{
+public:
+    ReLUDivider( std::shared_ptr<IEngine> engine, DivideStrategy divideStrategy );
+
+    void createSubQueries( unsigned numNewSubQueries,
+                           const String queryIdPrefix,
+                           const PiecewiseLinearCaseSplit
+                           &previousSplit,
+                           const unsigned timeoutInSeconds,
+                           SubQueries &subQueries );
+
+    /*
+      Returns the ReLU to split on once the given split is applied, or
+      NULL if all ReLUs are fixed. The state of the engine is restored
+      afterwards.
+    */
+    PiecewiseLinearConstraint *getReLUToSplit( const PiecewiseLinearCaseSplit &split );
+
+private:
+    /*
+      The engine, which is assumed to be in the state of the query
+      being divided
+    */
+    std::shared_ptr<IEngine> _engine;
+
+    DivideStrategy _divideStrategy;
+};
+
+#endif // __ReLUDivider_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -20,17 +20,39 @@
 #include "SparseUnsortedList.h"
 #include "Statistics.h"
 
+#include <list>
+#include <thread>
+
 RowBoundTightener::RowBoundTightener( const ITableau &tableau )
     : _tableau( tableau )
+    , _numWorkers( 1 )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
     , _tightenedLower( NULL )
     , _tightenedUpper( NULL )
     , _rows( NULL )
     , _z( NULL )
+    , _aColumn( NULL )
     , _ciTimesLb( NULL )
     , _ciTimesUb( NULL )
     , _ciSign( NULL )
+    , _basisRowQueued( NULL )
+    , _unitVector( NULL )
+    , _multiplierIndices( NULL )
+    , _rowCombination( NULL )
+    , _inRowCombination( NULL )
+    , _rowCombinationIndices( NULL )
+    , _sparseRowEntries( NULL )
+    , _isPriorityRow( NULL )
+    , _nextPriorityRow( 0 )
+    , _nextOtherRow( 0 )
+    , _activitiesValid( false )
+    , _minActivity( NULL )
+    , _maxActivity( NULL )
+    , _minActivityInfinite( NULL )
+    , _maxActivityInfinite( NULL )
+    , _activityStale( NULL )
+    , _rowQueued( NULL )
     , _statistics( NULL )
 {
 }
@@ -75,15 +97,91 @@ void RowBoundTightener::setDimensions()
             _rows[i] = new TableauRow( _n - _m );
 
         _z = new double[_m];
+        _aColumn = new double[_m];
+        std::fill_n( _aColumn, _m, 0.0 );
+    }
+    else if ( GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE ==
+              GlobalConfiguration::COMPUTE_SPARSE_BASIS_ROWS )
+    {
+        // No rows are stored, so the memory is linear in the tableau size
+        _z = new double[_m];
+        if ( !_z )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::z" );
+
+        _unitVector = new double[_m];
+        if ( !_unitVector )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::unitVector" );
+        std::fill_n( _unitVector, _m, 0.0 );
+
+        _multiplierIndices = new unsigned[_m];
+        if ( !_multiplierIndices )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::multiplierIndices" );
+
+        _rowCombination = new double[_n];
+        if ( !_rowCombination )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::rowCombination" );
+        std::fill_n( _rowCombination, _n, 0.0 );
+
+        _inRowCombination = new bool[_n];
+        if ( !_inRowCombination )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::inRowCombination" );
+        std::fill_n( _inRowCombination, _n, false );
+
+        _rowCombinationIndices = new unsigned[_n];
+        if ( !_rowCombinationIndices )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::rowCombinationIndices" );
+
+        _sparseRowEntries = new TableauRow::Entry[_n];
+        if ( !_sparseRowEntries )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::sparseRowEntries" );
+
+        _isPriorityRow = new bool[_m];
+        if ( !_isPriorityRow )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::isPriorityRow" );
+        std::fill_n( _isPriorityRow, _m, false );
     }
 
     _ciTimesLb = new double[_n];
     _ciTimesUb = new double[_n];
     _ciSign = new char[_n];
+
+    _basisRowQueued = new bool[_m];
+    if ( !_basisRowQueued )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::basisRowQueued" );
+    std::fill_n( _basisRowQueued, _m, false );
+
+    _minActivity = new double[_m];
+    if ( !_minActivity )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::minActivity" );
+
+    _maxActivity = new double[_m];
+    if ( !_maxActivity )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::maxActivity" );
+
+    _minActivityInfinite = new unsigned[_m];
+    if ( !_minActivityInfinite )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::minActivityInfinite" );
+
+    _maxActivityInfinite = new unsigned[_m];
+    if ( !_maxActivityInfinite )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::maxActivityInfinite" );
+
+    _activityStale = new bool[_m];
+    if ( !_activityStale )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::activityStale" );
+    std::fill_n( _activityStale, _m, false );
+
+    _rowQueued = new bool[_m];
+    if ( !_rowQueued )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::rowQueued" );
+    std::fill_n( _rowQueued, _m, false );
+    _rowQueue.clear();
 }
 
 void RowBoundTightener::resetBounds()
 {
+    _activitiesValid = false;
+
     std::fill( _tightenedLower, _tightenedLower + _n, false );
     std::fill( _tightenedUpper, _tightenedUpper + _n, false );
 
@@ -96,6 +194,8 @@ void RowBoundTightener::resetBounds()
 
 void RowBoundTightener::clear()
 {
+    _activitiesValid = false;
+
     std::fill( _tightenedLower, _tightenedLower + _n, false );
     std::fill( _tightenedUpper, _tightenedUpper + _n, false );
 
@@ -151,6 +251,12 @@ void RowBoundTightener::freeMemoryIfNeeded()
         _z = NULL;
     }
 
+    if ( _aColumn )
+    {
+        delete[] _aColumn;
+        _aColumn = NULL;
+    }
+
     if ( _ciTimesLb )
     {
         delete[] _ciTimesLb;
@@ -168,6 +274,92 @@ void RowBoundTightener::freeMemoryIfNeeded()
         delete[] _ciSign;
         _ciSign = NULL;
     }
+
+    if ( _basisRowQueued )
+    {
+        delete[] _basisRowQueued;
+        _basisRowQueued = NULL;
+    }
+
+    if ( _unitVector )
+    {
+        delete[] _unitVector;
+        _unitVector = NULL;
+    }
+
+    if ( _multiplierIndices )
+    {
+        delete[] _multiplierIndices;
+        _multiplierIndices = NULL;
+    }
+
+    if ( _rowCombination )
+    {
+        delete[] _rowCombination;
+        _rowCombination = NULL;
+    }
+
+    if ( _inRowCombination )
+    {
+        delete[] _inRowCombination;
+        _inRowCombination = NULL;
+    }
+
+    if ( _rowCombinationIndices )
+    {
+        delete[] _rowCombinationIndices;
+        _rowCombinationIndices = NULL;
+    }
+
+    if ( _sparseRowEntries )
+    {
+        delete[] _sparseRowEntries;
+        _sparseRowEntries = NULL;
+    }
+
+    if ( _isPriorityRow )
+    {
+        delete[] _isPriorityRow;
+        _isPriorityRow = NULL;
+    }
+
+    if ( _minActivity )
+    {
+        delete[] _minActivity;
+        _minActivity = NULL;
+    }
+
+    if ( _maxActivity )
+    {
+        delete[] _maxActivity;
+        _maxActivity = NULL;
+    }
+
+    if ( _minActivityInfinite )
+    {
+        delete[] _minActivityInfinite;
+        _minActivityInfinite = NULL;
+    }
+
+    if ( _maxActivityInfinite )
+    {
+        delete[] _maxActivityInfinite;
+        _maxActivityInfinite = NULL;
+    }
+
+    if ( _activityStale )
+    {
+        delete[] _activityStale;
+        _activityStale = NULL;
+    }
+
+    if ( _rowQueued )
+    {
+        delete[] _rowQueued;
+        _rowQueued = NULL;
+    }
+
+    _activitiesValid = false;
 }
 
 void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation )
@@ -191,8 +383,14 @@ void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation
     for ( unsigned i = 0; i < _n - _m; ++i )
     {
         unsigned nonBasic = _tableau.nonBasicIndexToVariable( i );
-        const double *ANColumn = _tableau.getAColumn( nonBasic );
-        _tableau.forwardTransformation( ANColumn, _z );
+        const SparseUnsortedList *column = _tableau.getSparseAColumn( nonBasic );
+        for ( const auto &entry : *column )
+            _aColumn[entry._index] = entry._value;
+
+        _tableau.forwardTransformation( _aColumn, _z );
+
+        for ( const auto &entry : *column )
+            _aColumn[entry._index] = 0.0;
 
         for ( unsigned j = 0; j < _m; ++j )
         {
@@ -202,21 +400,7 @@ void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation
     }
 
     // We now have all the rows, can use them for tightening.
-    // The tightening procedure may throw an exception, in which case we need
-    // to release the rows.
-    unsigned newBoundsLearned;
-    unsigned maxNumberOfIterations = untilSaturation ?
-        GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
-    do
-    {
-        newBoundsLearned = onePassOverInvertedBasisRows();
-
-        if ( _statistics && ( newBoundsLearned > 0 ) )
-            _statistics->incNumTighteningsFromExplicitBasis( newBoundsLearned );
-
-        --maxNumberOfIterations;
-    }
-    while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
+    examineInvertedBasisRows( untilSaturation );
 }
 
 void RowBoundTightener::examineInvertedBasisMatrix( bool untilSaturation )
@@ -264,41 +448,277 @@ void RowBoundTightener::examineInvertedBasisMatrix( bool untilSaturation )
         // We now have all the rows, can use them for tightening.
         // The tightening procedure may throw an exception, in which case we need
         // to release the rows.
+        examineInvertedBasisRows( untilSaturation );
+    }
+    catch ( ... )
+    {
+        delete[] invB;
+        throw;
+    }
 
+    delete[] invB;
+}
+
+void RowBoundTightener::examineInvertedBasisRows( bool untilSaturation )
+{
+    // Start with a pass over all the rows
+    _basisRowQueue.clear();
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        _basisRowQueue.push( i );
+        _basisRowQueued[i] = true;
+    }
+
+    /*
+      Subsequent passes only revisit the rows that contain a variable
+      whose bound was tightened, as the other rows cannot yield
+      anything new.
+    */
+    unsigned newBoundsLearned;
+    unsigned maxNumberOfIterations = untilSaturation ?
+        GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
+    do
+    {
+        newBoundsLearned = onePassOverInvertedBasisRows();
+
+        if ( _statistics && ( newBoundsLearned > 0 ) )
+            _statistics->incNumTighteningsFromExplicitBasis( newBoundsLearned );
+
+        --maxNumberOfIterations;
+    }
+    while ( ( maxNumberOfIterations != 0 ) && !_basisRowQueue.empty() );
+
+    while ( !_basisRowQueue.empty() )
+    {
+        _basisRowQueued[_basisRowQueue.peak()] = false;
+        _basisRowQueue.pop();
+    }
+}
+
+unsigned RowBoundTightener::onePassOverInvertedBasisRows()
+{
+    unsigned newBounds = 0;
+
+    unsigned numberOfRows = _basisRowQueue.size();
+    for ( unsigned i = 0; i < numberOfRows; ++i )
+    {
+        unsigned row = _basisRowQueue.peak();
+        _basisRowQueue.pop();
+
+        unsigned newBoundsForRow = tightenOnSingleInvertedBasisRow( *( _rows[row] ) );
+        _basisRowQueued[row] = false;
+
+        if ( newBoundsForRow > 0 )
+        {
+            newBounds += newBoundsForRow;
+
+            // A row's own tightenings are already reflected in its row,
+            // so it is only revisited if another row tightens one of its
+            // variables
+            _basisRowQueued[row] = true;
+            for ( const auto &variable : _tightenedVariables )
+                enqueueInvertedBasisRows( variable );
+            _basisRowQueued[row] = false;
+        }
+    }
+
+    return newBounds;
+}
+
+void RowBoundTightener::enqueueInvertedBasisRows( unsigned variable )
+{
+    unsigned index = _tableau.variableToIndex( variable );
+
+    // A basic variable is the lhs of its own row only
+    if ( _tableau.isBasic( variable ) )
+    {
+        if ( !_basisRowQueued[index] )
+        {
+            _basisRowQueue.push( index );
+            _basisRowQueued[index] = true;
+        }
+        return;
+    }
+
+    // All rows share the same order of non-basic variables
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !_basisRowQueued[i] && !FloatUtils::isZero( _rows[i]->_row[index]._coefficient ) )
+        {
+            _basisRowQueue.push( i );
+            _basisRowQueued[i] = true;
+        }
+    }
+}
+
+void RowBoundTightener::examineSparseBasisRows( const List<unsigned> &priorityVariables,
+                                                bool untilSaturation )
+{
+    ASSERT( _rowCombination );
+
+    /*
+      The budget counts operations rather than time, so that runs
+      remain reproducible
+    */
+    unsigned rowBudget = GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_ROWS;
+    unsigned long long workBudget = GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_MAX_WORK;
+    unsigned rowsExamined = 0;
+    unsigned long long work = 0;
+
+    auto budgetExhausted = [&]()
+    {
+        return ( rowsExamined >= rowBudget ) || ( work >= workBudget );
+    };
+
+    // Find the rows of the priority variables that are basic
+    Vector<unsigned> priorityRows;
+    for ( const auto &variable : priorityVariables )
+    {
+        if ( variable >= _n || !_tableau.isBasic( variable ) )
+            continue;
+
+        unsigned index = _tableau.variableToIndex( variable );
+        if ( !_isPriorityRow[index] )
+        {
+            _isPriorityRow[index] = true;
+            priorityRows.append( index );
+        }
+    }
+
+    try
+    {
         unsigned newBoundsLearned;
         unsigned maxNumberOfIterations = untilSaturation ?
             GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
         do
         {
-            newBoundsLearned = onePassOverInvertedBasisRows();
+            newBoundsLearned = 0;
+
+            // The priority rows, resuming from where we stopped last time
+            unsigned numPriorityRows = priorityRows.size();
+            for ( unsigned i = 0; i < numPriorityRows && !budgetExhausted(); ++i )
+            {
+                _nextPriorityRow = ( _nextPriorityRow + 1 ) % numPriorityRows;
+                newBoundsLearned += tightenOnSparseBasisRow( priorityRows[_nextPriorityRow], work );
+                ++rowsExamined;
+            }
+
+            // The other rows, if there is budget left
+            for ( unsigned i = 0; i < _m && !budgetExhausted(); ++i )
+            {
+                _nextOtherRow = ( _nextOtherRow + 1 ) % _m;
+                if ( _isPriorityRow[_nextOtherRow] )
+                    continue;
+
+                newBoundsLearned += tightenOnSparseBasisRow( _nextOtherRow, work );
+                ++rowsExamined;
+            }
 
             if ( _statistics && ( newBoundsLearned > 0 ) )
                 _statistics->incNumTighteningsFromExplicitBasis( newBoundsLearned );
 
             --maxNumberOfIterations;
         }
-        while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
+        while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) && !budgetExhausted() );
     }
-    catch ( ... )
+    catch ( const InfeasibleQueryException & )
     {
-        delete[] invB;
+        for ( const auto &row : priorityRows )
+            _isPriorityRow[row] = false;
         throw;
     }
 
-    delete[] invB;
+    for ( const auto &row : priorityRows )
+        _isPriorityRow[row] = false;
 }
 
-unsigned RowBoundTightener::onePassOverInvertedBasisRows()
+unsigned RowBoundTightener::tightenOnSparseBasisRow( unsigned basicIndex, unsigned long long &work )
 {
-    unsigned newBounds = 0;
+    /*
+      The row of basic variable i is
 
-    for ( unsigned i = 0; i < _m; ++i )
-        newBounds += tightenOnSingleInvertedBasisRow( *( _rows[i] ) );
+         xi = z * b - z * AN * xN,   where z = ei * inv(B)
 
-    return newBounds;
+      z is found by a sparse BTRAN. z * AN is then accumulated from the
+      rows of A that have a non-zero multiplier, rather than computed
+      column by column.
+    */
+    unsigned multipliersNnz;
+    _unitVector[basicIndex] = 1;
+    _tableau.sparseBackwardTransformation( _unitVector,
+                                           &basicIndex,
+                                           1,
+                                           _z,
+                                           _multiplierIndices,
+                                           multipliersNnz );
+    _unitVector[basicIndex] = 0;
+
+    const double *b = _tableau.getRightHandSide();
+    double scalar = 0;
+    unsigned combinationNnz = 0;
+
+    for ( unsigned i = 0; i < multipliersNnz; ++i )
+    {
+        unsigned row = _multiplierIndices[i];
+        double multiplier = _z[row];
+        if ( multiplier == 0.0 )
+            continue;
+
+        scalar += multiplier * b[row];
+
+        const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
+        work += sparseRow->getNnz();
+
+        for ( const auto &entry : *sparseRow )
+        {
+            if ( !_inRowCombination[entry._index] )
+            {
+                _inRowCombination[entry._index] = true;
+                _rowCombinationIndices[combinationNnz] = entry._index;
+                ++combinationNnz;
+            }
+
+            _rowCombination[entry._index] -= multiplier * entry._value;
+        }
+    }
+
+    work += multipliersNnz;
+
+    // Keep the non-basic entries, and restore the work space
+    unsigned numEntries = 0;
+    for ( unsigned i = 0; i < combinationNnz; ++i )
+    {
+        unsigned variable = _rowCombinationIndices[i];
+        double coefficient = _rowCombination[variable];
+
+        _rowCombination[variable] = 0;
+        _inRowCombination[variable] = false;
+
+        if ( FloatUtils::isZero( coefficient ) || _tableau.isBasic( variable ) )
+            continue;
+
+        _sparseRowEntries[numEntries] = TableauRow::Entry( variable, coefficient );
+        ++numEntries;
+    }
+
+    return tightenOnSingleInvertedBasisRow( _tableau.basicIndexToVariable( basicIndex ),
+                                            scalar,
+                                            _sparseRowEntries,
+                                            numEntries );
 }
 
 unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &row )
+{
+    return tightenOnSingleInvertedBasisRow( row._lhs,
+                                            row._scalar,
+                                            row._row,
+                                            _tableau.getN() - _tableau.getM() );
+}
+
+unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( unsigned lhs,
+                                                             double scalar,
+                                                             const TableauRow::Entry *entries,
+                                                             unsigned numEntries )
 {
 	/*
       A row is of the form
@@ -307,10 +727,8 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
       We wish to tighten once for y, but also once for every x.
     */
-    unsigned n = _tableau.getN();
-    unsigned m = _tableau.getM();
-
     unsigned result = 0;
+    _tightenedVariables.clear();
 
     // Compute ci * lb, ci * ub, flag signs for all entries
     enum {
@@ -319,9 +737,9 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
         NEGATIVE = 2,
     };
 
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numEntries; ++i )
     {
-        double ci = row[i];
+        double ci = entries[i]._coefficient;
 
         if ( FloatUtils::isZero( ci ) )
         {
@@ -333,20 +751,20 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
         _ciSign[i] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
 
-        unsigned xi = row._row[i]._var;
+        unsigned xi = entries[i]._var;
         _ciTimesLb[i] = ci * _lowerBounds[xi];
         _ciTimesUb[i] = ci * _upperBounds[xi];
     }
 
     // Start with a pass for y
-    unsigned y = row._lhs;
-    double upperBound = row._scalar;
-    double lowerBound = row._scalar;
+    unsigned y = lhs;
+    double upperBound = scalar;
+    double lowerBound = scalar;
 
     unsigned xi;
     double ci;
 
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numEntries; ++i )
     {
         if ( _ciSign[i] == POSITIVE )
         {
@@ -362,18 +780,21 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
     if ( FloatUtils::lt( _lowerBounds[y], lowerBound ) )
     {
-        _lowerBounds[y] = lowerBound;
+        setLowerBound( y, lowerBound );
         _tightenedLower[y] = true;
         ++result;
     }
 
     if ( FloatUtils::gt( _upperBounds[y], upperBound ) )
     {
-        _upperBounds[y] = upperBound;
+        setUpperBound( y, upperBound );
         _tightenedUpper[y] = true;
         ++result;
     }
 
+    if ( result > 0 )
+        _tightenedVariables.append( y );
+
     if ( FloatUtils::gt( _lowerBounds[y], _upperBounds[y] ) )
         throw InfeasibleQueryException();
 
@@ -392,11 +813,11 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
     // Then, when we consider xi we adjust the computed lower and upper
     // boudns accordingly.
 
-    double auxLb = _lowerBounds[y] - row._scalar;
-    double auxUb = _upperBounds[y] - row._scalar;
+    double auxLb = _lowerBounds[y] - scalar;
+    double auxUb = _upperBounds[y] - scalar;
 
     // Now add ALL xi's
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numEntries; ++i )
     {
         if ( _ciSign[i] == NEGATIVE )
         {
@@ -411,7 +832,7 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
     }
 
     // Now consider each individual xi
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numEntries; ++i )
     {
         // If ci = 0, nothing to do.
         if ( _ciSign[i] == ZERO )
@@ -433,7 +854,7 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
         }
 
         // Now divide everything by ci, switching signs if needed.
-        ci = row[i];
+        ci = entries[i]._coefficient;
         lowerBound = lowerBound / ci;
         upperBound = upperBound / ci;
 
@@ -445,21 +866,27 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
         }
 
         // If a tighter bound is found, store it
-        xi = row._row[i]._var;
+        xi = entries[i]._var;
+        bool tightened = false;
         if ( FloatUtils::lt( _lowerBounds[xi], lowerBound ) )
         {
-            _lowerBounds[xi] = lowerBound;
+            setLowerBound( xi, lowerBound );
             _tightenedLower[xi] = true;
+            tightened = true;
             ++result;
         }
 
         if ( FloatUtils::gt( _upperBounds[xi], upperBound ) )
         {
-            _upperBounds[xi] = upperBound;
+            setUpperBound( xi, upperBound );
             _tightenedUpper[xi] = true;
+            tightened = true;
             ++result;
         }
 
+        if ( tightened )
+            _tightenedVariables.append( xi );
+
         if ( FloatUtils::gt( _lowerBounds[xi], _upperBounds[xi] ) )
             throw InfeasibleQueryException();
     }
@@ -469,11 +896,15 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
 void RowBoundTightener::examineConstraintMatrix( bool untilSaturation )
 {
+    if ( !_activitiesValid )
+        computeActivities();
+
     unsigned newBoundsLearned;
 
     /*
-      If working until saturation, do single passes over the matrix until no new bounds
-      are learned. Otherwise, just do a single pass.
+      If working until saturation, do passes over the queued rows until
+      no rows are left. Otherwise, just do a single pass. Rows that
+      are tightened during a pass are examined in the next pass.
     */
     unsigned maxNumberOfIterations = untilSaturation ?
         GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
@@ -486,151 +917,343 @@ void RowBoundTightener::examineConstraintMatrix( bool untilSaturation )
 
         --maxNumberOfIterations;
     }
-    while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
+    while ( ( maxNumberOfIterations != 0 ) && !_rowQueue.empty() );
 }
 
-unsigned RowBoundTightener::onePassOverConstraintMatrix()
+void RowBoundTightener::computeActivities()
 {
-    unsigned result = 0;
-
     unsigned m = _tableau.getM();
 
+    _rowQueue.clear();
+
     for ( unsigned i = 0; i < m; ++i )
-        result += tightenOnSingleConstraintRow( i );
+    {
+        computeActivity( i );
 
-    return result;
+        _rowQueue.push( i );
+        _rowQueued[i] = true;
+    }
+
+    _activitiesValid = true;
 }
 
-unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
+void RowBoundTightener::computeActivity( unsigned row )
 {
-    /*
-      The cosntraint matrix A satisfies Ax = b.
-      Each row is of the form:
+    _minActivity[row] = 0;
+    _maxActivity[row] = 0;
+    _minActivityInfinite[row] = 0;
+    _maxActivityInfinite[row] = 0;
 
-          sum ci xi - b = 0
+    for ( const auto &entry : *_tableau.getSparseARow( row ) )
+    {
+        double ci = entry._value;
+        double minBound = ( ci > 0 ) ? _lowerBounds[entry._index] : _upperBounds[entry._index];
+        double maxBound = ( ci > 0 ) ? _upperBounds[entry._index] : _lowerBounds[entry._index];
 
-      We first compute the lower and upper bounds for the expression
+        if ( FloatUtils::isFinite( minBound ) )
+            _minActivity[row] += ci * minBound;
+        else
+            ++_minActivityInfinite[row];
 
-          sum ci xi - b
-    */
-    unsigned n = _tableau.getN();
+        if ( FloatUtils::isFinite( maxBound ) )
+            _maxActivity[row] += ci * maxBound;
+        else
+            ++_maxActivityInfinite[row];
+    }
+
+    _activityStale[row] = false;
+}
+
+void RowBoundTightener::updateActivities( unsigned variable, double oldBound, double newBound, bool isLowerBound )
+{
+    if ( !_activitiesValid )
+        return;
+
+    for ( const auto &entry : *_tableau.getSparseAColumn( variable ) )
+    {
+        unsigned row = entry._index;
+        double ci = entry._value;
+
+        /*
+          A lower bound contributes to the minimal activity of the rows
+          where its coefficient is positive, and to the maximal activity
+          of the rest. Upper bounds are the other way around.
+        */
+        bool minimal = ( ( ci > 0 ) == isLowerBound );
+        double &activity = minimal ? _minActivity[row] : _maxActivity[row];
+        unsigned &numInfinite = minimal ? _minActivityInfinite[row] : _maxActivityInfinite[row];
+
+        if ( FloatUtils::isFinite( oldBound ) )
+        {
+            double oldTerm = ci * oldBound;
+            activity -= oldTerm;
+
+            if ( FloatUtils::gt( FloatUtils::abs( oldTerm ),
+                                 GlobalConfiguration::ROW_BOUND_TIGHTENER_ACTIVITY_RECOMPUTATION_THRESHOLD ) )
+                _activityStale[row] = true;
+        }
+        else
+            --numInfinite;
+
+        if ( FloatUtils::isFinite( newBound ) )
+            activity += ci * newBound;
+        else
+            ++numInfinite;
+
+        if ( !_rowQueued[row] )
+        {
+            _rowQueue.push( row );
+            _rowQueued[row] = true;
+        }
+    }
+}
+
+void RowBoundTightener::setLowerBound( unsigned variable, double bound )
+{
+    double oldBound = _lowerBounds[variable];
+    _lowerBounds[variable] = bound;
+    updateActivities( variable, oldBound, bound, true );
+}
+
+void RowBoundTightener::setUpperBound( unsigned variable, double bound )
+{
+    double oldBound = _upperBounds[variable];
+    _upperBounds[variable] = bound;
+    updateActivities( variable, oldBound, bound, false );
+}
+
+unsigned RowBoundTightener::onePassOverConstraintMatrix()
+{
+    if ( _numWorkers > 1 )
+        return onePassOverConstraintMatrixInParallel();
 
     unsigned result = 0;
 
-    const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
-    const double *b = _tableau.getRightHandSide();
+    unsigned numberOfRows = _rowQueue.size();
 
-    double ci;
-    unsigned index;
+    try
+    {
+        for ( unsigned i = 0; i < numberOfRows; ++i )
+        {
+            unsigned row = _rowQueue.peak();
+            _rowQueue.pop();
 
-    // Compute ci * lb, ci * ub, flag signs for all entries
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-    };
+            // The row stays marked while it is examined, so that its own
+            // tightenings do not enqueue it again
+            result += tightenOnSingleConstraintRow( row );
+            _rowQueued[row] = false;
+        }
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        // The queue is no longer consistent; start over next time
+        _activitiesValid = false;
+        throw;
+    }
 
-    std::fill_n( _ciSign, n, ZERO );
-    std::fill_n( _ciTimesLb, n, 0 );
-    std::fill_n( _ciTimesUb, n, 0 );
+    return result;
+}
 
-    for ( const auto &entry : *sparseRow )
+unsigned RowBoundTightener::onePassOverConstraintMatrixInParallel()
+{
+    Vector<unsigned> rows;
+    while ( !_rowQueue.empty() )
     {
-        index = entry._index;
-        ci = entry._value;
+        unsigned row = _rowQueue.peak();
+        _rowQueue.pop();
+
+        // Stale rows are recomputed here, as the workers only read
+        // the activities
+        if ( _activityStale[row] )
+            computeActivity( row );
 
-        _ciSign[index] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
-        _ciTimesLb[index] = ci * _lowerBounds[index];
-        _ciTimesUb[index] = ci * _upperBounds[index];
+        rows.append( row );
+        _rowQueued[row] = false;
     }
 
+    unsigned numThreads =
+        ( rows.size() + GlobalConfiguration::ROW_BOUND_TIGHTENER_MIN_ROWS_PER_WORKER - 1 ) /
+        GlobalConfiguration::ROW_BOUND_TIGHTENER_MIN_ROWS_PER_WORKER;
+    if ( numThreads > _numWorkers )
+        numThreads = _numWorkers;
+    if ( numThreads == 0 )
+        numThreads = 1;
+
     /*
-      Do a pass for each of the rhs variables.
-      For this, we wish to logically transform the equation into:
+      Each worker examines a contiguous block of rows and collects the
+      tightenings. Nothing is stored until all workers are done, so
+      concatenating the blocks in order is deterministic.
+    */
+    Vector<List<Tightening>> tightenings( numThreads );
+    auto examineRows = [this, &rows, &tightenings, numThreads]( unsigned worker )
+    {
+        unsigned begin = rows.size() * worker / numThreads;
+        unsigned end = rows.size() * ( worker + 1 ) / numThreads;
 
-          xi = 1/ci * ( b - sum cj xj )
+        for ( unsigned i = begin; i < end; ++i )
+            computeConstraintRowTightenings( rows.get( i ), tightenings[worker] );
+    };
+
+    std::list<std::thread> threads;
+    for ( unsigned i = 1; i < numThreads; ++i )
+        threads.push_back( std::thread( examineRows, i ) );
+
+    examineRows( 0 );
 
-      And then compute the upper/lower bounds for xi.
+    for ( auto &thread : threads )
+        thread.join();
 
-      However, for efficiency, we compute the lower and upper
-      bounds of the expression:
+    unsigned result = 0;
+    try
+    {
+        for ( unsigned i = 0; i < numThreads; ++i )
+            result += applyTightenings( tightenings[i] );
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        _activitiesValid = false;
+        throw;
+    }
 
-              b - sum ci xi
+    return result;
+}
 
-      Then, when we consider xi we adjust the computed lower and upper
-      boudns accordingly.
+unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
+{
+    /*
+      Each bound is computed from the activities at the start of the
+      row, so computing all of them before storing any gives the same
+      results as storing them one by one.
     */
+    if ( _activityStale[row] )
+        computeActivity( row );
 
-    double auxLb = b[row];
-    double auxUb = b[row];
+    List<Tightening> tightenings;
+    computeConstraintRowTightenings( row, tightenings );
 
-    // Now add ALL xi's
-    for ( unsigned i = 0; i < n; ++i )
+    if ( tightenings.empty() )
+        return 0;
+
+    return applyTightenings( tightenings );
+}
+
+void RowBoundTightener::computeConstraintRowTightenings( unsigned row, List<Tightening> &tightenings ) const
+{
+    /*
+      The cosntraint matrix A satisfies Ax = b.
+      Each row is of the form:
+
+          sum ci xi = b
+
+      We wish to logically transform the equation into:
+
+          xi = 1/ci * ( b - sum cj xj )
+
+      And then compute the upper/lower bounds for xi. The bounds of
+      sum cj xj, for j != i, are obtained by removing the contribution
+      of xi from the row's activities. If the activity has infinite
+      terms, this is only possible if xi's term is the only one.
+    */
+    double minActivity = _minActivity[row];
+    double maxActivity = _maxActivity[row];
+    unsigned minActivityInfinite = _minActivityInfinite[row];
+    unsigned maxActivityInfinite = _maxActivityInfinite[row];
+
+    // No variable can be bounded if two terms are unbounded both ways
+    if ( minActivityInfinite > 1 && maxActivityInfinite > 1 )
+        return;
+
+    const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
+    double b = _tableau.getRightHandSide()[row];
+
+    for ( const auto &entry : *sparseRow )
     {
-        if ( _ciSign[i] == NEGATIVE )
+        unsigned index = entry._index;
+        double ci = entry._value;
+
+        double minBound = ( ci > 0 ) ? _lowerBounds[index] : _upperBounds[index];
+        double maxBound = ( ci > 0 ) ? _upperBounds[index] : _lowerBounds[index];
+
+        // Bounds for the sum of the other terms
+        double restMin = FloatUtils::negativeInfinity();
+        if ( FloatUtils::isFinite( minBound ) )
         {
-            auxLb -= _ciTimesLb[i];
-            auxUb -= _ciTimesUb[i];
+            if ( minActivityInfinite == 0 )
+                restMin = minActivity - ci * minBound;
         }
-        else
+        else if ( minActivityInfinite == 1 )
         {
-            auxLb -= _ciTimesUb[i];
-            auxUb -= _ciTimesLb[i];
+            restMin = minActivity;
         }
-    }
 
-    double lowerBound;
-    double upperBound;
-
-    // Now consider each individual xi with non zero coefficient
-    for ( const auto &entry : *sparseRow )
-    {
-        index = entry._index;
+        double restMax = FloatUtils::infinity();
+        if ( FloatUtils::isFinite( maxBound ) )
+        {
+            if ( maxActivityInfinite == 0 )
+                restMax = maxActivity - ci * maxBound;
+        }
+        else if ( maxActivityInfinite == 1 )
+        {
+            restMax = maxActivity;
+        }
 
-        lowerBound = auxLb;
-        upperBound = auxUb;
+        // ci xi is in the range [b - restMax, b - restMin]. Divide by
+        // ci, switching sides if needed.
+        double lowerBound = FloatUtils::negativeInfinity();
+        double upperBound = FloatUtils::infinity();
 
-        // Adjust the aux bounds to remove xi
-        if ( _ciSign[index] == NEGATIVE )
+        if ( ci > 0 )
         {
-            lowerBound += _ciTimesLb[index];
-            upperBound += _ciTimesUb[index];
+            if ( FloatUtils::isFinite( restMax ) )
+                lowerBound = ( b - restMax ) / ci;
+            if ( FloatUtils::isFinite( restMin ) )
+                upperBound = ( b - restMin ) / ci;
         }
         else
         {
-            lowerBound += _ciTimesUb[index];
-            upperBound += _ciTimesLb[index];
+            if ( FloatUtils::isFinite( restMin ) )
+                lowerBound = ( b - restMin ) / ci;
+            if ( FloatUtils::isFinite( restMax ) )
+                upperBound = ( b - restMax ) / ci;
         }
 
-        // Now divide everything by ci, switching signs if needed.
-        ci = entry._value;
+        if ( FloatUtils::isFinite( lowerBound ) && FloatUtils::lt( _lowerBounds[index], lowerBound ) )
+            tightenings.append( Tightening( index, lowerBound, Tightening::LB ) );
 
-        lowerBound = lowerBound / ci;
-        upperBound = upperBound / ci;
+        if ( FloatUtils::isFinite( upperBound ) && FloatUtils::gt( _upperBounds[index], upperBound ) )
+            tightenings.append( Tightening( index, upperBound, Tightening::UB ) );
+    }
+}
 
-        if ( _ciSign[index] == NEGATIVE )
-        {
-            double temp = upperBound;
-            upperBound = lowerBound;
-            lowerBound = temp;
-        }
+unsigned RowBoundTightener::applyTightenings( const List<Tightening> &tightenings )
+{
+    unsigned result = 0;
 
-        // If a tighter bound is found, store it
-        if ( FloatUtils::lt( _lowerBounds[index], lowerBound ) )
+    for ( const auto &tightening : tightenings )
+    {
+        unsigned variable = tightening._variable;
+
+        // Several rows may bound the same variable; keep the tightest
+        if ( tightening._type == Tightening::LB )
         {
-            _lowerBounds[index] = lowerBound;
-            _tightenedLower[index] = true;
-            ++result;
-        }
+            if ( !FloatUtils::lt( _lowerBounds[variable], tightening._value ) )
+                continue;
 
-        if ( FloatUtils::gt( _upperBounds[index], upperBound ) )
+            setLowerBound( variable, tightening._value );
+            _tightenedLower[variable] = true;
+        }
+        else
         {
-            _upperBounds[index] = upperBound;
-            _tightenedUpper[index] = true;
-            ++result;
+            if ( !FloatUtils::gt( _upperBounds[variable], tightening._value ) )
+                continue;
+
+            setUpperBound( variable, tightening._value );
+            _tightenedUpper[variable] = true;
         }
 
-        if ( FloatUtils::gt( _lowerBounds[index], _upperBounds[index] ) )
+        ++result;
+
+        if ( FloatUtils::gt( _lowerBounds[variable], _upperBounds[variable] ) )
             throw InfeasibleQueryException();
     }
 
@@ -672,11 +1295,16 @@ void RowBoundTightener::setStatistics( Statistics *statistics )
     _statistics = statistics;
 }
 
+void RowBoundTightener::setNumWorkers( unsigned numWorkers )
+{
+    _numWorkers = numWorkers;
+}
+
 void RowBoundTightener::notifyLowerBound( unsigned variable, double bound )
 {
     if ( FloatUtils::gt( bound, _lowerBounds[variable] ) )
     {
-        _lowerBounds[variable] = bound;
+        setLowerBound( variable, bound );
         _tightenedLower[variable] = false;
     }
 }
@@ -685,7 +1313,7 @@ void RowBoundTightener::notifyUpperBound( unsigned variable, double bound )
 {
     if ( FloatUtils::lt( bound, _upperBounds[variable] ) )
     {
-        _upperBounds[variable] = bound;
+        setUpperBound( variable, bound );
         _tightenedUpper[variable] = false;
     }
 }
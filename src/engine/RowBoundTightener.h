@@ -22,6 +22,7 @@
 #include "Queue.h"
 #include "TableauRow.h"
 #include "Tightening.h"
+#include "Vector.h"
 
 class RowBoundTightener : public IRowBoundTightener
 {
@@ -73,6 +74,18 @@ public:
      */
     void examineImplicitInvertedBasisMatrix( bool untilSaturation );
 
+    /*
+      Derive and enqueue new bounds using some of the rows of the
+      inverse of the explicit basis matrix, inv(B0). Inv(B0) is never
+      formed: each row is computed by a sparse BTRAN, followed by a
+      combination of the few rows of A that it involves. Rows whose
+      basic variables appear in priorityVariables are examined first,
+      and the examination stops once the row or work budget is
+      exhausted. The next call resumes from where this one stopped.
+    */
+    void examineSparseBasisRows( const List<unsigned> &priorityVariables,
+                                 bool untilSaturation );
+
     /*
       Derive and enqueue new bounds for all varaibles, using the
       original constraint matrix A and right hands side vector b. Can
@@ -98,10 +111,21 @@ public:
      */
     void setStatistics( Statistics *statistics );
 
+    /*
+      Set the number of threads used when examining the constraint
+      matrix. With more than one worker, the rows of each pass are
+      examined against the bounds known at the start of the pass, and
+      their tightenings are merged afterwards in row order. The
+      results are therefore the same for any number of workers
+      greater than one.
+    */
+    void setNumWorkers( unsigned numWorkers );
+
 private:
     const ITableau &_tableau;
     unsigned _n;
     unsigned _m;
+    unsigned _numWorkers;
 
     /*
       Work space for the tightener to derive tighter bounds. These
@@ -119,10 +143,58 @@ private:
     */
     TableauRow **_rows;
     double *_z;
+    double *_aColumn;
     double *_ciTimesLb;
     double *_ciTimesUb;
     char *_ciSign;
 
+    /*
+      The inverted basis rows that need to be examined in the next
+      pass, and the variables whose bounds were tightened by the last
+      inverted basis row examined.
+    */
+    Queue<unsigned> _basisRowQueue;
+    bool *_basisRowQueued;
+    Vector<unsigned> _tightenedVariables;
+
+    /*
+      Work space for the sparse basis rows tightener. The BTRAN input
+      and the row combination are kept zero between rows.
+    */
+    double *_unitVector;
+    unsigned *_multiplierIndices;
+    double *_rowCombination;
+    bool *_inRowCombination;
+    unsigned *_rowCombinationIndices;
+    TableauRow::Entry *_sparseRowEntries;
+    bool *_isPriorityRow;
+    unsigned _nextPriorityRow;
+    unsigned _nextOtherRow;
+
+    /*
+      For every row sum ci xi = b of the constraint matrix, the
+      smallest and largest values of sum ci xi under the current
+      bounds. Infinite terms are not summed, but counted separately.
+      The activities are maintained incrementally as bounds are
+      tightened, and are recomputed from scratch on the first
+      examination after the bounds are reset. A row is marked stale
+      when a large term is removed from its activities, as this may
+      lose precision; it is then recomputed before it is examined.
+    */
+    bool _activitiesValid;
+    double *_minActivity;
+    double *_maxActivity;
+    unsigned *_minActivityInfinite;
+    unsigned *_maxActivityInfinite;
+    bool *_activityStale;
+
+    /*
+      The rows of the constraint matrix that contain a variable whose
+      bound was tightened since they were last examined.
+    */
+    Queue<unsigned> _rowQueue;
+    bool *_rowQueued;
+
     /*
       Statistics collection
     */
@@ -134,11 +206,36 @@ private:
     void freeMemoryIfNeeded();
 
     /*
-      Do a single pass over the constraint matrix and derive any
-      tighter bounds. Return the number of new bounds learned.
+      Store a tighter bound for a variable, update the activities of
+      the rows in which it appears, and enqueue these rows.
+    */
+    void setLowerBound( unsigned variable, double bound );
+    void setUpperBound( unsigned variable, double bound );
+    void updateActivities( unsigned variable, double oldBound, double newBound, bool isLowerBound );
+
+    /*
+      Compute the activities of all the rows of the constraint
+      matrix from scratch, and enqueue all rows.
+    */
+    void computeActivities();
+
+    /*
+      Compute the activities of a single row from scratch.
+    */
+    void computeActivity( unsigned row );
+
+    /*
+      Do a single pass over the rows of the constraint matrix that are
+      currently queued and derive any tighter bounds. Return the
+      number of new bounds learned.
     */
     unsigned onePassOverConstraintMatrix();
 
+    /*
+      The same, with the queued rows split among the worker threads.
+    */
+    unsigned onePassOverConstraintMatrixInParallel();
+
     /*
       Process the tableau row and attempt to derive tighter
       lower/upper bounds for the specified variable. Return the number of
@@ -147,17 +244,61 @@ private:
     unsigned tightenOnSingleConstraintRow( unsigned row );
 
     /*
-      Do a single pass over the inverted basis rows and derive any
-      tighter bounds. Return the number of new bounds learned.
+      Compute the bounds entailed by a row of the constraint matrix
+      that are tighter than the current ones, without storing them.
+      Only reads the bounds and the activities, so rows can be
+      processed concurrently.
+    */
+    void computeConstraintRowTightenings( unsigned row, List<Tightening> &tightenings ) const;
+
+    /*
+      Store the bounds that are tighter than the current ones. Return
+      the number of new bounds, or throw if a variable's bounds become
+      inconsistent.
+    */
+    unsigned applyTightenings( const List<Tightening> &tightenings );
+
+    /*
+      Examine the inverted basis rows stored in _rows: first all of
+      them, and then, if working until saturation, only the rows that
+      contain variables whose bounds were tightened.
+    */
+    void examineInvertedBasisRows( bool untilSaturation );
+
+    /*
+      Do a single pass over the queued inverted basis rows and derive
+      any tighter bounds. Return the number of new bounds learned.
     */
     unsigned onePassOverInvertedBasisRows();
 
+    /*
+      Enqueue the inverted basis rows in which the variable appears
+    */
+    void enqueueInvertedBasisRows( unsigned variable );
+
     /*
       Process the inverted basis row and attempt to derive tighter
       lower/upper bounds for the specified variable. Return the number
       of tighter bounds found.
     */
     unsigned tightenOnSingleInvertedBasisRow( const TableauRow &row );
+
+    /*
+      The same, for a row given by its lhs, scalar and (non-basic)
+      entries.
+    */
+    unsigned tightenOnSingleInvertedBasisRow( unsigned lhs,
+                                              double scalar,
+                                              const TableauRow::Entry *entries,
+                                              unsigned numEntries );
+
+    /*
+      Compute the row of inv(B0) * A for the basic variable at the
+      given index, store its non-zero entries in _sparseRowEntries, and
+      tighten bounds using it. Return the number of tighter bounds found,
+      and add the number of entries processed to work.
+    */
+    unsigned tightenOnSparseBasisRow( unsigned basicIndex, unsigned long long &work );
 };
 
 #endif // __RowBoundTightener_h__
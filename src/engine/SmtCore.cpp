@@ -32,6 +32,7 @@ SmtCore::SmtCore( IEngine *engine )
     , _stateId( 0 )
     , _constraintViolationThreshold
       ( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+    , _splittingStrategy( (DivideStrategy)GlobalConfiguration::SPLITTING_HEURISTICS )
 {
 }
 
@@ -58,11 +59,16 @@ void SmtCore::reportViolatedConstraint( PiecewiseLinearConstraint *constraint )
 
     ++_constraintToViolationCount[constraint];
 
+    if ( !_constraintToTotalViolationCount.exists( constraint ) )
+        _constraintToTotalViolationCount[constraint] = 0;
+
+    ++_constraintToTotalViolationCount[constraint];
+
     if ( _constraintToViolationCount[constraint] >=
          _constraintViolationThreshold )
     {
         _needToSplit = true;
-        if ( GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::ReLUViolation )
+        if ( _splittingStrategy == DivideStrategy::ReLUViolation )
             _constraintForSplitting = constraint;
         else
             pickSplitPLConstraint();
@@ -77,6 +83,14 @@ unsigned SmtCore::getViolationCounts( PiecewiseLinearConstraint *constraint ) co
     return _constraintToViolationCount[constraint];
 }
 
+unsigned SmtCore::getTotalViolationCounts( PiecewiseLinearConstraint *constraint ) const
+{
+    if ( !_constraintToTotalViolationCount.exists( constraint ) )
+        return 0;
+
+    return _constraintToTotalViolationCount[constraint];
+}
+
 bool SmtCore::needToSplit() const
 {
     return _needToSplit;
@@ -369,6 +383,11 @@ void SmtCore::setConstraintViolationThreshold( unsigned threshold )
     _constraintViolationThreshold = threshold;
 }
 
+void SmtCore::setSplittingStrategy( DivideStrategy strategy )
+{
+    _splittingStrategy = strategy;
+}
+
 PiecewiseLinearConstraint *SmtCore::chooseViolatedConstraintForFixing( List<PiecewiseLinearConstraint *> &_violatedPlConstraints ) const
 {
     ASSERT( !_violatedPlConstraints.empty() );
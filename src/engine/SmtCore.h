@@ -16,6 +16,7 @@
 #ifndef __SmtCore_h__
 #define __SmtCore_h__
 
+#include "DivideStrategy.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Stack.h"
@@ -47,6 +48,15 @@ public:
     */
     unsigned getViolationCounts( PiecewiseLinearConstraint* constraint ) const;
 
+    /*
+      Get the number of times a specific PL constraint has been reported as
+      violated since this SMT core was created. Unlike the counts above,
+      these are not reset when the engine backtracks or splits. The engine
+      creates a new SMT core in Engine::reset(), which DnC workers call
+      before solving each sub-query.
+    */
+    unsigned getTotalViolationCounts( PiecewiseLinearConstraint* constraint ) const;
+
     /*
       Reset all reported violation counts.
     */
@@ -98,6 +108,12 @@ public:
 
     void setConstraintViolationThreshold( unsigned threshold );
 
+    /*
+      Set how the constraint to split on is picked, once some constraint
+      has been violated too many times
+    */
+    void setSplittingStrategy( DivideStrategy strategy );
+
     /*
       Pick the piecewise linear constraint for splitting
     */
@@ -156,6 +172,12 @@ private:
     */
     Map<PiecewiseLinearConstraint *, unsigned> _constraintToViolationCount;
 
+    /*
+      Count how many times each constraint has been violated, for the
+      lifetime of this SMT core. Used by DnC to divide a query.
+    */
+    Map<PiecewiseLinearConstraint *, unsigned> _constraintToTotalViolationCount;
+
     static void log( const String &message );
 
     /*
@@ -173,6 +195,11 @@ private:
       Split when some relu has been violated for this many times
     */
     unsigned _constraintViolationThreshold;
+
+    /*
+      The strategy for picking the constraint to split on
+    */
+    DivideStrategy _splittingStrategy;
 };
 
 #endif // __SmtCore_h__
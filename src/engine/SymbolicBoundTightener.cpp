@@ -20,19 +20,23 @@
 #include "SymbolicBoundTightener.h"
 
 SymbolicBoundTightener::SymbolicBoundTightener()
-    : _layerSizes( NULL )
+    : _numberOfLayers( 0 )
+    , _layerSizes( NULL )
+    , _layerTypes( NULL )
+    , _inputLayerSize( 0 )
     , _biases( NULL )
     , _weights( NULL )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
-    , _currentLayerLowerBounds( NULL )
-    , _currentLayerUpperBounds( NULL )
-    , _currentLayerLowerBias( NULL )
-    , _currentLayerUpperBias( NULL )
-    , _previousLayerLowerBounds( NULL )
-    , _previousLayerUpperBounds( NULL )
-    , _previousLayerLowerBias( NULL )
-    , _previousLayerUpperBias( NULL )
+    , _symbolicLb( NULL )
+    , _symbolicUb( NULL )
+    , _symbolicLowerBias( NULL )
+    , _symbolicUpperBias( NULL )
+    , _inputLb( NULL )
+    , _inputUb( NULL )
+    , _weightsCompressed( false )
+    , _firstDirtyLayer( 0 )
+    , _lastRunUsedLinearConcretization( false )
 {
     if ( GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS )
         throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_OPTION_NOT_SUPPORTED,
@@ -44,127 +48,80 @@ SymbolicBoundTightener::~SymbolicBoundTightener()
     freeMemoryIfNeeded();
 }
 
-void SymbolicBoundTightener::freeMemoryIfNeeded()
+static void freeLayerArrays( double **&arrays, unsigned numberOfLayers )
 {
-    if ( _biases )
-    {
-        for ( unsigned i = 0; i < _numberOfLayers; ++i )
-        {
-            if ( _biases[i] )
-            {
-                delete[] _biases[i];
-                _biases[i] = NULL;
-            }
-        }
+    if ( !arrays )
+        return;
 
-        delete[] _biases;
-        _biases = NULL;
-    }
-
-    if ( _weights )
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
     {
-        for ( unsigned i = 0; i < _numberOfLayers - 1; ++i )
+        if ( arrays[i] )
         {
-            if ( _weights[i]._positiveValues )
-            {
-                delete[] _weights[i]._positiveValues;
-                _weights[i]._positiveValues = NULL;
-            }
-
-            if ( _weights[i]._negativeValues )
-            {
-                delete[] _weights[i]._negativeValues;
-                _weights[i]._negativeValues = NULL;
-            }
+            delete[] arrays[i];
+            arrays[i] = NULL;
         }
-
-        delete[] _weights;
-        _weights = NULL;
     }
 
-    if ( _lowerBounds )
-    {
-        for ( unsigned i = 0; i < _numberOfLayers; ++i )
-        {
-            if ( _lowerBounds[i] )
-            {
-                delete[] _lowerBounds[i];
-                _lowerBounds[i] = NULL;
-            }
-        }
+    delete[] arrays;
+    arrays = NULL;
+}
 
-        delete[] _lowerBounds;
-        _lowerBounds = NULL;
-    }
+void SymbolicBoundTightener::freeMemoryIfNeeded()
+{
+    freeLayerArrays( _biases, _numberOfLayers );
 
-    if ( _upperBounds )
+    if ( _weights )
     {
         for ( unsigned i = 0; i < _numberOfLayers; ++i )
         {
-            if ( _upperBounds[i] )
+            for ( auto &weights : _weights[i] )
             {
-                delete[] _upperBounds[i];
-                _upperBounds[i] = NULL;
+                freeDenseWeights( weights.second );
+                freeSparseWeights( weights.second );
             }
         }
 
-        delete[] _upperBounds;
-        _upperBounds = NULL;
+        delete[] _weights;
+        _weights = NULL;
     }
 
-    if ( _currentLayerLowerBounds )
-    {
-        delete[] _currentLayerLowerBounds;
-        _currentLayerLowerBounds = NULL;
-    }
+    freeLayerArrays( _lowerBounds, _numberOfLayers );
+    freeLayerArrays( _upperBounds, _numberOfLayers );
 
-    if ( _currentLayerUpperBounds )
-    {
-        delete[] _currentLayerUpperBounds;
-        _currentLayerUpperBounds = NULL;
-    }
-
-    if ( _currentLayerLowerBias )
-    {
-        delete[] _currentLayerLowerBias;
-        _currentLayerLowerBias = NULL;
-    }
+    freeLayerArrays( _symbolicLb, _numberOfLayers );
+    freeLayerArrays( _symbolicUb, _numberOfLayers );
+    freeLayerArrays( _symbolicLowerBias, _numberOfLayers );
+    freeLayerArrays( _symbolicUpperBias, _numberOfLayers );
 
-    if ( _currentLayerUpperBias )
+    if ( _inputLb )
     {
-        delete[] _currentLayerUpperBias;
-        _currentLayerUpperBias = NULL;
+        delete[] _inputLb;
+        _inputLb = NULL;
     }
 
-    if ( _previousLayerLowerBounds )
+    if ( _inputUb )
     {
-        delete[] _previousLayerLowerBounds;
-        _previousLayerLowerBounds = NULL;
+        delete[] _inputUb;
+        _inputUb = NULL;
     }
 
-    if ( _previousLayerUpperBounds )
-    {
-        delete[] _previousLayerUpperBounds;
-        _previousLayerUpperBounds = NULL;
-    }
+    _weightsCompressed = false;
+    _firstDirtyLayer = 0;
 
-    if ( _previousLayerLowerBias )
+    if ( _layerSizes )
     {
-        delete[] _previousLayerLowerBias;
-        _previousLayerLowerBias = NULL;
+        delete[] _layerSizes;
+        _layerSizes = NULL;
     }
 
-    if ( _previousLayerUpperBias )
+    if ( _layerTypes )
     {
-        delete[] _previousLayerUpperBias;
-        _previousLayerUpperBias = NULL;
+        delete[] _layerTypes;
+        _layerTypes = NULL;
     }
 
-    if ( _layerSizes )
-    {
-        delete[] _layerSizes;
-        _layerSizes = NULL;
-    }
+    _layerSources.clear();
+    _maxSources.clear();
 
     _inputLowerBounds.clear();
     _inputUpperBounds.clear();
@@ -176,8 +133,25 @@ void SymbolicBoundTightener::setNumberOfLayers( unsigned layers )
 
     _numberOfLayers = layers;
     _layerSizes = new unsigned[layers];
+    if ( !_layerSizes )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::layerSizes" );
 
     std::fill_n( _layerSizes, layers, 0 );
+
+    // By default: an input layer, ReLU hidden layers and a weighted sum output layer
+    _layerTypes = new LayerType[layers];
+    if ( !_layerTypes )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::layerTypes" );
+
+    for ( unsigned i = 0; i < layers; ++i )
+    {
+        if ( i == 0 )
+            _layerTypes[i] = INPUT;
+        else if ( i == layers - 1 )
+            _layerTypes[i] = WEIGHTED_SUM;
+        else
+            _layerTypes[i] = RELU;
+    }
 }
 
 void SymbolicBoundTightener::setLayerSize( unsigned layer, unsigned layerSize )
@@ -185,10 +159,40 @@ void SymbolicBoundTightener::setLayerSize( unsigned layer, unsigned layerSize )
     _layerSizes[layer] = layerSize;
 }
 
+void SymbolicBoundTightener::setLayerType( unsigned layer, LayerType type )
+{
+    ASSERT( layer < _numberOfLayers );
+
+    if ( ( layer == 0 ) != ( type == INPUT ) )
+        throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT,
+                             "Only layer 0 can be an input layer" );
+
+    _layerTypes[layer] = type;
+    markDirty( layer );
+}
+
+void SymbolicBoundTightener::addLayerDependency( unsigned sourceLayer, unsigned targetLayer )
+{
+    if ( sourceLayer >= targetLayer || targetLayer >= _numberOfLayers )
+        throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT,
+                             Stringf( "Invalid dependency between layers %u and %u",
+                                      sourceLayer, targetLayer ).ascii() );
+
+    if ( _weights )
+        throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT,
+                             "Layer dependencies must be added before allocating the weights" );
+
+    if ( !_layerSources[targetLayer].exists( sourceLayer ) )
+        _layerSources[targetLayer].append( sourceLayer );
+}
+
 void SymbolicBoundTightener::allocateWeightAndBiasSpace()
 {
     // Allocate biases
     _biases = new double *[_numberOfLayers];
+    if ( !_biases )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::biases" );
+
     for ( unsigned i = 0; i < _numberOfLayers; ++i )
     {
         ASSERT( _layerSizes[i] > 0 );
@@ -197,18 +201,35 @@ void SymbolicBoundTightener::allocateWeightAndBiasSpace()
         std::fill_n( _biases[i], _layerSizes[i], 0 );
     }
 
+    // Unless stated otherwise, a layer's source is the previous layer
+    for ( unsigned i = 1; i < _numberOfLayers; ++i )
+    {
+        if ( _layerTypes[i] != MAX && !_layerSources.exists( i ) )
+            _layerSources[i].append( i - 1 );
+    }
+
     // Allocate weights
-    _weights = new WeightMatrix[_numberOfLayers - 1];
-    for ( unsigned i = 0; i < _numberOfLayers - 1; ++i )
+    _weights = new Map<unsigned, WeightMatrix>[_numberOfLayers];
+    if ( !_weights )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::weights" );
+
+    for ( const auto &sources : _layerSources )
     {
-        // The rows represent the sources, the columns the targets
-        _weights[i]._rows = _layerSizes[i];
-        _weights[i]._columns = _layerSizes[i+1];
-        _weights[i]._positiveValues = new double[_weights[i]._rows * _weights[i]._columns];
-        _weights[i]._negativeValues = new double[_weights[i]._rows * _weights[i]._columns];
+        unsigned target = sources.first;
+        for ( const auto &source : sources.second )
+        {
+            // The rows represent the sources, the columns the targets
+            WeightMatrix weights;
+            weights._rows = _layerSizes[source];
+            weights._columns = _layerSizes[target];
+            allocateDenseWeights( weights );
 
-        std::fill_n( _weights[i]._positiveValues, _weights[i]._rows * _weights[i]._columns, 0 );
-        std::fill_n( _weights[i]._negativeValues, _weights[i]._rows * _weights[i]._columns, 0 );
+            weights._targetStart = NULL;
+            weights._sourceNeurons = NULL;
+            weights._sparseValues = NULL;
+
+            _weights[target][source] = weights;
+        }
     }
 
     _lowerBounds = new double *[_numberOfLayers];
@@ -229,53 +250,247 @@ void SymbolicBoundTightener::allocateWeightAndBiasSpace()
         std::fill_n( _upperBounds[i], _layerSizes[i], FloatUtils::infinity() );
     }
 
-    // Allocate work space for the bound computation
-    _maxLayerSize = 0;
-    for ( unsigned i = 0; i < _numberOfLayers; ++i )
-        if ( _maxLayerSize < _layerSizes[i] )
-            _maxLayerSize = _layerSizes[i];
-
     _inputLayerSize = _layerSizes[0];
 
     _inputNeuronToIndex.clear();
     for ( unsigned i = 0; i < _inputLayerSize; ++i )
         _inputNeuronToIndex[i] = i;
 
-    _currentLayerLowerBounds = new double[_maxLayerSize * _inputLayerSize];
-    _currentLayerUpperBounds = new double[_maxLayerSize * _inputLayerSize];
-    _currentLayerLowerBias = new double[_maxLayerSize];
-    _currentLayerUpperBias = new double[_maxLayerSize];
+    // Allocate space for the symbolic bounds of every layer
+    _symbolicLb = new double *[_numberOfLayers];
+    _symbolicUb = new double *[_numberOfLayers];
+    _symbolicLowerBias = new double *[_numberOfLayers];
+    _symbolicUpperBias = new double *[_numberOfLayers];
+    for ( unsigned i = 0; i < _numberOfLayers; ++i )
+    {
+        _symbolicLb[i] = new double[_layerSizes[i] * _inputLayerSize];
+        _symbolicUb[i] = new double[_layerSizes[i] * _inputLayerSize];
+        _symbolicLowerBias[i] = new double[_layerSizes[i]];
+        _symbolicUpperBias[i] = new double[_layerSizes[i]];
+    }
+
+    _inputLb = new double[_inputLayerSize];
+    if ( !_inputLb )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::inputLb" );
+
+    _inputUb = new double[_inputLayerSize];
+    if ( !_inputUb )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::inputUb" );
 
-    _previousLayerLowerBounds = new double[_maxLayerSize * _inputLayerSize];
-    _previousLayerUpperBounds = new double[_maxLayerSize * _inputLayerSize];
-    _previousLayerLowerBias = new double[_maxLayerSize];
-    _previousLayerUpperBias = new double[_maxLayerSize];
+    _weightsCompressed = false;
+    _firstDirtyLayer = 0;
 }
 
 void SymbolicBoundTightener::setBias( unsigned layer, unsigned neuron, double bias )
 {
     //TODO: check that layer and neuron are not off bounds
     _biases[layer][neuron] = bias;
+    markDirty( layer );
 }
 
 void SymbolicBoundTightener::setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight )
 {
+    setWeight( sourceLayer, sourceNeuron, sourceLayer + 1, targetNeuron, weight );
+}
+
+void SymbolicBoundTightener::setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetLayer, unsigned targetNeuron, double weight )
+{
+    if ( targetLayer >= _numberOfLayers || !_weights[targetLayer].exists( sourceLayer ) )
+        throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT,
+                             Stringf( "Layer %u is not a source of layer %u",
+                                      sourceLayer, targetLayer ).ascii() );
+
+    WeightMatrix &weights = _weights[targetLayer][sourceLayer];
+    if ( !weights._positiveValues )
+        expandWeights( weights );
+
+    // A weight may change sign when it is set again, so clear the
+    // entry of the other sign
+    unsigned index = sourceNeuron * weights._columns + targetNeuron;
     if ( weight > 0 )
-        _weights[sourceLayer]._positiveValues[sourceNeuron * _weights[sourceLayer]._columns + targetNeuron] = weight;
+    {
+        weights._positiveValues[index] = weight;
+        weights._negativeValues[index] = 0;
+    }
     else
-        _weights[sourceLayer]._negativeValues[sourceNeuron * _weights[sourceLayer]._columns + targetNeuron] = weight;
+    {
+        weights._positiveValues[index] = 0;
+        weights._negativeValues[index] = weight;
+    }
+
+    _weightsCompressed = false;
+    markDirty( targetLayer );
+}
+
+void SymbolicBoundTightener::compressWeights()
+{
+    for ( unsigned i = 0; i < _numberOfLayers; ++i )
+    {
+        for ( auto &pair : _weights[i] )
+        {
+            WeightMatrix &weights = pair.second;
+
+            // Matrices that have not changed are already sparse
+            if ( !weights._positiveValues )
+                continue;
+
+            unsigned size = weights._rows * weights._columns;
+            unsigned nnz = 0;
+            for ( unsigned j = 0; j < size; ++j )
+            {
+                if ( weights._positiveValues[j] + weights._negativeValues[j] != 0 )
+                    ++nnz;
+            }
+
+            allocateSparseWeights( weights, nnz );
+
+            // Store the non-zero weights by target neuron
+            unsigned entry = 0;
+            for ( unsigned target = 0; target < weights._columns; ++target )
+            {
+                weights._targetStart[target] = entry;
+                for ( unsigned source = 0; source < weights._rows; ++source )
+                {
+                    unsigned index = source * weights._columns + target;
+                    double weight = weights._positiveValues[index] + weights._negativeValues[index];
+                    if ( weight != 0 )
+                    {
+                        weights._sourceNeurons[entry] = source;
+                        weights._sparseValues[entry] = weight;
+                        ++entry;
+                    }
+                }
+            }
+            weights._targetStart[weights._columns] = entry;
+
+            freeDenseWeights( weights );
+        }
+    }
+
+    _weightsCompressed = true;
+}
+
+void SymbolicBoundTightener::allocateDenseWeights( WeightMatrix &weights )
+{
+    unsigned size = weights._rows * weights._columns;
+
+    weights._positiveValues = new double[size];
+    if ( !weights._positiveValues )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::positiveValues" );
+
+    weights._negativeValues = new double[size];
+    if ( !weights._negativeValues )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::negativeValues" );
+
+    std::fill_n( weights._positiveValues, size, 0 );
+    std::fill_n( weights._negativeValues, size, 0 );
+}
+
+void SymbolicBoundTightener::expandWeights( WeightMatrix &weights )
+{
+    allocateDenseWeights( weights );
+
+    for ( unsigned target = 0; target < weights._columns; ++target )
+    {
+        for ( unsigned entry = weights._targetStart[target]; entry < weights._targetStart[target + 1]; ++entry )
+        {
+            unsigned index = weights._sourceNeurons[entry] * weights._columns + target;
+            double weight = weights._sparseValues[entry];
+
+            if ( weight > 0 )
+                weights._positiveValues[index] = weight;
+            else
+                weights._negativeValues[index] = weight;
+        }
+    }
+
+    freeSparseWeights( weights );
+}
+
+void SymbolicBoundTightener::freeDenseWeights( WeightMatrix &weights )
+{
+    if ( weights._positiveValues )
+    {
+        delete[] weights._positiveValues;
+        weights._positiveValues = NULL;
+    }
+
+    if ( weights._negativeValues )
+    {
+        delete[] weights._negativeValues;
+        weights._negativeValues = NULL;
+    }
+}
+
+void SymbolicBoundTightener::allocateSparseWeights( WeightMatrix &weights, unsigned nnz )
+{
+    weights._targetStart = new unsigned[weights._columns + 1];
+    if ( !weights._targetStart )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::targetStart" );
+
+    weights._sourceNeurons = new unsigned[nnz];
+    if ( !weights._sourceNeurons )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::sourceNeurons" );
+
+    weights._sparseValues = new double[nnz];
+    if ( !weights._sparseValues )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SymbolicBoundTightener::sparseValues" );
+}
+
+void SymbolicBoundTightener::freeSparseWeights( WeightMatrix &weights )
+{
+    if ( weights._targetStart )
+    {
+        delete[] weights._targetStart;
+        weights._targetStart = NULL;
+    }
+
+    if ( weights._sourceNeurons )
+    {
+        delete[] weights._sourceNeurons;
+        weights._sourceNeurons = NULL;
+    }
+
+    if ( weights._sparseValues )
+    {
+        delete[] weights._sparseValues;
+        weights._sparseValues = NULL;
+    }
+}
+
+void SymbolicBoundTightener::addMaxSource( unsigned layer, unsigned neuron, unsigned sourceLayer, unsigned sourceNeuron )
+{
+    if ( sourceLayer >= layer || _layerTypes[layer] != MAX )
+        throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT,
+                             Stringf( "Invalid max source for neuron <%u,%u>", layer, neuron ).ascii() );
+
+    _maxSources[NodeIndex( layer, neuron )].append( NodeIndex( sourceLayer, sourceNeuron ) );
+    markDirty( layer );
 }
 
 void SymbolicBoundTightener::setInputLowerBound( unsigned neuron, double bound )
 {
     ASSERT( _inputNeuronToIndex.exists( neuron ) );
-    _inputLowerBounds[_inputNeuronToIndex[neuron]] = bound;
+    unsigned index = _inputNeuronToIndex[neuron];
+
+    // Input bounds affect the concrete bounds of all layers
+    if ( !_inputLowerBounds.exists( index ) || _inputLowerBounds[index] != bound )
+    {
+        _inputLowerBounds[index] = bound;
+        markDirty( 0 );
+    }
 }
 
 void SymbolicBoundTightener::setInputUpperBound( unsigned neuron, double bound )
 {
     ASSERT( _inputNeuronToIndex.exists( neuron ) );
-    _inputUpperBounds[_inputNeuronToIndex[neuron]] = bound;
+    unsigned index = _inputNeuronToIndex[neuron];
+
+    if ( !_inputUpperBounds.exists( index ) || _inputUpperBounds[index] != bound )
+    {
+        _inputUpperBounds[index] = bound;
+        markDirty( 0 );
+    }
 }
 
 void SymbolicBoundTightener::run()
@@ -285,388 +500,498 @@ void SymbolicBoundTightener::run()
 
 void SymbolicBoundTightener::run( bool useLinearConcretization )
 {
-    /*
-      Initialize the symbolic bounds for the first layer. Each variable has symbolic
-      upper and lower bound 1 for itself, 0 for all other varibales.
-      The input layer has no biases.
-    */
-    std::fill_n( _previousLayerLowerBounds, _maxLayerSize * _inputLayerSize, 0 );
-    std::fill_n( _previousLayerUpperBounds, _maxLayerSize * _inputLayerSize, 0 );
-    for ( unsigned i = 0; i < _inputLayerSize; ++i )
+    if ( !_weightsCompressed )
+        compressWeights();
+
+    // Switching the concretization method invalidates all cached layers
+    if ( useLinearConcretization != _lastRunUsedLinearConcretization )
     {
-        _previousLayerLowerBounds[i * _inputLayerSize + i] = 1;
-        _previousLayerUpperBounds[i * _inputLayerSize + i] = 1;
+        markDirty( 0 );
+        _lastRunUsedLinearConcretization = useLinearConcretization;
     }
-    std::fill_n( _previousLayerLowerBias, _maxLayerSize, 0 );
-    std::fill_n( _previousLayerUpperBias, _maxLayerSize, 0 );
 
-    log( "Initializing.\n\tLB matrix:\n" );
-    for ( unsigned i = 0; i < _inputLayerSize; ++i )
+    // The symbolic bounds of layers before the first dirty layer are
+    // still valid, and are not recomputed
+    if ( _firstDirtyLayer >= _numberOfLayers )
     {
-        log( "\t" );
-        for ( unsigned j = 0; j < _inputLayerSize; ++j )
-        {
-            log( Stringf( "%.2lf ", _previousLayerLowerBounds[i*_inputLayerSize + j] ) );
-        }
-        log( "\n" );
+        log( "SBT: nothing has changed since the last run\n" );
+        return;
     }
-    log( "\nUB matrix:\n" );
-    for ( unsigned i = 0; i < _inputLayerSize; ++i )
+
+    if ( _firstDirtyLayer == 0 )
     {
-        log( "\t" );
-        for ( unsigned j = 0; j < _inputLayerSize; ++j )
+        /*
+          Initialize the symbolic bounds for the first layer. Each variable has symbolic
+          upper and lower bound 1 for itself, 0 for all other varibales.
+          The input layer has no biases.
+        */
+        std::fill_n( _symbolicLb[0], _inputLayerSize * _inputLayerSize, 0 );
+        std::fill_n( _symbolicUb[0], _inputLayerSize * _inputLayerSize, 0 );
+        for ( unsigned i = 0; i < _inputLayerSize; ++i )
         {
-            log( Stringf( "%.2lf ", _previousLayerUpperBounds[i*_inputLayerSize + j] ) );
+            _symbolicLb[0][i * _inputLayerSize + i] = 1;
+            _symbolicUb[0][i * _inputLayerSize + i] = 1;
+
+            _inputLb[i] = _inputLowerBounds[i];
+            _inputUb[i] = _inputUpperBounds[i];
+
+            _lowerBounds[0][i] = _inputLb[i];
+            _upperBounds[0][i] = _inputUb[i];
         }
-        log( "\n" );
+        std::fill_n( _symbolicLowerBias[0], _inputLayerSize, 0 );
+        std::fill_n( _symbolicUpperBias[0], _inputLayerSize, 0 );
+
+        _firstDirtyLayer = 1;
     }
 
-    for ( unsigned currentLayer = 1; currentLayer < _numberOfLayers; ++currentLayer )
+    for ( unsigned currentLayer = _firstDirtyLayer; currentLayer < _numberOfLayers; ++currentLayer )
     {
         log( Stringf( "\nStarting work on layer %u\n", currentLayer ) );
 
-        unsigned currentLayerSize = _layerSizes[currentLayer];
-        unsigned previousLayerSize = _layerSizes[currentLayer - 1];
+        if ( _layerTypes[currentLayer] == MAX )
+        {
+            handleMaxLayer( currentLayer );
+            continue;
+        }
 
         /*
-          Computing symbolic bounds for layer i, based on layer i-1.
-          We assume that the bounds for the previous layer have been computed.
+          Computing symbolic bounds for the layer, based on its source layers.
+          We assume that the bounds for the source layers have been computed.
         */
+        computeWeightedSum( currentLayer );
+
+        // We now have the symbolic representation for the new layer. Next, we compute new lower
+        // and upper bounds for it. For each of these bounds, we compute an upper bound and a lower
+        // bound.
+        for ( unsigned i = 0; i < _layerSizes[currentLayer]; ++i )
+        {
+            // lbLb: the lower bound for the expression of the lower bound
+            // lbUb: the upper bound for the expression of the lower bound
+            // etc
+            double lbLb, lbUb, ubLb, ubUb;
+            computeConcreteBounds( currentLayer, i, lbLb, lbUb, ubLb, ubUb );
 
-        std::fill_n( _currentLayerLowerBounds, _maxLayerSize * _inputLayerSize, 0 );
-        std::fill_n( _currentLayerUpperBounds, _maxLayerSize * _inputLayerSize, 0 );
+            log( Stringf( "Neuron %u: Computed concrete lb: %lf, ub: %lf\n", i, lbLb, ubUb ) );
 
-        // Grab the weights
-        WeightMatrix weights = _weights[currentLayer-1];
+            // Handle the activation function. We know that:
+            //   lbLb <= true LB <= lbUb
+            //   ubLb <= true UB <= ubUb
+            if ( _layerTypes[currentLayer] == RELU )
+                handleRelu( currentLayer, i, useLinearConcretization, lbLb, lbUb, ubLb, ubUb );
+            else if ( _layerTypes[currentLayer] == ABSOLUTE_VALUE )
+                handleAbsoluteValue( currentLayer, i, lbLb, lbUb, ubLb, ubUb );
 
-        log( "Positive weights:\n" );
-        for ( unsigned i = 0; i < _layerSizes[currentLayer - 1]; ++i )
-        {
-            log( "\t" );
-            for ( unsigned j = 0; j < _layerSizes[currentLayer]; ++j )
-            {
-                log( Stringf( "%.2lf ", weights._positiveValues[i*_layerSizes[currentLayer] + j] ) );
-            }
-            log( "\n" );
-        }
-        log( "\nNegative weights:\n" );
-        for ( unsigned i = 0; i < _layerSizes[currentLayer - 1]; ++i )
-        {
-            log( "\t" );
-            for ( unsigned j = 0; j < _layerSizes[currentLayer]; ++j )
-            {
-                log( Stringf( "%.2lf ", weights._negativeValues[i*_layerSizes[currentLayer] + j] ) );
-            }
-            log( "\n" );
+            // Store the bounds for this neuron
+            _lowerBounds[currentLayer][i] = lbLb;
+            _upperBounds[currentLayer][i] = ubUb;
         }
+    }
 
-        /*
-          Perform the multiplication.
-
-            newUB = oldUB * posWeights + oldLB * negWeights
-            newLB = oldUB * negWeights + oldLB * posWeights
+    _firstDirtyLayer = _numberOfLayers;
+}
 
-            dimensions for oldUB and oldLB: inputLayerSize x previousLayerSize
-            dimensions for posWeights and negWeights: previousLayerSize x layerSize
+void SymbolicBoundTightener::markDirty( unsigned layer )
+{
+    if ( layer < _firstDirtyLayer )
+        _firstDirtyLayer = layer;
+}
 
-            newUB, newLB dimensions: inputLayerSize x layerSize
-        */
+void SymbolicBoundTightener::computeWeightedSum( unsigned layer )
+{
+    unsigned layerSize = _layerSizes[layer];
 
-        for ( unsigned i = 0; i < _inputLayerSize; ++i )
-        {
-            for ( unsigned j = 0; j < currentLayerSize; ++j )
-            {
-                for ( unsigned k = 0; k < previousLayerSize; ++k )
-                {
-                    _currentLayerLowerBounds[i * currentLayerSize + j] +=
-                        _previousLayerUpperBounds[i * previousLayerSize + k] *
-                        weights._negativeValues[k * currentLayerSize + j];
+    /*
+      Computing symbolic bounds for the layer, one neuron at a time.
+      For every non-zero weight w between source neuron k and neuron j:
 
-                    _currentLayerLowerBounds[i * currentLayerSize + j] +=
-                        _previousLayerLowerBounds[i * previousLayerSize + k] *
-                        weights._positiveValues[k * currentLayerSize + j];
+        newUB_j += w * oldUB_k  (w > 0)   or   w * oldLB_k  (w < 0)
+        newLB_j += w * oldLB_k  (w > 0)   or   w * oldUB_k  (w < 0)
 
-                    _currentLayerUpperBounds[i * currentLayerSize + j] +=
-                        _previousLayerUpperBounds[i * previousLayerSize + k] *
-                        weights._positiveValues[k * currentLayerSize + j];
+      where every symbolic bound is a row of inputLayerSize
+      coefficients, stored contiguously.
+    */
+    for ( unsigned j = 0; j < layerSize; ++j )
+    {
+        double *lowerBounds = _symbolicLb[layer] + j * _inputLayerSize;
+        double *upperBounds = _symbolicUb[layer] + j * _inputLayerSize;
+        double &lowerBias = _symbolicLowerBias[layer][j];
+        double &upperBias = _symbolicUpperBias[layer][j];
 
-                    _currentLayerUpperBounds[i * currentLayerSize + j] +=
-                        _previousLayerLowerBounds[i * previousLayerSize + k] *
-                        weights._negativeValues[k * currentLayerSize + j];
-                }
-            }
-        }
+        std::fill_n( lowerBounds, _inputLayerSize, 0 );
+        std::fill_n( upperBounds, _inputLayerSize, 0 );
+        lowerBias = _biases[layer][j];
+        upperBias = _biases[layer][j];
 
-        /*
-          Compute the biases for the new layer
-        */
-        for ( unsigned j = 0; j < currentLayerSize; ++j )
+        for ( const auto &sourceLayer : _layerSources[layer] )
         {
-            _currentLayerLowerBias[j] = _biases[currentLayer][j];
-            _currentLayerUpperBias[j] = _biases[currentLayer][j];
+            const WeightMatrix &weights = _weights[layer][sourceLayer];
 
-            // Add the weighted bias from the previous layer
-            for ( unsigned k = 0; k < previousLayerSize; ++k )
+            for ( unsigned entry = weights._targetStart[j]; entry < weights._targetStart[j + 1]; ++entry )
             {
-                double weight = weights._positiveValues[k * currentLayerSize + j] + weights._negativeValues[k * currentLayerSize + j];
+                unsigned k = weights._sourceNeurons[entry];
+                double weight = weights._sparseValues[entry];
+
+                const double *sourceLowerBounds = _symbolicLb[sourceLayer] + k * _inputLayerSize;
+                const double *sourceUpperBounds = _symbolicUb[sourceLayer] + k * _inputLayerSize;
 
                 if ( weight > 0 )
                 {
-                    _currentLayerLowerBias[j] += _previousLayerLowerBias[k] * weight;
-                    _currentLayerUpperBias[j] += _previousLayerUpperBias[k] * weight;
+                    addScaledRow( lowerBounds, sourceLowerBounds, weight, _inputLayerSize );
+                    addScaledRow( upperBounds, sourceUpperBounds, weight, _inputLayerSize );
+                    lowerBias += _symbolicLowerBias[sourceLayer][k] * weight;
+                    upperBias += _symbolicUpperBias[sourceLayer][k] * weight;
                 }
                 else
                 {
-                    _currentLayerLowerBias[j] += _previousLayerUpperBias[k] * weight;
-                    _currentLayerUpperBias[j] += _previousLayerLowerBias[k] * weight;
+                    addScaledRow( lowerBounds, sourceUpperBounds, weight, _inputLayerSize );
+                    addScaledRow( upperBounds, sourceLowerBounds, weight, _inputLayerSize );
+                    lowerBias += _symbolicUpperBias[sourceLayer][k] * weight;
+                    upperBias += _symbolicLowerBias[sourceLayer][k] * weight;
                 }
             }
         }
+    }
+}
 
-        log( "\nAfter matrix multiplication, newLB is:\n" );
-        for ( unsigned i = 0; i < _inputLayerSize; ++i )
+void SymbolicBoundTightener::computeConcreteBounds( unsigned layer, unsigned neuron,
+                                                    double &lbLb, double &lbUb,
+                                                    double &ubLb, double &ubUb ) const
+{
+    const double *lowerBounds = _symbolicLb[layer] + neuron * _inputLayerSize;
+    const double *upperBounds = _symbolicUb[layer] + neuron * _inputLayerSize;
+
+    lbLb = 0;
+    lbUb = 0;
+    ubLb = 0;
+    ubUb = 0;
+
+    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+    {
+        double entry = lowerBounds[j];
+        double atLower = entry * _inputLb[j];
+        double atUpper = entry * _inputUb[j];
+
+        lbLb += ( entry >= 0 ) ? atLower : atUpper;
+        lbUb += ( entry >= 0 ) ? atUpper : atLower;
+
+        entry = upperBounds[j];
+        atLower = entry * _inputLb[j];
+        atUpper = entry * _inputUb[j];
+
+        ubLb += ( entry >= 0 ) ? atLower : atUpper;
+        ubUb += ( entry >= 0 ) ? atUpper : atLower;
+    }
+
+    // Account for rounding errors, once per input neuron
+    double rounding = _inputLayerSize * GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
+    lbLb -= rounding;
+    lbUb += rounding;
+    ubLb -= rounding;
+    ubUb += rounding;
+
+    // Add the network bias to all bounds
+    lbLb += _symbolicLowerBias[layer][neuron];
+    lbUb += _symbolicLowerBias[layer][neuron];
+    ubLb += _symbolicUpperBias[layer][neuron];
+    ubUb += _symbolicUpperBias[layer][neuron];
+}
+
+void SymbolicBoundTightener::zeroOutNeuron( unsigned layer, unsigned neuron )
+{
+    std::fill_n( _symbolicLb[layer] + neuron * _inputLayerSize, _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb[layer] + neuron * _inputLayerSize, _inputLayerSize, 0 );
+    _symbolicLowerBias[layer][neuron] = 0;
+    _symbolicUpperBias[layer][neuron] = 0;
+}
+
+void SymbolicBoundTightener::addScaledRow( double *target, const double *source, double scale, unsigned size )
+{
+    // Kept branch-free, so that the compiler can vectorize it
+    for ( unsigned i = 0; i < size; ++i )
+        target[i] += scale * source[i];
+}
+
+void SymbolicBoundTightener::handleRelu( unsigned layer, unsigned neuron, bool useLinearConcretization,
+                                         double &lbLb, double &lbUb, double &ubLb, double &ubUb )
+{
+    // The symbolic bounds of this neuron
+    double *lowerBounds = _symbolicLb[layer] + neuron * _inputLayerSize;
+    double *upperBounds = _symbolicUb[layer] + neuron * _inputLayerSize;
+    double *lowerBias = _symbolicLowerBias[layer];
+    double *upperBias = _symbolicUpperBias[layer];
+
+    NodeIndex reluIndex( layer, neuron );
+
+    ReluConstraint::PhaseStatus reluPhase = ReluConstraint::PHASE_NOT_FIXED;
+    if ( _nodeIndexToEliminatedReluState.exists( reluIndex ) )
+    {
+        reluPhase = _nodeIndexToEliminatedReluState[reluIndex];
+        ASSERT( reluPhase != ReluConstraint::PHASE_NOT_FIXED );
+    }
+    else if ( _nodeIndexToReluState.exists( reluIndex ) )
+    {
+        reluPhase = _nodeIndexToReluState[reluIndex];
+    }
+
+    // If the ReLU phase is not fixed yet, do the usual propagation:
+    if ( reluPhase == ReluConstraint::PHASE_NOT_FIXED )
+    {
+        if ( ubUb <= 0 )
         {
-            log( "\t" );
-            for ( unsigned j = 0; j < _layerSizes[currentLayer]; ++j )
-            {
-                log( Stringf( "%.2lf ", _currentLayerLowerBounds[i*_layerSizes[currentLayer] + j] ) );
-            }
-            log( "\n" );
+            // lb <= ub <= 0
+            // The ReLU will zero this entry out
+            lbLb = 0;
+            lbUb = 0;
+            ubLb = 0;
+            ubUb = 0;
+
+            zeroOutNeuron( layer, neuron );
         }
-        log( "\nnew UB is:\n" );
-        for ( unsigned i = 0; i < _inputLayerSize; ++i )
+        else if ( lbLb >= 0 )
         {
-            log( "\t" );
-            for ( unsigned j = 0; j < _layerSizes[currentLayer]; ++j )
-            {
-                log( Stringf( "%.2lf ", _currentLayerUpperBounds[i*_layerSizes[currentLayer] + j] ) );
-            }
-            log( "\n" );
-        }
+            // 0 <= lb <= ub
+            // The ReLU will not affect this entry
 
-        // We now have the symbolic representation for the new layer. Next, we compute new lower
-        // and upper bounds for it. For each of these bounds, we compute an upper bound and a lower
-        // bound.
-        //
-        // newUB, newLB dimensions: inputLayerSize x layerSize
-        //
-        for ( unsigned i = 0; i < currentLayerSize; ++i )
+            log( "SBT: eliminated nothing!\n" );
+        }
+        else
         {
-            // lbLb: the lower bound for the expression of the lower bound
-            // lbUb: the upper bound for the expression of the lower bound
-            // etc
+            // lbLb < 0 < ubUb
+            // The ReLU might affect this entry, we need to figure out how
 
-            double lbLb = 0;
-            double lbUb = 0;
-            double ubLb = 0;
-            double ubUb = 0;
-
-            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+            if ( ubLb < 0 )
             {
-                double entry = _currentLayerLowerBounds[j * currentLayerSize + i];
-
-                if ( entry >= 0 )
+                // ubLb < 0 < ubUb
+                if ( useLinearConcretization )
                 {
-                    lbLb += ( entry * _inputLowerBounds[j] );
-                    lbUb += ( entry * _inputUpperBounds[j] );
+                    // Concretize the upper bound using the Ehler's-like sapproximation
+
+                    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                        upperBounds[j] =
+                            upperBounds[j] * ubUb / ( ubUb - ubLb );
+
+                    // Do the same for the bias, and then adjust
+                    upperBias[neuron] = upperBias[neuron] * ubUb / ( ubUb - ubLb );
+                    upperBias[neuron] -= ubUb * ubLb / ( ubUb - ubLb );
                 }
                 else
                 {
-                    lbLb += ( entry * _inputUpperBounds[j] );
-                    lbUb += ( entry * _inputLowerBounds[j] );
-                }
+                    // No linear concretization //
 
-                lbLb -= GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
-                lbUb += GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
+                    // The upper bound range goes below 0, we we need to zero it out
+                    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                        upperBounds[j] = 0;
 
-                entry = _currentLayerUpperBounds[j * currentLayerSize + i];
+                    // We keep the concrete maxiaml value of the upper bound as the bias for this layer
+                    upperBias[neuron] = ubUb;
+                }
+            }
+            else
+            {
+                log( "SBT: did not eliminate upper!\n" );
+            }
 
-                if ( entry >= 0 )
+            if ( useLinearConcretization )
+            {
+                if ( lbUb < 0 )
                 {
-                    ubLb += ( entry * _inputLowerBounds[j] );
-                    ubUb += ( entry * _inputUpperBounds[j] );
+                    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                        lowerBounds[j] = 0;
+
+                    lowerBias[neuron] = 0;
                 }
                 else
                 {
-                    ubLb += ( entry * _inputUpperBounds[j] );
-                    ubUb += ( entry * _inputLowerBounds[j] );
+                    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                        lowerBounds[j] =
+                            lowerBounds[j] * lbUb / ( lbUb - lbLb );
+
+                    lowerBias[neuron] = lowerBias[neuron] * lbUb / ( lbUb - lbLb );
                 }
+            }
+            else
+            {
+                // No linear concretization //
+
+                // The lower bound can be negative, so it is zeroed out also
+                for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                    lowerBounds[j] = 0;
 
-                ubLb -= GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
-                ubUb += GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
+                lowerBias[neuron] = 0;
             }
 
-            // Add the network bias to all bounds
-            lbLb += _currentLayerLowerBias[i];
-            lbUb += _currentLayerLowerBias[i];
-            ubLb += _currentLayerUpperBias[i];
-            ubUb += _currentLayerUpperBias[i];
+            lbLb = 0;
+        }
 
-            log( Stringf( "Neuron %u: Computed concrete lb: %lf, ub: %lf\n", i, lbLb, ubUb ) );
+        log( Stringf( "\tAfter ReLU: concrete lb: %lf, ub: %lf\n", lbLb, ubUb ) );
+    }
+    else
+    {
+        // The phase of this ReLU is fixed!
+        if ( reluPhase == ReluConstraint::PHASE_ACTIVE )
+        {
+            // Active ReLU, bounds are propagated as is
+        }
+        else
+        {
+            // Inactive ReLU, returns zero
+            lbLb = 0;
+            lbUb = 0;
+            ubLb = 0;
+            ubUb = 0;
 
-            // Handle the ReLU activation. We know that:
-            //   lbLb <= true LB <= lbUb
-            //   ubLb <= true UB <= ubUb
+            zeroOutNeuron( layer, neuron );
+        }
 
-            if ( currentLayer < _numberOfLayers - 1 )
-            {
-                NodeIndex reluIndex( currentLayer, i );
+        log( Stringf( "\tAfter phase-fixed ReLU: concrete lb: %lf, ub: %lf\n", lbLb, ubUb ) );
+    }
+}
 
-                ReluConstraint::PhaseStatus reluPhase = ReluConstraint::PHASE_NOT_FIXED;
-                if ( _nodeIndexToEliminatedReluState.exists( reluIndex ) )
-                {
-                    reluPhase = _nodeIndexToEliminatedReluState[reluIndex];
-                    ASSERT( reluPhase != ReluConstraint::PHASE_NOT_FIXED );
-                }
-                else if ( _nodeIndexToReluState.exists( reluIndex ) )
-                {
-                    reluPhase = _nodeIndexToReluState[reluIndex];
-                }
+void SymbolicBoundTightener::handleAbsoluteValue( unsigned layer, unsigned neuron,
+                                                  double &lbLb, double &lbUb, double &ubLb, double &ubUb )
+{
+    // The symbolic bounds of this neuron
+    double *lowerBounds = _symbolicLb[layer] + neuron * _inputLayerSize;
+    double *upperBounds = _symbolicUb[layer] + neuron * _inputLayerSize;
+    double *lowerBias = _symbolicLowerBias[layer];
+    double *upperBias = _symbolicUpperBias[layer];
 
-                // If the ReLU phase is not fixed yet, do the usual propagation:
-                if ( reluPhase == ReluConstraint::PHASE_NOT_FIXED )
-                {
-                    if ( ubUb <= 0 )
-                    {
-                        // lb <= ub <= 0
-                        // The ReLU will zero this entry out
-                        lbLb = 0;
-                        lbUb = 0;
-                        ubLb = 0;
-                        ubUb = 0;
-
-                        for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                        {
-                            _currentLayerLowerBounds[j * currentLayerSize + i] = 0;
-                            _currentLayerUpperBounds[j * currentLayerSize + i] = 0;
-                        }
-                        _currentLayerLowerBias[i] = 0;
-                        _currentLayerUpperBias[i] = 0;
-                    }
-                    else if ( lbLb >= 0 )
-                    {
-                        // 0 <= lb <= ub
-                        // The ReLU will not affect this entry
+    NodeIndex absIndex( layer, neuron );
 
-                        log( "SBT: eliminated nothing!\n" );
-                    }
-                    else
-                    {
-                        // lbLb < 0 < ubUb
-                        // The ReLU might affect this entry, we need to figure out how
-
-                        if ( ubLb < 0 )
-                        {
-                            // ubLb < 0 < ubUb
-                            if ( useLinearConcretization )
-                            {
-                                // Concretize the upper bound using the Ehler's-like sapproximation
-
-                                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                                    _currentLayerUpperBounds[j * currentLayerSize + i] =
-                                        _currentLayerUpperBounds[j * currentLayerSize + i] * ubUb / ( ubUb - ubLb );
-
-                                // Do the same for the bias, and then adjust
-                                _currentLayerUpperBias[i] = _currentLayerUpperBias[i] * ubUb / ( ubUb - ubLb );
-                                _currentLayerUpperBias[i] -= ubUb * ubLb / ( ubUb - ubLb );
-                            }
-                            else
-                            {
-                                // No linear concretization //
-
-                                // The upper bound range goes below 0, we we need to zero it out
-                                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                                    _currentLayerUpperBounds[j * currentLayerSize + i] = 0;
-
-                                // We keep the concrete maxiaml value of the upper bound as the bias for this layer
-                                _currentLayerUpperBias[i] = ubUb;
-                            }
-                        }
-                        else
-                        {
-                            log( "SBT: did not eliminate upper!\n" );
-                        }
-
-                        if ( useLinearConcretization )
-                        {
-                            if ( lbUb < 0 )
-                            {
-                                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                                    _currentLayerLowerBounds[j * currentLayerSize + i] = 0;
-
-                                _currentLayerLowerBias[i] = 0;
-                            }
-                            else
-                            {
-                                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                                    _currentLayerLowerBounds[j * currentLayerSize + i] =
-                                        _currentLayerLowerBounds[j * currentLayerSize + i] * lbUb / ( lbUb - lbLb );
-
-                                _currentLayerLowerBias[i] = _currentLayerLowerBias[i] * lbUb / ( lbUb - lbLb );
-                            }
-                        }
-                        else
-                        {
-                            // No linear concretization //
-
-                            // The lower bound can be negative, so it is zeroed out also
-                            for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                                _currentLayerLowerBounds[j * currentLayerSize + i] = 0;
-
-                            _currentLayerLowerBias[i] = 0;
-                        }
-
-                        lbLb = 0;
-                    }
+    AbsoluteValueConstraint::PhaseStatus absPhase = AbsoluteValueConstraint::PHASE_NOT_FIXED;
+    if ( _nodeIndexToEliminatedAbsoluteValueState.exists( absIndex ) )
+        absPhase = _nodeIndexToEliminatedAbsoluteValueState[absIndex];
+    else if ( _nodeIndexToAbsoluteValueState.exists( absIndex ) )
+        absPhase = _nodeIndexToAbsoluteValueState[absIndex];
 
-                    log( Stringf( "\tAfter ReLU: concrete lb: %lf, ub: %lf\n", lbLb, ubUb ) );
-                }
-                else
-                {
-                    // The phase of this ReLU is fixed!
-                    if ( reluPhase == ReluConstraint::PHASE_ACTIVE )
-                    {
-                        // printf( "Relu <%u,%u> is ACTIVE, leaving equations as is\n", reluIndex._layer, reluIndex._neuron );
-                        // Active ReLU, bounds are propagated as is
-                    }
-                    else
-                    {
-                        // printf( "Relu <%u,%u> is INACTIVE, zeroing out equations\n", reluIndex._layer, reluIndex._neuron );
-
-                        // Inactive ReLU, returns zero
-                        lbLb = 0;
-                        lbUb = 0;
-                        ubLb = 0;
-                        ubUb = 0;
-
-                        for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                        {
-                            _currentLayerLowerBounds[j * currentLayerSize + i] = 0;
-                            _currentLayerUpperBounds[j * currentLayerSize + i] = 0;
-                        }
-                        _currentLayerLowerBias[i] = 0;
-                        _currentLayerUpperBias[i] = 0;
-                    }
+    if ( absPhase == AbsoluteValueConstraint::PHASE_NOT_FIXED )
+    {
+        if ( lbLb >= 0 )
+            absPhase = AbsoluteValueConstraint::PHASE_POSITIVE;
+        else if ( ubUb <= 0 )
+            absPhase = AbsoluteValueConstraint::PHASE_NEGATIVE;
+    }
 
-                    log( Stringf( "\tAfter phase-fixed ReLU: concrete lb: %lf, ub: %lf\n", lbLb, ubUb ) );
-                }
+    if ( absPhase == AbsoluteValueConstraint::PHASE_POSITIVE )
+    {
+        // The absolute value will not affect this entry
+    }
+    else if ( absPhase == AbsoluteValueConstraint::PHASE_NEGATIVE )
+    {
+        // The absolute value negates this entry, which swaps the bounds
+        for ( unsigned j = 0; j < _inputLayerSize; ++j )
+        {
+            double temp = lowerBounds[j];
+            lowerBounds[j] = -upperBounds[j];
+            upperBounds[j] = -temp;
+        }
+
+        double temp = lowerBias[neuron];
+        lowerBias[neuron] = -upperBias[neuron];
+        upperBias[neuron] = -temp;
+
+        double newLbLb = -ubUb;
+        double newLbUb = -ubLb;
+        double newUbLb = -lbUb;
+        double newUbUb = -lbLb;
+
+        lbLb = newLbLb;
+        lbUb = newLbUb;
+        ubLb = newUbLb;
+        ubUb = newUbUb;
+    }
+    else
+    {
+        // lbLb < 0 < ubUb
+        // The lower bound is 0, and the upper bound is concretized
+        double maxValue = FloatUtils::max( -lbLb, ubUb );
+
+        zeroOutNeuron( layer, neuron );
+        upperBias[neuron] = maxValue;
+
+        lbLb = 0;
+        lbUb = 0;
+        ubLb = maxValue;
+        ubUb = maxValue;
+    }
+
+    // The absolute value is never negative
+    if ( lbLb < 0 )
+        lbLb = 0;
+
+    log( Stringf( "\tAfter absolute value: concrete lb: %lf, ub: %lf\n", lbLb, ubUb ) );
+}
+
+void SymbolicBoundTightener::handleMaxLayer( unsigned layer )
+{
+    unsigned layerSize = _layerSizes[layer];
+    double *lowerBounds = _symbolicLb[layer];
+    double *upperBounds = _symbolicUb[layer];
+    double *lowerBias = _symbolicLowerBias[layer];
+    double *upperBias = _symbolicUpperBias[layer];
+
+    for ( unsigned i = 0; i < layerSize; ++i )
+    {
+        NodeIndex maxIndex( layer, i );
+        if ( !_maxSources.exists( maxIndex ) )
+            throw MarabouError( MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT,
+                                 Stringf( "Max neuron <%u,%u> has no sources", layer, i ).ascii() );
+
+        const List<NodeIndex> &sources = _maxSources[maxIndex];
+
+        // Find the source with the largest lower bound, and the largest upper bound
+        NodeIndex bestSource = *sources.begin();
+        double maxUb = FloatUtils::negativeInfinity();
+        for ( const auto &source : sources )
+        {
+            if ( _lowerBounds[source._layer][source._neuron] >
+                 _lowerBounds[bestSource._layer][bestSource._neuron] )
+                bestSource = source;
+
+            maxUb = FloatUtils::max( maxUb, _upperBounds[source._layer][source._neuron] );
+        }
+
+        double bestLb = _lowerBounds[bestSource._layer][bestSource._neuron];
+
+        // The max is at least as large as any of its sources
+        unsigned bestOffset = bestSource._neuron * _inputLayerSize;
+        memcpy( lowerBounds + i * _inputLayerSize, _symbolicLb[bestSource._layer] + bestOffset,
+                sizeof(double) * _inputLayerSize );
+        lowerBias[i] = _symbolicLowerBias[bestSource._layer][bestSource._neuron];
+
+        // If the best source dominates all others, the max is equal to it
+        bool dominates = true;
+        for ( const auto &source : sources )
+        {
+            if ( ( source._layer != bestSource._layer || source._neuron != bestSource._neuron ) &&
+                 _upperBounds[source._layer][source._neuron] > bestLb )
+            {
+                dominates = false;
+                break;
             }
+        }
 
-            // Store the bounds for this neuron
-            _lowerBounds[currentLayer][i] = lbLb;
-            _upperBounds[currentLayer][i] = ubUb;
+        if ( dominates )
+        {
+            memcpy( upperBounds + i * _inputLayerSize, _symbolicUb[bestSource._layer] + bestOffset,
+                    sizeof(double) * _inputLayerSize );
+            upperBias[i] = _symbolicUpperBias[bestSource._layer][bestSource._neuron];
+
+            _lowerBounds[layer][i] = bestLb;
+            _upperBounds[layer][i] = _upperBounds[bestSource._layer][bestSource._neuron];
         }
+        else
+        {
+            // The upper bound is concretized to the largest upper bound of the sources
+            std::fill_n( upperBounds + i * _inputLayerSize, _inputLayerSize, 0 );
+            upperBias[i] = maxUb;
 
-        log( "Dumping current layer upper bounds, before copy:\n" );
-        for ( unsigned i = 0; i < _maxLayerSize * _inputLayerSize; ++i )
-            log( Stringf( "%.5lf ", _currentLayerUpperBounds[i] ) );
-        log( "\n\n" );
+            _lowerBounds[layer][i] = bestLb;
+            _upperBounds[layer][i] = maxUb;
+        }
 
-        // Prepare for next iteration
-        memcpy( _previousLayerLowerBounds, _currentLayerLowerBounds, sizeof(double) * _maxLayerSize * _inputLayerSize );
-        memcpy( _previousLayerUpperBounds, _currentLayerUpperBounds, sizeof(double) * _maxLayerSize * _inputLayerSize );
-        memcpy( _previousLayerLowerBias, _currentLayerLowerBias, sizeof(double) * _maxLayerSize );
-        memcpy( _previousLayerUpperBias, _currentLayerUpperBias, sizeof(double) * _maxLayerSize );
+        log( Stringf( "Max neuron %u: concrete lb: %lf, ub: %lf\n", i,
+                      _lowerBounds[layer][i], _upperBounds[layer][i] ) );
     }
 }
 
@@ -688,12 +1013,51 @@ void SymbolicBoundTightener::log( const String &message )
 
 void SymbolicBoundTightener::clearReluStatuses()
 {
+    for ( const auto &entry : _nodeIndexToReluState )
+    {
+        if ( entry.second != ReluConstraint::PHASE_NOT_FIXED )
+            markDirty( entry.first._layer );
+    }
+
     _nodeIndexToReluState.clear();
 }
 
 void SymbolicBoundTightener::setReluStatus( unsigned layer, unsigned neuron, ReluConstraint::PhaseStatus status )
 {
-    _nodeIndexToReluState[NodeIndex( layer, neuron )] = status;
+    NodeIndex index( layer, neuron );
+
+    // A missing entry is equivalent to a phase that is not fixed
+    ReluConstraint::PhaseStatus previous = _nodeIndexToReluState.exists( index ) ?
+        _nodeIndexToReluState[index] : ReluConstraint::PHASE_NOT_FIXED;
+
+    if ( previous != status )
+        markDirty( layer );
+
+    _nodeIndexToReluState[index] = status;
+}
+
+void SymbolicBoundTightener::clearAbsoluteValueStatuses()
+{
+    for ( const auto &entry : _nodeIndexToAbsoluteValueState )
+    {
+        if ( entry.second != AbsoluteValueConstraint::PHASE_NOT_FIXED )
+            markDirty( entry.first._layer );
+    }
+
+    _nodeIndexToAbsoluteValueState.clear();
+}
+
+void SymbolicBoundTightener::setAbsoluteValueStatus( unsigned layer, unsigned neuron, AbsoluteValueConstraint::PhaseStatus status )
+{
+    NodeIndex index( layer, neuron );
+
+    AbsoluteValueConstraint::PhaseStatus previous = _nodeIndexToAbsoluteValueState.exists( index ) ?
+        _nodeIndexToAbsoluteValueState[index] : AbsoluteValueConstraint::PHASE_NOT_FIXED;
+
+    if ( previous != status )
+        markDirty( layer );
+
+    _nodeIndexToAbsoluteValueState[index] = status;
 }
 
 void SymbolicBoundTightener::setReluBVariable( unsigned layer, unsigned neuron, unsigned b )
@@ -705,6 +1069,28 @@ void SymbolicBoundTightener::setReluBVariable( unsigned layer, unsigned neuron,
 void SymbolicBoundTightener::setReluFVariable( unsigned layer, unsigned neuron, unsigned f )
 {
     _nodeIndexToFVariable[NodeIndex( layer, neuron )] = f;
+    _fVariableToNodeIndex[f] = NodeIndex( layer, neuron );
+}
+
+bool SymbolicBoundTightener::hasNodeIndexForB( unsigned b ) const
+{
+    return _bVariableToNodeIndex.exists( b );
+}
+
+bool SymbolicBoundTightener::hasMaxNodeForF( unsigned f ) const
+{
+    if ( !_fVariableToNodeIndex.exists( f ) )
+        return false;
+
+    return _layerTypes[_fVariableToNodeIndex.at( f )._layer] == MAX;
+}
+
+bool SymbolicBoundTightener::hasAbsoluteValueNodeForB( unsigned b ) const
+{
+    if ( !_bVariableToNodeIndex.exists( b ) )
+        return false;
+
+    return _layerTypes[_bVariableToNodeIndex.at( b )._layer] == ABSOLUTE_VALUE;
 }
 
 SymbolicBoundTightener::NodeIndex SymbolicBoundTightener::nodeIndexFromB( unsigned b ) const
@@ -719,6 +1105,14 @@ void SymbolicBoundTightener::setEliminatedRelu( unsigned layer, unsigned neuron,
 {
     ASSERT( status != ReluConstraint::PHASE_NOT_FIXED );
     _nodeIndexToEliminatedReluState[NodeIndex( layer, neuron )] = status;
+    markDirty( layer );
+}
+
+void SymbolicBoundTightener::setEliminatedAbsoluteValue( unsigned layer, unsigned neuron, AbsoluteValueConstraint::PhaseStatus status )
+{
+    ASSERT( status != AbsoluteValueConstraint::PHASE_NOT_FIXED );
+    _nodeIndexToEliminatedAbsoluteValueState[NodeIndex( layer, neuron )] = status;
+    markDirty( layer );
 }
 
 void SymbolicBoundTightener::updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
@@ -807,7 +1201,13 @@ void SymbolicBoundTightener::updateVariableIndices( const Map<unsigned, unsigned
     for ( const auto &entry : _nodeIndexToBVariable )
         _bVariableToNodeIndex[entry.second] = entry.first;
 
+    // Recreate the inverse F map
+    _fVariableToNodeIndex.clear();
+    for ( const auto &entry : _nodeIndexToFVariable )
+        _fVariableToNodeIndex[entry.second] = entry.first;
+
     // Set the lower and upper bound for any input variable that has become fixed
+    markDirty( 0 );
     for ( unsigned i = 0; i < _inputLayerSize; ++i )
     {
         if ( mergedVariables.exists( i ) )
@@ -831,11 +1231,39 @@ void SymbolicBoundTightener::updateVariableIndices( const Map<unsigned, unsigned
     }
 }
 
+void SymbolicBoundTightener::mergeVariables( unsigned v1, unsigned v2 )
+{
+    for ( auto &entry : _nodeIndexToBVariable )
+    {
+        if ( entry.second == v1 )
+            entry.second = v2;
+    }
+
+    for ( auto &entry : _nodeIndexToFVariable )
+    {
+        if ( entry.second == v1 )
+            entry.second = v2;
+    }
+
+    if ( _bVariableToNodeIndex.exists( v1 ) )
+    {
+        _bVariableToNodeIndex[v2] = _bVariableToNodeIndex[v1];
+        _bVariableToNodeIndex.erase( v1 );
+    }
+
+    if ( _fVariableToNodeIndex.exists( v1 ) )
+    {
+        _fVariableToNodeIndex[v2] = _fVariableToNodeIndex[v1];
+        _fVariableToNodeIndex.erase( v1 );
+    }
+}
+
 const Map<SymbolicBoundTightener::NodeIndex, unsigned> &SymbolicBoundTightener::getNodeIndexToFMapping() const
 {
     return _nodeIndexToFVariable;
 }
 
+
 void SymbolicBoundTightener::storeIntoOther( SymbolicBoundTightener &other ) const
 {
     other.freeMemoryIfNeeded();
@@ -843,20 +1271,40 @@ void SymbolicBoundTightener::storeIntoOther( SymbolicBoundTightener &other ) con
     other.setNumberOfLayers( _numberOfLayers );
 
     for ( unsigned i = 0; i < _numberOfLayers; ++i )
+    {
         other.setLayerSize( i, _layerSizes[i] );
+        other._layerTypes[i] = _layerTypes[i];
+    }
+
+    other._layerSources = _layerSources;
+    other._maxSources = _maxSources;
 
     other.allocateWeightAndBiasSpace();
 
-    for ( unsigned i = 0; i < _numberOfLayers - 1; ++i )
+    for ( unsigned i = 0; i < _numberOfLayers; ++i )
     {
-        unsigned rows = _weights[i]._rows;
-        unsigned columns = _weights[i]._columns;
+        for ( const auto &weights : _weights[i] )
+        {
+            unsigned rows = weights.second._rows;
+            unsigned columns = weights.second._columns;
 
-        other._weights[i]._rows = rows;
-        other._weights[i]._columns = columns;
+            WeightMatrix &otherWeights = other._weights[i][weights.first];
+            if ( weights.second._positiveValues )
+            {
+                memcpy( otherWeights._positiveValues, weights.second._positiveValues, sizeof(double) * rows * columns );
+                memcpy( otherWeights._negativeValues, weights.second._negativeValues, sizeof(double) * rows * columns );
+            }
+            else
+            {
+                unsigned nnz = weights.second._targetStart[columns];
 
-        memcpy( other._weights[i]._positiveValues, _weights[i]._positiveValues, sizeof(double) * rows * columns );
-        memcpy( other._weights[i]._negativeValues, _weights[i]._negativeValues, sizeof(double) * rows * columns );
+                freeDenseWeights( otherWeights );
+                allocateSparseWeights( otherWeights, nnz );
+                memcpy( otherWeights._targetStart, weights.second._targetStart, sizeof(unsigned) * ( columns + 1 ) );
+                memcpy( otherWeights._sourceNeurons, weights.second._sourceNeurons, sizeof(unsigned) * nnz );
+                memcpy( otherWeights._sparseValues, weights.second._sparseValues, sizeof(double) * nnz );
+            }
+        }
     }
 
     for ( unsigned i = 0; i < _numberOfLayers; ++i )
@@ -865,7 +1313,6 @@ void SymbolicBoundTightener::storeIntoOther( SymbolicBoundTightener &other ) con
     }
 
     other._inputLayerSize = _inputLayerSize;
-    other._maxLayerSize = _maxLayerSize;
     other._inputLowerBounds = _inputLowerBounds;
     other._inputUpperBounds = _inputUpperBounds;
 
@@ -878,9 +1325,12 @@ void SymbolicBoundTightener::storeIntoOther( SymbolicBoundTightener &other ) con
     other._nodeIndexToBVariable = _nodeIndexToBVariable;
     other._nodeIndexToFVariable = _nodeIndexToFVariable;
     other._bVariableToNodeIndex = _bVariableToNodeIndex;
+    other._fVariableToNodeIndex = _fVariableToNodeIndex;
 
     other._nodeIndexToReluState = _nodeIndexToReluState;
     other._nodeIndexToEliminatedReluState = _nodeIndexToEliminatedReluState;
+    other._nodeIndexToAbsoluteValueState = _nodeIndexToAbsoluteValueState;
+    other._nodeIndexToEliminatedAbsoluteValueState = _nodeIndexToEliminatedAbsoluteValueState;
 
     other._inputNeuronToIndex = _inputNeuronToIndex;
 }
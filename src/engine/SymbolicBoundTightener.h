@@ -16,30 +16,74 @@
 #ifndef __SymbolicBoundTightener_h__
 #define __SymbolicBoundTightener_h__
 
+#include "List.h"
 #include "MString.h"
 #include "Map.h"
 
-// Todo: remove this include later
+// Todo: remove these includes later
+#include "AbsoluteValueConstraint.h"
 #include "ReluConstraint.h"
 
 /*
   A utility class for performing symbolic bound tightening.
-  It currently makes the following assumptions:
 
-    1. The network only has ReLU activations functions
-    2. The network is fully connected
-    3. An external caller has stored the weights and topology
+  The network is described as a sequence of layers, numbered in
+  topological order: a layer may only receive inputs from layers with
+  smaller indices. Layer 0 is the input layer. Every other layer has a
+  type:
+
+    - A weighted sum layer computes an affine function of the neurons
+      in its source layers. By default, the source of layer i is
+      layer i - 1, but additional sources (e.g., residual connections)
+      may be specified.
+    - A ReLU or an absolute value layer computes a weighted sum, as
+      above, and then applies the activation function.
+    - A max layer (e.g., max pooling) has no weights: each of its
+      neurons is the maximum of a set of neurons in earlier layers.
+
+  By default, the last layer is a weighted sum layer and all other
+  non-input layers are ReLU layers, which matches a fully connected
+  feed-forward ReLU network.
+
+  The symbolic bounds of all layers are kept in memory, as they may be
+  needed by any later layer. The class makes the following
+  assumptions:
+
+    1. An external caller has stored the weights and topology
+    2. The topology is set before allocateWeightAndBiasSpace() is
+       called
 */
 
 class SymbolicBoundTightener
 {
 public:
+    enum LayerType {
+        INPUT = 0,
+        WEIGHTED_SUM,
+        RELU,
+        ABSOLUTE_VALUE,
+        MAX,
+    };
+
+    /*
+      The weights between a source layer (rows) and a target layer
+      (columns). The dense positive and negative parts are filled by
+      setWeight(); before running, the non-zero weights are compressed
+      by target neuron: the weights of target neuron j are stored in
+      entries _targetStart[j] to _targetStart[j + 1] - 1 of
+      _sourceNeurons and _sparseValues. The dense parts are then
+      freed, and only restored if a weight is set again.
+    */
     struct WeightMatrix
     {
         double *_positiveValues;
         double *_negativeValues;
         unsigned _rows;
         unsigned _columns;
+
+        unsigned *_targetStart;
+        unsigned *_sourceNeurons;
+        double *_sparseValues;
     };
 
     struct NodeIndex
@@ -75,25 +119,39 @@ public:
       Initialization methods for reporting the topology of the network:
 
       - Number of layers
-      - Layer sizes
+      - Layer sizes, types and the connections between layers
       - Allocating the required internal memory
       - Biases and weights
+      - The sources of max neurons
       - Lower and upper bounds for input neurons
+
+      setWeight() without a target layer refers to the connection
+      between sourceLayer and sourceLayer + 1.
     */
     void setNumberOfLayers( unsigned layers );
     void setLayerSize( unsigned layer, unsigned layerSize );
+    void setLayerType( unsigned layer, LayerType type );
+    void addLayerDependency( unsigned sourceLayer, unsigned targetLayer );
     void allocateWeightAndBiasSpace();
     void setBias( unsigned layer, unsigned neuron, double bias );
     void setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight );
+    void setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetLayer, unsigned targetNeuron, double weight );
+    void addMaxSource( unsigned layer, unsigned neuron, unsigned sourceLayer, unsigned sourceNeuron );
     void setInputLowerBound( unsigned neuron, double bound );
     void setInputUpperBound( unsigned neuron, double bound );
 
     /*
-      Setting the connections between the network topology and the simplex variables
+      Setting the connections between the network topology and the
+      simplex variables. For ReLU and absolute value neurons, b is the
+      weighted sum and f is the activation result. For other neurons,
+      only f is used.
     */
     void setReluBVariable( unsigned layer, unsigned neuron, unsigned b );
     void setReluFVariable( unsigned layer, unsigned neuron, unsigned f );
 
+    bool hasNodeIndexForB( unsigned b ) const;
+    bool hasMaxNodeForF( unsigned f ) const;
+    bool hasAbsoluteValueNodeForB( unsigned b ) const;
     NodeIndex nodeIndexFromB( unsigned b ) const;
     const Map<NodeIndex, unsigned> &getNodeIndexToFMapping() const;
 
@@ -102,16 +160,29 @@ public:
                                 const Map<unsigned, double> &fixedVariableValues );
 
     /*
-      Report that a ReLU constraint has become permanently fixed (i.e., at decision level 0)
+      Report that variable v1 has been merged into v2. The preprocessor
+      may look up constraints by their new variables before the indices
+      are updated.
+    */
+    void mergeVariables( unsigned v1, unsigned v2 );
+
+    /*
+      Report that a ReLU or an absolute value constraint has become
+      permanently fixed (i.e., at decision level 0)
     */
     void setEliminatedRelu( unsigned layer, unsigned neuron, ReluConstraint::PhaseStatus status );
+    void setEliminatedAbsoluteValue( unsigned layer, unsigned neuron, AbsoluteValueConstraint::PhaseStatus status );
 
     /*
-      Prior to running, we can use these methods to report any ReLUs that have becomes
-      fixed, or to clear previously-reported information
+      Prior to running, we can use these methods to report any ReLUs
+      or absolute values that have becomes fixed, or to clear
+      previously-reported information. Reporting the same phases as in
+      the previous run does not trigger any recomputation.
     */
     void setReluStatus( unsigned layer, unsigned neuron, ReluConstraint::PhaseStatus status );
     void clearReluStatuses();
+    void setAbsoluteValueStatus( unsigned layer, unsigned neuron, AbsoluteValueConstraint::PhaseStatus status );
+    void clearAbsoluteValueStatuses();
 
     /*
       Running the tool, with or without linear concertization
@@ -132,15 +203,22 @@ public:
     void storeIntoOther( SymbolicBoundTightener &other ) const;
 
 private:
-    // The number of layers and their sizes
+    // The number of layers, their sizes and types
     unsigned _numberOfLayers;
     unsigned *_layerSizes;
+    LayerType *_layerTypes;
     unsigned _inputLayerSize;
-    unsigned _maxLayerSize;
 
-    // The network's weights and biases
+    // The source layers of every weighted sum layer
+    Map<unsigned, List<unsigned>> _layerSources;
+
+    // The network's weights and biases. The weights are indexed by
+    // target layer, and then by source layer.
     double **_biases;
-    WeightMatrix *_weights;
+    Map<unsigned, WeightMatrix> *_weights;
+
+    // The sources of every max neuron
+    Map<NodeIndex, List<NodeIndex>> _maxSources;
 
     // Lower and upper bounds for input neurons
     Map<unsigned,double> _inputLowerBounds;
@@ -150,30 +228,82 @@ private:
     double **_lowerBounds;
     double **_upperBounds;
 
-    // Mapping from ReLUs to simplex variables
+    // Mapping from neurons to simplex variables
     Map<NodeIndex, unsigned> _nodeIndexToBVariable;
     Map<NodeIndex, unsigned> _nodeIndexToFVariable;
     Map<unsigned, NodeIndex> _bVariableToNodeIndex;
+    Map<unsigned, NodeIndex> _fVariableToNodeIndex;
 
-    // Information about the phase statuses of ReLU nodes
+    // Information about the phase statuses of ReLU and absolute value nodes
     Map<NodeIndex, ReluConstraint::PhaseStatus> _nodeIndexToReluState;
     Map<NodeIndex, ReluConstraint::PhaseStatus> _nodeIndexToEliminatedReluState;
+    Map<NodeIndex, AbsoluteValueConstraint::PhaseStatus> _nodeIndexToAbsoluteValueState;
+    Map<NodeIndex, AbsoluteValueConstraint::PhaseStatus> _nodeIndexToEliminatedAbsoluteValueState;
 
     // To account for input variable renaming as part of preprocessing
     Map<unsigned, unsigned> _inputNeuronToIndex;
 
     /*
-      Work space for the bound computation
+      The symbolic bounds of every layer, in terms of the input
+      neurons. For layer i, entry k * inputLayerSize + j is the
+      coefficient of input neuron j in the bound of neuron k, so that
+      the bound of every neuron is stored contiguously.
+    */
+    double **_symbolicLb;
+    double **_symbolicUb;
+    double **_symbolicLowerBias;
+    double **_symbolicUpperBias;
+
+    /*
+      The input bounds as dense arrays, refreshed on every run
+    */
+    double *_inputLb;
+    double *_inputUb;
+
+    /*
+      Whether all weight matrices are in their sparse form. A matrix
+      is either dense or sparse, never both.
+    */
+    bool _weightsCompressed;
+    void compressWeights();
+    static void allocateDenseWeights( WeightMatrix &weights );
+    static void expandWeights( WeightMatrix &weights );
+    static void freeDenseWeights( WeightMatrix &weights );
+    static void freeSparseWeights( WeightMatrix &weights );
+    static void allocateSparseWeights( WeightMatrix &weights, unsigned nnz );
+
+    /*
+      The symbolic and concrete bounds of the layers are kept between
+      runs. A layer is dirty if its bounds may have changed since the
+      last run, e.g. because a ReLU phase in it was fixed or an input
+      bound changed. Every layer after a dirty layer may depend on it,
+      so only the index of the first dirty layer is tracked, and run()
+      recomputes the layers from that point on.
+    */
+    unsigned _firstDirtyLayer;
+    bool _lastRunUsedLinearConcretization;
+    void markDirty( unsigned layer );
+
+    /*
+      Helpers for computing the symbolic bounds of a layer, and for
+      concretizing and adjusting the bounds of its neurons
+    */
+    void computeWeightedSum( unsigned layer );
+    void computeConcreteBounds( unsigned layer, unsigned neuron,
+                                double &lbLb, double &lbUb,
+                                double &ubLb, double &ubUb ) const;
+    void handleRelu( unsigned layer, unsigned neuron, bool useLinearConcretization,
+                     double &lbLb, double &lbUb, double &ubLb, double &ubUb );
+    void handleAbsoluteValue( unsigned layer, unsigned neuron,
+                              double &lbLb, double &lbUb, double &ubLb, double &ubUb );
+    void handleMaxLayer( unsigned layer );
+
+    void zeroOutNeuron( unsigned layer, unsigned neuron );
+
+    /*
+      target += scale * source, for rows of the given size
     */
-    double *_currentLayerLowerBounds;
-    double *_currentLayerUpperBounds;
-    double *_currentLayerLowerBias;
-    double *_currentLayerUpperBias;
-
-    double *_previousLayerLowerBounds;
-    double *_previousLayerUpperBounds;
-    double *_previousLayerLowerBias;
-    double *_previousLayerUpperBias;
+    static void addScaledRow( double *target, const double *source, double scale, unsigned size );
 
     void freeMemoryIfNeeded();
     static void log( const String &message );
@@ -20,11 +20,16 @@
 #include "EntrySelectionStrategy.h"
 #include "Equation.h"
 #include "FloatUtils.h"
+#include "ForrestTomlinFactorization.h"
+#include "GlobalConfiguration.h"
 #include "ICostFunctionManager.h"
+#include "LUFactorization.h"
 #include "MStringf.h"
 #include "MalformedBasisException.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "MarabouError.h"
+#include "SparseFTFactorization.h"
+#include "SparseLUFactorization.h"
 #include "Tableau.h"
 #include "TableauRow.h"
 #include "TableauState.h"
@@ -37,15 +42,20 @@ Tableau::Tableau()
     , _A( NULL )
     , _sparseColumnsOfA( NULL )
     , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
     , _changeColumn( NULL )
+    , _changeColumnIndices( NULL )
+    , _changeColumnNnz( 0 )
     , _pivotRow( NULL )
     , _b( NULL )
     , _workM( NULL )
     , _workN( NULL )
+    , _aColumn( NULL )
+    , _aColumnIndices( NULL )
     , _unitVector( NULL )
     , _basisFactorization( NULL )
+    , _basisFactorizationType( GlobalConfiguration::BASIS_FACTORIZATION_TYPE )
     , _multipliers( NULL )
+    , _multiplierIndices( NULL )
     , _basicIndexToVariable( NULL )
     , _nonBasicIndexToVariable( NULL )
     , _variableToIndex( NULL )
@@ -55,6 +65,10 @@ Tableau::Tableau()
     , _boundsValid( true )
     , _basicAssignment( NULL )
     , _basicStatus( NULL )
+    , _candidatePool( NULL )
+    , _candidatePoolSize( 0 )
+    , _inCandidatePool( NULL )
+    , _pricingCursor( 0 )
     , _basicAssignmentStatus( ITableau::BASIC_ASSIGNMENT_INVALID )
     , _statistics( NULL )
     , _costFunctionManager( NULL )
@@ -68,6 +82,12 @@ Tableau::~Tableau()
 }
 
 void Tableau::freeMemoryIfNeeded()
+{
+    freeConstraintMatrixIfNeeded();
+    freeWorkMemoryIfNeeded();
+}
+
+void Tableau::freeConstraintMatrixIfNeeded()
 {
     if ( _A )
     {
@@ -104,19 +124,22 @@ void Tableau::freeMemoryIfNeeded()
         delete[] _sparseRowsOfA;
         _sparseRowsOfA = NULL;
     }
+}
 
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
-
+void Tableau::freeWorkMemoryIfNeeded()
+{
     if ( _changeColumn )
     {
         delete[] _changeColumn;
         _changeColumn = NULL;
     }
 
+    if ( _changeColumnIndices )
+    {
+        delete[] _changeColumnIndices;
+        _changeColumnIndices = NULL;
+    }
+
     if ( _pivotRow )
     {
         delete _pivotRow;
@@ -141,6 +164,12 @@ void Tableau::freeMemoryIfNeeded()
         _multipliers = NULL;
     }
 
+    if ( _multiplierIndices )
+    {
+        delete[] _multiplierIndices;
+        _multiplierIndices = NULL;
+    }
+
     if ( _basicIndexToVariable )
     {
         delete[] _basicIndexToVariable;
@@ -189,6 +218,18 @@ void Tableau::freeMemoryIfNeeded()
         _basicStatus = NULL;
     }
 
+    if ( _candidatePool )
+    {
+        delete[] _candidatePool;
+        _candidatePool = NULL;
+    }
+
+    if ( _inCandidatePool )
+    {
+        delete[] _inCandidatePool;
+        _inCandidatePool = NULL;
+    }
+
     if ( _basisFactorization )
     {
         delete _basisFactorization;
@@ -206,6 +247,18 @@ void Tableau::freeMemoryIfNeeded()
         delete[] _workN;
         _workN = NULL;
     }
+
+    if ( _aColumn )
+    {
+        delete[] _aColumn;
+        _aColumn = NULL;
+    }
+
+    if ( _aColumnIndices )
+    {
+        delete[] _aColumnIndices;
+        _aColumnIndices = NULL;
+    }
 }
 
 void Tableau::setDimensions( unsigned m, unsigned n )
@@ -239,77 +292,107 @@ void Tableau::setDimensions( unsigned m, unsigned n )
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA[i]" );
     }
 
-    _denseA = new double[m*n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseA" );
+    allocateWorkMemory();
+}
 
-    _changeColumn = new double[m];
+void Tableau::allocateWorkMemory()
+{
+    _changeColumn = new double[_m];
     if ( !_changeColumn )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::changeColumn" );
 
-    _pivotRow = new TableauRow( n-m );
+    _changeColumnIndices = new unsigned[_m];
+    if ( !_changeColumnIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::changeColumnIndices" );
+
+    _pivotRow = new TableauRow( _n - _m );
     if ( !_pivotRow )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::pivotRow" );
 
-    _b = new double[m];
+    _b = new double[_m];
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::b" );
 
-    _unitVector = new double[m];
+    _unitVector = new double[_m];
     if ( !_unitVector )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::unitVector" );
 
-    _multipliers = new double[m];
+    _multipliers = new double[_m];
     if ( !_multipliers )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::multipliers" );
 
-    _basicIndexToVariable = new unsigned[m];
+    _multiplierIndices = new unsigned[_m];
+    if ( !_multiplierIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::multiplierIndices" );
+
+    _basicIndexToVariable = new unsigned[_m];
     if ( !_basicIndexToVariable )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::basicIndexToVariable" );
 
-    _variableToIndex = new unsigned[n];
+    _variableToIndex = new unsigned[_n];
     if ( !_variableToIndex )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::variableToIndex" );
 
-    _nonBasicIndexToVariable = new unsigned[n-m];
+    _nonBasicIndexToVariable = new unsigned[_n - _m];
     if ( !_nonBasicIndexToVariable )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::nonBasicIndexToVariable" );
 
-    _nonBasicAssignment = new double[n-m];
+    _nonBasicAssignment = new double[_n - _m];
     if ( !_nonBasicAssignment )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::nonBasicAssignment" );
 
-    _lowerBounds = new double[n];
+    _lowerBounds = new double[_n];
     if ( !_lowerBounds )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::lowerBounds" );
-    std::fill_n( _lowerBounds, n, FloatUtils::negativeInfinity() );
+    std::fill_n( _lowerBounds, _n, FloatUtils::negativeInfinity() );
 
-    _upperBounds = new double[n];
+    _upperBounds = new double[_n];
     if ( !_upperBounds )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::upperBounds" );
-    std::fill_n( _upperBounds, n, FloatUtils::infinity() );
+    std::fill_n( _upperBounds, _n, FloatUtils::infinity() );
 
-    _basicAssignment = new double[m];
+    _basicAssignment = new double[_m];
     if ( !_basicAssignment )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::assignment" );
 
-    _basicStatus = new unsigned[m];
+    _basicStatus = new unsigned[_m];
     if ( !_basicStatus )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::basicStatus" );
 
+    _candidatePool = new unsigned[_n - _m];
+    if ( !_candidatePool )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::candidatePool" );
+
+    _inCandidatePool = new bool[_n - _m];
+    if ( !_inCandidatePool )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::inCandidatePool" );
+    std::fill_n( _inCandidatePool, _n - _m, false );
+    _candidatePoolSize = 0;
+    _pricingCursor = 0;
+
+    _basisFactorizationType = BasisFactorizationFactory::getBasisFactorizationType();
     _basisFactorization = BasisFactorizationFactory::createBasisFactorization( _m, *this );
     if ( !_basisFactorization )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::basisFactorization" );
     _basisFactorization->setStatistics( _statistics );
 
-    _workM = new double[m];
+    _workM = new double[_m];
     if ( !_workM )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::work" );
 
-    _workN = new double[n];
+    _workN = new double[_n];
     if ( !_workN )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::work" );
 
+    _aColumn = new double[_m];
+    if ( !_aColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::aColumn" );
+    std::fill_n( _aColumn, _m, 0.0 );
+
+    _aColumnIndices = new unsigned[_m];
+    if ( !_aColumnIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::aColumnIndices" );
+
     if ( _statistics )
         _statistics->setCurrentTableauDimension( _m, _n );
 }
@@ -319,15 +402,19 @@ void Tableau::setConstraintMatrix( const double *A )
     _A->initialize( A, _m, _n );
 
     for ( unsigned column = 0; column < _n; ++column )
+        _sparseColumnsOfA[column]->clear();
+
+    for ( unsigned row = 0; row < _m; ++row )
     {
-        for ( unsigned row = 0; row < _m; ++row )
-            _denseA[column*_m + row] = A[row*_n + column];
+        const double *denseRow = A + ( row * _n );
+        _sparseRowsOfA[row]->initialize( denseRow, _n );
 
-        _sparseColumnsOfA[column]->initialize( _denseA + ( column * _m ), _m );
+        for ( unsigned column = 0; column < _n; ++column )
+        {
+            if ( !FloatUtils::isZero( denseRow[column] ) )
+                _sparseColumnsOfA[column]->append( row, denseRow[column] );
+        }
     }
-
-    for ( unsigned row = 0; row < _m; ++row )
-        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
 }
 
 void Tableau::markAsBasic( unsigned variable )
@@ -411,7 +498,7 @@ void Tableau::computeAssignment()
     }
 
     // Solve B*xB = y by performing a forward transformation
-    _basisFactorization->forwardTransformation( _workM, _basicAssignment );
+    basisForwardTransformation( _workM, _basicAssignment );
 
     computeBasicStatus();
 
@@ -596,7 +683,7 @@ void Tableau::computeCostFunction()
 
 void Tableau::computeMultipliers( double *rowCoefficients )
 {
-    _basisFactorization->backwardTransformation( rowCoefficients, _multipliers );
+    basisBackwardTransformation( rowCoefficients, _multipliers );
 }
 
 unsigned Tableau::getBasicStatus( unsigned basic )
@@ -609,15 +696,97 @@ unsigned Tableau::getBasicStatusByIndex( unsigned basicIndex )
     return _basicStatus[basicIndex];
 }
 
-void Tableau::getEntryCandidates( List<unsigned> &candidates ) const
+void Tableau::getEntryCandidates( List<unsigned> &candidates )
 {
     candidates.clear();
     const double *costFunction = _costFunctionManager->getCostFunction();
-    for ( unsigned i = 0; i < _n - _m; ++i )
+
+    if ( !usePartialPricing() )
     {
-        if ( eligibleForEntry( i, costFunction ) )
-            candidates.append( i );
+        for ( unsigned i = 0; i < _n - _m; ++i )
+        {
+            if ( eligibleForEntry( i, costFunction ) )
+                candidates.append( i );
+        }
+        return;
     }
+
+    priceNextBlock( costFunction );
+
+    for ( unsigned i = 0; i < _candidatePoolSize; ++i )
+        candidates.append( _candidatePool[i] );
+}
+
+bool Tableau::usePartialPricing() const
+{
+    return _n - _m > GlobalConfiguration::PARTIAL_PRICING_BLOCK_SIZE;
+}
+
+void Tableau::priceNextBlock( const double *costFunction )
+{
+    // Drop pool members that are no longer eligible
+    unsigned poolSize = 0;
+    for ( unsigned i = 0; i < _candidatePoolSize; ++i )
+    {
+        unsigned nonBasic = _candidatePool[i];
+        if ( eligibleForEntry( nonBasic, costFunction ) )
+            _candidatePool[poolSize++] = nonBasic;
+        else
+            _inCandidatePool[nonBasic] = false;
+    }
+    _candidatePoolSize = poolSize;
+
+    /*
+      Price the next block. If the pool is exhausted, keep going until
+      a candidate is found, or until all non-basics have been priced;
+      so, an empty pool means that no non-basic is eligible.
+    */
+    unsigned numNonBasics = _n - _m;
+    unsigned numPriced = 0;
+    while ( numPriced < numNonBasics &&
+            ( numPriced < GlobalConfiguration::PARTIAL_PRICING_BLOCK_SIZE || _candidatePoolSize == 0 ) )
+    {
+        unsigned nonBasic = _pricingCursor;
+        ++_pricingCursor;
+        if ( _pricingCursor == numNonBasics )
+            _pricingCursor = 0;
+        ++numPriced;
+
+        if ( !_inCandidatePool[nonBasic] && eligibleForEntry( nonBasic, costFunction ) )
+            addToCandidatePool( nonBasic, costFunction );
+    }
+}
+
+void Tableau::addToCandidatePool( unsigned nonBasic, const double *costFunction )
+{
+    ASSERT( !_inCandidatePool[nonBasic] );
+
+    if ( _candidatePoolSize < GlobalConfiguration::PARTIAL_PRICING_CANDIDATE_POOL_SIZE )
+    {
+        _candidatePool[_candidatePoolSize++] = nonBasic;
+        _inCandidatePool[nonBasic] = true;
+        return;
+    }
+
+    // The pool is full, evict its weakest member
+    unsigned weakest = 0;
+    double weakestCost = FloatUtils::abs( costFunction[_candidatePool[0]] );
+    for ( unsigned i = 1; i < _candidatePoolSize; ++i )
+    {
+        double cost = FloatUtils::abs( costFunction[_candidatePool[i]] );
+        if ( cost < weakestCost )
+        {
+            weakest = i;
+            weakestCost = cost;
+        }
+    }
+
+    if ( FloatUtils::abs( costFunction[nonBasic] ) <= weakestCost )
+        return;
+
+    _inCandidatePool[_candidatePool[weakest]] = false;
+    _candidatePool[weakest] = nonBasic;
+    _inCandidatePool[nonBasic] = true;
 }
 
 void Tableau::setEnteringVariableIndex( unsigned nonBasic )
@@ -792,9 +961,11 @@ void Tableau::performPivot()
 
     // Update the basis factorization. The column corresponding to the
     // leaving variable is the one that has changed
+    unsigned aColumnNnz = scatterAColumn( currentNonBasic );
     _basisFactorization->updateToAdjacentBasis( _leavingVariable,
                                                 _changeColumn,
-                                                getAColumn( currentNonBasic ) );
+                                                _aColumn );
+    clearAColumn( aColumnNnz );
 
     if ( _statistics )
     {
@@ -834,9 +1005,11 @@ void Tableau::performDegeneratePivot()
     _variableToIndex[currentNonBasic] = _leavingVariable;
 
     // Update the basis factorization
+    unsigned aColumnNnz = scatterAColumn( currentNonBasic );
     _basisFactorization->updateToAdjacentBasis( _leavingVariable,
                                                 _changeColumn,
-                                                getAColumn( currentNonBasic ) );
+                                                _aColumn );
+    clearAColumn( aColumnNnz );
 
     // Switch assignment values. No call to notify is required,
     // because values haven't changed.
@@ -1379,11 +1552,25 @@ void Tableau::setChangeRatio( double changeRatio )
     _changeRatio = changeRatio;
 }
 
+void Tableau::setLeavingVariableIncreases( bool increases )
+{
+    _leavingVariableIncreases = increases;
+}
+
 void Tableau::computeChangeColumn()
 {
-    // Compute d = inv(B) * a using the basis factorization
-    const double *a = getAColumn( _nonBasicIndexToVariable[_enteringVariable] );
-    _basisFactorization->forwardTransformation( a, _changeColumn );
+    // Compute d = inv(B) * a using the basis factorization. Columns of
+    // A are very sparse, so this is a hyper-sparse FTRAN.
+    unsigned aColumnNnz = scatterAColumn( _nonBasicIndexToVariable[_enteringVariable] );
+
+    basisSparseForwardTransformation( _aColumn,
+                                      _aColumnIndices,
+                                      aColumnNnz,
+                                      _changeColumn,
+                                      _changeColumnIndices,
+                                      _changeColumnNnz );
+
+    clearAColumn( aColumnNnz );
 }
 
 const double *Tableau::getChangeColumn() const
@@ -1394,6 +1581,16 @@ const double *Tableau::getChangeColumn() const
 void Tableau::setChangeColumn( const double *column )
 {
     memcpy( _changeColumn, column, _m * sizeof(double) );
+
+    _changeColumnNnz = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( _changeColumn[i] != 0.0 )
+        {
+            _changeColumnIndices[_changeColumnNnz] = i;
+            ++_changeColumnNnz;
+        }
+    }
 }
 
 void Tableau::computePivotRow()
@@ -1506,17 +1703,51 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
 
     std::fill( _unitVector, _unitVector + _m, 0.0 );
     _unitVector[index] = 1;
-    computeMultipliers( _unitVector );
 
-    for ( unsigned i = 0; i < _n - _m; ++i )
+    unsigned multipliersNnz;
+    basisSparseBackwardTransformation( _unitVector,
+                                       &index,
+                                       1,
+                                       _multipliers,
+                                       _multiplierIndices,
+                                       multipliersNnz );
+
+    if ( multipliersNnz > GlobalConfiguration::HYPER_SPARSE_DENSITY_THRESHOLD * _m )
     {
-        row->_row[i]._var = _nonBasicIndexToVariable[i];
-        row->_row[i]._coefficient = 0;
+        for ( unsigned i = 0; i < _n - _m; ++i )
+        {
+            row->_row[i]._var = _nonBasicIndexToVariable[i];
+            row->_row[i]._coefficient = 0;
 
-        SparseUnsortedList *column = _sparseColumnsOfA[_nonBasicIndexToVariable[i]];
+            SparseUnsortedList *column = _sparseColumnsOfA[_nonBasicIndexToVariable[i]];
 
-        for ( const auto &entry : *column )
-            row->_row[i]._coefficient -= ( _multipliers[entry._index] * entry._value );
+            for ( const auto &entry : *column )
+                row->_row[i]._coefficient -= ( _multipliers[entry._index] * entry._value );
+        }
+    }
+    else
+    {
+        /*
+          Only a few rows of A are involved. Accumulate the combination
+          of these rows for all variables, and then pick the entries of
+          the non-basic ones.
+        */
+        std::fill_n( _workN, _n, 0.0 );
+        for ( unsigned i = 0; i < multipliersNnz; ++i )
+        {
+            double multiplier = _multipliers[_multiplierIndices[i]];
+            if ( multiplier == 0.0 )
+                continue;
+
+            for ( const auto &entry : *_sparseRowsOfA[_multiplierIndices[i]] )
+                _workN[entry._index] -= ( multiplier * entry._value );
+        }
+
+        for ( unsigned i = 0; i < _n - _m; ++i )
+        {
+            row->_row[i]._var = _nonBasicIndexToVariable[i];
+            row->_row[i]._coefficient = _workN[_nonBasicIndexToVariable[i]];
+        }
     }
 
     /*
@@ -1528,7 +1759,7 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
         row->_scalar = 0;
     else
     {
-        _basisFactorization->forwardTransformation( _b, _workM );
+        basisForwardTransformation( _b, _workM );
         row->_scalar = _workM[index];
     }
 
@@ -1540,9 +1771,22 @@ const SparseMatrix *Tableau::getSparseA() const
     return _A;
 }
 
-const double *Tableau::getAColumn( unsigned variable ) const
+unsigned Tableau::scatterAColumn( unsigned variable )
 {
-    return _denseA + ( variable * _m );
+    unsigned nnz = 0;
+    for ( const auto &entry : *_sparseColumnsOfA[variable] )
+    {
+        _aColumn[entry._index] = entry._value;
+        _aColumnIndices[nnz] = entry._index;
+        ++nnz;
+    }
+    return nnz;
+}
+
+void Tableau::clearAColumn( unsigned nnz )
+{
+    for ( unsigned i = 0; i < nnz; ++i )
+        _aColumn[_aColumnIndices[i]] = 0.0;
 }
 
 void Tableau::getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const
@@ -1580,17 +1824,37 @@ void Tableau::dumpEquations()
 }
 
 void Tableau::storeState( TableauState &state ) const
+{
+    /*
+      Without column merging, the constraint matrix only changes by
+      having rows appended to it, so an incremental state can recover
+      it by truncation and the matrix need not be copied.
+    */
+    bool storeConstraintMatrix =
+        GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS ||
+        !GlobalConfiguration::USE_INCREMENTAL_TABLEAU_STATES;
+    storeState( state, storeConstraintMatrix );
+}
+
+void Tableau::storeCompleteState( TableauState &state ) const
+{
+    storeState( state, true );
+}
+
+void Tableau::storeState( TableauState &state, bool storeConstraintMatrix ) const
 {
     // Set the dimensions
-    state.setDimensions( _m, _n, *this );
+    state.setDimensions( _m, _n, *this, storeConstraintMatrix );
 
     // Store matrix A
-    _A->storeIntoOther( state._A );
-    for ( unsigned i = 0; i < _n; ++i )
-        _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
-    for ( unsigned i = 0; i < _m; ++i )
-        _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
-    memcpy( state._denseA, _denseA, sizeof(double) * _m * _n );
+    if ( storeConstraintMatrix )
+    {
+        _A->storeIntoOther( state._A );
+        for ( unsigned i = 0; i < _n; ++i )
+            _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
+        for ( unsigned i = 0; i < _m; ++i )
+            _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
+    }
 
     // Store right hand side vector _b
     memcpy( state._b, _b, sizeof(double) * _m );
@@ -1624,19 +1888,48 @@ void Tableau::storeState( TableauState &state ) const
 
 void Tableau::restoreState( const TableauState &state )
 {
-    freeMemoryIfNeeded();
-    setDimensions( state._m, state._n );
+    if ( state._constraintMatrixStored )
+    {
+        freeMemoryIfNeeded();
+        setDimensions( state._m, state._n );
 
-    // Restore matrix A
-    state._A->storeIntoOther( _A );
-    for ( unsigned i = 0; i < _n; ++i )
-        state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
-    for ( unsigned i = 0; i < _m; ++i )
-        state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
-    memcpy( _denseA, state._denseA, sizeof(double) * _m * _n );
+        // Restore matrix A
+        state._A->storeIntoOther( _A );
+        for ( unsigned i = 0; i < _n; ++i )
+            state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
+        for ( unsigned i = 0; i < _m; ++i )
+            state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
+    }
+    else
+    {
+        /*
+          The state was stored from this tableau, before some equations
+          may have been added to it. Remove these equations and their
+          auxiliary variables.
+        */
+        if ( ( state._m > _m ) || ( state._n - state._m != _n - _m ) )
+            throw MarabouError( MarabouError::CANNOT_RESTORE_TABLEAU,
+                                "Incremental state does not match the tableau dimensions" );
+
+        freeWorkMemoryIfNeeded();
+
+        while ( _m > state._m )
+            removeLastRow();
+
+        allocateWorkMemory();
+    }
 
     // Restore right hand side vector _b
     memcpy( _b, state._b, sizeof(double) * _m );
+    _rhsIsAllZeros = true;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !FloatUtils::isZero( _b[i] ) )
+        {
+            _rhsIsAllZeros = false;
+            break;
+        }
+    }
 
     // Restore the bounds and valid status
     // TODO: should notify all the constraints.
@@ -1775,15 +2068,16 @@ unsigned Tableau::addEquation( const Equation &equation )
     for ( const auto &addend : equation._addends )
     {
         _workN[addend._variable] = addend._coefficient;
-        _sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
         _sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
-        _denseA[(addend._variable * _m) + _m - 1] = addend._coefficient;
     }
 
+    // The row is new, so its entries can be appended to the columns directly
+    for ( const auto &entry : *_sparseRowsOfA[_m - 1] )
+        _sparseColumnsOfA[entry._index]->append( _m - 1, entry._value );
+
     _workN[auxVariable] = 1;
-    _sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
-    _sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
-    _denseA[(auxVariable * _m) + _m - 1] = 1;
+    _sparseColumnsOfA[auxVariable]->append( _m - 1, 1 );
+    _sparseRowsOfA[_m - 1]->append( auxVariable, 1 );
     _A->addLastRow( _workN );
 
     // Invalidate the cost function, so that it is recomputed in the next iteration.
@@ -1830,15 +2124,43 @@ unsigned Tableau::addEquation( const Equation &equation )
     _variableToIndex[auxVariable] = _m - 1;
     _basicVariables.insert( auxVariable );
 
-    // Attempt to refactorize the basis
-    bool factorizationSuccessful = true;
-    try
+    /*
+      The new basis has the old one in its top left corner, and the
+      unit column of the auxiliary variable. Its factorization can
+      usually be obtained by extending the old one with the new row,
+      which is much cheaper than refactorizing.
+    */
+    std::fill_n( _workM, _m, 0.0 );
+    for ( const auto &entry : *_sparseRowsOfA[_m - 1] )
     {
-        _basisFactorization->obtainFreshBasis();
+        if ( _basicVariables.exists( entry._index ) )
+            _workM[_variableToIndex[entry._index]] = entry._value;
     }
-    catch ( MalformedBasisException & )
+
+    IBasisFactorization *newBasisFactorization =
+        BasisFactorizationFactory::createBasisFactorization( _m, *this );
+    if ( !newBasisFactorization )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBasisFactorization" );
+    newBasisFactorization->setStatistics( _statistics );
+
+    bool factorizationExtended =
+        newBasisFactorization->extendFactorization( _basisFactorization, _workM );
+
+    delete _basisFactorization;
+    _basisFactorization = newBasisFactorization;
+
+    // Otherwise, attempt to refactorize the basis
+    bool factorizationSuccessful = true;
+    if ( !factorizationExtended )
     {
-        factorizationSuccessful = false;
+        try
+        {
+            _basisFactorization->obtainFreshBasis();
+        }
+        catch ( MalformedBasisException & )
+        {
+            factorizationSuccessful = false;
+        }
     }
 
     if ( factorizationSuccessful )
@@ -1929,21 +2251,6 @@ void Tableau::addRow()
     delete[] _sparseRowsOfA;
     _sparseRowsOfA = newSparseRowsOfA;
 
-    // Allocate a larger _denseA, keep old entries
-    double *newDenseA = new double[newM * newN];
-    if ( !newDenseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseA" );
-
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        memcpy( newDenseA + ( column * newM ), _denseA + ( column * _m ), sizeof(double) * _m );
-        newDenseA[column*newM + newM - 1] = 0.0;
-    }
-    std::fill_n( newDenseA + ( newN - 1 ) * newM, newM, 0.0 );
-
-    delete[] _denseA;
-    _denseA = newDenseA;
-
     // Allocate a new changeColumn. Don't need to initialize
     double *newChangeColumn = new double[newM];
     if ( !newChangeColumn )
@@ -1951,6 +2258,13 @@ void Tableau::addRow()
     delete[] _changeColumn;
     _changeColumn = newChangeColumn;
 
+    unsigned *newChangeColumnIndices = new unsigned[newM];
+    if ( !newChangeColumnIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newChangeColumnIndices" );
+    delete[] _changeColumnIndices;
+    _changeColumnIndices = newChangeColumnIndices;
+    _changeColumnNnz = 0;
+
     // Allocate a new b and copy the old values
     double *newB = new double[newM];
     if ( !newB )
@@ -1974,6 +2288,12 @@ void Tableau::addRow()
     delete[] _multipliers;
     _multipliers = newMultipliers;
 
+    unsigned *newMultiplierIndices = new unsigned[newM];
+    if ( !newMultiplierIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newMultiplierIndices" );
+    delete[] _multiplierIndices;
+    _multiplierIndices = newMultiplierIndices;
+
     // Allocate new index arrays. Copy old indices, but don't assign indices to new variables yet.
     unsigned *newBasicIndexToVariable = new unsigned[newM];
     if ( !newBasicIndexToVariable )
@@ -2023,15 +2343,6 @@ void Tableau::addRow()
     _lowerBounds[_n] = FloatUtils::negativeInfinity();
     _upperBounds[_n] = FloatUtils::infinity();
 
-    // Allocate a larger basis factorization
-    IBasisFactorization *newBasisFactorization =
-        BasisFactorizationFactory::createBasisFactorization( newM, *this );
-    if ( !newBasisFactorization )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBasisFactorization" );
-    delete _basisFactorization;
-    _basisFactorization = newBasisFactorization;
-    _basisFactorization->setStatistics( _statistics );
-
     // Allocate a larger _workM and _workN. Don't need to initialize.
     double *newWorkM = new double[newM];
     if ( !newWorkM )
@@ -2045,6 +2356,19 @@ void Tableau::addRow()
     delete[] _workN;
     _workN = newWorkN;
 
+    double *newAColumn = new double[newM];
+    if ( !newAColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newAColumn" );
+    std::fill_n( newAColumn, newM, 0.0 );
+    delete[] _aColumn;
+    _aColumn = newAColumn;
+
+    unsigned *newAColumnIndices = new unsigned[newM];
+    if ( !newAColumnIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newAColumnIndices" );
+    delete[] _aColumnIndices;
+    _aColumnIndices = newAColumnIndices;
+
     _m = newM;
     _n = newN;
     _costFunctionManager->initialize();
@@ -2059,6 +2383,39 @@ void Tableau::addRow()
     }
 }
 
+void Tableau::removeLastRow()
+{
+    ASSERT( _m > 0 );
+
+    unsigned lastRow = _m - 1;
+    unsigned auxVariable = _n - 1;
+
+    // Remove the entries of the last row from the columns
+    for ( const auto &entry : *_sparseRowsOfA[lastRow] )
+    {
+        if ( entry._index != auxVariable )
+            _sparseColumnsOfA[entry._index]->set( lastRow, 0.0 );
+    }
+
+    delete _sparseRowsOfA[lastRow];
+    _sparseRowsOfA[lastRow] = NULL;
+
+    delete _sparseColumnsOfA[auxVariable];
+    _sparseColumnsOfA[auxVariable] = NULL;
+
+    for ( unsigned i = 0; i < lastRow; ++i )
+        _sparseRowsOfA[i]->decrementSize();
+
+    for ( unsigned i = 0; i < auxVariable; ++i )
+        _sparseColumnsOfA[i]->decrementSize();
+
+    _A->removeLastRow();
+    _A->removeLastColumn();
+
+    _m = lastRow;
+    _n = auxVariable;
+}
+
 void Tableau::registerToWatchVariable( VariableWatcher *watcher, unsigned variable )
 {
     _variableToWatchers[variable].append( watcher );
@@ -2122,12 +2479,22 @@ const double *Tableau::getRightHandSide() const
 
 void Tableau::forwardTransformation( const double *y, double *x ) const
 {
-    _basisFactorization->forwardTransformation( y, x );
+    basisForwardTransformation( y, x );
 }
 
 void Tableau::backwardTransformation( const double *y, double *x ) const
 {
-    _basisFactorization->backwardTransformation( y, x );
+    basisBackwardTransformation( y, x );
+}
+
+void Tableau::sparseBackwardTransformation( const double *y,
+                                            const unsigned *yIndices,
+                                            unsigned yNnz,
+                                            double *x,
+                                            unsigned *xIndices,
+                                            unsigned &xNnz ) const
+{
+    basisSparseBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
 }
 
 double Tableau::getSumOfInfeasibilities() const
@@ -2149,6 +2516,112 @@ void Tableau::setStatistics( Statistics *statistics )
     _statistics = statistics;
 }
 
+void Tableau::basisForwardTransformation( const double *y, double *x ) const
+{
+    switch ( _basisFactorizationType )
+    {
+    case GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION:
+        static_cast<SparseFTFactorization *>( _basisFactorization )->forwardTransformation( y, x );
+        break;
+
+    case GlobalConfiguration::SPARSE_LU_FACTORIZATION:
+        static_cast<SparseLUFactorization *>( _basisFactorization )->forwardTransformation( y, x );
+        break;
+
+    case GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION:
+        static_cast<ForrestTomlinFactorization *>( _basisFactorization )->forwardTransformation( y, x );
+        break;
+
+    case GlobalConfiguration::LU_FACTORIZATION:
+        static_cast<LUFactorization *>( _basisFactorization )->forwardTransformation( y, x );
+        break;
+    }
+}
+
+void Tableau::basisBackwardTransformation( const double *y, double *x ) const
+{
+    switch ( _basisFactorizationType )
+    {
+    case GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION:
+        static_cast<SparseFTFactorization *>( _basisFactorization )->backwardTransformation( y, x );
+        break;
+
+    case GlobalConfiguration::SPARSE_LU_FACTORIZATION:
+        static_cast<SparseLUFactorization *>( _basisFactorization )->backwardTransformation( y, x );
+        break;
+
+    case GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION:
+        static_cast<ForrestTomlinFactorization *>( _basisFactorization )->backwardTransformation( y, x );
+        break;
+
+    case GlobalConfiguration::LU_FACTORIZATION:
+        static_cast<LUFactorization *>( _basisFactorization )->backwardTransformation( y, x );
+        break;
+    }
+}
+
+void Tableau::basisSparseForwardTransformation( const double *y,
+                                                const unsigned *yIndices,
+                                                unsigned yNnz,
+                                                double *x,
+                                                unsigned *xIndices,
+                                                unsigned &xNnz ) const
+{
+    switch ( _basisFactorizationType )
+    {
+    case GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION:
+        static_cast<SparseFTFactorization *>( _basisFactorization )->
+            sparseForwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+
+    case GlobalConfiguration::SPARSE_LU_FACTORIZATION:
+        static_cast<SparseLUFactorization *>( _basisFactorization )->
+            sparseForwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+
+    case GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION:
+        static_cast<ForrestTomlinFactorization *>( _basisFactorization )->
+            sparseForwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+
+    case GlobalConfiguration::LU_FACTORIZATION:
+        static_cast<LUFactorization *>( _basisFactorization )->
+            sparseForwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+    }
+}
+
+void Tableau::basisSparseBackwardTransformation( const double *y,
+                                                 const unsigned *yIndices,
+                                                 unsigned yNnz,
+                                                 double *x,
+                                                 unsigned *xIndices,
+                                                 unsigned &xNnz ) const
+{
+    switch ( _basisFactorizationType )
+    {
+    case GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION:
+        static_cast<SparseFTFactorization *>( _basisFactorization )->
+            sparseBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+
+    case GlobalConfiguration::SPARSE_LU_FACTORIZATION:
+        static_cast<SparseLUFactorization *>( _basisFactorization )->
+            sparseBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+
+    case GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION:
+        static_cast<ForrestTomlinFactorization *>( _basisFactorization )->
+            sparseBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+
+    case GlobalConfiguration::LU_FACTORIZATION:
+        static_cast<LUFactorization *>( _basisFactorization )->
+            sparseBackwardTransformation( y, yIndices, yNnz, x, xIndices, xNnz );
+        break;
+    }
+}
+
 void Tableau::log( const String &message )
 {
     if ( GlobalConfiguration::TABLEAU_LOGGING )
@@ -2312,8 +2785,9 @@ void Tableau::updateAssignmentForPivot()
             nonBasicDelta = _upperBounds[nonBasic] - _nonBasicAssignment[_enteringVariable];
 
         // Update all the affected basic variables
-        for ( unsigned i = 0; i < _m; ++i )
+        for ( unsigned j = 0; j < _changeColumnNnz; ++j )
         {
+            unsigned i = _changeColumnIndices[j];
             if ( FloatUtils::isZero( _changeColumn[i] ) )
                  continue;
 
@@ -2397,7 +2871,24 @@ void Tableau::updateCostFunctionForPivot()
                                                                                _changeColumn );
 
     if ( FloatUtils::gt( normalizedError, GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD ) )
+    {
         _costFunctionManager->invalidateCostFunction();
+        return;
+    }
+
+    /*
+      The leaving variable now occupies the entering variable's
+      non-basic index, and its reduced cost has just been computed.
+      Offer it to the candidate pool, so that the pool remains current
+      without re-pricing. Pool members whose reduced costs changed are
+      re-checked when the next candidates are requested.
+    */
+    if ( usePartialPricing() && !_inCandidatePool[_enteringVariable] )
+    {
+        const double *costFunction = _costFunctionManager->getCostFunction();
+        if ( eligibleForEntry( _enteringVariable, costFunction ) )
+            addToCandidatePool( _enteringVariable, costFunction );
+    }
 }
 
 ITableau::BasicAssignmentStatus Tableau::getBasicAssignmentStatus() const
@@ -2509,11 +3000,6 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
     for ( unsigned i = 0; i < _m; ++i )
         _sparseRowsOfA[i]->mergeEntries( x2, x1 );
 
-    // And the dense ones, too
-    for ( unsigned i = 0; i < _m; ++i )
-        _denseA[x1*_m + i] += _denseA[x2*_m + i];
-    std::fill_n( _denseA + x2 * _m, _m, 0 );
-
     computeAssignment();
     computeCostFunction();
 
@@ -2536,15 +3022,16 @@ bool Tableau::areLinearlyDependent( unsigned x1, unsigned x2, double &coefficien
     unsigned nonBasic = oneIsBasic ? x2 : x1;
 
     // Find the column of the non-basic
-    const double *a = getAColumn( nonBasic );
-    _basisFactorization->forwardTransformation( a, _workM );
+    unsigned aColumnNnz = scatterAColumn( nonBasic );
+    basisForwardTransformation( _aColumn, _workM );
+    clearAColumn( aColumnNnz );
 
     // Find the correct entry in the column
     unsigned basicIndex = _variableToIndex[basic];
 
     coefficient = -_workM[basicIndex];
 
-    _basisFactorization->forwardTransformation( _b, _workM );
+    basisForwardTransformation( _b, _workM );
 
     // Coefficient is zero - independent!
     if ( FloatUtils::isZero( coefficient ) )
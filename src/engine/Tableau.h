@@ -16,6 +16,7 @@
 #ifndef __Tableau_h__
 #define __Tableau_h__
 
+#include "GlobalConfiguration.h"
 #include "IBasisFactorization.h"
 #include "ITableau.h"
 #include "MString.h"
@@ -80,6 +81,17 @@ public:
     void forwardTransformation( const double *y, double *x ) const;
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      A backward transformation for a sparse y. See
+      IBasisFactorization for the conventions.
+    */
+    void sparseBackwardTransformation( const double *y,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz,
+                                       double *x,
+                                       unsigned *xIndices,
+                                       unsigned &xNnz ) const;
+
     /*
       Mark a variable as basic in the initial basis
      */
@@ -222,6 +234,14 @@ public:
     double getChangeRatio() const;
     void setChangeRatio( double changeRatio );
 
+    /*
+      Set the direction in which the leaving variable moves. This is
+      normally determined when picking the leaving variable, but
+      needs to be set explicitly when the pivot is chosen by the dual
+      simplex method.
+    */
+    void setLeavingVariableIncreases( bool increases );
+
     /*
       Returns true iff the current iteration is a fake pivot, i.e. the
       entering variable jumping from one bound to the other.
@@ -278,7 +298,7 @@ public:
       basis, i.e. variables that can be changed in a way that would
       reduce the cost value.
     */
-    void getEntryCandidates( List<unsigned> &candidates ) const;
+    void getEntryCandidates( List<unsigned> &candidates );
 
     /*
       Compute the multipliers for a given list of row coefficient.
@@ -320,11 +340,10 @@ public:
     void getTableauRow( unsigned index, TableauRow *row );
 
     /*
-      Get the original constraint matrix A or a column thereof,
-      in dense form.
+      Get the original constraint matrix A or a column thereof. The
+      dense column is written into result, which should be of size m.
     */
     const SparseMatrix *getSparseA() const;
-    const double *getAColumn( unsigned variable ) const;
     void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const;
     void getSparseARow( unsigned row, SparseUnsortedList *result ) const;
     const SparseUnsortedList *getSparseAColumn( unsigned variable ) const;
@@ -335,7 +354,9 @@ public:
       and backtracking. The stored elements are the current:
 
       - Tableau dimensions
-      - The current matrix A
+      - The current matrix A (unless incremental states are used, in
+        which case the matrix is recovered on restoration by removing
+        any rows added since the state was stored)
       - Lower and upper bounds
       - Basic variables
       - Basic and non-basic assignments
@@ -345,6 +366,12 @@ public:
     void storeState( TableauState &state ) const;
     void restoreState( const TableauState &state );
 
+    /*
+      Store the state of the tableau, always including the constraint
+      matrix. Such a state can be restored into a different tableau.
+    */
+    void storeCompleteState( TableauState &state ) const;
+
     /*
       Register or unregister to watch a variable.
     */
@@ -464,18 +491,18 @@ private:
 
     /*
       The constraint matrix A, and a collection of its
-      sparse columns. The matrix is also stored in dense
-      form (column-major).
+      sparse columns and rows.
     */
     SparseMatrix *_A;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
 
     /*
-      Used to compute inv(B)*a
+      Used to compute inv(B)*a, and the indices of its non-zero entries
     */
     double *_changeColumn;
+    unsigned *_changeColumnIndices;
+    unsigned _changeColumnNnz;
 
     /*
       Used to store the pivot row
@@ -493,6 +520,23 @@ private:
     double *_workM;
     double *_workN;
 
+    /*
+      Work space for a dense column of A (of size m), and the indices
+      of its non-zero entries. The dense column is kept zeroed between
+      uses, so that scattering a column into it and clearing it
+      afterwards only costs the number of non-zeros.
+    */
+    double *_aColumn;
+    unsigned *_aColumnIndices;
+
+    /*
+      Scatter the column of A for the given variable into _aColumn and
+      its indices into _aColumnIndices, returning the number of
+      non-zeros; and reset those entries of _aColumn back to zero.
+    */
+    unsigned scatterAColumn( unsigned variable );
+    void clearAColumn( unsigned nnz );
+
     /*
       A unit vector of size m
     */
@@ -504,9 +548,18 @@ private:
     IBasisFactorization *_basisFactorization;
 
     /*
-      The multiplier vector
+      The concrete type of the basis factorization. The transformations
+      in the simplex hot paths are dispatched on it, so that they call
+      the (final) factorization classes directly, rather than through
+      the virtual interface.
+    */
+    GlobalConfiguration::BasisFactorizationType _basisFactorizationType;
+
+    /*
+      The multiplier vector, and the indices of its non-zero entries
     */
     double *_multipliers;
+    unsigned *_multiplierIndices;
 
     /*
       Mapping between basic variables and indices (length m)
@@ -554,6 +607,18 @@ private:
     */
     unsigned *_basicStatus;
 
+    /*
+      The pool of entry candidates used for partial pricing, and an
+      indicator of which non-basic variables are currently in it.
+      Pool members are re-checked for eligibility in every iteration,
+      and are complemented by a block of freshly priced non-basics
+      that starts at the pricing cursor.
+    */
+    unsigned *_candidatePool;
+    unsigned _candidatePoolSize;
+    bool *_inCandidatePool;
+    unsigned _pricingCursor;
+
     /*
       A non-basic variable chosen to become basic in this iteration
     */
@@ -604,15 +669,39 @@ private:
     bool _rhsIsAllZeros;
 
     /*
-      Free all allocated memory.
+      Free all allocated memory. The constraint matrix and the
+      remaining, dimension-dependent structures can also be freed
+      separately.
     */
     void freeMemoryIfNeeded();
+    void freeConstraintMatrixIfNeeded();
+    void freeWorkMemoryIfNeeded();
+
+    /*
+      Allocate the dimension-dependent structures, other than the
+      constraint matrix, according to the current _m and _n.
+    */
+    void allocateWorkMemory();
+
+    /*
+      Store the state of the tableau, with or without the constraint matrix.
+    */
+    void storeState( TableauState &state, bool storeConstraintMatrix ) const;
 
     /*
       Resize the relevant data structures to add a new row to the tableau.
     */
     void addRow();
 
+    /*
+      Remove the last row of the constraint matrix, together with the
+      column of its auxiliary variable (the last variable). This undoes
+      the changes that addEquation() makes to the constraint matrix.
+      Only the constraint matrix is adjusted, and the remaining
+      structures must be reallocated by the caller.
+    */
+    void removeLastRow();
+
     /*
       Update the variable assignment to reflect a pivot operation,
       without re-computing it from scratch.
@@ -625,6 +714,34 @@ private:
     void standardRatioTest( double *changeColumn );
     void harrisRatioTest( double *changeColumn );
 
+    /*
+      Partial pricing: refresh the candidate pool, and price the next
+      block of non-basic variables. Non-basics are added to the pool if
+      there is room, or if their reduced cost is larger than that of
+      the weakest pool member.
+    */
+    void priceNextBlock( const double *costFunction );
+    void addToCandidatePool( unsigned nonBasic, const double *costFunction );
+    bool usePartialPricing() const;
+
+    /*
+      FTRAN and BTRAN, dispatched on the concrete factorization type
+    */
+    void basisForwardTransformation( const double *y, double *x ) const;
+    void basisBackwardTransformation( const double *y, double *x ) const;
+    void basisSparseForwardTransformation( const double *y,
+                                           const unsigned *yIndices,
+                                           unsigned yNnz,
+                                           double *x,
+                                           unsigned *xIndices,
+                                           unsigned &xNnz ) const;
+    void basisSparseBackwardTransformation( const double *y,
+                                            const unsigned *yIndices,
+                                            unsigned yNnz,
+                                            double *x,
+                                            unsigned *xIndices,
+                                            unsigned &xNnz ) const;
+
     static void log( const String &message );
 
     /*
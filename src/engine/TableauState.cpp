@@ -20,10 +20,10 @@
 #include "TableauState.h"
 
 TableauState::TableauState()
-    : _A( NULL )
+    : _constraintMatrixStored( false )
+    , _A( NULL )
     , _sparseColumnsOfA( NULL )
     , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
     , _b( NULL )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
@@ -74,11 +74,6 @@ TableauState::~TableauState()
         _sparseRowsOfA = NULL;
     }
 
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
 
     if ( _b )
     {
@@ -135,41 +130,44 @@ TableauState::~TableauState()
     }
 }
 
-void TableauState::setDimensions( unsigned m, unsigned n, const IBasisFactorization::BasisColumnOracle &oracle )
+void TableauState::setDimensions( unsigned m,
+                                  unsigned n,
+                                  const IBasisFactorization::BasisColumnOracle &oracle,
+                                  bool storeConstraintMatrix )
 {
     _m = m;
     _n = n;
+    _constraintMatrixStored = storeConstraintMatrix;
 
-    _A = new CSRMatrix();
-    if ( !_A )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::A" );
+    if ( storeConstraintMatrix )
+    {
+        _A = new CSRMatrix();
+        if ( !_A )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::A" );
 
-    _sparseColumnsOfA = new SparseUnsortedList *[n];
-    if ( !_sparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA" );
+        _sparseColumnsOfA = new SparseUnsortedList *[n];
+        if ( !_sparseColumnsOfA )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA" );
 
-    for ( unsigned i = 0; i < n; ++i )
-    {
-        _sparseColumnsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseColumnsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA[i]" );
-    }
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            _sparseColumnsOfA[i] = new SparseUnsortedList;
+            if ( !_sparseColumnsOfA[i] )
+                throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA[i]" );
+        }
 
-    _sparseRowsOfA = new SparseUnsortedList *[m];
-    if ( !_sparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA" );
+        _sparseRowsOfA = new SparseUnsortedList *[m];
+        if ( !_sparseRowsOfA )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA" );
 
-    for ( unsigned i = 0; i < m; ++i )
-    {
-        _sparseRowsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseRowsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA[i]" );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            _sparseRowsOfA[i] = new SparseUnsortedList;
+            if ( !_sparseRowsOfA[i] )
+                throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA[i]" );
+        }
     }
 
-    _denseA = new double[m*n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::denseA" );
-
     _b = new double[m];
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::b" );
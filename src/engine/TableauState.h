@@ -28,7 +28,7 @@ class TableauState
       A Tableu state includes the following elements:
 
       - Tableau dimensions
-      - The matrix A
+      - The matrix A (unless the state is incremental)
       - The right hand side vector b
       - Lower and upper bounds
       - Basic variables
@@ -41,7 +41,17 @@ public:
     TableauState();
     ~TableauState();
 
-    void setDimensions( unsigned m, unsigned n, const IBasisFactorization::BasisColumnOracle &oracle );
+    /*
+      Allocate memory for a state of the given dimensions. If
+      storeConstraintMatrix is false, no memory is allocated for the
+      constraint matrix, and the state can only be restored into the
+      tableau it was stored from (or one of its descendants, obtained
+      by adding equations).
+    */
+    void setDimensions( unsigned m,
+                        unsigned n,
+                        const IBasisFactorization::BasisColumnOracle &oracle,
+                        bool storeConstraintMatrix = true );
 
     /*
       The dimensions of matrix A
@@ -50,12 +60,13 @@ public:
     unsigned _n;
 
     /*
-      The matrix
+      The matrix. These are only populated if _constraintMatrixStored
+      is true.
     */
+    bool _constraintMatrixStored;
     SparseMatrix *_A;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
 
     /*
       The right hand side
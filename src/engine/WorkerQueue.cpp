@@ -0,0 +1,165 @@
+/*********************                                                        */
+/*! \file WorkerQueue.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "MarabouError.h"
+#include "WorkerQueue.h"
+
+#include <chrono>
+
+WorkerQueue::WorkerQueue( unsigned numWorkers )
+    : _numWorkers( numWorkers )
+    , _deques( NULL )
+    , _size( 0 )
+{
+    ASSERT( _numWorkers > 0 );
+
+    _deques = new WorkerDeque[_numWorkers];
+    if ( !_deques )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "WorkerQueue::deques" );
+}
+
+WorkerQueue::~WorkerQueue()
+{
+    if ( _deques )
+    {
+        for ( unsigned i = 0; i < _numWorkers; ++i )
+        {
+            for ( auto &subQuery : _deques[i]._subQueries )
+                delete subQuery;
+        }
+
+        delete[] _deques;
+        _deques = NULL;
+    }
+}
+
+void WorkerQueue::push( unsigned workerId, SubQuery *subQuery )
+{
+    ASSERT( workerId < _numWorkers );
+
+    {
+        std::lock_guard<std::mutex> dequeLock( _deques[workerId]._mutex );
+        _deques[workerId]._subQueries.push_back( subQuery );
+
+        // Update the size under both locks: the sub-query cannot be
+        // popped before it is counted, and blocked threads cannot miss
+        // the notification
+        std::lock_guard<std::mutex> lock( _mutex );
+        ++_size;
+    }
+
+    _condition.notify_all();
+}
+
+bool WorkerQueue::pop( unsigned workerId, SubQuery *&subQuery )
+{
+    ASSERT( workerId < _numWorkers );
+
+    if ( popFromBack( workerId, subQuery ) )
+        return true;
+
+    // Steal from the other workers, starting with the next one
+    for ( unsigned i = 1; i < _numWorkers; ++i )
+    {
+        if ( popFromFront( ( workerId + i ) % _numWorkers, subQuery ) )
+            return true;
+    }
+
+    return false;
+}
+
+bool WorkerQueue::waitAndPop( unsigned workerId, SubQuery *&subQuery, const std::atomic_bool &shouldQuit )
+{
+    while ( true )
+    {
+        if ( pop( workerId, subQuery ) )
+            return true;
+
+        std::unique_lock<std::mutex> lock( _mutex );
+        _condition.wait( lock, [&]() { return _size.load() > 0 || shouldQuit.load(); } );
+
+        if ( shouldQuit.load() )
+            return false;
+    }
+}
+
+void WorkerQueue::waitForQuit( const std::atomic_bool &shouldQuit, unsigned long long timeoutInMicroSeconds )
+{
+    std::unique_lock<std::mutex> lock( _mutex );
+    auto quitRequested = [&]() { return shouldQuit.load(); };
+
+    if ( timeoutInMicroSeconds == 0 )
+        _condition.wait( lock, quitRequested );
+    else
+        _condition.wait_for( lock, std::chrono::microseconds( timeoutInMicroSeconds ), quitRequested );
+}
+
+void WorkerQueue::notifyAll()
+{
+    // Acquiring the lock ensures that a thread that has just checked
+    // its flag is already blocked, and will receive the notification
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+    }
+    _condition.notify_all();
+}
+
+unsigned WorkerQueue::getNumWorkers() const
+{
+    return _numWorkers;
+}
+
+unsigned WorkerQueue::size() const
+{
+    return _size.load();
+}
+
+bool WorkerQueue::empty() const
+{
+    return _size.load() == 0;
+}
+
+bool WorkerQueue::popFromBack( unsigned workerId, SubQuery *&subQuery )
+{
+    std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+    if ( _deques[workerId]._subQueries.empty() )
+        return false;
+
+    subQuery = _deques[workerId]._subQueries.back();
+    _deques[workerId]._subQueries.pop_back();
+    --_size;
+    return true;
+}
+
+bool WorkerQueue::popFromFront( unsigned workerId, SubQuery *&subQuery )
+{
+    std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+    if ( _deques[workerId]._subQueries.empty() )
+        return false;
+
+    subQuery = _deques[workerId]._subQueries.front();
+    _deques[workerId]._subQueries.pop_front();
+    --_size;
+    return true;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file WorkerQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __WorkerQueue_h__
+#define __WorkerQueue_h__
+
+#include "SubQuery.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/*
+  The sub-queries shared by the DnC workers. Each worker owns a deque
+  of sub-queries: it pushes and pops sub-queries at the back of its own
+  deque, so that the sub-queries created by dividing a query are
+  solved by the same worker, in depth-first order. A worker whose deque
+  is empty steals from the front of the other workers' deques, which
+  holds their oldest (and typically largest) sub-queries.
+
+  The queue also serves as the notification mechanism between the
+  workers and the DnCManager: threads that have nothing to do block on
+  it, until a sub-query is pushed or until they are notified that
+  solving is over.
+*/
+class WorkerQueue
+{
+public:
+    WorkerQueue( unsigned numWorkers );
+    ~WorkerQueue();
+
+    /*
+      Push a sub-query to the back of a worker's deque. The queue
+      takes ownership of the sub-query.
+    */
+    void push( unsigned workerId, SubQuery *subQuery );
+
+    /*
+      Pop a sub-query for the given worker, stealing one from another
+      worker if the worker's own deque is empty. Return false if all
+      deques are empty.
+    */
+    bool pop( unsigned workerId, SubQuery *&subQuery );
+
+    /*
+      Like pop(), but if all deques are empty, block until a
+      sub-query is pushed or until shouldQuit is set. Return false
+      if shouldQuit was set while blocking.
+    */
+    bool waitAndPop( unsigned workerId, SubQuery *&subQuery, const std::atomic_bool &shouldQuit );
+
+    /*
+      Block until shouldQuit is set, or until the timeout (in
+      microseconds) expires. A timeout of 0 means no timeout.
+    */
+    void waitForQuit( const std::atomic_bool &shouldQuit, unsigned long long timeoutInMicroSeconds );
+
+    /*
+      Wake up all blocked threads. Should be called after setting a
+      flag passed to waitAndPop() or waitForQuit().
+    */
+    void notifyAll();
+
+    unsigned getNumWorkers() const;
+    unsigned size() const;
+    bool empty() const;
+
+private:
+    struct WorkerDeque
+    {
+        std::mutex _mutex;
+        std::deque<SubQuery *> _subQueries;
+    };
+
+    unsigned _numWorkers;
+    WorkerDeque *_deques;
+
+    /*
+      The total number of sub-queries, across all deques
+    */
+    std::atomic_uint _size;
+
+    /*
+      Used for blocking until a change occurs
+    */
+    std::mutex _mutex;
+    std::condition_variable _condition;
+
+    bool popFromBack( unsigned workerId, SubQuery *&subQuery );
+    bool popFromFront( unsigned workerId, SubQuery *&subQuery );
+};
+
+#endif // __WorkerQueue_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -13,10 +13,12 @@
 
  **/
 
+#include "BasisFactorizationFactory.h"
 #include "DnCMarabou.h"
 #include "Error.h"
 #include "Marabou.h"
 #include "Options.h"
+#include "PortfolioMarabou.h"
 
 static std::string getCompiler() {
     std::stringstream ss;
@@ -59,8 +61,13 @@ void printHelpMessage()
     std::cout << "\t--help - Prints the help message " << std::endl;
     std::cout << "\t--version - Prints the version " << std::endl;
     std::cout << "\t--pl-aux-eq - PL constraints generate auxiliary equations" <<std::endl;
+    std::cout << "\t--basis-factorization - The basis factorization: lu, sparse-lu, ft or sparse-ft " << std::endl;
+    std::cout << "\t--entry-strategy - The entering variable rule: pse, devex, dantzig or bland (portfolio engines pick their own) " << std::endl;
+    std::cout << "\t--lp-tightening - Tighten ReLU bounds with LP relaxations before solving " << std::endl;
+    std::cout << "\t--dual-simplex - Re-solve child nodes with the dual simplex method after splits " << std::endl;
     std::cout << "\t--dnc - Use the divide-and-conquer solving mode " << std::endl;
-    std::cout << "\t--num-workers - (DNC) Number of workers " << std::endl;
+    std::cout << "\t--portfolio - Run differently configured engines in parallel " << std::endl;
+    std::cout << "\t--num-workers - (DNC/portfolio) Number of workers " << std::endl;
     std::cout << "\t--initial-divides - (DNC) Number of initial bisections over input range" << std::endl;
     std::cout << "\t--initial-timeout - (DNC) The initial timeout " << std::endl;
     std::cout << "\t--num-online-divides - (DNC) Number of further bisections after a timeout" << std::endl;
@@ -90,8 +97,14 @@ int main( int argc, char **argv )
             return 0;
         };
 
+        String basisFactorization = options->getString( Options::BASIS_FACTORIZATION );
+        if ( basisFactorization.length() > 0 )
+            BasisFactorizationFactory::setBasisFactorizationType( basisFactorization );
+
         if ( options->getBool( Options::DNC_MODE ) )
             DnCMarabou().run();
+        else if ( options->getBool( Options::PORTFOLIO_MODE ) )
+            PortfolioMarabou().run();
         else
             Marabou( options->getInt( Options::VERBOSITY ) ).run();
     }
@@ -29,6 +29,7 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        pickSplitPLConstraintCalled = false;
     }
 
     ~MockEngine()
@@ -147,10 +148,25 @@ public:
     {
     }
 
+    bool pickSplitPLConstraintCalled;
     PiecewiseLinearConstraint *pickSplitPLConstraint()
     {
+        pickSplitPLConstraintCalled = true;
         return NULL;
     }
+
+    List<PiecewiseLinearConstraint *> nextConstraintsForDivide;
+    DivideStrategy lastDivideStrategy;
+    PiecewiseLinearConstraint *pickSplitPLConstraintForDivide( DivideStrategy strategy )
+    {
+        lastDivideStrategy = strategy;
+        if ( nextConstraintsForDivide.empty() )
+            return NULL;
+
+        PiecewiseLinearConstraint *constraint = *nextConstraintsForDivide.begin();
+        nextConstraintsForDivide.erase( nextConstraintsForDivide.begin() );
+        return constraint;
+    }
 };
 
 #endif // __MockEngine_h__
@@ -69,7 +69,10 @@ public:
     void examinePivotRow() {}
     void getRowTightenings( List<Tightening> &/* tightenings */ ) const {}
     void setStatistics( Statistics */* statistics */ ) {}
+    void setNumWorkers( unsigned /* numWorkers */ ) {}
     void examineImplicitInvertedBasisMatrix( bool /* untilSaturation */ ) {}
+    void examineSparseBasisRows( const List<unsigned> &/* priorityVariables */,
+                                 bool /* untilSaturation */ ) {}
 };
 
 #endif // __MockRowBoundTightener_h__
@@ -45,6 +45,9 @@ public:
         lastCostFunctionManager = NULL;
 
         nextLinearlyDependentResult = false;
+
+        A = NULL;
+        sparseRows = NULL;
     }
 
     ~MockTableau()
@@ -78,6 +81,12 @@ public:
             delete[] nextCostFunction;
             nextCostFunction = NULL;
         }
+
+        if ( sparseRows )
+        {
+            delete[] sparseRows;
+            sparseRows = NULL;
+        }
     }
 
 	bool wasCreated;
@@ -85,7 +94,7 @@ public:
 
     List<unsigned> mockCandidates;
     unsigned mockEnteringVariable;
-    void getEntryCandidates( List<unsigned> &candidates ) const
+    void getEntryCandidates( List<unsigned> &candidates )
     {
         candidates = mockCandidates;
     }
@@ -124,6 +133,9 @@ public:
         nextCostFunction = new double[n - m];
         std::fill( nextCostFunction, nextCostFunction + ( n - m ), 0.0 );
 
+        // One list per row, so that different rows can be read concurrently
+        sparseRows = new SparseUnsortedList[m];
+
         lastBtranInput = new double[m];
         nextBtranOutput = new double[m];
     }
@@ -267,6 +279,7 @@ public:
 
     double getChangeRatio() const { return 0; }
     void setChangeRatio( double /* changeRatio */ ) {}
+    void setLeavingVariableIncreases( bool /* increases */ ) {}
 
     void performPivot() {}
     bool performingFakePivot() const
@@ -408,13 +421,6 @@ public:
     }
 
     Map<unsigned, const double *> nextAColumn;
-    const double *getAColumn( unsigned index ) const
-    {
-        TS_ASSERT( nextAColumn.exists( index ) );
-        TS_ASSERT( nextAColumn.get( index ) );
-        return nextAColumn.get( index );
-    }
-
     void getSparseAColumn( unsigned index, SparseUnsortedList *result ) const
     {
         TS_ASSERT( nextAColumn.exists( index ) );
@@ -429,6 +435,18 @@ public:
     mutable SparseUnsortedList sparseColumn;
     const SparseUnsortedList *getSparseAColumn( unsigned index ) const
     {
+        if ( !nextAColumn.exists( index ) )
+        {
+            // Fall back to the column of the dense constraint matrix
+            TS_ASSERT( A );
+            double *column = new double[lastM];
+            for ( unsigned i = 0; i < lastM; ++i )
+                column[i] = A[i * lastN + index];
+            sparseColumn.initialize( column, lastM );
+            delete[] column;
+            return &sparseColumn;
+        }
+
         TS_ASSERT( nextAColumn.get( index ) );
         sparseColumn.initialize( nextAColumn.get( index ), lastM );
         return &sparseColumn;
@@ -454,11 +472,11 @@ public:
         delete[] temp;
     }
 
-    mutable SparseUnsortedList sparseRow;
+    SparseUnsortedList *sparseRows;
     const SparseUnsortedList *getSparseARow( unsigned row ) const
     {
-        sparseRow.initialize( A + ( row * lastN ), lastN );
-        return &sparseRow;
+        sparseRows[row].initialize( A + ( row * lastN ), lastN );
+        return &sparseRows[row];
     }
 
     void performDegeneratePivot()
@@ -473,6 +491,10 @@ public:
     {
     }
 
+    void storeCompleteState( TableauState &/* state */ ) const
+    {
+    }
+
     Map<unsigned, double> tightenedLowerBounds;
     void tightenLowerBound( unsigned variable, double value )
     {
@@ -542,6 +564,19 @@ public:
         memcpy( output, nextBtranOutput, lastM * sizeof(double) );
     }
 
+    // The basis is taken to be the identity matrix
+    void sparseBackwardTransformation( const double *y,
+                                       const unsigned *yIndices,
+                                       unsigned yNnz,
+                                       double *x,
+                                       unsigned *xIndices,
+                                       unsigned &xNnz ) const
+    {
+        memcpy( x, y, lastM * sizeof(double) );
+        memcpy( xIndices, yIndices, yNnz * sizeof(unsigned) );
+        xNnz = yNnz;
+    }
+
     double getSumOfInfeasibilities() const
     {
         return 0;
@@ -1048,6 +1048,21 @@ public:
         for ( const auto &it : a )
             TS_ASSERT( b.exists( it ) );
     }
+
+    void test_serialize_and_unserialize()
+    {
+        unsigned b = 42;
+        unsigned f = 7;
+
+        AbsoluteValueConstraint originalAbs( b, f );
+        String originalSerialized = originalAbs.serializeToString();
+        AbsoluteValueConstraint recoveredAbs( originalSerialized );
+
+        TS_ASSERT_EQUALS( recoveredAbs.getB(), b );
+        TS_ASSERT_EQUALS( recoveredAbs.getF(), f );
+        TS_ASSERT_EQUALS( originalAbs.serializeToString(),
+                          recoveredAbs.serializeToString() );
+    }
 };
 
 //
@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file Test_DevexRule.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DevexRule.h"
+#include "FloatUtils.h"
+#include "MockTableau.h"
+#include "TableauRow.h"
+
+class MockForDevexRule
+{
+public:
+};
+
+class DevexRuleTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDevexRule *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDevexRule );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_variable_selection_and_weight_updates()
+    {
+        MockTableau tableau;
+        tableau.setDimensions( 2, 5 );
+
+        DevexRule devex;
+
+        // Non basics are {x0, x1, x2}, basics are {x3, x4}
+        tableau.nextNonBasicIndexToVariable[0] = 0;
+        tableau.nextNonBasicIndexToVariable[1] = 1;
+        tableau.nextNonBasicIndexToVariable[2] = 2;
+        tableau.nextBasicIndexToVariable[0] = 3;
+        tableau.nextBasicIndexToVariable[1] = 4;
+
+        TS_ASSERT_THROWS_NOTHING( devex.initialize( tableau ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( devex.getWeight( i ), 1.0 );
+
+        Set<unsigned> excluded;
+        List<unsigned> candidates = { 0, 1, 2 };
+        double costFunction[] = { -5.0, -3.0, -7.0 };
+        memcpy( tableau.nextCostFunction, costFunction, sizeof(costFunction) );
+
+        // All weights are 1, so the largest cost wins
+        TS_ASSERT( devex.select( tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 2U );
+
+        excluded.insert( 2 );
+        TS_ASSERT( devex.select( tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 0U );
+        excluded.clear();
+
+        // Fake pivots do not change the weights
+        tableau.mockLeavingVariable = 0;
+        TS_ASSERT_THROWS_NOTHING( devex.prePivotHook( tableau, true ) );
+        TS_ASSERT_THROWS_NOTHING( devex.postPivotHook( tableau, true ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( devex.getWeight( i ), 1.0 );
+
+        // A real pivot: x1 (index 1) enters, x3 (index 0) leaves
+        tableau.nextEnteringVariable = 1;
+        tableau.nextEnteringVariableIndex = 1;
+        tableau.mockLeavingVariable = 0;
+
+        double changeColumn[] = { 2, 1 };
+        tableau.nextChangeColumn = changeColumn;
+
+        TableauRow pivotRow( 3 );
+        pivotRow._row[0]._coefficient = 3;
+        pivotRow._row[1]._coefficient = 2;
+        pivotRow._row[2]._coefficient = 10;
+        tableau.nextPivotRow = &pivotRow;
+
+        // The accurate weight of x1 is 1, as x3 and x4 are not in the framework
+        TS_ASSERT_THROWS_NOTHING( devex.prePivotHook( tableau, false ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 0 ), 2.25 ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 1 ), 1.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 2 ), 25.0 ) );
+
+        TS_ASSERT_THROWS_NOTHING( devex.postPivotHook( tableau, false ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 2 ), 25.0 ) );
+
+        // The weights now affect the selection
+        TS_ASSERT( devex.select( tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau.mockEnteringVariable, 0U );
+
+        // Non basics are now {x0, x3, x2}, basics are {x1, x4}
+        tableau.nextNonBasicIndexToVariable[1] = 3;
+        tableau.nextBasicIndexToVariable[0] = 1;
+
+        // x2 (index 2) enters, x4 (index 1) leaves. The accurate
+        // weight of x2 is 1 + 1 = 2, far below its approximate weight.
+        tableau.nextEnteringVariable = 2;
+        tableau.nextEnteringVariableIndex = 2;
+        tableau.mockLeavingVariable = 1;
+
+        changeColumn[0] = 1;
+        changeColumn[1] = 1;
+
+        pivotRow._row[0]._coefficient = 0;
+        pivotRow._row[1]._coefficient = 0;
+        pivotRow._row[2]._coefficient = 1;
+
+        TS_ASSERT_THROWS_NOTHING( devex.prePivotHook( tableau, false ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 0 ), 2.25 ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 2 ), 2.0 ) );
+
+        // This triggers a reset of the reference framework
+        tableau.nextNonBasicIndexToVariable[2] = 4;
+        TS_ASSERT_THROWS_NOTHING( devex.postPivotHook( tableau, false ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( devex.getWeight( i ), 1.0 );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
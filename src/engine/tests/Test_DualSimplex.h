@@ -0,0 +1,183 @@
+/*********************                                                        */
+/*! \file Test_DualSimplex.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DualSimplex.h"
+#include "FloatUtils.h"
+#include "MockTableau.h"
+#include "TableauRow.h"
+
+class MockForDualSimplex
+{
+public:
+};
+
+class DualSimplexTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDualSimplex *mock;
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDualSimplex );
+        TS_ASSERT( tableau = new MockTableau );
+
+        tableau->setDimensions( 2, 5 );
+
+        // Non basics are {x0, x1, x2}, basics are {x3, x4}
+        tableau->nextBasicIndexToVariable[0] = 3;
+        tableau->nextBasicIndexToVariable[1] = 4;
+
+        // x3 = 5 is above its upper bound, x4 = -1 is below its lower bound
+        tableau->setLowerBound( 3, 0 );
+        tableau->setUpperBound( 3, 3 );
+        tableau->nextValues[3] = 5;
+        tableau->nextBasicTooHigh.insert( 0 );
+
+        tableau->setLowerBound( 4, 0 );
+        tableau->setUpperBound( 4, 10 );
+        tableau->nextValues[4] = -1;
+        tableau->nextBasicTooLow.insert( 1 );
+
+        // All non-basics are at their lower bounds
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            tableau->setLowerBound( i, 0 );
+            tableau->setUpperBound( i, 10 );
+            tableau->nextValues[i] = 0;
+        }
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_select_leaving_variable()
+    {
+        DualSimplex dualSimplex;
+        TS_ASSERT_THROWS_NOTHING( dualSimplex.initialize( *tableau ) );
+
+        for ( unsigned i = 0; i < 2; ++i )
+            TS_ASSERT_EQUALS( dualSimplex.getWeight( i ), 1.0 );
+
+        tableau->nextBtranOutput[0] = 2;
+        tableau->nextBtranOutput[1] = 1;
+
+        // x3 is further away from its bound
+        unsigned leaving = 2;
+        TS_ASSERT( dualSimplex.selectLeavingVariable( *tableau, leaving ) );
+        TS_ASSERT_EQUALS( leaving, 0U );
+        TS_ASSERT_EQUALS( dualSimplex.getTotalInfeasibility(), 3.0 );
+
+        // The weight of the leaving variable is recomputed from its row of inv(B)
+        TS_ASSERT_EQUALS( dualSimplex.getWeight( 0 ), 5.0 );
+        TS_ASSERT_EQUALS( dualSimplex.getWeight( 1 ), 1.0 );
+
+        // With the new weights, x4 is preferred
+        TS_ASSERT( dualSimplex.selectLeavingVariable( *tableau, leaving ) );
+        TS_ASSERT_EQUALS( leaving, 1U );
+
+        // Nothing to do when all basics are within bounds
+        tableau->nextBasicTooHigh.clear();
+        tableau->nextBasicTooLow.clear();
+        TS_ASSERT( !dualSimplex.selectLeavingVariable( *tableau, leaving ) );
+    }
+
+    void test_select_entering_variable()
+    {
+        DualSimplex dualSimplex;
+        TS_ASSERT_THROWS_NOTHING( dualSimplex.initialize( *tableau ) );
+
+        unsigned leaving;
+        TS_ASSERT( dualSimplex.selectLeavingVariable( *tableau, leaving ) );
+        TS_ASSERT_EQUALS( leaving, 0U );
+
+        // x3 = x0 - 4x1 - 0.5x2 + 5, and x3 needs to decrease by 2
+        TableauRow row( 3 );
+        row._row[0]._var = 0;
+        row._row[0]._coefficient = 1;
+        row._row[1]._var = 1;
+        row._row[1]._coefficient = -4;
+        row._row[2]._var = 2;
+        row._row[2]._coefficient = -0.5;
+        row._scalar = 5;
+        row._lhs = 3;
+
+        // x0 is at its lower bound and cannot decrease, and x1 is
+        // preferred over x2 due to its larger coefficient
+        unsigned entering = 3;
+        TS_ASSERT( dualSimplex.selectEnteringVariable( *tableau, row, entering ) );
+        TS_ASSERT_EQUALS( entering, 1U );
+        TS_ASSERT( !dualSimplex.pivotRowIsInfeasible( *tableau, row ) );
+
+        // x1 would have to exceed its upper bound
+        tableau->setUpperBound( 1, 0.25 );
+        TS_ASSERT( dualSimplex.selectEnteringVariable( *tableau, row, entering ) );
+        TS_ASSERT_EQUALS( entering, 2U );
+        TS_ASSERT( !dualSimplex.pivotRowIsInfeasible( *tableau, row ) );
+
+        // Now x3 can decrease by at most 4 * 0.25 + 0.5 * 1 = 1.5
+        tableau->setUpperBound( 2, 1 );
+        TS_ASSERT( !dualSimplex.selectEnteringVariable( *tableau, row, entering ) );
+        TS_ASSERT( dualSimplex.pivotRowIsInfeasible( *tableau, row ) );
+
+        // An unbounded variable means the row proves nothing
+        tableau->setUpperBound( 2, FloatUtils::infinity() );
+        TS_ASSERT( dualSimplex.selectEnteringVariable( *tableau, row, entering ) );
+        TS_ASSERT( !dualSimplex.pivotRowIsInfeasible( *tableau, row ) );
+    }
+
+    void test_tiny_coefficients_count_towards_feasibility()
+    {
+        DualSimplex dualSimplex;
+        TS_ASSERT_THROWS_NOTHING( dualSimplex.initialize( *tableau ) );
+
+        unsigned leaving;
+        TS_ASSERT( dualSimplex.selectLeavingVariable( *tableau, leaving ) );
+        TS_ASSERT_EQUALS( leaving, 0U );
+
+        // x3 = x0 - 0.00000000001x1 + 3.000001, and x3 needs to decrease
+        // by 2. x0 can only contribute 1.999999, and the rest has to
+        // come from the wide range of x1.
+        tableau->nextValues[0] = 1.999999;
+        tableau->setUpperBound( 1, 100000 );
+
+        TableauRow row( 2 );
+        row._row[0]._var = 0;
+        row._row[0]._coefficient = 1;
+        row._row[1]._var = 1;
+        row._row[1]._coefficient = -0.00000000001;
+        row._scalar = 3.000001;
+        row._lhs = 3;
+
+        TS_ASSERT( !dualSimplex.pivotRowIsInfeasible( *tableau, row ) );
+
+        // Without the range of x1, the row is infeasible
+        tableau->setUpperBound( 1, 0 );
+        TS_ASSERT( dualSimplex.pivotRowIsInfeasible( *tableau, row ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -181,6 +181,88 @@ public:
 
         delete inputQuery;
     }
+
+    void test_construct_symbolic_bound_tightener()
+    {
+        // x2 = 2x0 - x1 + 1, x3 = ReLU( x2 ), x4 = x3 + x0
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 5 );
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.markInputVariable( 1, 1 );
+        inputQuery.setLowerBound( 0, 0 );
+        inputQuery.setUpperBound( 0, 1 );
+        inputQuery.setLowerBound( 1, 0 );
+        inputQuery.setUpperBound( 1, 1 );
+
+        Equation equation1;
+        equation1.addAddend( 2, 0 );
+        equation1.addAddend( -1, 1 );
+        equation1.addAddend( -1, 2 );
+        equation1.setScalar( -1 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 3 );
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( -1, 4 );
+        equation2.setScalar( 0 );
+        inputQuery.addEquation( equation2 );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 3 ) );
+
+        TS_ASSERT( inputQuery.constructSymbolicBoundTightener() );
+        SymbolicBoundTightener *sbt = inputQuery._sbt;
+        TS_ASSERT( sbt );
+
+        // The weighted sum is merged into the ReLU, and the output has
+        // a residual connection to the input layer
+        SymbolicBoundTightener::NodeIndex relu = sbt->nodeIndexFromB( 2 );
+        TS_ASSERT_EQUALS( relu._layer, 1U );
+        TS_ASSERT_EQUALS( relu._neuron, 0U );
+
+        const Map<SymbolicBoundTightener::NodeIndex, unsigned> &nodeToF = sbt->getNodeIndexToFMapping();
+        TS_ASSERT_EQUALS( nodeToF.at( SymbolicBoundTightener::NodeIndex( 1, 0 ) ), 3U );
+        TS_ASSERT_EQUALS( nodeToF.at( SymbolicBoundTightener::NodeIndex( 2, 0 ) ), 4U );
+
+        // The ReLU is active, so x4 = 3x0 - x1 + 1
+        TS_ASSERT_THROWS_NOTHING( sbt->run() );
+        TS_ASSERT_DELTA( sbt->getLowerBound( 2, 0 ), 0, 0.001 );
+        TS_ASSERT_DELTA( sbt->getUpperBound( 2, 0 ), 4, 0.001 );
+    }
+
+    void test_construct_symbolic_bound_tightener_unsupported()
+    {
+        // The SBT requires the inputs to be the first variables
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 3 );
+        inputQuery.markInputVariable( 1, 0 );
+
+        Equation equation;
+        equation.addAddend( 1, 1 );
+        equation.addAddend( -1, 0 );
+        equation.setScalar( 0 );
+        inputQuery.addEquation( equation );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 0, 2 ) );
+
+        TS_ASSERT( !inputQuery.constructSymbolicBoundTightener() );
+        TS_ASSERT( !inputQuery._sbt );
+
+        // The ReLU's b variable is never defined by an equation
+        InputQuery inputQuery2;
+        inputQuery2.setNumberOfVariables( 4 );
+        inputQuery2.markInputVariable( 0, 0 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( 1, 1 );
+        equation2.addAddend( -1, 3 );
+        equation2.setScalar( 0 );
+        inputQuery2.addEquation( equation2 );
+        inputQuery2.addPiecewiseLinearConstraint( new ReluConstraint( 1, 2 ) );
+
+        TS_ASSERT( !inputQuery2.constructSymbolicBoundTightener() );
+        TS_ASSERT( !inputQuery2._sbt );
+    }
 };
 
 //
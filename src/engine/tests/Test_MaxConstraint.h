@@ -340,6 +340,61 @@ public:
         TS_ASSERT_EQUALS( it->_type, Tightening::LB );
 	}
 
+    void test_large_max_eliminates_elements()
+    {
+        // Enough elements for the flat index to hash its keys
+        unsigned f = 0;
+        Set<unsigned> elements;
+        for ( unsigned i = 1; i <= 40; ++i )
+            elements.insert( i );
+
+        MaxConstraint max( f, elements );
+
+        for ( unsigned i = 1; i <= 40; ++i )
+        {
+            max.notifyLowerBound( i, 0 );
+            max.notifyUpperBound( i, i );
+        }
+
+        TS_ASSERT( !max.phaseFixed() );
+        TS_ASSERT_EQUALS( max.getParticipatingVariables().size(), 41U );
+
+        // Elements that are bounded below 30 can no longer be the max
+        max.notifyLowerBound( 35, 30 );
+
+        TS_ASSERT_EQUALS( max.getParticipatingVariables().size(), 12U );
+        for ( unsigned i = 1; i < 30; ++i )
+            TS_ASSERT( !max.participatingVariable( i ) );
+        for ( unsigned i = 30; i <= 40; ++i )
+            TS_ASSERT( max.participatingVariable( i ) );
+        TS_ASSERT( max.participatingVariable( f ) );
+
+        // The remaining candidates are eliminated one by one
+        for ( unsigned i = 30; i <= 40; ++i )
+        {
+            if ( i != 35 )
+                max.notifyUpperBound( i, 29 );
+        }
+
+        TS_ASSERT( max.phaseFixed() );
+        TS_ASSERT_EQUALS( max.getParticipatingVariables().size(), 2U );
+
+        List<Tightening> tightenings;
+        max.notifyLowerBound( f, 31 );
+        TS_ASSERT_THROWS_NOTHING( max.getEntailedTightenings( tightenings ) );
+
+        bool foundElementLowerBound = false;
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._variable == 35 && tightening._type == Tightening::LB )
+            {
+                TS_ASSERT_EQUALS( tightening._value, 31 );
+                foundElementLowerBound = true;
+            }
+        }
+        TS_ASSERT( foundElementLowerBound );
+    }
+
 	void test_max_obsolete()
     {
 		unsigned f = 1;
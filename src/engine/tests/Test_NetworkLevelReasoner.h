@@ -206,6 +206,258 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output1[0], output2[0] ) );
         TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
     }
+
+    void test_back_substitution_relu()
+    {
+        NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        nlr.setNeuronActivationFunction( 1, 0, NetworkLevelReasoner::ReLU );
+        nlr.setNeuronActivationFunction( 1, 1, NetworkLevelReasoner::ReLU );
+        nlr.setNeuronActivationFunction( 1, 2, NetworkLevelReasoner::ReLU );
+
+        nlr.setNeuronActivationFunction( 2, 0, NetworkLevelReasoner::ReLU );
+        nlr.setNeuronActivationFunction( 2, 1, NetworkLevelReasoner::ReLU );
+
+        nlr.setWeightedSumVariable( 1, 1, 5 );
+        nlr.setActivationResultVariable( 1, 1, 6 );
+
+        // No input bounds, nothing is computed
+        TS_ASSERT_THROWS_NOTHING( nlr.clearBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+        TS_ASSERT( !FloatUtils::isFinite( nlr.getUpperBound( 3, 0 ) ) );
+
+        nlr.setInputBounds( 0, 0, 1 );
+        nlr.setInputBounds( 1, 0, 1 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        // a = relu( x + 1 ), b = relu( 2x - 3y ), c = relu( y )
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 1, 0 ), 1, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 1, 0 ), 2, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 1, 1 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 1, 1 ), 2, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 1, 2 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 1, 2 ), 1, 0.0001 ) );
+
+        List<Tightening> tightenings;
+        nlr.getConstraintTightenings( tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 4U );
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._variable == 5 && tightening._type == Tightening::LB )
+                TS_ASSERT( FloatUtils::areEqual( tightening._value, -3, 0.0001 ) );
+            if ( tightening._variable == 6 && tightening._type == Tightening::UB )
+                TS_ASSERT( FloatUtils::areEqual( tightening._value, 2, 0.0001 ) );
+        }
+
+        // The outputs are sound for every input
+        for ( unsigned i = 0; i <= 10; ++i )
+        {
+            for ( unsigned j = 0; j <= 10; ++j )
+            {
+                double input[2] = { i / 10.0, j / 10.0 };
+                double output[2];
+                nlr.evaluate( input, output );
+
+                for ( unsigned k = 0; k < 2; ++k )
+                {
+                    TS_ASSERT( FloatUtils::gte( output[k], nlr.getLowerBound( 3, k ) ) );
+                    TS_ASSERT( FloatUtils::lte( output[k], nlr.getUpperBound( 3, k ) ) );
+                }
+            }
+        }
+
+        // Known bounds are taken into account
+        nlr.clearBounds();
+        nlr.setInputBounds( 0, 0, 1 );
+        nlr.setInputBounds( 1, 0, 1 );
+        nlr.setWeightedSumBounds( 1, 1, 0, 2 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        // b's ReLU is now active, so f = 2x - 3y
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 1, 1 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 1, 1 ), 2, 0.0001 ) );
+    }
+
+    void test_back_substitution_with_fixed_inputs()
+    {
+        NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        // The inputs x and y are variables 5 and 7. x is fixed to 1,
+        // so y (renamed to variable 3) becomes input 0
+        Map<unsigned, unsigned> oldIndexToNewIndex;
+        Map<unsigned, unsigned> mergedVariables;
+        Map<unsigned, double> fixedVariableValues;
+        Map<unsigned, unsigned> inputIndexToVariable;
+
+        oldIndexToNewIndex[7] = 3;
+        fixedVariableValues[5] = 1;
+        inputIndexToVariable[0] = 5;
+        inputIndexToVariable[1] = 7;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.updateVariableIndices( oldIndexToNewIndex,
+                                                             mergedVariables,
+                                                             fixedVariableValues,
+                                                             inputIndexToVariable ) );
+
+        nlr.clearBounds();
+        nlr.setInputBounds( 0, 2, 2 );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        // Without ReLUs, the outputs for ( 1, 2 ) are ( -4, -22 )
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 3, 0 ), -4, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 3, 0 ), -4, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 3, 1 ), -22, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 3, 1 ), -22, 0.0001 ) );
+    }
+
+    void test_back_substitution_is_tighter_than_intervals()
+    {
+        NetworkLevelReasoner nlr;
+
+        /*
+              a
+          x       y
+              b
+
+          a = relu( x + 2 ), b = relu( x + 2 ), y = a - b
+        */
+        nlr.setNumberOfLayers( 3 );
+        nlr.setLayerSize( 0, 1 );
+        nlr.setLayerSize( 1, 2 );
+        nlr.setLayerSize( 2, 1 );
+        nlr.allocateWeightMatrices();
+
+        nlr.setWeight( 0, 0, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1 );
+        nlr.setWeight( 1, 0, 0, 1 );
+        nlr.setWeight( 1, 1, 0, -1 );
+
+        nlr.setBias( 1, 0, 2 );
+        nlr.setBias( 1, 1, 2 );
+
+        nlr.setNeuronActivationFunction( 1, 0, NetworkLevelReasoner::ReLU );
+        nlr.setNeuronActivationFunction( 1, 1, NetworkLevelReasoner::ReLU );
+
+        nlr.setInputBounds( 0, -1, 1 );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        // Interval arithmetic would give [-2, 2]
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 2, 0 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 2, 0 ), 0, 0.0001 ) );
+    }
+
+    void test_back_substitution_absolute_value()
+    {
+        NetworkLevelReasoner nlr;
+
+        // a = |x|, y = a - x
+        nlr.setNumberOfLayers( 3 );
+        nlr.setLayerSize( 0, 1 );
+        nlr.setLayerSize( 1, 2 );
+        nlr.setLayerSize( 2, 1 );
+        nlr.allocateWeightMatrices();
+
+        nlr.setWeight( 0, 0, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1 );
+        nlr.setWeight( 1, 0, 0, 1 );
+        nlr.setWeight( 1, 1, 0, -1 );
+
+        nlr.setNeuronActivationFunction( 1, 0, NetworkLevelReasoner::AbsoluteValue );
+
+        double input[1] = { -1 };
+        double output[1];
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 2 ) );
+
+        nlr.setInputBounds( 0, -1, 2 );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 1, 0 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 1, 0 ), 2, 0.0001 ) );
+
+        // The upper relaxation of a is x/3 + 4/3. Interval arithmetic
+        // would give an upper bound of 3.
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 2, 0 ), -2, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 2, 0 ), 2, 0.0001 ) );
+
+        // In the negative phase, the bounds are exact
+        nlr.clearBounds();
+        nlr.setInputBounds( 0, -2, -1 );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 1, 0 ), 1, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 1, 0 ), 2, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 2, 0 ), 2, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 2, 0 ), 4, 0.0001 ) );
+    }
+
+    void test_back_substitution_max()
+    {
+        NetworkLevelReasoner nlr;
+
+        /*
+          a = x1, b = x2, c = x2
+          m = max( a, b ), d = c
+          y = m - d
+        */
+        nlr.setNumberOfLayers( 4 );
+        nlr.setLayerSize( 0, 2 );
+        nlr.setLayerSize( 1, 3 );
+        nlr.setLayerSize( 2, 2 );
+        nlr.setLayerSize( 3, 1 );
+        nlr.allocateWeightMatrices();
+
+        nlr.setWeight( 0, 0, 0, 1 );
+        nlr.setWeight( 0, 1, 1, 1 );
+        nlr.setWeight( 0, 1, 2, 1 );
+        nlr.setWeight( 1, 2, 1, 1 );
+        nlr.setWeight( 2, 0, 0, 1 );
+        nlr.setWeight( 2, 1, 0, -1 );
+
+        nlr.setNeuronActivationFunction( 2, 0, NetworkLevelReasoner::Max );
+        nlr.addMaxSource( 2, 0, 0 );
+        nlr.addMaxSource( 2, 0, 1 );
+
+        double input[2] = { 3, 1 };
+        double output[1];
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 2 ) );
+
+        // b always dominates a, so m = b
+        nlr.setInputBounds( 0, 0, 1 );
+        nlr.setInputBounds( 1, 2, 3 );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 2, 0 ), 2, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 2, 0 ), 3, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 3, 0 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 3, 0 ), 0, 0.0001 ) );
+
+        // No source dominates: b <= m <= 3
+        nlr.clearBounds();
+        nlr.setInputBounds( 0, 0, 1 );
+        nlr.setInputBounds( 1, 0.5, 3 );
+        TS_ASSERT_THROWS_NOTHING( nlr.performBackSubstitution() );
+
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 2, 0 ), 0.5, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 2, 0 ), 3, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLowerBound( 3, 0 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getUpperBound( 3, 0 ), 2.5, 0.0001 ) );
+
+        // Max sources are duplicated
+        NetworkLevelReasoner nlr2;
+        TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( nlr2 ) );
+        input[0] = 1;
+        input[1] = 0.5;
+        TS_ASSERT_THROWS_NOTHING( nlr2.evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 0.5 ) );
+    }
 };
 
 //
@@ -0,0 +1,80 @@
+/*********************                                                        */
+/*! \file Test_PortfolioManager.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "EngineConfiguration.h"
+#include "GlobalConfiguration.h"
+#include "PortfolioManager.h"
+
+class PortfolioManagerTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    bool sameConfiguration( const EngineConfiguration &one, const EngineConfiguration &other )
+    {
+        return
+            one._entryStrategy == other._entryStrategy &&
+            one._splittingStrategy == other._splittingStrategy &&
+            one._constraintViolationThreshold == other._constraintViolationThreshold &&
+            one._useLinearConcretization == other._useLinearConcretization;
+    }
+
+    void test_first_configuration_is_default()
+    {
+        EngineConfiguration defaultConfiguration;
+        EngineConfiguration configuration = PortfolioManager::getConfiguration
+            ( 0, GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD );
+
+        TS_ASSERT( sameConfiguration( configuration, defaultConfiguration ) );
+    }
+
+    void test_configurations_are_distinct()
+    {
+        unsigned numConfigurations = 12;
+        for ( unsigned i = 0; i < numConfigurations; ++i )
+        {
+            EngineConfiguration one = PortfolioManager::getConfiguration( i, 20 );
+            TS_ASSERT( one._constraintViolationThreshold > 0 );
+
+            for ( unsigned j = i + 1; j < numConfigurations; ++j )
+            {
+                EngineConfiguration other = PortfolioManager::getConfiguration( j, 20 );
+                TS_ASSERT( !sameConfiguration( one, other ) );
+            }
+        }
+    }
+
+    void test_threshold_never_zero()
+    {
+        for ( unsigned i = 0; i < 12; ++i )
+            TS_ASSERT( PortfolioManager::getConfiguration( i, 0 )._constraintViolationThreshold > 0 );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
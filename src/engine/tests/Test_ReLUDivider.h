@@ -0,0 +1,143 @@
+/*********************                                                        */
+/*! \file Test_ReLUDivider.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "EngineState.h"
+#include "MStringf.h"
+#include "MockEngine.h"
+#include "ReLUDivider.h"
+#include "ReluConstraint.h"
+#include "SubQuery.h"
+
+class ReLUDividerTestSuite : public CxxTest::TestSuite
+{
+public:
+    std::shared_ptr<MockEngine> engine;
+
+    void setUp()
+    {
+        TS_ASSERT( engine = std::make_shared<MockEngine>() );
+    }
+
+    void tearDown()
+    {
+    }
+
+    bool containsTightening( const PiecewiseLinearCaseSplit &split,
+                             const Tightening &tightening )
+    {
+        for ( const auto &bound : split.getBoundTightenings() )
+            if ( bound == tightening )
+                return true;
+        return false;
+    }
+
+    void test_create_subqueries()
+    {
+        // Two ReLUs: x2 = relu( x1 ) and x4 = relu( x3 )
+        ReluConstraint relu1( 1, 2 );
+        ReluConstraint relu2( 3, 4 );
+
+        engine->nextConstraintsForDivide.append( &relu1 );
+        engine->nextConstraintsForDivide.append( &relu2 );
+        engine->nextConstraintsForDivide.append( &relu2 );
+
+        ReLUDivider divider( engine, DivideStrategy::EarliestReLU );
+
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 0, -1, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 0, 1, Tightening::UB ) );
+
+        SubQueries subQueries;
+        TS_ASSERT_THROWS_NOTHING( divider.createSubQueries( 4, "query", previousSplit,
+                                                            7, subQueries ) );
+
+        TS_ASSERT_EQUALS( engine->lastDivideStrategy, DivideStrategy::EarliestReLU );
+        TS_ASSERT( engine->nextConstraintsForDivide.empty() );
+
+        // The engine is restored after each attempted split
+        TS_ASSERT_EQUALS( engine->lastRestoredState, engine->lastStoredState );
+
+        TS_ASSERT_EQUALS( subQueries.size(), 4U );
+
+        unsigned queryIdSuffix = 1;
+        for ( const auto &subQuery : subQueries )
+        {
+            TS_ASSERT_EQUALS( subQuery->_queryId,
+                              Stringf( "query-%u", queryIdSuffix++ ) );
+            TS_ASSERT_EQUALS( subQuery->_timeoutInSeconds, 7U );
+
+            // Every sub-query keeps the previous split, and fixes both ReLUs
+            const PiecewiseLinearCaseSplit &split = *subQuery->_split;
+            TS_ASSERT( containsTightening( split, Tightening( 0, -1, Tightening::LB ) ) );
+            TS_ASSERT( containsTightening( split, Tightening( 0, 1, Tightening::UB ) ) );
+            TS_ASSERT( containsTightening( split, Tightening( 1, 0, Tightening::LB ) ) ||
+                       containsTightening( split, Tightening( 1, 0, Tightening::UB ) ) );
+            TS_ASSERT( containsTightening( split, Tightening( 3, 0, Tightening::LB ) ) ||
+                       containsTightening( split, Tightening( 3, 0, Tightening::UB ) ) );
+        }
+
+        // The four sub-queries cover the four phase combinations
+        auto it = subQueries.begin();
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 1, 0, Tightening::UB ) ) );
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 3, 0, Tightening::UB ) ) );
+        TS_ASSERT_EQUALS( (*it)->_split->getEquations().size(), 0U );
+        ++it;
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 1, 0, Tightening::UB ) ) );
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 3, 0, Tightening::LB ) ) );
+        TS_ASSERT_EQUALS( (*it)->_split->getEquations().size(), 1U );
+        ++it;
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 1, 0, Tightening::LB ) ) );
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 3, 0, Tightening::UB ) ) );
+        TS_ASSERT_EQUALS( (*it)->_split->getEquations().size(), 1U );
+        ++it;
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 1, 0, Tightening::LB ) ) );
+        TS_ASSERT( containsTightening( *(*it)->_split, Tightening( 3, 0, Tightening::LB ) ) );
+        TS_ASSERT_EQUALS( (*it)->_split->getEquations().size(), 2U );
+
+        for ( auto &subQuery : subQueries )
+            delete subQuery;
+    }
+
+    void test_all_relus_fixed()
+    {
+        // When no ReLU can be split, the previous split is kept as is
+        ReLUDivider divider( engine, DivideStrategy::ReLUViolation );
+
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 0, -1, Tightening::LB ) );
+
+        SubQueries subQueries;
+        TS_ASSERT_THROWS_NOTHING( divider.createSubQueries( 2, "", previousSplit,
+                                                            5, subQueries ) );
+
+        TS_ASSERT_EQUALS( engine->lastDivideStrategy, DivideStrategy::ReLUViolation );
+        TS_ASSERT_EQUALS( subQueries.size(), 1U );
+        TS_ASSERT_EQUALS( (*subQueries.begin())->_queryId, "1" );
+        TS_ASSERT( *(*subQueries.begin())->_split == previousSplit );
+
+        for ( auto &subQuery : subQueries )
+            delete subQuery;
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -377,6 +377,337 @@ public:
         TS_ASSERT( FloatUtils::areEqual( it->_value, 2 ) );
         TS_ASSERT_EQUALS( it->_type, Tightening::UB );
     }
+
+    void test_examine_constraint_matrix_after_notification()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 2, 5 );
+
+        tableau->setLowerBound( 0, 0 );
+        tableau->setUpperBound( 0, 3 );
+        tableau->setLowerBound( 1, -1 );
+        tableau->setUpperBound( 1, 2 );
+        tableau->setLowerBound( 2, -10 );
+        tableau->setUpperBound( 2, 10 );
+        tableau->setLowerBound( 3, 0 );
+        tableau->setUpperBound( 3, 1 );
+        tableau->setLowerBound( 4, 2 );
+        tableau->setUpperBound( 4, 2 );
+
+        tightener.setDimensions();
+
+        double A[] = {
+            1, -2, 0, 1, 2,
+            0, -2, 1, 0, 0,
+        };
+
+        double b[] = { 1, -2 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( true ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 4U );
+
+        // Saturated: nothing new to learn
+        tightenings.clear();
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( true ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT( tightenings.empty() );
+
+        /*
+          Now x1 is in [1.5, 1.6], which affects both rows:
+
+                x0 = 2x1 - 3 - x3   -->  x0 <= 0.2
+                x3 = 2x1 - 3 - x0   -->  x3 <= 0.2
+                x2 = 2x1 - 2        -->  x2 <= 1.2
+        */
+        tightener.notifyUpperBound( 1, 1.6 );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 3U );
+
+        auto it = tightenings.begin();
+
+        TS_ASSERT_EQUALS( it->_variable, 0U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 0.2 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::UB );
+
+        ++it;
+
+        TS_ASSERT_EQUALS( it->_variable, 2U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 1.2 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::UB );
+
+        ++it;
+
+        TS_ASSERT_EQUALS( it->_variable, 3U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 0.2 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::UB );
+    }
+
+    void test_examine_sparse_basis_rows()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 1, 3 );
+
+        tableau->setLowerBound( 0, 0 );
+        tableau->setUpperBound( 0, 1 );
+        tableau->setLowerBound( 1, 0 );
+        tableau->setUpperBound( 1, 1 );
+        tableau->setLowerBound( 2, -10 );
+        tableau->setUpperBound( 2, 10 );
+
+        /*
+           Equation:
+                x0 - 2x1 + x2 = 1
+
+           x2 is basic, and the basis is the identity matrix. The
+           basis row is therefore
+
+                x2 = 1 - x0 + 2x1
+
+           which gives 0 <= x2 <= 3.
+        */
+
+        tightener.setDimensions();
+
+        double A[] = { 1, -2, 1 };
+        double b[] = { 1 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        tableau->nextIsBasic.insert( 2 );
+        tableau->nextVariableToIndex[2] = 0;
+        tableau->nextBasicIndexToVariable[0] = 2;
+
+        List<unsigned> priorityVariables = { 2 };
+        TS_ASSERT_THROWS_NOTHING( tightener.examineSparseBasisRows( priorityVariables, false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+
+        auto it = tightenings.begin();
+
+        TS_ASSERT_EQUALS( it->_variable, 2U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 0 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::LB );
+
+        ++it;
+
+        TS_ASSERT_EQUALS( it->_variable, 2U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 3 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::UB );
+    }
+
+    void examineChain( unsigned numWorkers, List<Tightening> &tightenings )
+    {
+        /*
+          A chain of equations
+
+              x(i+1) - xi = 1
+
+          with x0 in [0, 1], and the other variables in [-1000, 1000].
+        */
+        const unsigned m = 300;
+        const unsigned n = m + 1;
+
+        MockTableau chainTableau;
+        chainTableau.setDimensions( m, n );
+
+        chainTableau.setLowerBound( 0, 0 );
+        chainTableau.setUpperBound( 0, 1 );
+        for ( unsigned i = 1; i < n; ++i )
+        {
+            chainTableau.setLowerBound( i, -1000 );
+            chainTableau.setUpperBound( i, 1000 );
+        }
+
+        RowBoundTightener tightener( chainTableau );
+        tightener.setNumWorkers( numWorkers );
+        tightener.setDimensions();
+
+        double *A = new double[m * n];
+        std::fill_n( A, m * n, 0 );
+        double *b = new double[m];
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            A[i * n + i] = -1;
+            A[i * n + i + 1] = 1;
+            b[i] = 1;
+        }
+
+        chainTableau.A = A;
+        chainTableau.b = b;
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( true ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+
+        delete[] A;
+        delete[] b;
+    }
+
+    void test_examine_constraint_matrix_in_parallel()
+    {
+        List<Tightening> sequential;
+        List<Tightening> twoWorkers;
+        List<Tightening> fourWorkers;
+
+        examineChain( 1, sequential );
+        examineChain( 2, twoWorkers );
+        examineChain( 4, fourWorkers );
+
+        // The results do not depend on the number of workers
+        TS_ASSERT( !twoWorkers.empty() );
+        TS_ASSERT_EQUALS( twoWorkers.size(), fourWorkers.size() );
+
+        auto two = twoWorkers.begin();
+        auto four = fourWorkers.begin();
+        while ( two != twoWorkers.end() && four != fourWorkers.end() )
+        {
+            TS_ASSERT_EQUALS( two->_variable, four->_variable );
+            TS_ASSERT_EQUALS( two->_type, four->_type );
+            TS_ASSERT_EQUALS( two->_value, four->_value );
+            ++two;
+            ++four;
+        }
+
+        // All bounds are sound, and x1 is in [1, 2] in any case
+        for ( const auto &tightenings : { sequential, twoWorkers } )
+        {
+            for ( const auto &tightening : tightenings )
+            {
+                double k = tightening._variable;
+                if ( tightening._type == Tightening::LB )
+                {
+                    TS_ASSERT( FloatUtils::lte( tightening._value, k ) );
+                }
+                else
+                {
+                    TS_ASSERT( FloatUtils::gte( tightening._value, k + 1 ) );
+                }
+
+                if ( tightening._variable == 1 )
+                {
+                    TS_ASSERT( FloatUtils::areEqual( tightening._value,
+                                                     tightening._type == Tightening::LB ? 1 : 2 ) );
+                }
+            }
+        }
+    }
+
+    void test_examine_constraint_matrix_unbounded_variable()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 1, 3 );
+
+        tableau->setLowerBound( 0, 0 );
+        tableau->setUpperBound( 0, 2 );
+        tableau->setLowerBound( 1, FloatUtils::negativeInfinity() );
+        tableau->setUpperBound( 1, FloatUtils::infinity() );
+        tableau->setLowerBound( 2, 1 );
+        tableau->setUpperBound( 2, 1 );
+
+        /*
+           Equation:
+                x0 + x1 - x2 = 0
+
+           Ranges:
+                x0: [0, 2]
+                x1: unbounded
+                x2: [1, 1]
+
+           The equation gives us that -1 <= x1 <= 1
+        */
+
+        tightener.setDimensions();
+
+        double A[] = { 1, 1, -1 };
+        double b[] = { 0 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+
+        auto it = tightenings.begin();
+
+        TS_ASSERT_EQUALS( it->_variable, 1U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, -1 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::LB );
+
+        ++it;
+
+        TS_ASSERT_EQUALS( it->_variable, 1U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 1 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::UB );
+    }
+
+    void test_examine_constraint_matrix_after_large_bound_removed()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 1, 3 );
+
+        tableau->setLowerBound( 0, 0 );
+        tableau->setUpperBound( 0, 1e16 );
+        tableau->setLowerBound( 1, 0.25 );
+        tableau->setUpperBound( 1, 0.5 );
+        tableau->setLowerBound( 2, 0 );
+        tableau->setUpperBound( 2, 1e16 );
+
+        /*
+           Equation:
+                x0 + x1 - x2 = 0
+
+           The maximal activity of x0 + x1 is 1e16 + 0.5, in which the
+           0.5 is lost to rounding. Once x0 <= 1, x2 <= 1.5; removing
+           1e16 from the activity incrementally would give x2 <= 1.
+        */
+
+        tightener.setDimensions();
+
+        double A[] = { 1, 1, -1 };
+        double b[] = { 0 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+
+        tightener.notifyUpperBound( 0, 1 );
+
+        tightenings.clear();
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+
+        bool found = false;
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._variable == 2 && tightening._type == Tightening::UB )
+            {
+                found = true;
+                TS_ASSERT( FloatUtils::areEqual( tightening._value, 1.5 ) );
+            }
+        }
+        TS_ASSERT( found );
+    }
 };
 
 //
@@ -179,6 +179,57 @@ public:
         TS_ASSERT( smtCore.needToSplit() );
     }
 
+    void test_splitting_strategy()
+    {
+        ReluConstraint constraint1( 1, 2 );
+
+        SmtCore smtCore( engine );
+        smtCore.setConstraintViolationThreshold( 2 );
+
+        // Splitting on the most violated constraint does not consult the engine
+        smtCore.setSplittingStrategy( DivideStrategy::ReLUViolation );
+        smtCore.reportViolatedConstraint( &constraint1 );
+        TS_ASSERT( !smtCore.needToSplit() );
+        smtCore.reportViolatedConstraint( &constraint1 );
+        TS_ASSERT( smtCore.needToSplit() );
+        TS_ASSERT( !engine->pickSplitPLConstraintCalled );
+
+        // Other strategies let the engine pick the constraint
+        SmtCore otherSmtCore( engine );
+        otherSmtCore.setConstraintViolationThreshold( 2 );
+        otherSmtCore.setSplittingStrategy( DivideStrategy::EarliestReLU );
+        otherSmtCore.reportViolatedConstraint( &constraint1 );
+        TS_ASSERT( !otherSmtCore.needToSplit() );
+        otherSmtCore.reportViolatedConstraint( &constraint1 );
+        TS_ASSERT( otherSmtCore.needToSplit() );
+        TS_ASSERT( engine->pickSplitPLConstraintCalled );
+    }
+
+    void test_total_violation_counts()
+    {
+        ReluConstraint constraint1( 1, 2 );
+        ReluConstraint constraint2( 3, 4 );
+
+        SmtCore smtCore( engine );
+
+        smtCore.reportViolatedConstraint( &constraint1 );
+        smtCore.reportViolatedConstraint( &constraint1 );
+        smtCore.reportViolatedConstraint( &constraint2 );
+
+        TS_ASSERT_EQUALS( smtCore.getViolationCounts( &constraint1 ), 2U );
+        TS_ASSERT_EQUALS( smtCore.getTotalViolationCounts( &constraint1 ), 2U );
+        TS_ASSERT_EQUALS( smtCore.getTotalViolationCounts( &constraint2 ), 1U );
+
+        // Resetting the reported violations does not affect the total counts
+        smtCore.resetReportedViolations();
+        smtCore.reportViolatedConstraint( &constraint2 );
+
+        TS_ASSERT_EQUALS( smtCore.getViolationCounts( &constraint1 ), 0U );
+        TS_ASSERT_EQUALS( smtCore.getViolationCounts( &constraint2 ), 1U );
+        TS_ASSERT_EQUALS( smtCore.getTotalViolationCounts( &constraint1 ), 2U );
+        TS_ASSERT_EQUALS( smtCore.getTotalViolationCounts( &constraint2 ), 2U );
+    }
+
     void test_perform_split()
     {
         SmtCore smtCore( engine );
@@ -16,9 +16,12 @@
 #include <cxxtest/TestSuite.h>
 
 #include "FloatUtils.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
 #include "SymbolicBoundTightener.h"
 
 class MockForSymbolicBoundTightener
+    : public MockErrno
 {
 public:
 };
@@ -241,6 +244,80 @@ public:
         TS_ASSERT( sbt.getUpperBound( 2, 0 ) < -5 + 0.001 );
     }
 
+    void buildReluValNetwork( SymbolicBoundTightener &sbt )
+    {
+        sbt.setNumberOfLayers( 3 );
+        sbt.setLayerSize( 0, 2 );
+        sbt.setLayerSize( 1, 2 );
+        sbt.setLayerSize( 2, 1 );
+
+        sbt.allocateWeightAndBiasSpace();
+
+        sbt.setBias( 1, 0, -15 );
+
+        sbt.setWeight( 0, 0, 0, 2 );
+        sbt.setWeight( 0, 0, 1, 1 );
+        sbt.setWeight( 0, 1, 0, 3 );
+        sbt.setWeight( 0, 1, 1, 1 );
+        sbt.setWeight( 1, 0, 0, 1 );
+        sbt.setWeight( 1, 1, 0, -1 );
+
+        sbt.setInputLowerBound( 0, 4 );
+        sbt.setInputUpperBound( 0, 6 );
+        sbt.setInputLowerBound( 1, 1 );
+        sbt.setInputUpperBound( 1, 5 );
+    }
+
+    void test_incremental_runs()
+    {
+        SymbolicBoundTightener sbt;
+        buildReluValNetwork( sbt );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), -11, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 7, 0.001 ) );
+
+        // Reporting unchanged phases keeps the previous results
+        sbt.setReluStatus( 1, 0, ReluConstraint::PHASE_NOT_FIXED );
+        sbt.setReluStatus( 1, 1, ReluConstraint::PHASE_NOT_FIXED );
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), -11, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 7, 0.001 ) );
+
+        // Fixing a phase, and then clearing it
+        sbt.setReluStatus( 1, 0, ReluConstraint::PHASE_ACTIVE );
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), -9, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 1, 0.001 ) );
+
+        sbt.clearReluStatuses();
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), -11, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 7, 0.001 ) );
+
+        // Changing an input bound and the concretization method, compared
+        // to a tightener that runs from scratch
+        sbt.setInputUpperBound( 0, 5 );
+        TS_ASSERT_THROWS_NOTHING( sbt.run( true ) );
+
+        SymbolicBoundTightener fresh;
+        buildReluValNetwork( fresh );
+        fresh.setInputUpperBound( 0, 5 );
+        TS_ASSERT_THROWS_NOTHING( fresh.run( true ) );
+
+        for ( unsigned layer = 0; layer < 3; ++layer )
+        {
+            unsigned layerSize = ( layer == 2 ) ? 1 : 2;
+            for ( unsigned neuron = 0; neuron < layerSize; ++neuron )
+            {
+                TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( layer, neuron ),
+                                                 fresh.getLowerBound( layer, neuron ) ) );
+                TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( layer, neuron ),
+                                                 fresh.getUpperBound( layer, neuron ) ) );
+            }
+        }
+    }
+
     void test_duplicate()
     {
         SymbolicBoundTightener sbt;
@@ -286,6 +363,244 @@ public:
         TS_ASSERT( sbt2.getUpperBound( 2, 0 ) < -5 + 0.001 );
     }
 
+    void test_residual_connection()
+    {
+        SymbolicBoundTightener sbt;
+
+        sbt.setNumberOfLayers( 3 );
+        sbt.setLayerSize( 0, 1 );
+        sbt.setLayerSize( 1, 1 );
+        sbt.setLayerSize( 2, 1 );
+
+        // Layer 2 receives inputs from both layer 1 and the input layer
+        sbt.addLayerDependency( 1, 2 );
+        sbt.addLayerDependency( 0, 2 );
+
+        // Dependencies must go forward
+        TS_ASSERT_THROWS_EQUALS( sbt.addLayerDependency( 2, 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT );
+
+        sbt.allocateWeightAndBiasSpace();
+
+        // x1 = relu( x0 ), x2 = x1 - x0
+        sbt.setWeight( 0, 0, 0, 1 );
+        sbt.setWeight( 1, 0, 2, 0, 1 );
+        sbt.setWeight( 0, 0, 2, 0, -1 );
+
+        // There is no layer 3
+        TS_ASSERT_THROWS_EQUALS( sbt.setWeight( 0, 0, 3, 0, 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::SYMBOLIC_BOUND_TIGHTENER_FAULTY_INPUT );
+
+        sbt.setInputLowerBound( 0, -1 );
+        sbt.setInputUpperBound( 0, 2 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        // x1 in [0, 2], and so x2 in [0 - 2, 2 + 1]
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 0, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 2, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), -2, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 3, 0.001 ) );
+    }
+
+    void test_absolute_value_layer()
+    {
+        SymbolicBoundTightener sbt;
+
+        sbt.setNumberOfLayers( 3 );
+        sbt.setLayerSize( 0, 1 );
+        sbt.setLayerSize( 1, 1 );
+        sbt.setLayerSize( 2, 1 );
+        sbt.setLayerType( 1, SymbolicBoundTightener::ABSOLUTE_VALUE );
+
+        sbt.addLayerDependency( 1, 2 );
+        sbt.addLayerDependency( 0, 2 );
+
+        sbt.allocateWeightAndBiasSpace();
+
+        // x1 = | x0 |, x2 = x1 + x0
+        sbt.setWeight( 0, 0, 0, 1 );
+        sbt.setWeight( 1, 0, 2, 0, 1 );
+        sbt.setWeight( 0, 0, 2, 0, 1 );
+
+        // Only the absolute value neuron is reported as one
+        sbt.setReluBVariable( 1, 0, 3 );
+        sbt.setReluFVariable( 1, 0, 1 );
+        sbt.setReluBVariable( 2, 0, 4 );
+        TS_ASSERT( sbt.hasAbsoluteValueNodeForB( 3 ) );
+        TS_ASSERT( !sbt.hasAbsoluteValueNodeForB( 4 ) );
+        TS_ASSERT( !sbt.hasAbsoluteValueNodeForB( 5 ) );
+
+        // x0 is negative, so x1 = -x0 and x2 = 0 symbolically
+        sbt.setInputLowerBound( 0, -3 );
+        sbt.setInputUpperBound( 0, -1 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 1, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 3, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), 0, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 0, 0.001 ) );
+
+        // x0 crosses zero, so x1 is concretized to [0, 3]
+        sbt.setInputLowerBound( 0, -3 );
+        sbt.setInputUpperBound( 0, 2 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 0, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 3, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), -3, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 5, 0.001 ) );
+
+        // A fixed phase is respected
+        sbt.setAbsoluteValueStatus( 1, 0, AbsoluteValueConstraint::PHASE_POSITIVE );
+        sbt.setInputLowerBound( 0, 0 );
+        sbt.setInputUpperBound( 0, 2 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), 0, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 4, 0.001 ) );
+    }
+
+    void test_max_layer()
+    {
+        SymbolicBoundTightener sbt;
+
+        sbt.setNumberOfLayers( 3 );
+        sbt.setLayerSize( 0, 2 );
+        sbt.setLayerSize( 1, 1 );
+        sbt.setLayerSize( 2, 1 );
+        sbt.setLayerType( 1, SymbolicBoundTightener::MAX );
+
+        sbt.addLayerDependency( 1, 2 );
+        sbt.addLayerDependency( 0, 2 );
+
+        sbt.allocateWeightAndBiasSpace();
+
+        // x2 = max( x0, x1 ), x3 = x2 - x1
+        sbt.addMaxSource( 1, 0, 0, 0 );
+        sbt.addMaxSource( 1, 0, 0, 1 );
+        sbt.setWeight( 1, 0, 2, 0, 1 );
+        sbt.setWeight( 0, 1, 2, 0, -1 );
+
+        sbt.setReluFVariable( 1, 0, 2 );
+        sbt.setReluFVariable( 2, 0, 3 );
+        TS_ASSERT( sbt.hasMaxNodeForF( 2 ) );
+        TS_ASSERT( !sbt.hasMaxNodeForF( 3 ) );
+        TS_ASSERT( !sbt.hasMaxNodeForF( 4 ) );
+
+        // x1 dominates x0, so x2 = x1 and x3 = 0 symbolically
+        sbt.setInputLowerBound( 0, 0 );
+        sbt.setInputUpperBound( 0, 1 );
+        sbt.setInputLowerBound( 1, 2 );
+        sbt.setInputUpperBound( 1, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 2, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 3, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), 0, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 0, 0.001 ) );
+
+        // No source dominates: the upper bound is concretized
+        sbt.setInputUpperBound( 0, 4 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 2, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 4, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 2, 0 ), 0, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 2, 0 ), 2, 0.001 ) );
+
+        // The topology survives duplication
+        SymbolicBoundTightener sbt2;
+        TS_ASSERT_THROWS_NOTHING( sbt.storeIntoOther( sbt2 ) );
+        TS_ASSERT_THROWS_NOTHING( sbt2.run( false ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt2.getUpperBound( 2, 0 ), 2, 0.001 ) );
+    }
+
+    void test_weights_changed_between_runs()
+    {
+        SymbolicBoundTightener sbt;
+
+        sbt.setNumberOfLayers( 2 );
+        sbt.setLayerSize( 0, 2 );
+        sbt.setLayerSize( 1, 1 );
+
+        sbt.allocateWeightAndBiasSpace();
+
+        // x2 = x0, with a zero weight for x1
+        sbt.setWeight( 0, 0, 0, 1 );
+
+        sbt.setInputLowerBound( 0, 1 );
+        sbt.setInputUpperBound( 0, 2 );
+        sbt.setInputLowerBound( 1, 3 );
+        sbt.setInputUpperBound( 1, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 1, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 2, 0.001 ) );
+
+        // x2 = x0 - x1
+        sbt.setWeight( 0, 1, 0, -1 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), -4, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), -1, 0.001 ) );
+
+        // x2 = x0 + x1: the weight of x1 changes sign
+        sbt.setWeight( 0, 1, 0, 1 );
+
+        TS_ASSERT_THROWS_NOTHING( sbt.run( false ) );
+
+        TS_ASSERT( FloatUtils::areEqual( sbt.getLowerBound( 1, 0 ), 4, 0.001 ) );
+        TS_ASSERT( FloatUtils::areEqual( sbt.getUpperBound( 1, 0 ), 7, 0.001 ) );
+    }
+
+    void test_merge_variables()
+    {
+        SymbolicBoundTightener sbt;
+        buildReluValNetwork( sbt );
+
+        sbt.setReluBVariable( 1, 0, 2 );
+        sbt.setReluFVariable( 1, 0, 3 );
+        sbt.setReluBVariable( 1, 1, 4 );
+        sbt.setReluFVariable( 1, 1, 5 );
+        sbt.setReluFVariable( 2, 0, 6 );
+
+        // b variables are looked up under their new indices
+        sbt.mergeVariables( 2, 7 );
+        TS_ASSERT( !sbt.hasNodeIndexForB( 2 ) );
+        TS_ASSERT( sbt.hasNodeIndexForB( 7 ) );
+        TS_ASSERT_EQUALS( sbt.nodeIndexFromB( 7 )._layer, 1U );
+        TS_ASSERT_EQUALS( sbt.nodeIndexFromB( 7 )._neuron, 0U );
+
+        sbt.mergeVariables( 6, 8 );
+        TS_ASSERT_EQUALS( sbt.getNodeIndexToFMapping().at( SymbolicBoundTightener::NodeIndex( 2, 0 ) ), 8U );
+
+        // Later index updates see the merged variables
+        Map<unsigned, unsigned> oldIndexToNewIndex;
+        for ( unsigned i = 0; i < 9; ++i )
+            oldIndexToNewIndex[i] = i;
+        Map<unsigned, unsigned> mergedVariables;
+        mergedVariables[2] = 7;
+        mergedVariables[6] = 8;
+        Map<unsigned, double> fixedVariableValues;
+
+        TS_ASSERT_THROWS_NOTHING( sbt.updateVariableIndices( oldIndexToNewIndex, mergedVariables, fixedVariableValues ) );
+        TS_ASSERT_EQUALS( sbt.nodeIndexFromB( 7 )._neuron, 0U );
+        TS_ASSERT_EQUALS( sbt.nodeIndexFromB( 4 )._neuron, 1U );
+        TS_ASSERT_EQUALS( sbt.getNodeIndexToFMapping().at( SymbolicBoundTightener::NodeIndex( 2, 0 ) ), 8U );
+    }
+
     void test_todo()
     {
         TS_TRACE( "TODO: add a test for linear concretizations" );
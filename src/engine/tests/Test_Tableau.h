@@ -16,6 +16,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "BasisFactorizationError.h"
+#include "BasisFactorizationFactory.h"
 #include "Equation.h"
 #include "MockCostFunctionManager.h"
 #include "MockErrno.h"
@@ -27,6 +29,7 @@
 #include <string.h>
 
 class MockForTableau
+    : public MockErrno
 {
 public:
 };
@@ -68,7 +71,7 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete mock );
     }
 
-    bool hasCandidates( const ITableau &tableau ) const
+    bool hasCandidates( ITableau &tableau ) const
     {
         List<unsigned> candidates;
         tableau.getEntryCandidates( candidates );
@@ -171,6 +174,62 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_factorization_types()
+    {
+        GlobalConfiguration::BasisFactorizationType types[] = {
+            GlobalConfiguration::LU_FACTORIZATION,
+            GlobalConfiguration::SPARSE_LU_FACTORIZATION,
+            GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION,
+            GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION,
+        };
+
+        for ( const auto &type : types )
+        {
+            BasisFactorizationFactory::setBasisFactorizationType( type );
+
+            Tableau *tableau = NULL;
+            MockCostFunctionManager costFunctionManager;
+
+            TS_ASSERT( tableau = new Tableau );
+
+            TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+            tableau->registerCostFunctionManager( &costFunctionManager );
+            initializeTableauValues( *tableau );
+
+            for ( unsigned i = 0; i < 7; ++i )
+            {
+                TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+                TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 500 ) );
+            }
+
+            List<unsigned> basics = { 4, 5, 6 };
+            TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+            TS_ASSERT_EQUALS( tableau->getValue( 4 ), 217.0 );
+            TS_ASSERT_EQUALS( tableau->getValue( 5 ), 113.0 );
+            TS_ASSERT_EQUALS( tableau->getValue( 6 ), 406.0 );
+
+            // x6 = 117 - x1 - x2 - x3 - x4
+            TableauRow row( 4 );
+            TS_ASSERT_THROWS_NOTHING( tableau->getTableauRow( 1, &row ) );
+            for ( unsigned i = 0; i < 4; ++i )
+            {
+                TS_ASSERT_EQUALS( row._row[i]._var, i );
+                TS_ASSERT( FloatUtils::areEqual( row._row[i]._coefficient, -1 ) );
+            }
+            TS_ASSERT( FloatUtils::areEqual( row._scalar, 117 ) );
+
+            TS_ASSERT_THROWS_NOTHING( delete tableau );
+        }
+
+        BasisFactorizationFactory::setBasisFactorizationType( GlobalConfiguration::BASIS_FACTORIZATION_TYPE );
+
+        TS_ASSERT_THROWS_EQUALS( BasisFactorizationFactory::setBasisFactorizationType( "qr" ),
+                                 const BasisFactorizationError &e,
+                                 e.getCode(),
+                                 BasisFactorizationError::UNKNOWN_BASIS_FACTORIZATION_TYPE );
+    }
+
     void test_watcher__value_changes()
     {
         Tableau *tableau = NULL;
@@ -331,6 +390,62 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_partial_pricing()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        // Enough non-basics to trigger partial pricing: x0 + ... + x{n-2} + x{n-1} = 0
+        unsigned numNonBasics = GlobalConfiguration::PARTIAL_PRICING_BLOCK_SIZE + 1;
+        unsigned n = numNonBasics + 1;
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 1, n ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+
+        double *A = new double[n];
+        std::fill_n( A, n, 1.0 );
+        tableau->setConstraintMatrix( A );
+        delete[] A;
+
+        double b[1] = { 0 };
+        tableau->setRightHandSide( b );
+
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 0 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, n ) );
+        }
+
+        List<unsigned> basics = { n - 1 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // All non-basics are at their lower bounds, and can increase
+        costFunctionManager.nextCostFunction = new double[numNonBasics];
+        std::fill_n( costFunctionManager.nextCostFunction, numNonBasics, -1.0 );
+        costFunctionManager.nextCostFunction[700] = -5;
+
+        // Only a pool of candidates is offered, and strong ones are kept
+        List<unsigned> candidates;
+        TS_ASSERT_THROWS_NOTHING( tableau->getEntryCandidates( candidates ) );
+        TS_ASSERT_EQUALS( candidates.size(), GlobalConfiguration::PARTIAL_PRICING_CANDIDATE_POOL_SIZE );
+        TS_ASSERT( candidates.exists( 700 ) );
+
+        // Pool members that become ineligible are dropped, and the pool is refilled
+        std::fill_n( costFunctionManager.nextCostFunction, numNonBasics, 1.0 );
+        costFunctionManager.nextCostFunction[3] = -1;
+        TS_ASSERT_THROWS_NOTHING( tableau->getEntryCandidates( candidates ) );
+        TS_ASSERT_EQUALS( candidates.size(), 1U );
+        TS_ASSERT_EQUALS( *candidates.begin(), 3U );
+
+        // Once nothing is eligible, all non-basics are priced before giving up
+        costFunctionManager.nextCostFunction[3] = 1;
+        TS_ASSERT_THROWS_NOTHING( tableau->getEntryCandidates( candidates ) );
+        TS_ASSERT( candidates.empty() );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_get_get_leaving_variable()
     {
         Tableau *tableau = NULL;
@@ -1279,6 +1394,107 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_store_and_restore_after_add_equation()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // Store the tableau
+        TableauState *tableauState = NULL;
+        TS_ASSERT( tableauState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState( *tableauState ) );
+
+        double originalA[21];
+        double originalValues[7];
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            tableau->getSparseAColumn( i )->toDense( originalA + ( i * 3 ) );
+            originalValues[i] = tableau->getValue( i );
+        }
+
+        // Add two equations: 2x2 - 4x3 + x8 = 5 and x1 + x9 = 3
+        Equation equation1;
+        equation1.addAddend( 2, 1 );
+        equation1.addAddend( -4, 2 );
+        equation1.setScalar( 5 );
+        TS_ASSERT_THROWS_NOTHING( tableau->addEquation( equation1 ) );
+
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.setScalar( 3 );
+        TS_ASSERT_THROWS_NOTHING( tableau->addEquation( equation2 ) );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 5U );
+        TS_ASSERT_EQUALS( tableau->getN(), 9U );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 0, 5 ) );
+
+        // Restore the tableau, which should remove the new rows
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState( *tableauState ) );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 3U );
+        TS_ASSERT_EQUALS( tableau->getN(), 7U );
+
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            double column[3];
+            tableau->getSparseAColumn( i )->toDense( column );
+            for ( unsigned j = 0; j < 3; ++j )
+                TS_ASSERT_EQUALS( column[j], originalA[i * 3 + j] );
+
+            TS_ASSERT_EQUALS( tableau->getSparseAColumn( i )->getSize(), 3U );
+        }
+
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            TS_ASSERT_EQUALS( tableau->getSparseARow( i )->getSize(), 7U );
+            for ( const auto &entry : *tableau->getSparseARow( i ) )
+                TS_ASSERT( entry._index < 7 );
+        }
+
+        TS_ASSERT_EQUALS( tableau->getSparseA()->getNnz(), 15U );
+
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 0 ), 10.0 );
+        TS_ASSERT( tableau->isBasic( 4u ) );
+        TS_ASSERT( tableau->isBasic( 5u ) );
+        TS_ASSERT( tableau->isBasic( 6u ) );
+
+        for ( unsigned i = 0; i < 7; ++i )
+            TS_ASSERT_EQUALS( tableau->getValue( i ), originalValues[i] );
+
+        // The tableau can grow again after being restored
+        TS_ASSERT_THROWS_NOTHING( tableau->addEquation( equation1 ) );
+        TS_ASSERT_EQUALS( tableau->getM(), 4U );
+        TS_ASSERT_EQUALS( tableau->getN(), 8U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableauState );
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_tighten_bounds()
     {
         Tableau *tableau = NULL;
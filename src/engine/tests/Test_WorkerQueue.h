@@ -0,0 +1,142 @@
+/*********************                                                        */
+/*! \file Test_WorkerQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "WorkerQueue.h"
+
+#include <atomic>
+#include <thread>
+
+class WorkerQueueTestSuite : public CxxTest::TestSuite
+{
+public:
+    SubQuery *createSubQuery( const String &queryId )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_timeoutInSeconds = 0;
+        return subQuery;
+    }
+
+    void test_push_and_pop_own_deque()
+    {
+        WorkerQueue queue( 2 );
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT_EQUALS( queue.getNumWorkers(), 2U );
+
+        queue.push( 0, createSubQuery( "1" ) );
+        queue.push( 0, createSubQuery( "2" ) );
+        queue.push( 0, createSubQuery( "3" ) );
+
+        TS_ASSERT( !queue.empty() );
+        TS_ASSERT_EQUALS( queue.size(), 3U );
+
+        // A worker pops its most recent sub-query first
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "3" );
+        delete subQuery;
+
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "2" );
+        delete subQuery;
+
+        TS_ASSERT_EQUALS( queue.size(), 1U );
+    }
+
+    void test_steal()
+    {
+        WorkerQueue queue( 3 );
+
+        queue.push( 1, createSubQuery( "1" ) );
+        queue.push( 1, createSubQuery( "2" ) );
+        queue.push( 2, createSubQuery( "3" ) );
+
+        // Worker 0 has no sub-queries, and steals the oldest sub-query of
+        // the next worker
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1" );
+        delete subQuery;
+
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "2" );
+        delete subQuery;
+
+        TS_ASSERT( queue.pop( 0, subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "3" );
+        delete subQuery;
+
+        TS_ASSERT( !queue.pop( 0, subQuery ) );
+        TS_ASSERT( !queue.pop( 1, subQuery ) );
+        TS_ASSERT( queue.empty() );
+    }
+
+    void test_wait_and_pop()
+    {
+        WorkerQueue queue( 2 );
+        std::atomic_bool shouldQuit( false );
+
+        // A sub-query is pushed by another thread while waiting
+        std::thread pusher( [&]() { queue.push( 1, createSubQuery( "1" ) ); } );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.waitAndPop( 0, subQuery, shouldQuit ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1" );
+        delete subQuery;
+
+        pusher.join();
+
+        // Quitting releases the waiting thread
+        std::thread quitter( [&]() {
+                shouldQuit = true;
+                queue.notifyAll();
+            } );
+
+        TS_ASSERT( !queue.waitAndPop( 0, subQuery, shouldQuit ) );
+
+        quitter.join();
+
+        queue.waitForQuit( shouldQuit, 0 );
+    }
+
+    void test_wait_for_quit_timeout()
+    {
+        WorkerQueue queue( 1 );
+        std::atomic_bool shouldQuit( false );
+
+        TS_ASSERT_THROWS_NOTHING( queue.waitForQuit( shouldQuit, 1000 ) );
+        TS_ASSERT( !shouldQuit.load() );
+    }
+
+    void test_remaining_sub_queries_are_deleted()
+    {
+        WorkerQueue *queue = new WorkerQueue( 2 );
+
+        queue->push( 0, createSubQuery( "1" ) );
+        queue->push( 1, createSubQuery( "2" ) );
+
+        TS_ASSERT_THROWS_NOTHING( delete queue );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -14,6 +14,7 @@
  ** [[ Add lengthier description here ]]
  **/
 
+#include "AbsoluteValueConstraint.h"
 #include "AutoFile.h"
 #include "Debug.h"
 #include "Equation.h"
@@ -209,6 +210,10 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
         {
             constraint = new MaxConstraint( serializeConstraint );
         }
+        else if ( coType == "absoluteValue" )
+        {
+            constraint = new AbsoluteValueConstraint( serializeConstraint );
+        }
         else
         {
             throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_CONSTRAINT, Stringf( "Unsupported piecewise constraint: %s\n", coType.ascii() ).ascii() );
@@ -218,6 +223,11 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
         inputQuery.addPiecewiseLinearConstraint( constraint );
     }
 
+    // The file does not describe the network, so recover its topology
+    // for symbolic bound tightening
+    if ( inputQuery.constructSymbolicBoundTightener() )
+        log( "Constructed a symbolic bound tightener\n" );
+
     return inputQuery;
 }
 
@@ -15,9 +15,11 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "AbsoluteValueConstraint.h"
 #include "AutoFile.h"
 #include "Equation.h"
 #include "InputQuery.h"
+#include "MaxConstraint.h"
 #include "MockFileFactory.h"
 #include "QueryLoader.h"
 #include "T/unistd.h"
@@ -128,6 +130,83 @@ public:
         // Constraints unchanged
         TS_ASSERT( inputQuery.getPiecewiseLinearConstraints() == inputQuery.getPiecewiseLinearConstraints() );
     }
+
+    void build_max_and_absolute_value_query( InputQuery &inputQuery )
+    {
+        // x3 = | x0 + x1 |, x5 = ReLU( x0 - x1 ), x6 = max( x3, x5 ),
+        // and the output x7 = x6 + x0 has a residual connection
+        inputQuery.setNumberOfVariables( 8 );
+
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.markInputVariable( 1, 1 );
+        inputQuery.setLowerBound( 0, -1 );
+        inputQuery.setUpperBound( 0, 1 );
+        inputQuery.setLowerBound( 1, -1 );
+        inputQuery.setUpperBound( 1, 1 );
+
+        inputQuery.markOutputVariable( 7, 0 );
+
+        Equation equation0;
+        equation0.addAddend( 1, 0 );
+        equation0.addAddend( 1, 1 );
+        equation0.addAddend( -1, 2 );
+        equation0.setScalar( 0 );
+        inputQuery.addEquation( equation0 );
+
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( -1, 1 );
+        equation1.addAddend( -1, 4 );
+        equation1.setScalar( 0 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 6 );
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( -1, 7 );
+        equation2.setScalar( 0 );
+        inputQuery.addEquation( equation2 );
+
+        inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( 2, 3 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 4, 5 ) );
+        inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( 6, Set<unsigned>( { 3, 5 } ) ) );
+    }
+
+    void test_load_query_constructs_symbolic_bound_tightener()
+    {
+        InputQuery inputQuery;
+        build_max_and_absolute_value_query( inputQuery );
+        inputQuery.saveQuery( QUERY_TEST_FILE );
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+
+        InputQuery inputQuery2 = QueryLoader::loadQuery( QUERY_TEST_FILE );
+        TS_ASSERT_EQUALS( inputQuery2.getPiecewiseLinearConstraints().size(), 3U );
+
+        SymbolicBoundTightener *sbt = inputQuery2._sbt;
+        TS_ASSERT( sbt );
+        TS_ASSERT( sbt->hasAbsoluteValueNodeForB( 2 ) );
+        TS_ASSERT( sbt->hasMaxNodeForF( 6 ) );
+
+        TS_ASSERT_THROWS_NOTHING( sbt->run() );
+
+        Map<unsigned, SymbolicBoundTightener::NodeIndex> variableToNode;
+        for ( const auto &pair : sbt->getNodeIndexToFMapping() )
+            variableToNode[pair.second] = pair.first;
+
+        SymbolicBoundTightener::NodeIndex abs = variableToNode[3];
+        TS_ASSERT_DELTA( sbt->getLowerBound( abs._layer, abs._neuron ), 0, 0.001 );
+        TS_ASSERT_DELTA( sbt->getUpperBound( abs._layer, abs._neuron ), 2, 0.001 );
+
+        SymbolicBoundTightener::NodeIndex max = variableToNode[6];
+        TS_ASSERT_DELTA( sbt->getLowerBound( max._layer, max._neuron ), 0, 0.001 );
+        TS_ASSERT_DELTA( sbt->getUpperBound( max._layer, max._neuron ), 2, 0.001 );
+
+        SymbolicBoundTightener::NodeIndex output = variableToNode[7];
+        TS_ASSERT_DELTA( sbt->getLowerBound( output._layer, output._neuron ), -1, 0.001 );
+        TS_ASSERT_DELTA( sbt->getUpperBound( output._layer, output._neuron ), 3, 0.001 );
+    }
 };
 
 //
@@ -0,0 +1,179 @@
+/*********************                                                        */
+/*! \file Test_LPBoundTightener.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "LPBoundTightener.h"
+#include "NetworkLevelReasoner.h"
+#include "ReluConstraint.h"
+
+class LPBoundTightenerTestSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void populateQuery( InputQuery &query )
+    {
+        /*
+          x0 and x1 are the inputs, in [-1, 1]
+
+            b2 = x0 + x1       f4 = relu( b2 )
+            b3 = x0 - x1       f5 = relu( b3 )
+
+            b6 = f4 + f5 - 1   f7 = relu( b6 )
+
+          Interval arithmetic gives b6 <= 3. The triangle relaxation
+          gives f4 + f5 <= x0 + 2, and so b6 <= 2. The actual maximum
+          is 1.
+        */
+        query.setNumberOfVariables( 8 );
+
+        query.setLowerBound( 0, -1 );
+        query.setUpperBound( 0, 1 );
+        query.setLowerBound( 1, -1 );
+        query.setUpperBound( 1, 1 );
+
+        query.setLowerBound( 2, -2 );
+        query.setUpperBound( 2, 2 );
+        query.setLowerBound( 3, -2 );
+        query.setUpperBound( 3, 2 );
+        query.setLowerBound( 4, 0 );
+        query.setUpperBound( 4, 2 );
+        query.setLowerBound( 5, 0 );
+        query.setUpperBound( 5, 2 );
+
+        query.setLowerBound( 6, -1 );
+        query.setUpperBound( 6, 3 );
+        query.setLowerBound( 7, 0 );
+        query.setUpperBound( 7, 3 );
+
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( 1, 1 );
+        equation1.addAddend( -1, 2 );
+        equation1.setScalar( 0 );
+        query.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( -1, 1 );
+        equation2.addAddend( -1, 3 );
+        equation2.setScalar( 0 );
+        query.addEquation( equation2 );
+
+        Equation equation3;
+        equation3.addAddend( 1, 4 );
+        equation3.addAddend( 1, 5 );
+        equation3.addAddend( -1, 6 );
+        equation3.setScalar( 1 );
+        query.addEquation( equation3 );
+
+        query.addPiecewiseLinearConstraint( new ReluConstraint( 2, 4 ) );
+        query.addPiecewiseLinearConstraint( new ReluConstraint( 3, 5 ) );
+        query.addPiecewiseLinearConstraint( new ReluConstraint( 6, 7 ) );
+
+        NetworkLevelReasoner *nlr = new NetworkLevelReasoner;
+        nlr->setNumberOfLayers( 3 );
+        nlr->setLayerSize( 0, 2 );
+        nlr->setLayerSize( 1, 2 );
+        nlr->setLayerSize( 2, 1 );
+        nlr->allocateWeightMatrices();
+
+        nlr->setWeightedSumVariable( 1, 0, 2 );
+        nlr->setWeightedSumVariable( 1, 1, 3 );
+        nlr->setActivationResultVariable( 1, 0, 4 );
+        nlr->setActivationResultVariable( 1, 1, 5 );
+        nlr->setWeightedSumVariable( 2, 0, 6 );
+        nlr->setActivationResultVariable( 2, 0, 7 );
+
+        query.setNetworkLevelReasoner( nlr );
+    }
+
+    void test_tighten()
+    {
+        InputQuery query;
+        populateQuery( query );
+
+        LPBoundTightener tightener( 1 );
+        TS_ASSERT( tightener.tighten( query ) );
+        TS_ASSERT( tightener.getNumTightenedBounds() > 0 );
+
+        // The first layer is linear in the inputs, so nothing changes
+        TS_ASSERT( FloatUtils::areEqual( query.getLowerBound( 2 ), -2 ) );
+        TS_ASSERT( FloatUtils::areEqual( query.getUpperBound( 2 ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( query.getLowerBound( 3 ), -2 ) );
+        TS_ASSERT( FloatUtils::areEqual( query.getUpperBound( 3 ), 2 ) );
+
+        // The lower bound of b6 is tight, the upper bound approaches
+        // the optimum of the relaxation, 2, from above
+        TS_ASSERT( FloatUtils::areEqual( query.getLowerBound( 6 ), -1 ) );
+        TS_ASSERT( FloatUtils::gte( query.getUpperBound( 6 ), 2 ) );
+        TS_ASSERT( FloatUtils::lt( query.getUpperBound( 6 ), 3 ) );
+
+        // The new bound is propagated to f7
+        TS_ASSERT( FloatUtils::areEqual( query.getUpperBound( 7 ), query.getUpperBound( 6 ) ) );
+    }
+
+    void test_results_do_not_depend_on_number_of_workers()
+    {
+        InputQuery query1;
+        populateQuery( query1 );
+        InputQuery query2;
+        populateQuery( query2 );
+
+        LPBoundTightener tightener1( 1 );
+        LPBoundTightener tightener2( 4 );
+        TS_ASSERT( tightener1.tighten( query1 ) );
+        TS_ASSERT( tightener2.tighten( query2 ) );
+
+        TS_ASSERT_EQUALS( tightener1.getNumTightenedBounds(), tightener2.getNumTightenedBounds() );
+        for ( unsigned i = 0; i < query1.getNumberOfVariables(); ++i )
+        {
+            TS_ASSERT_EQUALS( query1.getLowerBound( i ), query2.getLowerBound( i ) );
+            TS_ASSERT_EQUALS( query1.getUpperBound( i ), query2.getUpperBound( i ) );
+        }
+    }
+
+    void test_infeasible_query()
+    {
+        InputQuery query;
+        populateQuery( query );
+
+        // With x0 <= -0.5 the relaxation gives b6 <= 0.5, and so
+        // f7 <= 1.125 by the upper side of the triangle. Interval
+        // arithmetic does not notice that f7 >= 1.2 is infeasible.
+        query.setUpperBound( 0, -0.5 );
+        query.setLowerBound( 7, 1.2 );
+
+        LPBoundTightener tightener( 2 );
+        TS_ASSERT( !tightener.tighten( query ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -14,10 +14,15 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "AbsoluteValueConstraint.h"
 #include "Engine.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MaxConstraint.h"
+#include "QueryLoader.h"
+#include "ReluConstraint.h"
+
+#include <cstdio>
 
 
 class MaxTestSuite : public CxxTest::TestSuite
@@ -202,6 +207,83 @@ public:
 		TS_ASSERT ( FloatUtils::areEqual( x1_relu, value_x3 ) )
 
     }
+
+    void test_max_and_absolute_value_in_loaded_query()
+    {
+        // x3 = | x0 + x1 |, x5 = ReLU( x0 - x1 ), x6 = max( x3, x5 ),
+        // x7 = x6 + x0. The query is saved and loaded, so that the
+        // engine runs the symbolic bound tightener that the loader
+        // constructs. x7 can reach 3 (at x0 = x1 = 1), but not 3.5.
+        double outputLowerBounds[] = { 2.5, 3.5 };
+        bool expectedResults[] = { true, false };
+        const String fileName( "max_and_absolute_value.ipq" );
+
+        for ( unsigned i = 0; i < 2; ++i )
+        {
+            InputQuery inputQuery;
+            inputQuery.setNumberOfVariables( 8 );
+
+            inputQuery.markInputVariable( 0, 0 );
+            inputQuery.markInputVariable( 1, 1 );
+            inputQuery.setLowerBound( 0, -1 );
+            inputQuery.setUpperBound( 0, 1 );
+            inputQuery.setLowerBound( 1, -1 );
+            inputQuery.setUpperBound( 1, 1 );
+
+            inputQuery.markOutputVariable( 7, 0 );
+            inputQuery.setLowerBound( 7, outputLowerBounds[i] );
+
+            Equation equation1;
+            equation1.addAddend( 1, 0 );
+            equation1.addAddend( 1, 1 );
+            equation1.addAddend( -1, 2 );
+            equation1.setScalar( 0 );
+            inputQuery.addEquation( equation1 );
+
+            Equation equation2;
+            equation2.addAddend( 1, 0 );
+            equation2.addAddend( -1, 1 );
+            equation2.addAddend( -1, 4 );
+            equation2.setScalar( 0 );
+            inputQuery.addEquation( equation2 );
+
+            Equation equation3;
+            equation3.addAddend( 1, 6 );
+            equation3.addAddend( 1, 0 );
+            equation3.addAddend( -1, 7 );
+            equation3.setScalar( 0 );
+            inputQuery.addEquation( equation3 );
+
+            inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( 2, 3 ) );
+            inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 4, 5 ) );
+            inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( 6, Set<unsigned>( { 3, 5 } ) ) );
+
+            inputQuery.saveQuery( fileName );
+            InputQuery loadedQuery = QueryLoader::loadQuery( fileName );
+            remove( fileName.ascii() );
+
+            TS_ASSERT( loadedQuery._sbt );
+
+            Engine engine;
+            bool result = false;
+            TS_ASSERT_THROWS_NOTHING( result = engine.processInputQuery( loadedQuery ) && engine.solve() );
+            TS_ASSERT_EQUALS( result, expectedResults[i] );
+
+            if ( result )
+            {
+                engine.extractSolution( loadedQuery );
+
+                double x0 = loadedQuery.getSolutionValue( 0 );
+                double x1 = loadedQuery.getSolutionValue( 1 );
+                double x7 = loadedQuery.getSolutionValue( 7 );
+                double expected = FloatUtils::max( FloatUtils::abs( x0 + x1 ),
+                                                   FloatUtils::max( x0 - x1, 0 ) ) + x0;
+
+                TS_ASSERT( FloatUtils::areEqual( x7, expected, 0.0001 ) );
+                TS_ASSERT( !FloatUtils::lt( x7, outputLowerBounds[i] ) );
+            }
+        }
+    }
 };
 
 //